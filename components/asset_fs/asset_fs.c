@@ -0,0 +1,152 @@
+#include "asset_fs.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <stdio.h>
+#include <string.h>
+
+#if CONFIG_ASSET_FS_LITTLEFS
+#include "esp_littlefs.h"
+#elif CONFIG_ASSET_FS_FATFS
+#include "esp_vfs_fat.h"
+#else
+#include "esp_spiffs.h"
+#endif
+
+static const char *TAG = "ASSETFS";
+
+#ifdef CONFIG_ASSET_FS_PARTITION_LABEL
+#define ASSET_FS_LABEL CONFIG_ASSET_FS_PARTITION_LABEL
+#else
+#define ASSET_FS_LABEL "spiffs"
+#endif
+
+#ifdef CONFIG_ASSET_FS_MAX_FILES
+#define ASSET_FS_MAX_FILES CONFIG_ASSET_FS_MAX_FILES
+#else
+#define ASSET_FS_MAX_FILES 12
+#endif
+
+static bool s_mounted = false;
+static uint32_t s_mount_us = 0;
+
+#if CONFIG_ASSET_FS_LITTLEFS
+
+static esp_err_t backend_mount(void)
+{
+    esp_vfs_littlefs_conf_t conf = {
+        .base_path = ASSET_FS_BASE_PATH,
+        .partition_label = ASSET_FS_LABEL,
+        .format_if_mount_failed = false,
+        .dont_mount = false,
+    };
+    return esp_vfs_littlefs_register(&conf);
+}
+
+static void backend_unmount(void)
+{
+    esp_vfs_littlefs_unregister(ASSET_FS_LABEL);
+}
+
+static esp_err_t backend_info(size_t *total, size_t *used)
+{
+    return esp_littlefs_info(ASSET_FS_LABEL, total, used);
+}
+
+const char* asset_fs_name(void) { return "LittleFS"; }
+
+#elif CONFIG_ASSET_FS_FATFS
+
+static esp_err_t backend_mount(void)
+{
+    const esp_vfs_fat_mount_config_t conf = {
+        .format_if_mount_failed = false,
+        .max_files = ASSET_FS_MAX_FILES,
+        .allocation_unit_size = 0,
+    };
+    return esp_vfs_fat_spiflash_mount_ro(ASSET_FS_BASE_PATH, ASSET_FS_LABEL, &conf);
+}
+
+static void backend_unmount(void)
+{
+    esp_vfs_fat_spiflash_unmount_ro(ASSET_FS_BASE_PATH, ASSET_FS_LABEL);
+}
+
+static esp_err_t backend_info(size_t *total, size_t *used)
+{
+    uint64_t t = 0, f = 0;
+    esp_err_t err = esp_vfs_fat_info(ASSET_FS_BASE_PATH, &t, &f);
+    *total = (size_t)t;
+    *used  = (size_t)(t - f);
+    return err;
+}
+
+const char* asset_fs_name(void) { return "FAT"; }
+
+#else
+
+static esp_err_t backend_mount(void)
+{
+    esp_vfs_spiffs_conf_t conf = {
+        .base_path = ASSET_FS_BASE_PATH,
+        .partition_label = ASSET_FS_LABEL,
+        .max_files = ASSET_FS_MAX_FILES,
+        .format_if_mount_failed = false,
+    };
+    return esp_vfs_spiffs_register(&conf);
+}
+
+static void backend_unmount(void)
+{
+    esp_vfs_spiffs_unregister(ASSET_FS_LABEL);
+}
+
+static esp_err_t backend_info(size_t *total, size_t *used)
+{
+    return esp_spiffs_info(ASSET_FS_LABEL, total, used);
+}
+
+const char* asset_fs_name(void) { return "SPIFFS"; }
+
+#endif
+
+esp_err_t asset_fs_mount(void)
+{
+    if (s_mounted) return ESP_OK;
+
+    int64_t t0 = esp_timer_get_time();
+    esp_err_t err = backend_mount();
+    s_mount_us = (uint32_t)(esp_timer_get_time() - t0);
+
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "%s mount of '%s' failed: %s", asset_fs_name(), ASSET_FS_LABEL, esp_err_to_name(err));
+        return err;
+    }
+    s_mounted = true;
+    ESP_LOGI(TAG, "%s '%s' mounted at %s in %u us", asset_fs_name(), ASSET_FS_LABEL, ASSET_FS_BASE_PATH,
+             (unsigned)s_mount_us);
+    return ESP_OK;
+}
+
+void asset_fs_unmount(void)
+{
+    if (!s_mounted) return;
+    backend_unmount();
+    s_mounted = false;
+}
+
+void asset_fs_get_info(asset_fs_info_t *out)
+{
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    out->mount_us = s_mount_us;
+    if (s_mounted && backend_info(&out->total_bytes, &out->used_bytes) != ESP_OK) {
+        out->total_bytes = out->used_bytes = 0;
+    }
+}
+
+int asset_fs_path(char *dst, size_t dst_sz, const char *rel)
+{
+    if (!rel) rel = "";
+    if (*rel == '/') rel++;
+    return snprintf(dst, dst_sz, "%s/%s", ASSET_FS_BASE_PATH, rel);
+}
@@ -0,0 +1,103 @@
+#include "asset_fs.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char *TAG = "ASSETFS";
+
+#define BENCH_BLOCK_SIZE (32 * 1024)
+#define BENCH_MAX_DEPTH  4
+
+typedef struct {
+    uint8_t *buf;
+    uint32_t files;
+    uint64_t bytes;
+    uint64_t open_us;
+    uint32_t open_max_us;
+    uint64_t read_us;
+} bench_t;
+
+static void bench_file(bench_t *b, const char *path)
+{
+    int64_t t0 = esp_timer_get_time();
+    int fd = open(path, O_RDONLY);
+    uint32_t open_us = (uint32_t)(esp_timer_get_time() - t0);
+    if (fd < 0) {
+        ESP_LOGW(TAG, "bench: open failed: %s", path);
+        return;
+    }
+
+    uint64_t bytes = 0;
+    int64_t t1 = esp_timer_get_time();
+    for (;;) {
+        ssize_t r = read(fd, b->buf, BENCH_BLOCK_SIZE);
+        if (r <= 0) break;
+        bytes += (uint64_t)r;
+    }
+    uint32_t read_us = (uint32_t)(esp_timer_get_time() - t1);
+    close(fd);
+
+    b->files++;
+    b->bytes += bytes;
+    b->open_us += open_us;
+    b->read_us += read_us;
+    if (open_us > b->open_max_us) b->open_max_us = open_us;
+
+    ESP_LOGD(TAG, "bench: %s open %u us, %u bytes in %u us", path, (unsigned)open_us, (unsigned)bytes,
+             (unsigned)read_us);
+}
+
+/* SPIFFS has no directories and returns "assets/x.bin" as a single entry;
+ * the other backends are walked recursively. */
+static void bench_dir(bench_t *b, const char *dir, int depth)
+{
+    DIR *d = opendir(dir);
+    if (!d) return;
+
+    struct dirent *e;
+    char path[256];
+    while ((e = readdir(d)) != NULL) {
+        if (e->d_name[0] == '.') continue;
+        if (snprintf(path, sizeof(path), "%s/%s", dir, e->d_name) >= (int)sizeof(path)) continue;
+
+        struct stat st;
+        if (stat(path, &st) != 0) continue;
+        if (S_ISDIR(st.st_mode)) {
+            if (depth < BENCH_MAX_DEPTH) bench_dir(b, path, depth + 1);
+        } else {
+            bench_file(b, path);
+        }
+    }
+    closedir(d);
+}
+
+void asset_fs_bench_run(void)
+{
+    bench_t b = { 0 };
+    b.buf = (uint8_t*)heap_caps_malloc(BENCH_BLOCK_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!b.buf) {
+        ESP_LOGE(TAG, "bench: buffer alloc failed");
+        return;
+    }
+
+    bench_dir(&b, ASSET_FS_BASE_PATH, 0);
+    heap_caps_free(b.buf);
+
+    asset_fs_info_t info;
+    asset_fs_get_info(&info);
+
+    /* bytes per microsecond == MB/s (10^6) */
+    uint32_t kbps = b.read_us ? (uint32_t)(b.bytes * 1000u / b.read_us) : 0;
+    ESP_LOGI(TAG, "bench %s: mount %u us, %u/%u KB used", asset_fs_name(), (unsigned)info.mount_us,
+             (unsigned)(info.used_bytes / 1024), (unsigned)(info.total_bytes / 1024));
+    ESP_LOGI(TAG, "bench %s: %u files, open avg %u us max %u us", asset_fs_name(), (unsigned)b.files,
+             (unsigned)(b.files ? b.open_us / b.files : 0), (unsigned)b.open_max_us);
+    ESP_LOGI(TAG, "bench %s: read %u KB in %u ms, %u.%03u MB/s", asset_fs_name(), (unsigned)(b.bytes / 1024),
+             (unsigned)(b.read_us / 1000), (unsigned)(kbps / 1000), (unsigned)(kbps % 1000));
+}
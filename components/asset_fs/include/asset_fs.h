@@ -0,0 +1,46 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Storage backend for assets/. The filesystem is chosen at build time
+ * (ASSET_FS_SPIFFS / ASSET_FS_LITTLEFS / ASSET_FS_FATFS) and mounted at
+ * ASSET_FS_BASE_PATH; everything above this layer uses plain VFS paths.
+ */
+
+#ifdef CONFIG_ASSET_FS_BASE_PATH
+#define ASSET_FS_BASE_PATH CONFIG_ASSET_FS_BASE_PATH
+#else
+#define ASSET_FS_BASE_PATH "/assets"
+#endif
+
+typedef struct {
+    uint32_t mount_us;
+    size_t total_bytes;
+    size_t used_bytes;
+} asset_fs_info_t;
+
+esp_err_t asset_fs_mount(void);
+void asset_fs_unmount(void);
+
+/* "SPIFFS", "LittleFS" or "FAT". */
+const char* asset_fs_name(void);
+
+void asset_fs_get_info(asset_fs_info_t* out);
+
+/* "assets/x.bin" -> ASSET_FS_BASE_PATH "/assets/x.bin". Returns the length snprintf() would write. */
+int asset_fs_path(char* dst, size_t dst_sz, const char* rel);
+
+/* Log mount time, per-file open latency and sequential read throughput for
+ * every file below ASSET_FS_BASE_PATH. */
+void asset_fs_bench_run(void);
+
+#ifdef __cplusplus
+}
+#endif
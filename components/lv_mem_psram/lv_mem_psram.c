@@ -1,9 +1,173 @@
 #include "lv_mem_psram.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "sdkconfig.h"
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+#define POOL_LOCK()      portENTER_CRITICAL(&s_lock)
+#define POOL_UNLOCK()    portEXIT_CRITICAL(&s_lock)
+#define ARENA_ALLOC(sz)  heap_caps_aligned_alloc(16, sz, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#else
+#define POOL_LOCK()
+#define POOL_UNLOCK()
+#define ARENA_ALLOC(sz)  aligned_alloc(16, sz)
+#define heap_caps_malloc(sz, caps)     malloc(sz)
+#define heap_caps_realloc(p, sz, caps) realloc(p, sz)
+#define heap_caps_free(p)              free(p)
+#if !CONFIG_LV_MEM_PSRAM_HYBRID && !CONFIG_LV_MEM_PSRAM_ONLY && !CONFIG_LV_MEM_PSRAM_MALLOC
+#define CONFIG_LV_MEM_PSRAM_HYBRID  1
+#endif
+#ifndef CONFIG_LV_MEM_PSRAM_POOL_KB
+#define CONFIG_LV_MEM_PSRAM_POOL_KB 48
+#endif
+#endif
 
 #ifndef LV_HEAP_CAPS
 #define LV_HEAP_CAPS  (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT | MALLOC_CAP_DMA)
 #endif
 
+#if CONFIG_LV_MEM_PSRAM_HYBRID
+
+#define SLAB_SIZE   4096
+#define CLASS_NUM   8
+#define ARENA_SIZE  (CONFIG_LV_MEM_PSRAM_POOL_KB * 1024)
+#define SLAB_NUM    (ARENA_SIZE / SLAB_SIZE)
+
+/* The arena is 16-byte aligned and slabs are 4 KB, so sizes in multiples of 16 keep every block 16-byte aligned */
+static const uint16_t s_class_size[CLASS_NUM] = {16, 32, 48, 64, 96, 128, 192, 256};
+/* Class of a size, by (size + 15) / 16 */
+static const uint8_t s_class_of[LV_MEM_PSRAM_SMALL_MAX / 16 + 1] = {0, 0, 1, 2, 3, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7};
+
+typedef struct free_block {
+    struct free_block * next;
+} free_block_t;
+
+static uint8_t * s_arena;                 /* NULL until the first call, or if it could not be allocated */
+static bool s_arena_tried;
+static size_t s_arena_top;                /* Bytes of the arena handed to classes */
+static uint8_t s_slab_class[SLAB_NUM];
+static free_block_t * s_free[CLASS_NUM];  /* Freed blocks */
+static uint8_t * s_bump[CLASS_NUM];       /* Never used blocks of the last slab of each class */
+static uint8_t * s_bump_end[CLASS_NUM];
+static lv_mem_psram_stats_t s_stats;
+
+static inline bool in_arena(const void * p) {
+    return (s_arena != NULL) && ((const uint8_t *)p >= s_arena) && ((const uint8_t *)p < s_arena + ARENA_SIZE);
+}
+
+/* Lock held */
+static void * pool_alloc(uint32_t c) {
+    void * p = s_free[c];
+    if(p != NULL) {
+        s_free[c] = s_free[c]->next;
+    }
+    else {
+        if(s_bump[c] == s_bump_end[c]) {
+            if(s_arena_top + SLAB_SIZE > ARENA_SIZE) {
+                return NULL;
+            }
+            s_slab_class[s_arena_top / SLAB_SIZE] = (uint8_t)c;
+            s_bump[c]     = s_arena + s_arena_top;
+            // The tail of a slab smaller than the class is left unused
+            s_bump_end[c] = s_bump[c] + SLAB_SIZE / s_class_size[c] * s_class_size[c];
+            s_arena_top  += SLAB_SIZE;
+        }
+        p = s_bump[c];
+        s_bump[c] += s_class_size[c];
+    }
+    s_stats.pool_allocs++;
+    s_stats.pool_used += s_class_size[c];
+    if(s_stats.pool_used > s_stats.pool_peak) {
+        s_stats.pool_peak = s_stats.pool_used;
+    }
+    return p;
+}
+
+static inline uint32_t class_of_block(const void * p) {
+    return s_slab_class[((const uint8_t *)p - s_arena) / SLAB_SIZE];
+}
+
+void * lv_mem_custom_alloc(size_t size) {
+    if(!s_arena_tried) {
+        // The first call comes from lv_init(), before any other task draws
+        s_arena_tried = true;
+        s_arena       = ARENA_ALLOC(ARENA_SIZE);
+    }
+    if((size <= LV_MEM_PSRAM_SMALL_MAX) && (s_arena != NULL)) {
+        POOL_LOCK();
+        void * p = pool_alloc(s_class_of[(size + 15) / 16]);
+        if(p == NULL) {
+            s_stats.spills++;
+        }
+        POOL_UNLOCK();
+        if(p != NULL) {
+            return p;
+        }
+    }
+    void * p = heap_caps_malloc(size, LV_HEAP_CAPS);
+    if(p != NULL) {
+        POOL_LOCK();
+        s_stats.psram_allocs++;
+        POOL_UNLOCK();
+    }
+    return p;
+}
+
+void lv_mem_custom_free(void * p) {
+    if(!in_arena(p)) {
+        heap_caps_free(p);
+        return;
+    }
+    uint32_t c = class_of_block(p);
+    POOL_LOCK();
+    ((free_block_t *)p)->next = s_free[c];
+    s_free[c]                 = (free_block_t *)p;
+    s_stats.pool_used        -= s_class_size[c];
+    POOL_UNLOCK();
+}
+
+void * lv_mem_custom_realloc(void * p, size_t new_size) {
+    if(p == NULL) {
+        return lv_mem_custom_alloc(new_size);
+    }
+    if(!in_arena(p)) {
+        return heap_caps_realloc(p, new_size, LV_HEAP_CAPS);
+    }
+    size_t old_size = s_class_size[class_of_block(p)];
+    if(new_size <= old_size) {
+        return p;
+    }
+    void * q = lv_mem_custom_alloc(new_size);
+    if(q != NULL) {
+        memcpy(q, p, old_size);
+        lv_mem_custom_free(p);
+    }
+    return q;
+}
+
+const char * lv_mem_psram_mode(void) {
+    return "hybrid";
+}
+
+void lv_mem_psram_get_stats(lv_mem_psram_stats_t * out, bool reset) {
+    POOL_LOCK();
+    *out            = s_stats;
+    out->pool_slabs = s_arena_top;
+    out->pool_size  = (s_arena != NULL) ? ARENA_SIZE : 0;
+    if(reset) {
+        size_t used = s_stats.pool_used;
+        memset(&s_stats, 0, sizeof(s_stats));
+        s_stats.pool_used = used;
+        s_stats.pool_peak = used;
+    }
+    POOL_UNLOCK();
+}
+
+#elif CONFIG_LV_MEM_PSRAM_ONLY
+
 void * lv_mem_custom_alloc(size_t size) {
     return heap_caps_malloc(size, LV_HEAP_CAPS);
 }
@@ -15,3 +179,35 @@ void * lv_mem_custom_realloc(void * p, size_t new_size) {
 void lv_mem_custom_free(void * p) {
     heap_caps_free(p);
 }
+
+const char * lv_mem_psram_mode(void) {
+    return "psram";
+}
+
+void lv_mem_psram_get_stats(lv_mem_psram_stats_t * out, bool reset) {
+    memset(out, 0, sizeof(*out));
+}
+
+#else
+
+void * lv_mem_custom_alloc(size_t size) {
+    return malloc(size);
+}
+
+void * lv_mem_custom_realloc(void * p, size_t new_size) {
+    return realloc(p, new_size);
+}
+
+void lv_mem_custom_free(void * p) {
+    free(p);
+}
+
+const char * lv_mem_psram_mode(void) {
+    return "malloc";
+}
+
+void lv_mem_psram_get_stats(lv_mem_psram_stats_t * out, bool reset) {
+    memset(out, 0, sizeof(*out));
+}
+
+#endif
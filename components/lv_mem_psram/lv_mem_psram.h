@@ -1,7 +1,59 @@
 #pragma once
+#include <stdbool.h>
 #include <stddef.h>
-#include "esp_heap_caps.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * LVGL allocator (LV_MEM_CUSTOM_INCLUDE).
+ *
+ * LV_MEM_PSRAM_HYBRID: blocks of up to LV_MEM_PSRAM_SMALL_MAX bytes (objects,
+ * style lists, event descriptors, timers, animations) come from fixed
+ * size-class pools in internal SRAM. Each class takes 4 KB slabs from one SRAM
+ * arena of LV_MEM_PSRAM_POOL_KB, allocated at the first call, and keeps its
+ * freed blocks in a list, so allocating and freeing a small block is O(1).
+ * Larger blocks, and small ones once the arena is used up, go to PSRAM.
+ * LV_MEM_PSRAM_ONLY: every block goes to PSRAM. LV_MEM_PSRAM_MALLOC: malloc().
+ */
+
+#define LV_MEM_PSRAM_SMALL_MAX 256
+
+typedef struct {
+    uint32_t pool_allocs;  /* Served by the SRAM pools */
+    uint32_t psram_allocs; /* Served by the PSRAM heap */
+    uint32_t spills;       /* Small blocks sent to PSRAM because the arena was used up */
+    size_t pool_used;      /* Bytes of pool blocks in use, at their class size */
+    size_t pool_peak;      /* Highest pool_used since the last reset */
+    size_t pool_slabs;     /* Bytes of the arena handed to size classes */
+    size_t pool_size;      /* Bytes of the arena, 0 without pools */
+} lv_mem_psram_stats_t;
 
 void * lv_mem_custom_alloc(size_t size);
 void * lv_mem_custom_realloc(void * p, size_t new_size);
 void   lv_mem_custom_free(void * p);
+
+/* "hybrid", "psram" or "malloc" */
+const char * lv_mem_psram_mode(void);
+
+/* Counters since the last reset; `reset` clears them and sets the peak to the current use. */
+void lv_mem_psram_get_stats(lv_mem_psram_stats_t * out, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*
+ * lv_mem.c includes this header after lv_conf_internal.h has defaulted the
+ * custom allocator to malloc(), realloc() and free(): point it here.
+ */
+#ifdef LV_MEM_CUSTOM_ALLOC
+#undef LV_MEM_CUSTOM_ALLOC
+#undef LV_MEM_CUSTOM_FREE
+#undef LV_MEM_CUSTOM_REALLOC
+#define LV_MEM_CUSTOM_ALLOC   lv_mem_custom_alloc
+#define LV_MEM_CUSTOM_FREE    lv_mem_custom_free
+#define LV_MEM_CUSTOM_REALLOC lv_mem_custom_realloc
+#endif
@@ -14,7 +14,9 @@
  *      DEFINES
  *********************/
 #define RND_NUM         64
+#ifndef SCENE_TIME
 #define SCENE_TIME      1000      /*ms*/
+#endif
 #define ANIM_TIME_MIN   ((2 * SCENE_TIME) / 10)
 #define ANIM_TIME_MAX   (SCENE_TIME)
 #define OBJ_NUM         8
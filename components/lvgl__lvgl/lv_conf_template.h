@@ -172,6 +172,14 @@
  *Only used if software rotation is enabled in the display driver.*/
 #define LV_DISP_ROT_MAX_BUF (10*1024)
 
+/*Mix RGB565 channels of one or two pixels in a 32-bit word in the software blender.
+ *Gives the same result as `lv_color_mix()`. Only used with 16 bit color depth without byte swap.*/
+#define LV_DRAW_SW_SWAR 0
+
+/*Split refreshed areas around the largest part covered by an opaque object
+ *and don't draw the screen background and the objects under it there.*/
+#define LV_REFR_OCCLUSION 0
+
 /*-------------
  * GPU
  *-----------*/
@@ -409,6 +417,10 @@
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 0
 
+/*Cache the glyphs of 1, 2 and 4 bpp fonts expanded to 8 bpp opacity masks.
+ *Size of the cache in bytes, 0: disable*/
+#define LV_FONT_FMT_TXT_A8_CACHE_SIZE 0
+
 /*Enable subpixel rendering*/
 #define LV_USE_FONT_SUBPX 0
 #if LV_USE_FONT_SUBPX
@@ -449,6 +461,9 @@
 /*The control character to use for signalling text recoloring.*/
 #define LV_TXT_COLOR_CMD "#"
 
+/*Number of texts whose line breaks and line widths are cached. 0: disable*/
+#define LV_TXT_LAYOUT_CACHE_NUM 0
+
 /*Support bidirectional texts. Allows mixing Left-to-Right and Right-to-Left texts.
  *The direction will be processed according to the Unicode Bidirectional Algorithm:
  *https://www.w3.org/International/articles/inline-bidi-markup/uba-basics*/
@@ -56,6 +56,11 @@ static void refr_invalid_areas(void);
 static void refr_sync_areas(void);
 static void refr_area(const lv_area_t * area_p);
 static void refr_area_part(lv_draw_ctx_t * draw_ctx);
+static lv_obj_t * refr_area_part_objs(lv_draw_ctx_t * draw_ctx, const lv_area_t * top_area);
+#if LV_REFR_OCCLUSION
+static void refr_area_part_occluded(lv_draw_ctx_t * draw_ctx);
+static void find_occluder(lv_obj_t * obj, const lv_area_t * area_p, lv_area_t * best);
+#endif
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void refr_obj_and_children(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_obj);
 static void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
@@ -75,6 +80,9 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
  **********************/
 static uint32_t px_num;
 static lv_disp_t * disp_refr; /*Display being refreshed*/
+#if LV_REFR_OCCLUSION
+    static uint32_t occluded_px;
+#endif
 
 #if LV_USE_PERF_MONITOR
     static perf_monitor_t   perf_monitor;
@@ -723,13 +731,30 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
 #endif
     }
 
+#if LV_REFR_OCCLUSION
+    refr_area_part_occluded(draw_ctx);
+#else
+    refr_area_part_objs(draw_ctx, draw_ctx->buf_area);
+#endif
+
+    draw_buf_flush(disp_refr);
+}
+
+/**
+ * Draw the screens and layers into the current clip area of the draw context
+ * @param draw_ctx  pointer to the draw context
+ * @param top_area  drawing starts from the most top object which fully covers this area
+ * @return          the object of the active screen the drawing started from
+ */
+static lv_obj_t * refr_area_part_objs(lv_draw_ctx_t * draw_ctx, const lv_area_t * top_area)
+{
     lv_obj_t * top_act_scr = NULL;
     lv_obj_t * top_prev_scr = NULL;
 
     /*Get the most top object which is not covered by others*/
-    top_act_scr = lv_refr_get_top_obj(draw_ctx->buf_area, lv_disp_get_scr_act(disp_refr));
+    top_act_scr = lv_refr_get_top_obj(top_area, lv_disp_get_scr_act(disp_refr));
     if(disp_refr->prev_scr) {
-        top_prev_scr = lv_refr_get_top_obj(draw_ctx->buf_area, disp_refr->prev_scr);
+        top_prev_scr = lv_refr_get_top_obj(top_area, disp_refr->prev_scr);
     }
 
     /*Draw a display background if there is no top object*/
@@ -793,8 +818,106 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
     refr_obj_and_children(draw_ctx, lv_disp_get_layer_top(disp_refr));
     refr_obj_and_children(draw_ctx, lv_disp_get_layer_sys(disp_refr));
 
-    draw_buf_flush(disp_refr);
+    return top_act_scr;
+}
+
+#if LV_REFR_OCCLUSION
+/*Smaller occluders are not worth the extra passes over the object tree*/
+#define REFR_OCCLUSION_MIN_PX   1024
+
+/**
+ * Draw the clip area of the draw context in up to 5 parts: the largest part covered by an opaque
+ * object of the active screen, and the strips around it. The covered part starts from that
+ * object, so the screen background and everything under it are not drawn there.
+ * The result is the same as drawing the whole clip area at once.
+ * @param draw_ctx  pointer to the draw context
+ */
+static void refr_area_part_occluded(lv_draw_ctx_t * draw_ctx)
+{
+    const lv_area_t * clip_ori = draw_ctx->clip_area;
+    lv_area_t occ = {0, 0, -1, -1};
+
+    /*During screen load animations both screens are drawn; keep them in one pass*/
+    if(disp_refr->prev_scr == NULL && !disp_refr->driver->screen_transp) {
+        lv_obj_t * scr = lv_disp_get_scr_act(disp_refr);
+        lv_obj_t * child;
+        uint32_t i;
+        for(i = 0; i < lv_obj_get_child_cnt(scr); i++) {
+            child = scr->spec_attr->children[i];
+            find_occluder(child, clip_ori, &occ);
+        }
+    }
+
+    if(lv_area_get_size(&occ) < REFR_OCCLUSION_MIN_PX || _lv_area_is_in(clip_ori, &occ, 0)) {
+        refr_area_part_objs(draw_ctx, clip_ori);
+        return;
+    }
+
+    lv_area_t parts[4];
+    uint32_t part_cnt = 0;
+    if(occ.y1 > clip_ori->y1) lv_area_set(&parts[part_cnt++], clip_ori->x1, clip_ori->y1, clip_ori->x2, occ.y1 - 1);
+    if(occ.y2 < clip_ori->y2) lv_area_set(&parts[part_cnt++], clip_ori->x1, occ.y2 + 1, clip_ori->x2, clip_ori->y2);
+    if(occ.x1 > clip_ori->x1) lv_area_set(&parts[part_cnt++], clip_ori->x1, occ.y1, occ.x1 - 1, occ.y2);
+    if(occ.x2 < clip_ori->x2) lv_area_set(&parts[part_cnt++], occ.x2 + 1, occ.y1, clip_ori->x2, occ.y2);
+
+    draw_ctx->clip_area = &occ;
+    lv_obj_t * top_obj = refr_area_part_objs(draw_ctx, &occ);
+    if(top_obj != lv_disp_get_scr_act(disp_refr)) occluded_px += lv_area_get_size(&occ);
+
+    uint32_t i;
+    for(i = 0; i < part_cnt; i++) {
+        draw_ctx->clip_area = &parts[i];
+        refr_area_part_objs(draw_ctx, &parts[i]);
+    }
+
+    draw_ctx->clip_area = clip_ori;
+}
+
+/**
+ * Find the largest part of an area fully covered by `obj` or one of its children
+ * @param obj       the object to check
+ * @param area_p    the area to cover, already clipped to the parents of `obj`
+ * @param best      the largest covered part found so far, updated if `obj` covers more
+ */
+static void find_occluder(lv_obj_t * obj, const lv_area_t * area_p, lv_area_t * best)
+{
+    lv_area_t part;
+    if(!_lv_area_intersect(&part, area_p, &obj->coords)) return;
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+    if(_lv_obj_get_layer_type(obj) != LV_LAYER_TYPE_NONE) return;
+
+    lv_cover_check_info_t info;
+    info.res = LV_COVER_RES_COVER;
+    info.area = &part;
+    lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+    if(info.res == LV_COVER_RES_MASKED) return;
+    if(info.res == LV_COVER_RES_COVER && lv_area_get_size(&part) > lv_area_get_size(best)) *best = part;
+
+    /*An object with a frame (e.g. an image with a border) may still cover its content area*/
+    lv_area_t content;
+    lv_obj_get_content_coords(obj, &content);
+    if(info.res != LV_COVER_RES_COVER && _lv_area_intersect(&content, &part, &content) &&
+       lv_area_get_size(&content) > lv_area_get_size(best)) {
+        info.res = LV_COVER_RES_COVER;
+        info.area = &content;
+        lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+        if(info.res == LV_COVER_RES_COVER) *best = content;
+    }
+
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+    for(i = 0; i < child_cnt; i++) {
+        find_occluder(obj->spec_attr->children[i], &part, best);
+    }
+}
+
+uint32_t lv_refr_get_occluded_px(bool reset)
+{
+    uint32_t px = occluded_px;
+    if(reset) occluded_px = 0;
+    return px;
 }
+#endif /*LV_REFR_OCCLUSION*/
 
 /**
  * Search the most top object which fully covers an area
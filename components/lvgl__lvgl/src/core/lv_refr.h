@@ -85,6 +85,16 @@ lv_disp_t * _lv_refr_get_disp_refreshing(void);
  */
 void _lv_refr_set_disp_refreshing(lv_disp_t * disp);
 
+#if LV_REFR_OCCLUSION
+/**
+ * Get the number of pixels drawn without the objects under an opaque occluder
+ * (at least one skipped background fill each)
+ * @param reset     clear the counter after reading
+ * @return          the pixels since the last reset
+ */
+uint32_t lv_refr_get_occluded_px(bool reset);
+#endif
+
 #if LV_USE_PERF_MONITOR
 /**
  * Reset FPS counter
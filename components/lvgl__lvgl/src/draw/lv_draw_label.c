@@ -35,6 +35,10 @@ typedef uint8_t cmd_state_t;
  **********************/
 
 static uint8_t hex_char_to_num(char hex);
+static uint32_t get_line_end(const lv_draw_label_dsc_t * dsc, const char * txt, uint32_t line_start, lv_coord_t w,
+                             const _lv_txt_layout_t * layout, uint32_t line_i);
+static lv_coord_t get_line_width(const lv_draw_label_dsc_t * dsc, const char * txt, uint32_t line_start,
+                                 uint32_t line_end, const _lv_txt_layout_t * layout, uint32_t line_i);
 
 /**********************
  *  STATIC VARIABLES
@@ -136,6 +140,15 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
     uint32_t line_start     = 0;
     int32_t last_line_start = -1;
 
+    /*With a cached layout the lines are found without measuring the text, so the hint is not needed*/
+#if LV_TXT_LAYOUT_CACHE_NUM
+    const _lv_txt_layout_t * layout = _lv_txt_get_layout(txt, font, dsc->letter_space, w, dsc->flag);
+    if(layout) hint = NULL;
+#else
+    const _lv_txt_layout_t * layout = NULL;
+#endif
+    uint32_t line_i = 0;
+
     /*Check the hint to use the cached info*/
     if(hint && y_ofs == 0 && coords->y1 < 0) {
         /*If the label changed too much recalculate the hint.*/
@@ -151,13 +164,14 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
         pos.y += hint->y;
     }
 
-    uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+    uint32_t line_end = get_line_end(dsc, txt, line_start, w, layout, line_i);
 
     /*Go the first visible line*/
     while(pos.y + line_height_font < draw_ctx->clip_area->y1) {
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_i++;
+        line_end = get_line_end(dsc, txt, line_start, w, layout, line_i);
         pos.y += line_height;
 
         /*Save at the threshold coordinate*/
@@ -172,14 +186,14 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        line_width = get_line_width(dsc, txt, line_start, line_end, layout, line_i);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        line_width = get_line_width(dsc, txt, line_start, line_end, layout, line_i);
         pos.x += lv_area_get_width(coords) - line_width;
     }
     uint32_t sel_start = dsc->sel_start;
@@ -334,21 +348,20 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_i++;
+        line_end = get_line_end(dsc, txt, line_start, w, layout, line_i);
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = get_line_width(dsc, txt, line_start, line_end, layout, line_i);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = get_line_width(dsc, txt, line_start, line_end, layout, line_i);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -371,6 +384,32 @@ void lv_draw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get where the line starting at `line_start` ends.
+ * @param layout the cached layout of `txt` or NULL to break the line now
+ * @param line_i index of the line in `layout`
+ */
+static uint32_t get_line_end(const lv_draw_label_dsc_t * dsc, const char * txt, uint32_t line_start, lv_coord_t w,
+                             const _lv_txt_layout_t * layout, uint32_t line_i)
+{
+    if(layout) return line_i < layout->line_cnt ? layout->lines[line_i + 1].start : line_start;
+
+    return line_start + _lv_txt_get_next_line(&txt[line_start], dsc->font, dsc->letter_space, w, NULL, dsc->flag);
+}
+
+/**
+ * Get the width of a line.
+ * @param layout the cached layout of `txt` or NULL to measure the line now
+ * @param line_i index of the line in `layout`
+ */
+static lv_coord_t get_line_width(const lv_draw_label_dsc_t * dsc, const char * txt, uint32_t line_start,
+                                 uint32_t line_end, const _lv_txt_layout_t * layout, uint32_t line_i)
+{
+    if(layout) return line_i < layout->line_cnt ? layout->lines[line_i].width : 0;
+
+    return lv_txt_get_width(&txt[line_start], line_end - line_start, dsc->font, dsc->letter_space, dsc->flag);
+}
+
 /**
  * Convert a hexadecimal characters to a number (0..15)
  * @param hex Pointer to a hexadecimal character (0..9, A..F)
@@ -14,6 +14,11 @@
 /*********************
  *      DEFINES
  *********************/
+#if LV_DRAW_SW_SWAR && LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0 && LV_COLOR_MIX_ROUND_OFS != 0
+    #define BLEND_SWAR  1
+#else
+    #define BLEND_SWAR  0
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -26,12 +31,12 @@
 static void fill_set_px(lv_color_t * dest_buf, const lv_area_t * blend_area, lv_coord_t dest_stride,
                         lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stide);
 
-static void /* LV_ATTRIBUTE_FAST_MEM */ fill_normal(lv_color_t * dest_buf, const lv_area_t * dest_area,
+static void LV_ATTRIBUTE_FAST_MEM fill_normal(lv_color_t * dest_buf, const lv_area_t * dest_area,
                                                     lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa,
                                                     const lv_opa_t * mask, lv_coord_t mask_stride);
 
 #if LV_COLOR_SCREEN_TRANSP
-static void /* LV_ATTRIBUTE_FAST_MEM */ fill_argb(lv_color_t * dest_buf, const lv_area_t * dest_area,
+static void LV_ATTRIBUTE_FAST_MEM fill_argb(lv_color_t * dest_buf, const lv_area_t * dest_area,
                                                   lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa,
                                                   const lv_opa_t * mask, lv_coord_t mask_stride);
 #endif /*LV_COLOR_SCREEN_TRANSP*/
@@ -45,13 +50,13 @@ static void map_set_px(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_co
                        const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa,
                        const lv_opa_t * mask, lv_coord_t mask_stride);
 
-static void /* LV_ATTRIBUTE_FAST_MEM */ map_normal(lv_color_t * dest_buf, const lv_area_t * dest_area,
+static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_area_t * dest_area,
                                                    lv_coord_t dest_stride, const lv_color_t * src_buf,
                                                    lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask,
                                                    lv_coord_t mask_stride);
 
 #if LV_COLOR_SCREEN_TRANSP
-static void /* LV_ATTRIBUTE_FAST_MEM */ map_argb(lv_color_t * dest_buf, const lv_area_t * dest_area,
+static void LV_ATTRIBUTE_FAST_MEM map_argb(lv_color_t * dest_buf, const lv_area_t * dest_area,
                                                  lv_coord_t dest_stride, const lv_color_t * src_buf,
                                                  lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask,
                                                  lv_coord_t mask_stride, lv_blend_mode_t blend_mode);
@@ -77,17 +82,94 @@ static inline lv_color_t color_blend_true_color_multiply(lv_color_t fg, lv_color
  **********************/
 #define FILL_NORMAL_MASK_PX(color)                                                          \
     if(*mask == LV_OPA_COVER) *dest_buf = color;                                 \
-    else *dest_buf = lv_color_mix(color, *dest_buf, *mask);            \
+    else *dest_buf = blend_mix(color, *dest_buf, *mask);            \
     mask++;                                                         \
     dest_buf++;
 
 #define MAP_NORMAL_MASK_PX(x)                                                          \
     if(*mask_tmp_x) {          \
         if(*mask_tmp_x == LV_OPA_COVER) dest_buf[x] = src_buf[x];                                 \
-        else dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], *mask_tmp_x);            \
+        else dest_buf[x] = blend_mix(src_buf[x], dest_buf[x], *mask_tmp_x);            \
     }                                                                                               \
     mask_tmp_x++;
 
+#if BLEND_SWAR
+/* RGB565 channels are mixed in two 16-bit lanes of a 32-bit word: red and blue of one pixel, or the green
+ * channels of two pixels. A lane holds at most 63 * 255 + LV_COLOR_MIX_ROUND_OFS, so lanes never carry
+ * into each other, and (x + 1 + (x >> 8)) >> 8 equals LV_UDIV255(x) for every x < 65535.
+ * The results are identical to lv_color_mix() and lv_color_mix_premult().*/
+#define SWAR_LANES      0x00FF00FFU
+#define SWAR_G2_MASK    0x003F003FU
+#define SWAR_ROUND_OFS  ((uint32_t)LV_COLOR_MIX_ROUND_OFS * 0x00010001U)
+
+static inline uint32_t swar_div255(uint32_t x)
+{
+    return ((x + 0x00010001U + ((x >> 8) & SWAR_LANES)) >> 8) & SWAR_LANES;
+}
+
+/*Red in the high lane, blue in the low lane*/
+static inline uint32_t swar_rb(uint32_t px)
+{
+    return ((px & 0xF800) << 5) | (px & 0x001F);
+}
+
+static inline uint32_t swar_pack(uint32_t rb, uint32_t g)
+{
+    return ((rb >> 5) & 0xF800) | (g << 5) | (rb & 0x001F);
+}
+
+/*Two pixels, pixel 0 in the low half*/
+static inline uint32_t swar_load2(const lv_color_t * buf)
+{
+    return buf[0].full | ((uint32_t)buf[1].full << 16);
+}
+
+static inline void swar_store2(lv_color_t * buf, uint32_t px2)
+{
+    buf[0].full = (uint16_t)px2;
+    buf[1].full = (uint16_t)(px2 >> 16);
+}
+
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM swar_mix(uint32_t fg, uint32_t bg, uint32_t mix, uint32_t mix_inv)
+{
+    uint32_t rb = swar_div255(swar_rb(fg) * mix + swar_rb(bg) * mix_inv + SWAR_ROUND_OFS);
+    uint32_t g = swar_div255(((fg >> 5) & 0x3F) * mix + ((bg >> 5) & 0x3F) * mix_inv + LV_COLOR_MIX_ROUND_OFS);
+    return swar_pack(rb, g);
+}
+
+/*Mix two pixel pairs with the same opacity*/
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM swar_mix2(uint32_t fg2, uint32_t bg2, uint32_t mix, uint32_t mix_inv)
+{
+    uint32_t rb0 = swar_div255(swar_rb(fg2 & 0xFFFF) * mix + swar_rb(bg2 & 0xFFFF) * mix_inv + SWAR_ROUND_OFS);
+    uint32_t rb1 = swar_div255(swar_rb(fg2 >> 16) * mix + swar_rb(bg2 >> 16) * mix_inv + SWAR_ROUND_OFS);
+    uint32_t g2 = swar_div255(((fg2 >> 5) & SWAR_G2_MASK) * mix + ((bg2 >> 5) & SWAR_G2_MASK) * mix_inv +
+                              SWAR_ROUND_OFS);
+    return swar_pack(rb0, g2 & 0xFFFF) | (swar_pack(rb1, g2 >> 16) << 16);
+}
+
+/*Mix a pixel pair over a constant, premultiplied color: `premult_rb = swar_rb(c) * opa + SWAR_ROUND_OFS`,
+ *`premult_g2 = green(c) * opa * 0x10001 + SWAR_ROUND_OFS`*/
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM swar_mix2_premult(uint32_t premult_rb, uint32_t premult_g2,
+                                                               uint32_t bg2, uint32_t mix_inv)
+{
+    uint32_t rb0 = swar_div255(swar_rb(bg2 & 0xFFFF) * mix_inv + premult_rb);
+    uint32_t rb1 = swar_div255(swar_rb(bg2 >> 16) * mix_inv + premult_rb);
+    uint32_t g2 = swar_div255(((bg2 >> 5) & SWAR_G2_MASK) * mix_inv + premult_g2);
+    return swar_pack(rb0, g2 & 0xFFFF) | (swar_pack(rb1, g2 >> 16) << 16);
+}
+#endif /*BLEND_SWAR*/
+
+static inline lv_color_t LV_ATTRIBUTE_FAST_MEM blend_mix(lv_color_t c1, lv_color_t c2, lv_opa_t mix)
+{
+#if BLEND_SWAR
+    lv_color_t ret;
+    ret.full = (uint16_t)swar_mix(c1.full, c2.full, mix, 255 - mix);
+    return ret;
+#else
+    return lv_color_mix(c1, c2, mix);
+#endif
+}
+
 /**********************
  *   GLOBAL FUNCTIONS
  **********************/
@@ -270,6 +352,29 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
             opa = opa << 3;
 #endif
 
+#if BLEND_SWAR
+            LV_UNUSED(last_res_color);
+            uint32_t opa_inv = 255 - opa;
+            uint32_t premult_rb = swar_rb(color.full) * opa + SWAR_ROUND_OFS;
+            uint32_t premult_g2 = ((color.full >> 5) & 0x3F) * opa * 0x00010001U + SWAR_ROUND_OFS;
+            uint32_t last_dest2 = 0;
+            uint32_t last_res2 = swar_mix2_premult(premult_rb, premult_g2, last_dest2, opa_inv);
+
+            for(y = 0; y < h; y++) {
+                for(x = 0; x < w - 1; x += 2) {
+                    uint32_t dest2 = swar_load2(&dest_buf[x]);
+                    if(last_dest2 != dest2) {
+                        last_dest2 = dest2;
+                        last_res2 = swar_mix2_premult(premult_rb, premult_g2, dest2, opa_inv);
+                    }
+                    swar_store2(&dest_buf[x], last_res2);
+                }
+                if(x < w) {
+                    dest_buf[x].full = (uint16_t)swar_mix2_premult(premult_rb, premult_g2, dest_buf[x].full, opa_inv);
+                }
+                dest_buf += dest_stride;
+            }
+#else
             uint16_t color_premult[3];
             lv_color_premult(color, opa, color_premult);
             lv_opa_t opa_inv = 255 - opa;
@@ -284,6 +389,7 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
                 }
                 dest_buf += dest_stride;
             }
+#endif
         }
     }
     /*Masked*/
@@ -359,7 +465,7 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
                                                              (uint32_t)((uint32_t)(*mask) * opa) >> 8;
                         if(*mask != last_mask || last_dest_color.full != dest_buf[x].full) {
                             if(opa_tmp == LV_OPA_COVER) last_res_color = color;
-                            else last_res_color = lv_color_mix(color, dest_buf[x], opa_tmp);
+                            else last_res_color = blend_mix(color, dest_buf[x], opa_tmp);
                             last_mask = *mask;
                             last_dest_color.full = dest_buf[x].full;
                         }
@@ -660,6 +766,19 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
             }
         }
         else {
+#if BLEND_SWAR
+            uint32_t opa_inv = 255 - opa;
+            for(y = 0; y < h; y++) {
+                for(x = 0; x < w - 1; x += 2) {
+                    swar_store2(&dest_buf[x], swar_mix2(swar_load2(&src_buf[x]), swar_load2(&dest_buf[x]), opa, opa_inv));
+                }
+                if(x < w) {
+                    dest_buf[x].full = (uint16_t)swar_mix(src_buf[x].full, dest_buf[x].full, opa, opa_inv);
+                }
+                dest_buf += dest_stride;
+                src_buf += src_stride;
+            }
+#else
             for(y = 0; y < h; y++) {
                 for(x = 0; x < w; x++) {
                     dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], opa);
@@ -667,6 +786,7 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
                 dest_buf += dest_stride;
                 src_buf += src_stride;
             }
+#endif
         }
     }
     /*Masked*/
@@ -722,7 +842,7 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
                 for(x = 0; x < w; x++) {
                     if(mask[x]) {
                         lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
-                        dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], opa_tmp);
+                        dest_buf[x] = blend_mix(src_buf[x], dest_buf[x], opa_tmp);
                     }
                 }
                 dest_buf += dest_stride;
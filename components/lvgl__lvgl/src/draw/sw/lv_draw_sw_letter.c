@@ -285,30 +285,44 @@ static void LV_ATTRIBUTE_FAST_MEM draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
 #if LV_DRAW_COMPLEX
         int32_t mask_p_start = mask_p;
 #endif
-        bitmask = bitmask_init >> col_bit;
-        for(col = col_start; col < col_end; col++) {
-            /*Load the pixel's opacity into the mask*/
-            letter_px = (*map_p & bitmask) >> (col_bit_max - col_bit);
-            if(letter_px) {
-                mask_buf[mask_p] = bpp_opa_table_p[letter_px];
+        if(bpp == 8) {
+            /*One opacity byte per pixel (e.g. from the A8 glyph cache): copy or map the whole row*/
+            int32_t w = col_end - col_start;
+            if(opa >= LV_OPA_MAX) {
+                lv_memcpy(mask_buf + mask_p, map_p, w);
             }
             else {
-                mask_buf[mask_p] = 0;
+                for(col = 0; col < w; col++) mask_buf[mask_p + col] = bpp_opa_table_p[map_p[col]];
             }
+            map_p += w;
+            mask_p += w;
+        }
+        else {
+            bitmask = bitmask_init >> col_bit;
+            for(col = col_start; col < col_end; col++) {
+                /*Load the pixel's opacity into the mask*/
+                letter_px = (*map_p & bitmask) >> (col_bit_max - col_bit);
+                if(letter_px) {
+                    mask_buf[mask_p] = bpp_opa_table_p[letter_px];
+                }
+                else {
+                    mask_buf[mask_p] = 0;
+                }
 
-            /*Go to the next column*/
-            if(col_bit < col_bit_max) {
-                col_bit += bpp;
-                bitmask = bitmask >> bpp;
-            }
-            else {
-                col_bit = 0;
-                bitmask = bitmask_init;
-                map_p++;
-            }
+                /*Go to the next column*/
+                if(col_bit < col_bit_max) {
+                    col_bit += bpp;
+                    bitmask = bitmask >> bpp;
+                }
+                else {
+                    col_bit = 0;
+                    bitmask = bitmask_init;
+                    map_p++;
+                }
 
-            /*Next mask byte*/
-            mask_p++;
+                /*Next mask byte*/
+                mask_p++;
+            }
         }
 
 #if LV_DRAW_COMPLEX
@@ -18,6 +18,10 @@
 /*********************
  *      DEFINES
  *********************/
+#if LV_FONT_FMT_TXT_A8_CACHE_SIZE
+    #define A8_CACHE_SETS   128
+    #define A8_CACHE_WAYS   4
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -28,6 +32,16 @@ typedef enum {
     RLE_STATE_COUNTER,
 } rle_state_t;
 
+#if LV_FONT_FMT_TXT_A8_CACHE_SIZE
+typedef struct {
+    const lv_font_fmt_txt_dsc_t * fdsc; /*NULL: unused*/
+    uint8_t * buf;                      /*box_w * box_h opacity bytes*/
+    uint32_t gid;
+    uint32_t size;
+    uint32_t life;                      /*Time of the last use, the smallest is evicted first*/
+} a8_cache_entry_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -36,6 +50,15 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
 static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
 static int32_t kern_pair_16_compare(const void * ref, const void * element);
+static const uint8_t * get_bitmap_packed(const lv_font_fmt_txt_dsc_t * fdsc,
+                                         const lv_font_fmt_txt_glyph_dsc_t * gdsc);
+
+#if LV_FONT_FMT_TXT_A8_CACHE_SIZE
+    static bool a8_cache_used(const lv_font_t * font);
+    static const uint8_t * a8_cache_get(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid);
+    static void a8_cache_drop(a8_cache_entry_t * e);
+    static void a8_expand(const uint8_t * in, uint8_t * out, uint32_t px_num, uint8_t bpp);
+#endif
 
 #if LV_USE_FONT_COMPRESSED
     static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord_t h, uint8_t bpp, bool prefilter);
@@ -58,9 +81,25 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
     static rle_state_t rle_state;
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_FONT_FMT_TXT_A8_CACHE_SIZE
+    static a8_cache_entry_t * a8_cache;     /*A8_CACHE_SETS * A8_CACHE_WAYS entries*/
+    static uint32_t a8_cache_bytes;
+    static uint32_t a8_cache_glyphs;
+    static uint32_t a8_cache_life;
+    static uint32_t a8_cache_hits;
+    static uint32_t a8_cache_misses;
+    static uint8_t * a8_scratch;            /*Used for glyphs which can't be cached*/
+    static uint32_t a8_scratch_size;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
+#if LV_FONT_FMT_TXT_A8_CACHE_SIZE
+    extern const uint8_t _lv_bpp1_opa_table[2];
+    extern const uint8_t _lv_bpp2_opa_table[4];
+    extern const uint8_t _lv_bpp4_opa_table[16];
+#endif
 
 /**********************
  *      MACROS
@@ -78,63 +117,19 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
  */
 const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unicode_letter)
 {
-    if(unicode_letter == '\t') unicode_letter = ' ';
+    bool is_tab = unicode_letter == '\t';
+    if(is_tab) unicode_letter = ' ';
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
     uint32_t gid = get_glyph_dsc_id(font, unicode_letter);
     if(!gid) return NULL;
 
-    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
-
-    if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
-        return &fdsc->glyph_bitmap[gdsc->bitmap_index];
-    }
-    /*Handle compressed bitmap*/
-    else {
-#if LV_USE_FONT_COMPRESSED
-        static size_t last_buf_size = 0;
-        if(LV_GC_ROOT(_lv_font_decompr_buf) == NULL) last_buf_size = 0;
-
-        uint32_t gsize = gdsc->box_w * gdsc->box_h;
-        if(gsize == 0) return NULL;
-
-        uint32_t buf_size = gsize;
-        /*Compute memory size needed to hold decompressed glyph, rounding up*/
-        switch(fdsc->bpp) {
-            case 1:
-                buf_size = (gsize + 7) >> 3;
-                break;
-            case 2:
-                buf_size = (gsize + 3) >> 2;
-                break;
-            case 3:
-                buf_size = (gsize + 1) >> 1;
-                break;
-            case 4:
-                buf_size = (gsize + 1) >> 1;
-                break;
-        }
-
-        if(last_buf_size < buf_size) {
-            uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
-            LV_ASSERT_MALLOC(tmp);
-            if(tmp == NULL) return NULL;
-            LV_GC_ROOT(_lv_font_decompr_buf) = tmp;
-            last_buf_size = buf_size;
-        }
-
-        bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
-        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], LV_GC_ROOT(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
-                   (uint8_t)fdsc->bpp, prefilter);
-        return LV_GC_ROOT(_lv_font_decompr_buf);
-#else /*!LV_USE_FONT_COMPRESSED*/
-        LV_LOG_WARN("Compressed fonts is used but LV_USE_FONT_COMPRESSED is not enabled in lv_conf.h");
-        return NULL;
+#if LV_FONT_FMT_TXT_A8_CACHE_SIZE
+    /*Tabs keep the original bpp, see lv_font_get_glyph_dsc_fmt_txt()*/
+    if(!is_tab && a8_cache_used(font)) return a8_cache_get(fdsc, gid);
 #endif
-    }
 
-    /*If not returned earlier then the letter is not found in this font*/
-    return NULL;
+    return get_bitmap_packed(fdsc, &fdsc->glyph_dsc[gid]);
 }
 
 /**
@@ -184,6 +179,11 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     dsc_out->bpp   = (uint8_t)fdsc->bpp;
     dsc_out->is_placeholder = false;
 
+#if LV_FONT_FMT_TXT_A8_CACHE_SIZE
+    /*The bitmap will come from the A8 cache. Not for tabs: their box is twice as wide as the space's bitmap*/
+    if(!is_tab && a8_cache_used(font)) dsc_out->bpp = 8;
+#endif
+
     if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
 
     return true;
@@ -200,18 +200,278 @@ void _lv_font_clean_up_fmt_txt(void)
         LV_GC_ROOT(_lv_font_decompr_buf) = NULL;
     }
 #endif
+
+#if LV_FONT_FMT_TXT_A8_CACHE_SIZE
+    /*The cached glyphs are kept between refreshes*/
+    if(a8_scratch) {
+        lv_mem_free(a8_scratch);
+        a8_scratch = NULL;
+        a8_scratch_size = 0;
+    }
+#endif
 }
 
+#if LV_FONT_FMT_TXT_A8_CACHE_SIZE
+/**
+ * Drop the cached A8 glyphs of a font. Call it before freeing a font.
+ * @param font pointer to a font using `lv_font_fmt_txt_dsc_t`, or NULL to drop every glyph and free the cache
+ */
+void lv_font_fmt_txt_a8_cache_invalidate(const lv_font_t * font)
+{
+    if(a8_cache == NULL) return;
+
+    const lv_font_fmt_txt_dsc_t * fdsc = font ? font->dsc : NULL;
+    uint32_t i;
+    for(i = 0; i < A8_CACHE_SETS * A8_CACHE_WAYS; i++) {
+        if(a8_cache[i].fdsc && (fdsc == NULL || a8_cache[i].fdsc == fdsc)) a8_cache_drop(&a8_cache[i]);
+    }
+
+    if(font == NULL) {
+        lv_mem_free(a8_cache);
+        a8_cache = NULL;
+    }
+}
+
+/**
+ * Get the statistics of the A8 glyph cache.
+ * @param stats store the statistics here
+ * @param reset true: clear the hit and miss counters after reading them
+ */
+void lv_font_fmt_txt_a8_cache_get_stats(lv_font_fmt_txt_a8_cache_stats_t * stats, bool reset)
+{
+    stats->hits = a8_cache_hits;
+    stats->misses = a8_cache_misses;
+    stats->glyphs = a8_cache_glyphs;
+    stats->bytes = a8_cache_bytes;
+
+    if(reset) {
+        a8_cache_hits = 0;
+        a8_cache_misses = 0;
+    }
+}
+#endif /*LV_FONT_FMT_TXT_A8_CACHE_SIZE*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get the bitmap of a glyph in the font's own format (decompressed if needed)
+ */
+static const uint8_t * get_bitmap_packed(const lv_font_fmt_txt_dsc_t * fdsc,
+                                         const lv_font_fmt_txt_glyph_dsc_t * gdsc)
+{
+    if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
+        return &fdsc->glyph_bitmap[gdsc->bitmap_index];
+    }
+    /*Handle compressed bitmap*/
+    else {
+#if LV_USE_FONT_COMPRESSED
+        static size_t last_buf_size = 0;
+        if(LV_GC_ROOT(_lv_font_decompr_buf) == NULL) last_buf_size = 0;
+
+        uint32_t gsize = gdsc->box_w * gdsc->box_h;
+        if(gsize == 0) return NULL;
+
+        uint32_t buf_size = gsize;
+        /*Compute memory size needed to hold decompressed glyph, rounding up*/
+        switch(fdsc->bpp) {
+            case 1:
+                buf_size = (gsize + 7) >> 3;
+                break;
+            case 2:
+                buf_size = (gsize + 3) >> 2;
+                break;
+            case 3:
+                buf_size = (gsize + 1) >> 1;
+                break;
+            case 4:
+                buf_size = (gsize + 1) >> 1;
+                break;
+        }
+
+        if(last_buf_size < buf_size) {
+            uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
+            LV_ASSERT_MALLOC(tmp);
+            if(tmp == NULL) return NULL;
+            LV_GC_ROOT(_lv_font_decompr_buf) = tmp;
+            last_buf_size = buf_size;
+        }
+
+        bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
+        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], LV_GC_ROOT(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
+                   (uint8_t)fdsc->bpp, prefilter);
+        return LV_GC_ROOT(_lv_font_decompr_buf);
+#else /*!LV_USE_FONT_COMPRESSED*/
+        LV_LOG_WARN("Compressed fonts is used but LV_USE_FONT_COMPRESSED is not enabled in lv_conf.h");
+        return NULL;
+#endif
+    }
+}
+
+#if LV_FONT_FMT_TXT_A8_CACHE_SIZE
+/**
+ * Tell whether the bitmaps of a font are served from the A8 cache.
+ * Sub-pixel fonts are drawn by `draw_letter_subpx()` which needs their own bpp.
+ */
+static bool a8_cache_used(const lv_font_t * font)
+{
+    const lv_font_fmt_txt_dsc_t * fdsc = font->dsc;
+    if(font->subpx != LV_FONT_SUBPX_NONE) return false;
+    return fdsc->bpp == 1 || fdsc->bpp == 2 || fdsc->bpp == 4;
+}
+
+/**
+ * Get the bitmap of a glyph expanded to one opacity byte per pixel.
+ * The glyphs are kept in a set associative cache, evicting the least recently used one of the set,
+ * and the least recently used ones of the whole cache to stay in `LV_FONT_FMT_TXT_A8_CACHE_SIZE` bytes.
+ */
+static const uint8_t * a8_cache_get(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid)
+{
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+    uint32_t size = gdsc->box_w * gdsc->box_h;
+    if(size == 0) return NULL;
+
+    if(a8_cache == NULL) {
+        a8_cache = lv_mem_alloc(sizeof(a8_cache_entry_t) * A8_CACHE_SETS * A8_CACHE_WAYS);
+        LV_ASSERT_MALLOC(a8_cache);
+        if(a8_cache) lv_memset_00(a8_cache, sizeof(a8_cache_entry_t) * A8_CACHE_SETS * A8_CACHE_WAYS);
+    }
+
+    a8_cache_life++;
+
+    a8_cache_entry_t * set = NULL;
+    if(a8_cache) {
+        uint32_t hash = ((uint32_t)(lv_uintptr_t)fdsc >> 2) * 31 + gid;
+        set = &a8_cache[(hash % A8_CACHE_SETS) * A8_CACHE_WAYS];
+
+        uint32_t i;
+        for(i = 0; i < A8_CACHE_WAYS; i++) {
+            if(set[i].fdsc == fdsc && set[i].gid == gid) {
+                set[i].life = a8_cache_life;
+                a8_cache_hits++;
+                return set[i].buf;
+            }
+        }
+    }
+
+    a8_cache_misses++;
+
+    const uint8_t * packed = get_bitmap_packed(fdsc, gdsc);
+    if(packed == NULL) return NULL;
+
+    uint8_t * buf = NULL;
+    a8_cache_entry_t * e = NULL;
+    if(set && size <= LV_FONT_FMT_TXT_A8_CACHE_SIZE) {
+        /*Free the unused or least recently used way of the set*/
+        uint32_t i;
+        e = &set[0];
+        for(i = 1; i < A8_CACHE_WAYS && e->fdsc; i++) {
+            if(set[i].fdsc == NULL || set[i].life < e->life) e = &set[i];
+        }
+        if(e->fdsc) a8_cache_drop(e);
+
+        /*Free the least recently used glyphs until the new one fits*/
+        while(a8_cache_bytes + size > LV_FONT_FMT_TXT_A8_CACHE_SIZE) {
+            a8_cache_entry_t * lru = NULL;
+            for(i = 0; i < A8_CACHE_SETS * A8_CACHE_WAYS; i++) {
+                if(a8_cache[i].fdsc && (lru == NULL || a8_cache[i].life < lru->life)) lru = &a8_cache[i];
+            }
+            if(lru == NULL) break;
+            a8_cache_drop(lru);
+        }
+
+        buf = lv_mem_alloc(size);
+        if(buf == NULL) e = NULL;
+    }
+
+    if(buf == NULL) {
+        /*Not cached: expand into the scratch buffer which is valid until the next call*/
+        if(a8_scratch_size < size) {
+            uint8_t * tmp = lv_mem_realloc(a8_scratch, size);
+            LV_ASSERT_MALLOC(tmp);
+            if(tmp == NULL) return NULL;
+            a8_scratch = tmp;
+            a8_scratch_size = size;
+        }
+        buf = a8_scratch;
+    }
+
+    a8_expand(packed, buf, size, (uint8_t)fdsc->bpp);
+
+    if(e) {
+        e->fdsc = fdsc;
+        e->gid = gid;
+        e->buf = buf;
+        e->size = size;
+        e->life = a8_cache_life;
+        a8_cache_bytes += size;
+        a8_cache_glyphs++;
+    }
+
+    return buf;
+}
+
+static void a8_cache_drop(a8_cache_entry_t * e)
+{
+    lv_mem_free(e->buf);
+    a8_cache_bytes -= e->size;
+    a8_cache_glyphs--;
+    lv_memset_00(e, sizeof(a8_cache_entry_t));
+}
+
+/**
+ * Expand `px_num` pixels of a 1, 2 or 4 bpp bitmap to opacity bytes.
+ * The rows are packed without padding so the bitmap can be handled as one long row.
+ * The same opacity tables are used as in `draw_letter_normal()` so the result is identical.
+ */
+static void a8_expand(const uint8_t * in, uint8_t * out, uint32_t px_num, uint8_t bpp)
+{
+    uint32_t i;
+    if(bpp == 4) {
+        for(i = 0; i + 1 < px_num; i += 2) {
+            uint8_t b = *in++;
+            out[i] = _lv_bpp4_opa_table[b >> 4];
+            out[i + 1] = _lv_bpp4_opa_table[b & 0x0F];
+        }
+        if(i < px_num) out[i] = _lv_bpp4_opa_table[*in >> 4];
+        return;
+    }
+
+    const uint8_t * table = bpp == 2 ? _lv_bpp2_opa_table : _lv_bpp1_opa_table;
+    uint8_t px_mask = (1 << bpp) - 1;
+    uint8_t shift = 8;
+    for(i = 0; i < px_num; i++) {
+        shift -= bpp;
+        out[i] = table[(*in >> shift) & px_mask];
+        if(shift == 0) {
+            shift = 8;
+            in++;
+        }
+    }
+}
+#endif /*LV_FONT_FMT_TXT_A8_CACHE_SIZE*/
+
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 {
     if(letter == '\0') return 0;
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
+    /*Fonts with a single continuous range (e.g. only ASCII, 0x20..0x7F): the ID is just an offset,
+     *or one byte of the offset list for fonts with glyphs left out (tools/font_subset.py)*/
+    if(fdsc->cmap_num == 1) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[0];
+        uint32_t rcp = letter - cmap->range_start;
+        if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
+            return rcp > cmap->range_length ? 0 : cmap->glyph_id_start + rcp;
+        }
+        if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
+            const uint8_t * gid_ofs_8 = cmap->glyph_id_ofs_list;
+            return rcp > cmap->range_length ? 0 : cmap->glyph_id_start + gid_ofs_8[rcp];
+        }
+    }
+
     /*Check the cache first*/
     if(fdsc->cache && letter == fdsc->cache->last_letter) return fdsc->cache->last_glyph_id;
 
@@ -197,6 +197,15 @@ typedef struct {
     lv_font_fmt_txt_glyph_cache_t * cache;
 } lv_font_fmt_txt_dsc_t;
 
+#if LV_FONT_FMT_TXT_A8_CACHE_SIZE
+typedef struct {
+    uint32_t hits;      /*Bitmaps served from the A8 cache*/
+    uint32_t misses;    /*Bitmaps expanded to A8*/
+    uint32_t glyphs;    /*Glyphs in the cache*/
+    uint32_t bytes;     /*Bytes used by the cached glyphs*/
+} lv_font_fmt_txt_a8_cache_stats_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -225,6 +234,21 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
  */
 void _lv_font_clean_up_fmt_txt(void);
 
+#if LV_FONT_FMT_TXT_A8_CACHE_SIZE
+/**
+ * Drop the cached A8 glyphs of a font. Call it before freeing a font.
+ * @param font pointer to a font using `lv_font_fmt_txt_dsc_t`, or NULL to drop every glyph and free the cache
+ */
+void lv_font_fmt_txt_a8_cache_invalidate(const lv_font_t * font);
+
+/**
+ * Get the statistics of the A8 glyph cache.
+ * @param stats store the statistics here
+ * @param reset true: clear the hit and miss counters after reading them
+ */
+void lv_font_fmt_txt_a8_cache_get_stats(lv_font_fmt_txt_a8_cache_stats_t * stats, bool reset);
+#endif
+
 /**********************
  *      MACROS
  **********************/
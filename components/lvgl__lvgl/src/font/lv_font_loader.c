@@ -120,6 +120,12 @@ void lv_font_free(lv_font_t * font)
         lv_font_fmt_txt_dsc_t * dsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
         if(NULL != dsc) {
+#if LV_FONT_FMT_TXT_A8_CACHE_SIZE
+            lv_font_fmt_txt_a8_cache_invalidate(font);
+#endif
+#if LV_TXT_LAYOUT_CACHE_NUM
+            lv_txt_layout_cache_invalidate(font);
+#endif
 
             if(dsc->kern_classes == 0) {
                 lv_font_fmt_txt_kern_pair_t * kern_dsc =
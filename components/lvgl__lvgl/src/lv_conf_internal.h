@@ -412,6 +412,26 @@
     #endif
 #endif
 
+/*Mix RGB565 channels of one or two pixels in a 32-bit word in the software blender.
+ *Gives the same result as `lv_color_mix()`. Only used with 16 bit color depth without byte swap.*/
+#ifndef LV_DRAW_SW_SWAR
+    #ifdef CONFIG_LV_DRAW_SW_SWAR
+        #define LV_DRAW_SW_SWAR CONFIG_LV_DRAW_SW_SWAR
+    #else
+        #define LV_DRAW_SW_SWAR 0
+    #endif
+#endif
+
+/*Split refreshed areas around the largest part covered by an opaque object
+ *and don't draw the screen background and the objects under it there.*/
+#ifndef LV_REFR_OCCLUSION
+    #ifdef CONFIG_LV_REFR_OCCLUSION
+        #define LV_REFR_OCCLUSION CONFIG_LV_REFR_OCCLUSION
+    #else
+        #define LV_REFR_OCCLUSION 0
+    #endif
+#endif
+
 /*-------------
  * GPU
  *-----------*/
@@ -1229,6 +1249,16 @@
     #endif
 #endif
 
+/*Cache the glyphs of 1, 2 and 4 bpp fonts expanded to 8 bpp opacity masks.
+ *Size of the cache in bytes, 0: disable*/
+#ifndef LV_FONT_FMT_TXT_A8_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_FMT_TXT_A8_CACHE_SIZE
+        #define LV_FONT_FMT_TXT_A8_CACHE_SIZE CONFIG_LV_FONT_FMT_TXT_A8_CACHE_SIZE
+    #else
+        #define LV_FONT_FMT_TXT_A8_CACHE_SIZE 0
+    #endif
+#endif
+
 /*Enable subpixel rendering*/
 #ifndef LV_USE_FONT_SUBPX
     #ifdef CONFIG_LV_USE_FONT_SUBPX
@@ -1327,6 +1357,15 @@
     #endif
 #endif
 
+/*Number of texts whose line breaks and line widths are cached. 0: disable*/
+#ifndef LV_TXT_LAYOUT_CACHE_NUM
+    #ifdef CONFIG_LV_TXT_LAYOUT_CACHE_NUM
+        #define LV_TXT_LAYOUT_CACHE_NUM CONFIG_LV_TXT_LAYOUT_CACHE_NUM
+    #else
+        #define LV_TXT_LAYOUT_CACHE_NUM 0
+    #endif
+#endif
+
 /*Support bidirectional texts. Allows mixing Left-to-Right and Right-to-Left texts.
  *The direction will be processed according to the Unicode Bidirectional Algorithm:
  *https://www.w3.org/International/articles/inline-bidi-markup/uba-basics*/
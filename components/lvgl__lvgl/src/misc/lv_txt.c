@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include <stdarg.h>
+#include <string.h>
 #include "lv_txt.h"
 #include "lv_txt_ap.h"
 #include "lv_math.h"
@@ -19,9 +20,26 @@
  *********************/
 #define NO_BREAK_FOUND UINT32_MAX
 
+#if LV_TXT_LAYOUT_CACHE_NUM
+    #define LAYOUT_MAX_LEN  1024    /*Longer texts are not cached, labels use the hint for them*/
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_TXT_LAYOUT_CACHE_NUM
+typedef struct {
+    _lv_txt_layout_t layout;
+    const char * txt;               /*Copy of the text, stored before the lines. NULL: unused entry*/
+    const lv_font_t * font;
+    uint32_t len;
+    uint32_t hash;
+    uint32_t life;                  /*Time of the last use, the smallest is reused first*/
+    lv_coord_t letter_space;
+    lv_coord_t max_width;
+    lv_text_flag_t flag;
+} txt_layout_entry_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -46,9 +64,19 @@
     static uint32_t lv_txt_iso8859_1_get_char_id(const char * txt, uint32_t byte_id);
     static uint32_t lv_txt_iso8859_1_get_length(const char * txt);
 #endif
+#if LV_TXT_LAYOUT_CACHE_NUM
+    static bool layout_build(txt_layout_entry_t * e, const char * txt, bool ascii);
+    static lv_coord_t txt_get_width_ascii(const char * txt, uint32_t length, const lv_font_t * font,
+                                          lv_coord_t letter_space, lv_text_flag_t flag);
+#endif
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_TXT_LAYOUT_CACHE_NUM
+    static txt_layout_entry_t layout_cache[LV_TXT_LAYOUT_CACHE_NUM];
+    static uint32_t layout_life;
+    static lv_txt_layout_cache_stats_t layout_stats;
+#endif
 
 /**********************
  *  GLOBAL VARIABLES
@@ -103,9 +131,18 @@ void lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t *
     uint32_t new_line_start = 0;
     uint16_t letter_height = lv_font_get_line_height(font);
 
+#if LV_TXT_LAYOUT_CACHE_NUM
+    const _lv_txt_layout_t * layout = _lv_txt_get_layout(text, font, letter_space, max_width, flag);
+    uint32_t line_i = 0;
+#endif
+
     /*Calc. the height and longest line*/
     while(text[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&text[line_start], font, letter_space, max_width, NULL, flag);
+#if LV_TXT_LAYOUT_CACHE_NUM
+        if(layout) new_line_start = layout->lines[line_i + 1].start;
+        else
+#endif
+            new_line_start += _lv_txt_get_next_line(&text[line_start], font, letter_space, max_width, NULL, flag);
 
         if((unsigned long)size_res->y + (unsigned long)letter_height + (unsigned long)line_space > LV_MAX_OF(lv_coord_t)) {
             LV_LOG_WARN("lv_txt_get_size: integer overflow while calculating text height");
@@ -117,8 +154,12 @@ void lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t *
         }
 
         /*Calculate the longest line*/
-        lv_coord_t act_line_length = lv_txt_get_width(&text[line_start], new_line_start - line_start, font, letter_space,
-                                                      flag);
+        lv_coord_t act_line_length;
+#if LV_TXT_LAYOUT_CACHE_NUM
+        if(layout) act_line_length = layout->lines[line_i++].width;
+        else
+#endif
+            act_line_length = lv_txt_get_width(&text[line_start], new_line_start - line_start, font, letter_space, flag);
 
         size_res->x = LV_MAX(act_line_length, size_res->x);
         line_start  = new_line_start;
@@ -379,6 +420,81 @@ lv_coord_t lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t *
     return width;
 }
 
+#if LV_TXT_LAYOUT_CACHE_NUM
+const _lv_txt_layout_t * _lv_txt_get_layout(const char * txt, const lv_font_t * font, lv_coord_t letter_space,
+                                            lv_coord_t max_width, lv_text_flag_t flag)
+{
+    if(txt == NULL || font == NULL || txt[0] == '\0') return NULL;
+
+    /*Without wrapping the max. width is not used*/
+    if((flag & LV_TEXT_FLAG_EXPAND) || (flag & LV_TEXT_FLAG_FIT)) max_width = LV_COORD_MAX;
+
+    /*FNV-1a hash of the text. Look for non-ASCII characters too.*/
+    uint32_t hash = 2166136261u;
+    uint8_t or_bytes = 0;
+    uint32_t len;
+    for(len = 0; txt[len] != '\0'; len++) {
+        if(len == LAYOUT_MAX_LEN) return NULL;
+        hash = (hash ^ (uint8_t)txt[len]) * 16777619u;
+        or_bytes |= (uint8_t)txt[len];
+    }
+
+    layout_life++;
+
+    txt_layout_entry_t * e = &layout_cache[0];
+    uint32_t i;
+    for(i = 0; i < LV_TXT_LAYOUT_CACHE_NUM; i++) {
+        txt_layout_entry_t * c = &layout_cache[i];
+        if(c->txt && c->hash == hash && c->len == len && c->font == font && c->letter_space == letter_space &&
+           c->max_width == max_width && c->flag == flag && memcmp(c->txt, txt, len) == 0) {
+            c->life = layout_life;
+            layout_stats.hits++;
+            layout_stats.hit_bytes += len;
+            return &c->layout;
+        }
+
+        /*Remember the unused or least recently used entry*/
+        if(e->txt && (c->txt == NULL || c->life < e->life)) e = c;
+    }
+
+    layout_stats.misses++;
+
+    if(e->txt) {
+        lv_mem_free((void *)e->txt);
+        e->txt = NULL;
+    }
+
+    e->font = font;
+    e->len = len;
+    e->hash = hash;
+    e->letter_space = letter_space;
+    e->max_width = max_width;
+    e->flag = flag;
+    e->life = layout_life;
+    if(!layout_build(e, txt, LV_TXT_ENC == LV_TXT_ENC_UTF8 && LV_IS_ASCII(or_bytes))) return NULL;
+
+    return &e->layout;
+}
+
+void lv_txt_layout_cache_invalidate(const lv_font_t * font)
+{
+    uint32_t i;
+    for(i = 0; i < LV_TXT_LAYOUT_CACHE_NUM; i++) {
+        txt_layout_entry_t * e = &layout_cache[i];
+        if(e->txt && (font == NULL || e->font == font)) {
+            lv_mem_free((void *)e->txt);
+            e->txt = NULL;
+        }
+    }
+}
+
+void lv_txt_layout_cache_get_stats(lv_txt_layout_cache_stats_t * stats, bool reset)
+{
+    *stats = layout_stats;
+    if(reset) lv_memset_00(&layout_stats, sizeof(layout_stats));
+}
+#endif /*LV_TXT_LAYOUT_CACHE_NUM*/
+
 bool _lv_txt_is_cmd(lv_text_cmd_state_t * state, uint32_t c)
 {
     bool ret = false;
@@ -496,6 +612,80 @@ void _lv_txt_encoded_letter_next_2(const char * txt, uint32_t * letter, uint32_t
     *letter_next = *letter != '\0' ? _lv_txt_encoded_next(&txt[*ofs], NULL) : 0;
 }
 
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_TXT_LAYOUT_CACHE_NUM
+/**
+ * Break `txt` into lines and store them in `e` together with a copy of the text.
+ * @param ascii true: the text has only ASCII characters, measure it without decoding
+ * @return false: out of memory
+ */
+static bool layout_build(txt_layout_entry_t * e, const char * txt, bool ascii)
+{
+    /*Every line has at least one character. Allocate for the worst case and shrink later.
+     *The text is stored first so shrinking keeps it.*/
+    uint32_t txt_size = (e->len + 1 + 3) & ~3U;
+    uint8_t * buf = lv_mem_alloc(txt_size + (e->len + 1) * sizeof(_lv_txt_line_t));
+    LV_ASSERT_MALLOC(buf);
+    if(buf == NULL) return false;
+
+    lv_memcpy(buf, txt, e->len + 1);
+    _lv_txt_line_t * lines = (_lv_txt_line_t *)(buf + txt_size);
+
+    uint32_t n = 0;
+    uint32_t start = 0;
+    while(txt[start] != '\0') {
+        uint32_t end = start + _lv_txt_get_next_line(&txt[start], e->font, e->letter_space, e->max_width, NULL, e->flag);
+        lines[n].start = start;
+        if(ascii) lines[n].width = txt_get_width_ascii(&txt[start], end - start, e->font, e->letter_space, e->flag);
+        else lines[n].width = lv_txt_get_width(&txt[start], end - start, e->font, e->letter_space, e->flag);
+        n++;
+        start = end;
+    }
+    lines[n].start = start;
+    lines[n].width = 0;
+
+    uint8_t * tmp = lv_mem_realloc(buf, txt_size + (n + 1) * sizeof(_lv_txt_line_t));
+    if(tmp) buf = tmp;
+
+    e->txt = (const char *)buf;
+    e->layout.lines = (const _lv_txt_line_t *)(buf + txt_size);
+    e->layout.line_cnt = n;
+    return true;
+}
+
+/**
+ * `lv_txt_get_width()` of an ASCII only text: the characters are the bytes, no need to decode them.
+ */
+static lv_coord_t txt_get_width_ascii(const char * txt, uint32_t length, const lv_font_t * font,
+                                      lv_coord_t letter_space, lv_text_flag_t flag)
+{
+    lv_coord_t width = 0;
+    lv_text_cmd_state_t cmd_state = LV_TEXT_CMD_STATE_WAIT;
+    uint32_t i;
+    for(i = 0; i < length; i++) {
+        uint32_t letter = (uint8_t)txt[i];
+        if((flag & LV_TEXT_FLAG_RECOLOR) != 0) {
+            if(_lv_txt_is_cmd(&cmd_state, letter) != false) {
+                continue;
+            }
+        }
+
+        lv_coord_t char_width = lv_font_get_glyph_width(font, letter, (uint8_t)txt[i + 1]);
+        if(char_width > 0) {
+            width += char_width;
+            width += letter_space;
+        }
+    }
+
+    if(width > 0) width -= letter_space;
+
+    return width;
+}
+#endif /*LV_TXT_LAYOUT_CACHE_NUM*/
+
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
 /*******************************
  *   UTF-8 ENCODER/DECODER
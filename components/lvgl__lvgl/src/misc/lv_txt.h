@@ -65,6 +65,26 @@ enum {
 };
 typedef uint8_t lv_text_align_t;
 
+/** A line of a text broken by `_lv_txt_get_next_line()`*/
+typedef struct {
+    uint32_t start;     /**< Byte index of the first character of the line*/
+    lv_coord_t width;   /**< Width of the line as `lv_txt_get_width()` measures it*/
+} _lv_txt_line_t;
+
+/** The lines of a text with a given font, letter space, max. width and flags*/
+typedef struct {
+    const _lv_txt_line_t * lines;   /**< `line_cnt + 1` lines. The `start` of the last one is the length of the text*/
+    uint32_t line_cnt;
+} _lv_txt_layout_t;
+
+#if LV_TXT_LAYOUT_CACHE_NUM
+typedef struct {
+    uint32_t hits;      /**< Layouts found in the cache*/
+    uint32_t misses;    /**< Layouts calculated*/
+    uint32_t hit_bytes; /**< Bytes of text which didn't need to be broken into lines and measured again*/
+} lv_txt_layout_cache_stats_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -112,6 +132,37 @@ uint32_t _lv_txt_get_next_line(const char * txt, const lv_font_t * font, lv_coor
 lv_coord_t lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t * font, lv_coord_t letter_space,
                             lv_text_flag_t flag);
 
+#if LV_TXT_LAYOUT_CACHE_NUM
+/**
+ * Break a text into lines and measure them like `_lv_txt_get_next_line()` and `lv_txt_get_width()` would.
+ * The result is cached by the content of the text and the other parameters,
+ * so the same text is broken and measured only once.
+ * @param txt a '\0' terminated string
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param max_width max width of the text (break the lines to fit this size). Set COORD_MAX to avoid
+ * line breaks
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return the layout, valid until the next call, or NULL if the text is too long to cache
+ *         or there is not enough memory. Use `_lv_txt_get_next_line()` in this case.
+ */
+const _lv_txt_layout_t * _lv_txt_get_layout(const char * txt, const lv_font_t * font, lv_coord_t letter_space,
+                                            lv_coord_t max_width, lv_text_flag_t flag);
+
+/**
+ * Drop the cached layouts of a font. Call it before freeing a font.
+ * @param font pointer to a font, or NULL to drop every layout
+ */
+void lv_txt_layout_cache_invalidate(const lv_font_t * font);
+
+/**
+ * Get the statistics of the text layout cache.
+ * @param stats store the statistics here
+ * @param reset true: clear the counters after reading them
+ */
+void lv_txt_layout_cache_get_stats(lv_txt_layout_cache_stats_t * stats, bool reset);
+#endif
+
 /**
  * Check next character in a string and decide if the character is part of the command or not
  * @param state pointer to a txt_cmd_state_t variable which stores the current state of command
@@ -545,12 +545,20 @@ static void draw_img(lv_event_t * e)
             return;
         }
 
-        const lv_area_t * clip_area = lv_event_get_param(e);
+        const lv_area_t * clip_area = info->area;
         if(img->zoom == LV_IMG_ZOOM_NONE) {
             if(_lv_area_is_in(clip_area, &obj->coords, 0) == false) {
                 info->res = LV_COVER_RES_NOT_COVER;
                 return;
             }
+
+            /*The image is tiled over the content area, so it covers it even without a background*/
+            lv_area_t content;
+            lv_obj_get_content_coords(obj, &content);
+            if(_lv_area_is_in(clip_area, &content, 0) && lv_obj_get_style_opa(obj, LV_PART_MAIN) >= LV_OPA_MAX &&
+               lv_obj_get_style_blend_mode(obj, LV_PART_MAIN) == LV_BLEND_MODE_NORMAL) {
+                info->res = LV_COVER_RES_COVER;
+            }
         }
         else {
             lv_area_t a;
@@ -26,11 +26,13 @@ extern "C" {
 #include "ui_events.h"
 
 #include "ui_img_manager.h"
+#include "ui_catalog.h"
 
 ///////////////////// SCREENS ////////////////////
 
 #include "ui_Screen1.h"
 #include "ui_Screen2.h"
+#include "ui_Screen3.h"
 
 ///////////////////// VARIABLES ////////////////////
 
@@ -40,28 +42,7 @@ extern "C" {
 extern lv_obj_t * ui____initial_actions0;
 
 // IMAGES AND IMAGE SETS
-extern lv_img_dsc_t ui_img_01_png;   
-void ui_img_01_png_load();
-extern lv_img_dsc_t ui_img_02_png;   
-void ui_img_02_png_load();
-extern lv_img_dsc_t ui_img_03_png;   
-void ui_img_03_png_load();
-extern lv_img_dsc_t ui_img_04_png;   
-void ui_img_04_png_load();
-extern lv_img_dsc_t ui_img_05_png;   
-void ui_img_05_png_load();
-extern lv_img_dsc_t ui_img_06_png;   
-void ui_img_06_png_load();
-extern lv_img_dsc_t ui_img_07_png;   
-void ui_img_07_png_load();
-extern lv_img_dsc_t ui_img_08_png;   
-void ui_img_08_png_load();
-extern lv_img_dsc_t ui_img_09_png;   
-void ui_img_09_png_load();
-extern lv_img_dsc_t ui_img_10_png;   
-void ui_img_10_png_load();
-
-
+// Per-case images come from the content catalog (ui_catalog.h).
 extern lv_img_dsc_t ui_img_1049104300;   
 void ui_img_1049104300_load();
 
@@ -0,0 +1,22 @@
+#ifndef UI_SCREEN3_H
+#define UI_SCREEN3_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// SCREEN: ui_Screen3
+extern void ui_Screen3_screen_init(void);
+extern void ui_Screen3_screen_destroy(void);
+extern lv_obj_t * ui_Screen3;
+extern void ui_event_btnback(lv_event_t * e);
+extern lv_obj_t * ui_btnback;
+extern lv_obj_t * ui_Label5;
+extern lv_obj_t * ui_galleryGrid;
+// CUSTOM VARIABLES
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif
@@ -0,0 +1,77 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Animated asset (produced by `tools/asset_packer.py anim`), little-endian:
+ *   ui_anim_header_t
+ *   ui_anim_frame_t[frame_count]     at header.index_off
+ *   frame data                       at ui_anim_frame_t::offset
+ *
+ * A key frame is a full RGB565 frame (w * h * 2 bytes). A delta frame is
+ *   uint16_t rect_count; { ui_anim_rect_t rect; lv_color_t px[rect.w * rect.h]; } [rect_count]
+ * holding only the pixels that changed since the previous frame.
+ * Frame 0 is always a key frame.
+ */
+
+#define UI_ANIM_MAGIC   0x4E414955u /* "UIAN" */
+#define UI_ANIM_VERSION 1
+
+#define UI_ANIM_FRAME_KEY   0
+#define UI_ANIM_FRAME_DELTA 1
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t frame_count;
+    uint16_t w;
+    uint16_t h;
+    uint32_t index_off;
+    uint32_t max_delta_size; /* largest delta frame, sizes the read buffer */
+    uint32_t reserved;
+} ui_anim_header_t;
+
+typedef struct {
+    uint32_t offset;
+    uint32_t size;
+    uint16_t delay_ms; /* time this frame stays on screen */
+    uint8_t type;      /* UI_ANIM_FRAME_* */
+    uint8_t reserved;
+} ui_anim_frame_t;
+
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+    uint16_t w;
+    uint16_t h;
+} ui_anim_rect_t;
+
+typedef struct {
+    uint32_t frames;      /* frames applied */
+    uint32_t key_frames;
+    uint32_t rects;
+    uint32_t px_updated;
+    uint32_t apply_us;    /* reading + patching the frame buffer */
+    uint32_t draw_us;     /* LVGL drawing the image widget */
+    uint32_t elapsed_us;  /* since playback started */
+} ui_anim_stats_t;
+
+typedef struct ui_anim_player ui_anim_player_t;
+
+/* Play "S:..." on `img` (an lv_img) in a loop and store the player in `*handle`
+ * (NULL on failure). The player owns the frame buffer and the image source; close
+ * it before setting another source on `img`. If `img` is deleted first, the player
+ * stops, frees itself and sets `*handle` to NULL, so `*handle` must outlive it. */
+bool ui_anim_player_open(ui_anim_player_t** handle, lv_obj_t* img, const char* path_S);
+void ui_anim_player_close(ui_anim_player_t* p);
+
+void ui_anim_player_get_stats(const ui_anim_player_t* p, ui_anim_stats_t* out);
+
+#ifdef __cplusplus
+}
+#endif
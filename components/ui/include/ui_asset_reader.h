@@ -0,0 +1,50 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Bulk asset reader.
+ *
+ * Reads a whole file with block-sized read() calls into two internal-SRAM
+ * bounce buffers and copies them into the destination (usually PSRAM).
+ * With UI_ASSET_READ_DOUBLE_BUFFER a reader task on the other core fills one
+ * buffer while the caller copies the other, so flash reads and PSRAM writes
+ * overlap. Thread-safe once ui_asset_reader_init() has returned; callers are
+ * serialized.
+ */
+
+typedef struct {
+    uint32_t files;
+    uint32_t bytes;
+    uint32_t wall_us; /* total time in ui_asset_read_file() */
+    uint32_t read_wall_us; /* wall time in read(), including blocking in the VFS and flash driver */
+    uint32_t copy_us;      /* time spent copying bounce buffers to the destination */
+} ui_asset_read_stats_t;
+
+/* Creates the lock. Called from ui_init(), before any loader task starts. */
+bool ui_asset_reader_init(void);
+
+/* Read exactly `size` bytes of `real_path` (VFS path) into `dst`. */
+bool ui_asset_read_file(const char* real_path, void* dst, uint32_t size);
+
+/* Polled before each block is copied; true stops the read. */
+typedef bool (*ui_asset_read_cancel_t)(void* arg);
+
+/*
+ * ui_asset_read_file() for a load that may be abandoned: once cancelled(arg)
+ * returns true, no more blocks are read and the reader is released for the
+ * next caller within one block. False if cancelled.
+ */
+bool ui_asset_read_file_cancellable(const char* real_path, void* dst, uint32_t size, ui_asset_read_cancel_t cancelled,
+                                    void* arg);
+
+void ui_asset_read_get_stats(ui_asset_read_stats_t* out);
+void ui_asset_read_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,98 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Runtime content catalog (produced by tools/asset_packer.py).
+ *
+ * Layout of the manifest, little-endian:
+ *   ui_catalog_header_t
+ *   ui_catalog_record_t[count]      at header.index_off, header.record_size apart
+ *   string table                    at header.strings_off: { uint16_t len; char text[len]; '\0' }
+ *
+ * Nothing but the header is kept in RAM: a lookup is one fseek + fread of a
+ * fixed-size record, strings are read only when asked for.
+ */
+
+#define UI_CATALOG_MAGIC   0x54434955u /* "UICT" */
+#define UI_CATALOG_VERSION 1
+
+/* ui_catalog_record_t::flags */
+#define UI_CATALOG_FLAG_JPEG 0x01 /* image is (split) JPEG, decoded to RGB565; img_size is the file size */
+#define UI_CATALOG_FLAG_ANIM 0x02 /* image is an animation (ui_anim.h), played in a loop */
+#define UI_CATALOG_FLAG_MIPS 0x04 /* RGB565 copies at 1/2 .. 1/(1 << UI_CATALOG_MIP_LEVELS) scale exist */
+
+#define UI_CATALOG_MIP_LEVELS 3
+
+#define UI_CATALOG_FILE     "S:assets/catalog.bin"
+#define UI_CATALOG_PATH_MAX 64
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t count;
+    uint32_t index_off;
+    uint32_t strings_off;
+    uint32_t strings_size;
+    uint32_t reserved[2];
+} ui_catalog_header_t;
+
+typedef enum {
+    UI_CATALOG_IMAGE = 0, /* image path, relative to the S: drive */
+    UI_CATALOG_QUESTION,
+    UI_CATALOG_OPTION_A,
+    UI_CATALOG_OPTION_B,
+    UI_CATALOG_OPTION_C,
+    UI_CATALOG_TTS,
+    UI_CATALOG_STR_COUNT
+} ui_catalog_str_t;
+
+typedef struct {
+    uint32_t str_off[UI_CATALOG_STR_COUNT];
+    uint32_t img_size;
+    uint16_t img_w;
+    uint16_t img_h;
+    uint8_t img_cf; /* lv_img_cf_t */
+    uint8_t flags;
+    uint16_t reserved;
+} ui_catalog_record_t;
+
+typedef struct {
+    uint32_t id;
+    char img_path[UI_CATALOG_PATH_MAX]; /* "S:assets/..." */
+    uint32_t img_size;
+    uint16_t img_w;
+    uint16_t img_h;
+    uint8_t img_cf;
+    uint8_t flags;
+} ui_catalog_item_t;
+
+/* Open the manifest, e.g. "S:assets/catalog.bin". */
+bool ui_catalog_open(const char* path_S);
+void ui_catalog_close(void);
+
+uint32_t ui_catalog_count(void);
+
+/* O(1): reads one index record. */
+bool ui_catalog_get(uint32_t id, ui_catalog_item_t* out);
+
+/* Reads one string of item `id` into `buf` (always NUL-terminated, truncated if needed). */
+bool ui_catalog_read_str(uint32_t id, ui_catalog_str_t which, char* buf, size_t size);
+
+/*
+ * Path of the mip level `shift` (1 .. UI_CATALOG_MIP_LEVELS) of `item`:
+ * "S:assets/x.bin" -> "S:assets/x.mip4.bin" for shift 2. The level is a
+ * LV_IMG_CF_TRUE_COLOR frame of (img_w >> shift) x (img_h >> shift).
+ * False if the item has no mips or the path does not fit.
+ */
+bool ui_catalog_mip_path(const ui_catalog_item_t* item, uint8_t shift, char* buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -9,6 +9,9 @@ extern "C" {
 void on_btn_change_pressed(lv_event_t * e);
 void on_btn_say_pressed(lv_event_t * e);
 void on_btn_answer_pressed(lv_event_t * e);
+void on_btn_change_long_pressed(lv_event_t * e);
+void on_btn_back_pressed(lv_event_t * e);
+void on_gallery_item_pressed(lv_event_t * e);
 void ui_notify_tts_finished(void);
 
 void ui_show_question_current_case(void);
@@ -0,0 +1,33 @@
+#pragma once
+#include <stdint.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Thumbnail gallery of every catalog item (ui_Screen3).
+ *
+ * Each tile shows the largest mip level of its image that fits in
+ * UI_GALLERY_TILE_W x UI_GALLERY_TILE_H, drawn 1:1 (no runtime scaling).
+ * Only about two screens of tiles exist; they are re-bound to other items as
+ * the grid scrolls, so the object count does not grow with the catalog either.
+ * Thumbnails are loaded lazily for the tiles on screen and kept in a fixed
+ * pool of UI_GALLERY_CACHE_NUM PSRAM slots; the least recently visible one is
+ * reused, so memory does not grow with the number of items.
+ * Must be called from the LVGL task.
+ */
+
+/* Lay out the tiles, allocate the pool and show the gallery scrolled to `current`. */
+void ui_gallery_open(uint32_t current);
+
+/* Drop all thumbnails and free the pool. The tiles are kept for the next open. */
+void ui_gallery_close(void);
+
+/* Catalog id shown by a gallery tile (the target of its click event). */
+uint32_t ui_gallery_item_of(const lv_obj_t* tile);
+
+#ifdef __cplusplus
+}
+#endif
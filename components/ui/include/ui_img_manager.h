@@ -1,13 +1,48 @@
 #pragma once
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
+#include "sdkconfig.h"
+#include "ui_img_stream.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* "S:assets/x.bin" -> ASSET_FS_BASE_PATH "/assets/x.bin"; other paths are copied as is. */
+void ui_img_map_path(char* dst, size_t dst_sz, const char* src);
+
 uint8_t* _ui_load_binary_direct(const char* fname_S, uint32_t size);
+uint8_t* _ui_load_binary_stream(const char* fname_S, uint32_t size);
+
+/*
+ * Background load of a whole asset into PSRAM, for progressive display.
+ * A loader task on the other core reads the file; the LVGL task polls the
+ * job and never blocks on flash. A cancelled job stops reading within one
+ * asset reader block.
+ */
+typedef struct ui_img_job ui_img_job_t;
+
+/* `first` queues the job ahead of those already waiting (a preview ahead of full images). */
+ui_img_job_t* ui_img_load_async(const char* fname_S, uint32_t size, bool first);
 
-#define UI_LOAD_IMAGE _ui_load_binary_direct
+/*
+ * True once the job has finished; the job is then freed and *data is the
+ * buffer (owned by the caller, heap_caps_free) or NULL on failure.
+ */
+bool ui_img_job_poll(ui_img_job_t* job, uint8_t** data);
+
+/* Give up on an unfinished or finished job; its buffer is freed. NULL is ignored. */
+void ui_img_job_cancel(ui_img_job_t* job);
+
+/* Set header.reserved of a descriptor to UI_LOAD_IMAGE_RESERVED along with data = UI_LOAD_IMAGE(...) */
+#if CONFIG_UI_IMG_STREAM
+#define UI_LOAD_IMAGE          _ui_load_binary_stream
+#define UI_LOAD_IMAGE_RESERVED UI_IMG_STREAM_RESERVED
+#else
+#define UI_LOAD_IMAGE          _ui_load_binary_direct
+#define UI_LOAD_IMAGE_RESERVED 0
+#endif
 
 #ifdef __cplusplus
 }
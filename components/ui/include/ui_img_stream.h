@@ -0,0 +1,51 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UI_IMG_STREAM_MAGIC 0x4D525453u /* "STRM" */
+
+/*
+ * lv_img_header_t::reserved of a descriptor whose data is a tag. The decoder
+ * reads the tag only behind this mark, so the pixels of other images, which
+ * may be smaller than a tag, are never read as one.
+ */
+#define UI_IMG_STREAM_RESERVED 0x2
+
+/* Stored in lv_img_dsc_t::data instead of the pixels when streaming is enabled. */
+typedef struct {
+    uint32_t magic;
+    uint32_t id;   /* unique per tag, so a recycled pointer never hits stale cache blocks */
+    uint32_t check; /* magic ^ id, guards against pixel data that happens to start with the magic */
+    uint32_t size; /* file size in bytes */
+    char path[];   /* real VFS path, e.g. "/assets/assets/ui_img_01_png.bin" */
+} ui_img_stream_tag_t;
+
+typedef struct {
+    uint32_t opens;
+    uint32_t lines;
+    uint32_t block_hits;
+    uint32_t block_misses;
+    uint32_t bytes_read;
+    uint32_t read_us;    /* time spent in fread() */
+    uint32_t cache_bytes; /* RAM held by the block cache */
+} ui_img_stream_stats_t;
+
+/* Register the streaming decoder. Must be called after lv_init(). */
+void ui_img_stream_init(void);
+
+/* Allocate a tag for `real_path` (caller frees it with heap_caps_free). */
+ui_img_stream_tag_t* ui_img_stream_tag_create(const char* real_path, uint32_t size);
+
+/* `data` must be at least a tag's size: only call it for descriptors marked UI_IMG_STREAM_RESERVED. */
+bool ui_img_stream_is_tag(const void* data);
+
+void ui_img_stream_get_stats(ui_img_stream_stats_t* out);
+void ui_img_stream_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,39 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * JPEG assets decoded straight into an RGB565 PSRAM buffer.
+ *
+ * Accepts plain baseline JPEG and LVGL's split-JPEG container (.sjpg, see
+ * extra/libs/sjpg/lv_sjpg.c), which tools/asset_packer.py produces. The
+ * strips of an .sjpg are independent JPEG streams, so they are handed out to
+ * one worker per core; a plain JPEG is decoded by the caller alone.
+ */
+
+typedef struct {
+    uint32_t images;
+    uint32_t strips;
+    uint32_t decode_us;   /* wall time in ui_jpeg_decode() */
+    uint32_t read_us;     /* wall time reading compressed files */
+    uint32_t in_bytes;    /* compressed bytes */
+    uint32_t out_bytes;   /* RGB565 bytes produced */
+} ui_jpeg_stats_t;
+
+/* Decode `data` into `dst` (w * h lv_color_t). `workers` is clamped to 1..2. */
+bool ui_jpeg_decode(const uint8_t* data, uint32_t size, uint16_t w, uint16_t h, lv_color_t* dst, int workers);
+
+/* Read "S:..." and decode it into a new PSRAM buffer (free with heap_caps_free). */
+uint8_t* ui_jpeg_load(const char* path_S, uint32_t file_size, uint16_t w, uint16_t h);
+
+void ui_jpeg_get_stats(ui_jpeg_stats_t* out);
+void ui_jpeg_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
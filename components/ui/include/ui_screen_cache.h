@@ -0,0 +1,65 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Snapshot cache of whole screens (CONFIG_UI_SCREEN_CACHE).
+ *
+ * Every registered screen keeps a PSRAM snapshot (lv_snapshot) of how it
+ * looks. Switching to a screen whose snapshot is up to date puts the snapshot
+ * on top of it as an opaque "cover" image, so the first frame is a single
+ * image blit instead of the object tree. Once that frame is out, the cover is
+ * hidden without redrawing anything: the objects below look the same. Slide
+ * and fade transitions move the two snapshots on a stage screen instead of
+ * redrawing both trees every frame.
+ *
+ * A snapshot goes stale when its screen is redrawn while shown, or when
+ * ui_screen_cache_invalidate() is called. LVGL does not see changes made to a
+ * screen that is not shown, so code doing that must call it. Stale snapshots
+ * of hidden screens are taken again when the UI has been idle for
+ * UI_SCREEN_CACHE_IDLE_MS, right after the screen's prepare callback, which can
+ * set the content the screen will be shown with next.
+ *
+ * Without CONFIG_UI_SCREEN_CACHE, ui_screen_cache_load() is lv_scr_load_anim()
+ * and the other functions do nothing. Must be called from the LVGL task.
+ */
+
+typedef struct {
+    uint32_t hits;              /* Switches drawn from a snapshot */
+    uint32_t misses;            /* Switches to a cached screen with a stale snapshot */
+    uint32_t snapshots;         /* Snapshots taken */
+    uint32_t snapshot_us;       /* Time spent taking them */
+    uint32_t transitions;       /* Animated transitions played with snapshots */
+    uint32_t transition_frames; /* Frames drawn during those transitions */
+    uint32_t transition_us;     /* Time from the start to the end of those transitions */
+} ui_screen_cache_stats_t;
+
+/* Called on idle for a hidden screen, before its snapshot is refreshed. */
+typedef void (*ui_screen_cache_prepare_cb_t)(lv_obj_t* scr);
+
+/*
+ * Cache `scr` (an opaque, full-screen screen object). Allocates its snapshot
+ * buffer in PSRAM; it is freed with the screen. `prepare` may be NULL.
+ * Returns false if the cache is disabled or out of memory.
+ */
+bool ui_screen_cache_add(lv_obj_t* scr, ui_screen_cache_prepare_cb_t prepare);
+
+/* The content of `scr` changed: don't switch to it from its snapshot until it is taken again. */
+void ui_screen_cache_invalidate(lv_obj_t* scr);
+
+/* `scr` changes on its own (e.g. an animation): don't snapshot it while `live`. */
+void ui_screen_cache_set_live(lv_obj_t* scr, bool live);
+
+/* Show `scr` like lv_scr_load_anim(..., false), from the snapshots when possible. */
+void ui_screen_cache_load(lv_obj_t* scr, lv_scr_load_anim_t anim, uint32_t time, uint32_t delay);
+
+void ui_screen_cache_get_stats(ui_screen_cache_stats_t* out, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
@@ -6,6 +6,9 @@
 #include "ui.h"
 #include "ui_helpers.h"
 #include "ui_events.h"
+#include "ui_img_stream.h"
+#include "ui_gallery.h"
+#include "ui_asset_reader.h"
 
 ///////////////////// VARIABLES ////////////////////
 
@@ -35,8 +38,18 @@ void ui_init(void)
                                                true, LV_FONT_DEFAULT);
     lv_disp_set_theme(dispp, theme);
 
+    ui_asset_reader_init();
+
+#if CONFIG_UI_IMG_STREAM
+    ui_img_stream_init();
+#endif
+
     ui_img_1049104300_load();
 
+    if (!ui_catalog_open(UI_CATALOG_FILE)) {
+        LV_LOG_ERROR("content catalog %s is missing", UI_CATALOG_FILE);
+    }
+
     ui_Screen1_screen_init();
     ui_Screen2_screen_init();
   
@@ -49,6 +62,8 @@ void ui_destroy(void)
 {
     ui_Screen1_screen_destroy();
     ui_Screen2_screen_destroy();
+    ui_gallery_close();
+    ui_Screen3_screen_destroy();
 }
 
 
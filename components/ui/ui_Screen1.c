@@ -27,9 +27,12 @@ void ui_event_btnchg(lv_event_t * e)
 {
     lv_event_code_t event_code = lv_event_get_code(e);
 
-    if(event_code == LV_EVENT_CLICKED) {
+    if(event_code == LV_EVENT_SHORT_CLICKED) {
         on_btn_change_pressed(e);
     }
+    if(event_code == LV_EVENT_LONG_PRESSED) {
+        on_btn_change_long_pressed(e);
+    }
 }
 
 // build funtions
@@ -0,0 +1,253 @@
+#include "ui_anim.h"
+#include "ui_img_manager.h"
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "UIANIM";
+
+#define ANIM_STATS_PERIOD_US (5 * 1000 * 1000)
+
+_Static_assert(sizeof(ui_anim_header_t) == 24, "anim header layout");
+_Static_assert(sizeof(ui_anim_frame_t) == 12, "anim frame layout");
+_Static_assert(sizeof(ui_anim_rect_t) == 8, "anim rect layout");
+
+struct ui_anim_player {
+    lv_obj_t *img;
+    ui_anim_player_t **handle; /* cleared when the player is freed */
+    FILE *fp;
+    ui_anim_header_t hdr;
+    ui_anim_frame_t *index;
+    uint16_t cur;
+    lv_img_dsc_t dsc;     /* points at `frame` */
+    lv_color_t *frame;    /* persistent PSRAM frame, patched in place */
+    uint8_t *delta;       /* one delta frame */
+    lv_timer_t *timer;
+    int64_t t_start;
+    int64_t t_draw;
+    int64_t t_log;
+    ui_anim_stats_t stats;
+};
+
+static bool read_at(FILE *fp, uint32_t off, void *dst, size_t len)
+{
+    if (fseek(fp, (long)off, SEEK_SET) != 0) return false;
+    return fread(dst, 1, len, fp) == len;
+}
+
+static void invalidate_rect(ui_anim_player_t *p, const ui_anim_rect_t *r)
+{
+    if (lv_img_get_zoom(p->img) != LV_IMG_ZOOM_NONE || lv_img_get_angle(p->img) != 0) {
+        lv_obj_invalidate(p->img);
+        return;
+    }
+    lv_area_t a;
+    a.x1 = p->img->coords.x1 + r->x;
+    a.y1 = p->img->coords.y1 + r->y;
+    a.x2 = a.x1 + r->w - 1;
+    a.y2 = a.y1 + r->h - 1;
+    lv_obj_invalidate_area(p->img, &a);
+}
+
+static bool apply_key(ui_anim_player_t *p, const ui_anim_frame_t *f)
+{
+    uint32_t len = (uint32_t)p->hdr.w * p->hdr.h * sizeof(lv_color_t);
+    if (f->size != len || !read_at(p->fp, f->offset, p->frame, len)) return false;
+
+    p->stats.key_frames++;
+    p->stats.px_updated += (uint32_t)p->hdr.w * p->hdr.h;
+    lv_obj_invalidate(p->img);
+    return true;
+}
+
+static bool apply_delta(ui_anim_player_t *p, const ui_anim_frame_t *f)
+{
+    if (f->size > p->hdr.max_delta_size || f->size < sizeof(uint16_t)) return false;
+    if (!read_at(p->fp, f->offset, p->delta, f->size)) return false;
+
+    const uint8_t *src = p->delta;
+    const uint8_t *end = p->delta + f->size;
+    uint16_t count;
+    memcpy(&count, src, sizeof(count));
+    src += sizeof(count);
+
+    for (uint16_t i = 0; i < count; ++i) {
+        ui_anim_rect_t r;
+        if (src + sizeof(r) > end) return false;
+        memcpy(&r, src, sizeof(r));
+        src += sizeof(r);
+
+        uint32_t row = (uint32_t)r.w * sizeof(lv_color_t);
+        if (r.x + r.w > p->hdr.w || r.y + r.h > p->hdr.h || src + row * r.h > end) return false;
+
+        lv_color_t *dst = p->frame + (uint32_t)r.y * p->hdr.w + r.x;
+        for (uint16_t y = 0; y < r.h; ++y) {
+            memcpy(dst, src, row);
+            dst += p->hdr.w;
+            src += row;
+        }
+        invalidate_rect(p, &r);
+        p->stats.rects++;
+        p->stats.px_updated += (uint32_t)r.w * r.h;
+    }
+    return true;
+}
+
+#if CONFIG_UI_ANIM_STATS
+static void log_stats(ui_anim_player_t *p, int64_t now)
+{
+    if (now - p->t_log < ANIM_STATS_PERIOD_US) return;
+    p->t_log = now;
+
+    ui_anim_stats_t s;
+    ui_anim_player_get_stats(p, &s);
+    uint32_t el = s.elapsed_us ? s.elapsed_us : 1;
+    ESP_LOGI(TAG, "%u frames (%u key), %u.%u fps, cpu %u%% (apply %u%%, draw %u%%), %u px/frame",
+             (unsigned)s.frames, (unsigned)s.key_frames, (unsigned)((uint64_t)s.frames * 1000000 / el),
+             (unsigned)((uint64_t)s.frames * 10000000 / el % 10),
+             (unsigned)((uint64_t)(s.apply_us + s.draw_us) * 100 / el), (unsigned)((uint64_t)s.apply_us * 100 / el),
+             (unsigned)((uint64_t)s.draw_us * 100 / el), (unsigned)(s.frames ? s.px_updated / s.frames : 0));
+}
+#endif
+
+static void anim_tick(lv_timer_t *t)
+{
+    ui_anim_player_t *p = (ui_anim_player_t*)t->user_data;
+
+    int64_t t0 = esp_timer_get_time();
+    p->cur = (uint16_t)((p->cur + 1) % p->hdr.frame_count);
+    const ui_anim_frame_t *f = &p->index[p->cur];
+
+    bool ok = f->type == UI_ANIM_FRAME_KEY ? apply_key(p, f) : apply_delta(p, f);
+    if (!ok) {
+        ESP_LOGE(TAG, "frame %u is corrupt, playback stopped", p->cur);
+        lv_timer_pause(t);
+        return;
+    }
+
+    int64_t now = esp_timer_get_time();
+    p->stats.frames++;
+    p->stats.apply_us += (uint32_t)(now - t0);
+    lv_timer_set_period(t, f->delay_ms ? f->delay_ms : 1);
+
+#if CONFIG_UI_ANIM_STATS
+    log_stats(p, now);
+#endif
+}
+
+static void anim_draw_cb(lv_event_t *e)
+{
+    ui_anim_player_t *p = (ui_anim_player_t*)lv_event_get_user_data(e);
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_DRAW_MAIN_BEGIN) {
+        p->t_draw = esp_timer_get_time();
+    } else if (code == LV_EVENT_DRAW_MAIN_END) {
+        p->stats.draw_us += (uint32_t)(esp_timer_get_time() - p->t_draw);
+    }
+}
+
+static void player_free(ui_anim_player_t *p)
+{
+    if (p->timer) lv_timer_del(p->timer);
+    if (p->fp) fclose(p->fp);
+    if (p->handle && *p->handle == p) *p->handle = NULL;
+    heap_caps_free(p->index);
+    heap_caps_free(p->frame);
+    heap_caps_free(p->delta);
+    heap_caps_free(p);
+}
+
+/* The image is going away with its screen: its source and event list go with it. */
+static void anim_delete_cb(lv_event_t *e)
+{
+    ui_anim_player_t *p = (ui_anim_player_t*)lv_event_get_user_data(e);
+    lv_img_cache_invalidate_src(&p->dsc);
+    player_free(p);
+}
+
+bool ui_anim_player_open(ui_anim_player_t **handle, lv_obj_t *img, const char *path_S)
+{
+    char real[256];
+    ui_img_map_path(real, sizeof(real), path_S);
+    *handle = NULL;
+
+    ui_anim_player_t *p = (ui_anim_player_t*)heap_caps_calloc(1, sizeof(*p), MALLOC_CAP_8BIT);
+    if (!p) return false;
+    p->img = img;
+
+    p->fp = fopen(real, "rb");
+    if (!p->fp) {
+        ESP_LOGE(TAG, "fopen failed: %s", real);
+        goto fail;
+    }
+    if (!read_at(p->fp, 0, &p->hdr, sizeof(p->hdr)) || p->hdr.magic != UI_ANIM_MAGIC ||
+        p->hdr.version > UI_ANIM_VERSION || p->hdr.frame_count == 0) {
+        ESP_LOGE(TAG, "%s: not an animation", real);
+        goto fail;
+    }
+
+    size_t index_len = (size_t)p->hdr.frame_count * sizeof(ui_anim_frame_t);
+    size_t frame_len = (size_t)p->hdr.w * p->hdr.h * sizeof(lv_color_t);
+    p->index = (ui_anim_frame_t*)heap_caps_malloc(index_len, MALLOC_CAP_8BIT);
+    p->frame = (lv_color_t*)heap_caps_malloc(frame_len, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (p->hdr.max_delta_size) {
+        p->delta = (uint8_t*)heap_caps_malloc(p->hdr.max_delta_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    }
+    if (!p->index || !p->frame || (p->hdr.max_delta_size && !p->delta)) {
+        ESP_LOGE(TAG, "%s: alloc failed", real);
+        goto fail;
+    }
+    if (!read_at(p->fp, p->hdr.index_off, p->index, index_len) || p->index[0].type != UI_ANIM_FRAME_KEY ||
+        !apply_key(p, &p->index[0])) {
+        ESP_LOGE(TAG, "%s: bad first frame", real);
+        goto fail;
+    }
+    memset(&p->stats, 0, sizeof(p->stats));
+
+    p->dsc.header.always_zero = 0;
+    p->dsc.header.w  = p->hdr.w;
+    p->dsc.header.h  = p->hdr.h;
+    p->dsc.header.cf = LV_IMG_CF_TRUE_COLOR;
+    p->dsc.data      = (const uint8_t*)p->frame;
+    p->dsc.data_size = frame_len;
+    lv_img_cache_invalidate_src(&p->dsc);
+    lv_img_set_src(img, &p->dsc);
+
+    lv_obj_add_event_cb(img, anim_draw_cb, LV_EVENT_ALL, p);
+    lv_obj_add_event_cb(img, anim_delete_cb, LV_EVENT_DELETE, p);
+    p->t_start = p->t_log = esp_timer_get_time();
+    if (p->hdr.frame_count > 1) {
+        p->timer = lv_timer_create(anim_tick, p->index[0].delay_ms ? p->index[0].delay_ms : 1, p);
+    }
+
+    ESP_LOGI(TAG, "%s: %ux%u, %u frames", real, p->hdr.w, p->hdr.h, p->hdr.frame_count);
+    p->handle = handle;
+    *handle   = p;
+    return true;
+
+fail:
+    ui_anim_player_close(p);
+    return false;
+}
+
+void ui_anim_player_close(ui_anim_player_t *p)
+{
+    if (!p) return;
+    if (p->dsc.data) {
+        lv_obj_remove_event_cb_with_user_data(p->img, anim_draw_cb, p);
+        lv_obj_remove_event_cb_with_user_data(p->img, anim_delete_cb, p);
+        lv_img_cache_invalidate_src(&p->dsc);
+        if (lv_img_get_src(p->img) == &p->dsc) lv_img_set_src(p->img, NULL);
+    }
+    player_free(p);
+}
+
+void ui_anim_player_get_stats(const ui_anim_player_t *p, ui_anim_stats_t *out)
+{
+    if (!p || !out) return;
+    *out = p->stats;
+    out->elapsed_us = (uint32_t)(esp_timer_get_time() - p->t_start);
+}
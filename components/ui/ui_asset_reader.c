@@ -0,0 +1,280 @@
+#include "ui_asset_reader.h"
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+
+static const char *TAG = "UIREAD";
+
+#ifdef CONFIG_UI_ASSET_READ_BLOCK_KB
+#define READ_BLOCK_SIZE (CONFIG_UI_ASSET_READ_BLOCK_KB * 1024)
+#else
+#define READ_BLOCK_SIZE (32 * 1024)
+#endif
+
+#define READ_BUF_NUM     2
+#define READ_BUF_ALIGN   16
+#define READ_TASK_STACK  (3 * 1024)
+#define READ_TASK_PRIO   5
+
+typedef struct {
+    int fd;
+    uint32_t size;
+} read_job_t;
+
+typedef struct {
+    uint8_t idx;
+    int32_t len; /* < 0: read error, job aborted */
+} read_block_t;
+
+static SemaphoreHandle_t s_lock = NULL;
+static uint8_t *s_buf[READ_BUF_NUM];
+static bool s_ready = false;
+
+#if CONFIG_UI_ASSET_READ_DOUBLE_BUFFER
+static QueueHandle_t s_job_q  = NULL;
+static QueueHandle_t s_free_q = NULL;
+static QueueHandle_t s_full_q = NULL;
+static TaskHandle_t s_task    = NULL;
+static volatile uint32_t s_job_read_wall_us;
+static volatile bool s_job_cancel; /* Set by the caller: the reader stops at the next block */
+#endif
+
+static ui_asset_read_stats_t s_stats;
+
+/* read() may return less than asked (VFS splits large requests). */
+static int32_t read_full(int fd, uint8_t *dst, uint32_t len)
+{
+    uint32_t done = 0;
+    while (done < len) {
+        ssize_t r = read(fd, dst + done, len - done);
+        if (r <= 0) return -1;
+        done += (uint32_t)r;
+    }
+    return (int32_t)done;
+}
+
+#if CONFIG_UI_ASSET_READ_DOUBLE_BUFFER
+static void reader_task(void *arg)
+{
+    (void)arg;
+    read_job_t job;
+    for (;;) {
+        if (xQueueReceive(s_job_q, &job, portMAX_DELAY) != pdTRUE) continue;
+
+        uint32_t read_wall_us = 0;
+        for (uint32_t off = 0; off < job.size;) {
+            uint8_t idx;
+            xQueueReceive(s_free_q, &idx, portMAX_DELAY);
+
+            uint32_t n = job.size - off;
+            if (n > READ_BLOCK_SIZE) n = READ_BLOCK_SIZE;
+
+            int64_t t0 = esp_timer_get_time();
+            int32_t r  = s_job_cancel ? -1 : read_full(job.fd, s_buf[idx], n);
+            read_wall_us += (uint32_t)(esp_timer_get_time() - t0);
+            s_job_read_wall_us = read_wall_us;
+
+            read_block_t blk = { .idx = idx, .len = r };
+            xQueueSend(s_full_q, &blk, portMAX_DELAY);
+            if (r < 0) break;
+            off += n;
+        }
+    }
+}
+#endif
+
+static bool reader_init(void)
+{
+    if (s_ready) return true;
+
+    for (int i = 0; i < READ_BUF_NUM; ++i) {
+        if (s_buf[i]) continue;
+        s_buf[i] = (uint8_t*)heap_caps_aligned_alloc(READ_BUF_ALIGN, READ_BLOCK_SIZE,
+                                                     MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+        if (!s_buf[i]) {
+            ESP_LOGE(TAG, "bounce buffer alloc(%u) failed", (unsigned)READ_BLOCK_SIZE);
+            return false;
+        }
+    }
+
+#if CONFIG_UI_ASSET_READ_DOUBLE_BUFFER
+    s_job_q  = xQueueCreate(1, sizeof(read_job_t));
+    s_free_q = xQueueCreate(READ_BUF_NUM, sizeof(uint8_t));
+    s_full_q = xQueueCreate(READ_BUF_NUM, sizeof(read_block_t));
+    if (!s_job_q || !s_free_q || !s_full_q) {
+        ESP_LOGE(TAG, "queue alloc failed");
+        return false;
+    }
+    for (uint8_t i = 0; i < READ_BUF_NUM; ++i) {
+        xQueueSend(s_free_q, &i, 0);
+    }
+
+    /* Run on the core the caller (the LVGL task) is not using. */
+#if CONFIG_FREERTOS_UNICORE
+    BaseType_t core = tskNO_AFFINITY;
+#else
+    BaseType_t core = xPortGetCoreID() ^ 1;
+#endif
+    if (xTaskCreatePinnedToCore(reader_task, "asset_rd", READ_TASK_STACK, NULL, READ_TASK_PRIO, &s_task, core) !=
+        pdPASS) {
+        ESP_LOGE(TAG, "reader task create failed");
+        return false;
+    }
+#endif
+
+    ESP_LOGI(TAG, "%d x %u byte bounce buffers", READ_BUF_NUM, (unsigned)READ_BLOCK_SIZE);
+    s_ready = true;
+    return true;
+}
+
+#if CONFIG_UI_ASSET_READ_DOUBLE_BUFFER
+static bool read_pipelined(int fd, uint8_t *dst, uint32_t size, ui_asset_read_cancel_t cancelled, void *arg,
+                           uint32_t *read_wall_us, uint32_t *copy_us)
+{
+    read_job_t job     = { .fd = fd, .size = size };
+    s_job_read_wall_us = 0;
+    s_job_cancel       = false;
+    xQueueSend(s_job_q, &job, portMAX_DELAY);
+
+    bool ok = true;
+    for (uint32_t off = 0; off < size;) {
+        read_block_t blk;
+        xQueueReceive(s_full_q, &blk, portMAX_DELAY);
+        if (blk.len < 0) {
+            xQueueSend(s_free_q, &blk.idx, portMAX_DELAY);
+            ok = false;
+            break;
+        }
+        /* Blocks already read are dropped until the reader sees the flag and posts a failed one */
+        if (ok && cancelled && cancelled(arg)) {
+            s_job_cancel = true;
+            ok           = false;
+        }
+
+        if (ok) {
+            int64_t t0 = esp_timer_get_time();
+            memcpy(dst + off, s_buf[blk.idx], (size_t)blk.len);
+            *copy_us += (uint32_t)(esp_timer_get_time() - t0);
+        }
+
+        xQueueSend(s_free_q, &blk.idx, portMAX_DELAY);
+        off += (uint32_t)blk.len;
+    }
+    /* The reader publishes its time before posting the last block. */
+    *read_wall_us = s_job_read_wall_us;
+    return ok;
+}
+#else
+static bool read_serial(int fd, uint8_t *dst, uint32_t size, ui_asset_read_cancel_t cancelled, void *arg,
+                        uint32_t *read_wall_us, uint32_t *copy_us)
+{
+    for (uint32_t off = 0; off < size;) {
+        if (cancelled && cancelled(arg)) return false;
+        uint32_t n = size - off;
+        if (n > READ_BLOCK_SIZE) n = READ_BLOCK_SIZE;
+
+        int64_t t0 = esp_timer_get_time();
+        int32_t r  = read_full(fd, s_buf[0], n);
+        int64_t t1 = esp_timer_get_time();
+        *read_wall_us += (uint32_t)(t1 - t0);
+        if (r < 0) return false;
+
+        memcpy(dst + off, s_buf[0], n);
+        *copy_us += (uint32_t)(esp_timer_get_time() - t1);
+        off += n;
+    }
+    return true;
+}
+#endif
+
+bool ui_asset_reader_init(void)
+{
+    if (s_lock) return true;
+    s_lock = xSemaphoreCreateMutex();
+    if (!s_lock) {
+        ESP_LOGE(TAG, "mutex alloc failed");
+        return false;
+    }
+    return true;
+}
+
+bool ui_asset_read_file(const char *real_path, void *dst, uint32_t size)
+{
+    return ui_asset_read_file_cancellable(real_path, dst, size, NULL, NULL);
+}
+
+bool ui_asset_read_file_cancellable(const char *real_path, void *dst, uint32_t size, ui_asset_read_cancel_t cancelled,
+                                    void *arg)
+{
+    if (!real_path || !dst) return false;
+    if (!s_lock) {
+        ESP_LOGE(TAG, "ui_asset_reader_init() not called");
+        return false;
+    }
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+
+    bool ok = false;
+    int64_t t0 = esp_timer_get_time();
+    uint32_t read_wall_us = 0, copy_us = 0;
+
+    if (!reader_init()) goto out;
+
+    int fd = open(real_path, O_RDONLY);
+    if (fd < 0) {
+        ESP_LOGE(TAG, "open failed: %s", real_path);
+        goto out;
+    }
+
+#if CONFIG_UI_ASSET_READ_DOUBLE_BUFFER
+    ok = read_pipelined(fd, (uint8_t*)dst, size, cancelled, arg, &read_wall_us, &copy_us);
+#else
+    ok = read_serial(fd, (uint8_t*)dst, size, cancelled, arg, &read_wall_us, &copy_us);
+#endif
+    close(fd);
+
+    if (!ok) {
+        if (cancelled && cancelled(arg)) {
+            ESP_LOGD(TAG, "read cancelled: %s", real_path);
+        } else {
+            ESP_LOGE(TAG, "read failed: %s", real_path);
+        }
+        goto out;
+    }
+
+    uint32_t wall_us = (uint32_t)(esp_timer_get_time() - t0);
+    s_stats.files++;
+    s_stats.bytes += size;
+    s_stats.wall_us += wall_us;
+    s_stats.read_wall_us += read_wall_us;
+    s_stats.copy_us += copy_us;
+
+#if CONFIG_UI_ASSET_READ_BENCH
+    /* bytes per microsecond == MB/s (10^6) */
+    uint32_t kbps = wall_us ? (uint32_t)((uint64_t)size * 1000u / wall_us) : 0;
+    ESP_LOGI(TAG, "%s: %u bytes in %u us, %u.%03u MB/s, read() wall %u us + copy %u us", real_path, (unsigned)size,
+             (unsigned)wall_us, (unsigned)(kbps / 1000), (unsigned)(kbps % 1000), (unsigned)read_wall_us,
+             (unsigned)copy_us);
+#endif
+
+out:
+    xSemaphoreGive(s_lock);
+    return ok;
+}
+
+void ui_asset_read_get_stats(ui_asset_read_stats_t *out)
+{
+    if (out) *out = s_stats;
+}
+
+void ui_asset_read_reset_stats(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+}
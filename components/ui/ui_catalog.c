@@ -0,0 +1,131 @@
+#include "ui_catalog.h"
+#include "ui_img_manager.h"
+#include "esp_log.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "UICAT";
+
+_Static_assert(sizeof(ui_catalog_header_t) == 32, "catalog header layout");
+_Static_assert(sizeof(ui_catalog_record_t) == 36, "catalog record layout");
+
+static FILE *s_fp = NULL;
+static ui_catalog_header_t s_hdr;
+
+static bool read_at(uint32_t off, void *dst, size_t len)
+{
+    if (fseek(s_fp, (long)off, SEEK_SET) != 0) return false;
+    return fread(dst, 1, len, s_fp) == len;
+}
+
+static bool read_record(uint32_t id, ui_catalog_record_t *rec)
+{
+    if (!s_fp || id >= s_hdr.count) return false;
+
+    /* Newer manifests may append fields to the record; only the known prefix is read. */
+    uint32_t off = s_hdr.index_off + id * (uint32_t)s_hdr.record_size;
+    if (!read_at(off, rec, sizeof(*rec))) {
+        ESP_LOGE(TAG, "index read failed (id %u)", (unsigned)id);
+        return false;
+    }
+    return true;
+}
+
+static bool read_string(uint32_t str_off, char *buf, size_t size)
+{
+    uint16_t len = 0;
+    if (str_off + sizeof(len) > s_hdr.strings_size) return false;
+    if (!read_at(s_hdr.strings_off + str_off, &len, sizeof(len))) return false;
+
+    size_t n = len;
+    if (n >= size) {
+        ESP_LOGW(TAG, "string at %u truncated: %u >= %u", (unsigned)str_off, (unsigned)len, (unsigned)size);
+        n = size - 1;
+    }
+    if (fread(buf, 1, n, s_fp) != n) return false;
+    buf[n] = '\0';
+    return true;
+}
+
+bool ui_catalog_open(const char *path_S)
+{
+    ui_catalog_close();
+
+    char real[256];
+    ui_img_map_path(real, sizeof(real), path_S);
+
+    s_fp = fopen(real, "rb");
+    if (!s_fp) {
+        ESP_LOGE(TAG, "fopen failed: %s", real);
+        return false;
+    }
+
+    if (!read_at(0, &s_hdr, sizeof(s_hdr)) || s_hdr.magic != UI_CATALOG_MAGIC) {
+        ESP_LOGE(TAG, "%s: not a catalog", real);
+        ui_catalog_close();
+        return false;
+    }
+    if (s_hdr.version > UI_CATALOG_VERSION || s_hdr.record_size < sizeof(ui_catalog_record_t)) {
+        ESP_LOGE(TAG, "%s: unsupported version %u (record %u)", real, s_hdr.version, s_hdr.record_size);
+        ui_catalog_close();
+        return false;
+    }
+
+    ESP_LOGI(TAG, "%s: %u items", real, (unsigned)s_hdr.count);
+    return true;
+}
+
+void ui_catalog_close(void)
+{
+    if (s_fp) fclose(s_fp);
+    s_fp = NULL;
+    memset(&s_hdr, 0, sizeof(s_hdr));
+}
+
+uint32_t ui_catalog_count(void)
+{
+    return s_fp ? s_hdr.count : 0;
+}
+
+bool ui_catalog_get(uint32_t id, ui_catalog_item_t *out)
+{
+    ui_catalog_record_t rec;
+    if (!out || !read_record(id, &rec)) return false;
+
+    char rel[UI_CATALOG_PATH_MAX - 2];
+    if (!read_string(rec.str_off[UI_CATALOG_IMAGE], rel, sizeof(rel))) return false;
+
+    out->id = id;
+    snprintf(out->img_path, sizeof(out->img_path), "S:%s", rel);
+    out->img_size = rec.img_size;
+    out->img_w    = rec.img_w;
+    out->img_h    = rec.img_h;
+    out->img_cf   = rec.img_cf;
+    out->flags    = rec.flags;
+    return true;
+}
+
+bool ui_catalog_read_str(uint32_t id, ui_catalog_str_t which, char *buf, size_t size)
+{
+    if (!buf || size == 0) return false;
+    buf[0] = '\0';
+    if (which >= UI_CATALOG_STR_COUNT) return false;
+
+    ui_catalog_record_t rec;
+    if (!read_record(id, &rec)) return false;
+    return read_string(rec.str_off[which], buf, size);
+}
+
+bool ui_catalog_mip_path(const ui_catalog_item_t *item, uint8_t shift, char *buf, size_t size)
+{
+    if (!item || !buf || !(item->flags & UI_CATALOG_FLAG_MIPS)) return false;
+    if (shift == 0 || shift > UI_CATALOG_MIP_LEVELS) return false;
+
+    const char *dot   = strrchr(item->img_path, '.');
+    const char *slash = strrchr(item->img_path, '/');
+    if (!dot || (slash && dot < slash)) dot = item->img_path + strlen(item->img_path);
+
+    int n = snprintf(buf, size, "%.*s.mip%u%s", (int)(dot - item->img_path), item->img_path,
+                     1u << shift, dot);
+    return n > 0 && (size_t)n < size;
+}
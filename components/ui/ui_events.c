@@ -2,127 +2,434 @@
 #include "ui.h"                 
 #include "tts_bridge.h"
 #include "builtin_texts.h"
+#include "ui_catalog.h"
+#include "ui_jpeg.h"
+#include "ui_anim.h"
+#include "ui_gallery.h"
+#include "ui_screen_cache.h"
 #include "esp_log.h"
 #include "lvgl.h"
 #include "esp_heap_caps.h"
+#include "esp_timer.h"
 #include <stdint.h> 
+#include <string.h>
 
 static const char* TAG_UI = "ui_events";
 
 static lv_timer_t* s_question_tts_timer = NULL;
 
-typedef void (*img_loader_t)(void);
-typedef struct { const lv_img_dsc_t* img; img_loader_t load; } case_visual_t;
+// Image of the current case. One descriptor is reused for every catalog item,
+// so RAM does not grow with the number of items.
+static lv_img_dsc_t s_case_img;
+// Set instead of s_case_img when the case has an animated image.
+static ui_anim_player_t* s_case_anim = NULL;
+
+#if CONFIG_UI_IMG_PROGRESSIVE
+// Smallest mip level, shown zoomed in ui_Img while s_case_job reads the full image.
+// The loader reads it ahead of any full image still queued.
+static lv_img_dsc_t s_case_preview;
+static ui_img_job_t* s_case_preview_job = NULL;
+static uint16_t s_case_preview_zoom;
+static ui_img_job_t* s_case_job = NULL;
+static lv_timer_t* s_case_job_timer = NULL;
+// ui_Img settings the zoomed preview overrides, restored when it goes
+static lv_img_size_mode_t s_preview_size_mode;
+static bool s_preview_antialias;
+#define CASE_JOB_POLL_MS 10
+#endif
+
+#define QA_QUESTION_MAX 256
+#define QA_OPTION_MAX   64
+
+static char s_qa_buf[QA_QUESTION_MAX];
+
+/* What Screen1 and Screen2 currently show, so a prepared screen is not filled again */
+static bool s_img_applied = false;
+static builtin_text_case_t s_img_case;
+static lv_obj_t* s_img_obj = NULL;
+static bool s_qa_filled = false;
+static builtin_text_case_t s_qa_case;
+static lv_obj_t* s_qa_obj = NULL;
+
+#if CONFIG_UI_SCREEN_TRANSITION_SLIDE
+#define SCREEN_ANIM_FWD  LV_SCR_LOAD_ANIM_MOVE_LEFT
+#define SCREEN_ANIM_BACK LV_SCR_LOAD_ANIM_MOVE_RIGHT
+#define SCREEN_ANIM_MS   CONFIG_UI_SCREEN_TRANSITION_MS
+#elif CONFIG_UI_SCREEN_TRANSITION_FADE
+#define SCREEN_ANIM_FWD  LV_SCR_LOAD_ANIM_FADE_IN
+#define SCREEN_ANIM_BACK LV_SCR_LOAD_ANIM_FADE_IN
+#define SCREEN_ANIM_MS   CONFIG_UI_SCREEN_TRANSITION_MS
+#else
+#define SCREEN_ANIM_FWD  LV_SCR_LOAD_ANIM_NONE
+#define SCREEN_ANIM_BACK LV_SCR_LOAD_ANIM_NONE
+#define SCREEN_ANIM_MS   0
+#endif
 
+static void tts_question_timer_cb(lv_timer_t* t)
+{
+    builtin_text_case_t c = (builtin_text_case_t)(uintptr_t)t->user_data;
+
+    if (ui_catalog_read_str(c, UI_CATALOG_QUESTION, s_qa_buf, sizeof(s_qa_buf)) && s_qa_buf[0]) {
+        start_tts_playback_c(s_qa_buf);
+    }
+    
+    s_question_tts_timer = NULL;   
+}
+
+#if CONFIG_UI_IMG_DRAW_BENCH
+/* Time spent drawing ui_Img, per color format, logged every UI_IMG_DRAW_BENCH_EVERY draws. */
+#define UI_IMG_DRAW_BENCH_EVERY 20
+
+static lv_obj_t* s_bench_obj = NULL;
+static int64_t s_bench_t0;
+static uint32_t s_bench_us, s_bench_max_us, s_bench_n;
 
-static const case_visual_t kVisuals[CASE_TXT_COUNT] = {
-    [CASE_TXT_01] = { &ui_img_01_png, ui_img_01_png_load },
-    [CASE_TXT_02] = { &ui_img_02_png, ui_img_02_png_load },
-    [CASE_TXT_03] = { &ui_img_03_png, ui_img_03_png_load },
-    [CASE_TXT_04] = { &ui_img_04_png, ui_img_04_png_load },
-    [CASE_TXT_05] = { &ui_img_05_png, ui_img_05_png_load },
-    [CASE_TXT_06] = { &ui_img_06_png, ui_img_06_png_load },
-    [CASE_TXT_07] = { &ui_img_07_png, ui_img_07_png_load },
-    [CASE_TXT_08] = { &ui_img_08_png, ui_img_08_png_load },
-    [CASE_TXT_09] = { &ui_img_09_png, ui_img_09_png_load },
-    [CASE_TXT_10] = { &ui_img_10_png, ui_img_10_png_load },
+static void img_draw_bench_cb(lv_event_t* e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_DRAW_MAIN_BEGIN) {
+        s_bench_t0 = esp_timer_get_time();
+        return;
+    }
+    if (code != LV_EVENT_DRAW_MAIN_END) return;
+
+    uint32_t us = (uint32_t)(esp_timer_get_time() - s_bench_t0);
+    s_bench_us += us;
+    if (us > s_bench_max_us) s_bench_max_us = us;
+    if (++s_bench_n < UI_IMG_DRAW_BENCH_EVERY) return;
+
+    ESP_LOGI(TAG_UI, "img draw cf %u (%ux%u, %u bytes): avg %u us, max %u us over %u draws",
+             (unsigned)s_case_img.header.cf, (unsigned)s_case_img.header.w, (unsigned)s_case_img.header.h,
+             (unsigned)s_case_img.data_size, (unsigned)(s_bench_us / s_bench_n), (unsigned)s_bench_max_us,
+             (unsigned)s_bench_n);
+    s_bench_us = s_bench_max_us = s_bench_n = 0;
+}
+
+static void img_draw_bench_attach(lv_obj_t* img)
+{
+    s_bench_us = s_bench_max_us = s_bench_n = 0;
+    if (s_bench_obj == img) return;
+    lv_obj_add_event_cb(img, img_draw_bench_cb, LV_EVENT_ALL, NULL);
+    s_bench_obj = img;
+}
+#endif
 
-    /* Example for CASE_TXT_11 (custom):
-    [CASE_TXT_11] = { &ui_img_11_png, ui_img_11_png_load },
-    */
-};
+#if CONFIG_UI_LABEL_DRAW_BENCH
+/* Time spent drawing each question/answer label, logged every UI_LABEL_DRAW_BENCH_EVERY draws
+ * together with the hit rates of the A8 glyph cache (LV_FONT_FMT_TXT_A8_CACHE_SIZE) and of the
+ * text layout cache (LV_TXT_LAYOUT_CACHE_NUM). */
+#define UI_LABEL_DRAW_BENCH_EVERY 20
+#define UI_LABEL_DRAW_BENCH_NUM   4
 
-// -------------------- QUESTION BANK FOR Screen2 --------------------
 typedef struct {
-    const char* question;
-    const char* A;
-    const char* B;
-    const char* C;
-} qa_t;
-
-static const qa_t kQA[CASE_TXT_COUNT] = {
-    [CASE_TXT_01] = { "Which animal sleeps standing on one leg ?", "Elephant", "Flamingo", "Kangaroo" },
-    [CASE_TXT_02] = { "Which animal can go without water for a whole week ?", "Camel", "Penguin", "Dolphin" },
-    [CASE_TXT_03] = { "Who can change color to disappear in the ocean ?", "Chameleon", "Octopus", "Owl" },
-    [CASE_TXT_04] = { "Who rolls into a spiky ball when scared ?", "Ant", "Hedgehog", "Elephant" },
-    [CASE_TXT_05] = { "Who changes color not just for hiding, but for mood ?", "Chameleon", "Flamingo", "Camel" },
-    [CASE_TXT_06] = { "Who talks without opening their mouth ?", "Dolphin", "Owl", "Penguin" },
-    [CASE_TXT_07] = { "Which tiny creature can lift 50 times its own weight ?", "Ant", "Hedgehog", "Octopus" },
-    [CASE_TXT_08] = { "Who can see in the dark better than anyone ?", "Owl", "Dolphin", "Chameleon" },
-    [CASE_TXT_09] = { "Which bird can't fly, but swims perfectly ?", "Penguin", "Flamingo", "Owl" },
-    [CASE_TXT_10] = { "Who remembers everything, even what never happened ?", "Elephant", "Camel", "Ant" },
-    /* Example for a custom case:
-    [CASE_TXT_11] = { "Your question?", "Option A", "Option B", "Option C" },
-    */
-};
+    lv_obj_t* obj;
+    int64_t t0;
+    uint32_t us, max_us, n;
+} label_bench_t;
 
-static void tts_question_timer_cb(lv_timer_t* t)
+static label_bench_t s_label_bench[UI_LABEL_DRAW_BENCH_NUM];
+
+static void label_draw_bench_cb(lv_event_t* e)
 {
-    builtin_text_case_t c = (builtin_text_case_t)(uintptr_t)t->user_data;
+    label_bench_t* b = (label_bench_t*)lv_event_get_user_data(e);
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_DRAW_MAIN_BEGIN) {
+        b->t0 = esp_timer_get_time();
+        return;
+    }
+    if (code != LV_EVENT_DRAW_MAIN_END) return;
+
+    uint32_t us = (uint32_t)(esp_timer_get_time() - b->t0);
+    b->us += us;
+    if (us > b->max_us) b->max_us = us;
+    if (++b->n < UI_LABEL_DRAW_BENCH_EVERY) return;
+
+    ESP_LOGI(TAG_UI, "label %u draw (%u chars): avg %u us, max %u us over %u draws",
+             (unsigned)(b - s_label_bench), (unsigned)strlen(lv_label_get_text(b->obj)),
+             (unsigned)(b->us / b->n), (unsigned)b->max_us, (unsigned)b->n);
+    b->us = b->max_us = b->n = 0;
+
+#if LV_FONT_FMT_TXT_A8_CACHE_SIZE
+    lv_font_fmt_txt_a8_cache_stats_t st;
+    lv_font_fmt_txt_a8_cache_get_stats(&st, false);
+    uint32_t lookups = st.hits + st.misses;
+    ESP_LOGI(TAG_UI, "glyph cache: %u%% hits (%u/%u), %u glyphs, %u bytes",
+             (unsigned)(lookups ? (uint64_t)st.hits * 100 / lookups : 0), (unsigned)st.hits, (unsigned)lookups,
+             (unsigned)st.glyphs, (unsigned)st.bytes);
+#endif
+#if LV_TXT_LAYOUT_CACHE_NUM
+    lv_txt_layout_cache_stats_t txt;
+    lv_txt_layout_cache_get_stats(&txt, false);
+    ESP_LOGI(TAG_UI, "text layout cache: %u hits, %u misses, %u bytes not measured again",
+             (unsigned)txt.hits, (unsigned)txt.misses, (unsigned)txt.hit_bytes);
+#endif
+}
 
-    if (c >= 0 && c < CASE_TXT_COUNT) {
-        const char* q = kQA[c].question;
-        if (q && *q) {
-            start_tts_playback_c(q);
-        }
+static void label_draw_bench_attach(size_t i, lv_obj_t* label)
+{
+    label_bench_t* b = &s_label_bench[i];
+    b->us = b->max_us = b->n = 0;
+    if (b->obj == label) return;
+    lv_obj_add_event_cb(label, label_draw_bench_cb, LV_EVENT_ALL, b);
+    b->obj = label;
+}
+#endif
+
+#if CONFIG_UI_IMG_PROGRESSIVE
+static void release_case_preview(void)
+{
+    ui_img_job_cancel(s_case_preview_job);
+    s_case_preview_job = NULL;
+    if (!s_case_preview.data) return;
+    /* The widget still shows the preview, or the full image that replaced it */
+    if (ui_Img && ui_Img == s_img_obj) {
+        lv_img_set_zoom(ui_Img, LV_IMG_ZOOM_NONE);
+        lv_img_set_size_mode(ui_Img, s_preview_size_mode);
+        lv_img_set_antialias(ui_Img, s_preview_antialias);
+    }
+    lv_img_cache_invalidate_src(&s_case_preview);
+    heap_caps_free((void*)s_case_preview.data);
+    s_case_preview.data = NULL;
+}
+#endif
+
+static void release_case_image(void)
+{
+    s_img_applied = false;
+    ui_anim_player_close(s_case_anim);
+    s_case_anim = NULL;
+
+#if CONFIG_UI_IMG_PROGRESSIVE
+    if (s_case_job_timer) {
+        lv_timer_del(s_case_job_timer);
+        s_case_job_timer = NULL;
+    }
+    ui_img_job_cancel(s_case_job);
+    s_case_job = NULL;
+    release_case_preview();
+#endif
+
+    if (s_case_img.data) {
+        ESP_LOGD(TAG_UI, "free image buffer: %p", s_case_img.data);
+        heap_caps_free((void*)s_case_img.data);
+        s_case_img.data = NULL;
+        s_case_img.data_size = 0;
     }
-    
-    s_question_tts_timer = NULL;   
 }
 
-static bool is_pinned_image(const lv_img_dsc_t* dsc)
+static void show_case_img(void)
 {
-    return (dsc == &ui_img_1049104300);
+    /* Same descriptor, new pixels: drop anything LVGL cached for it. */
+    lv_img_cache_invalidate_src(&s_case_img);
+
+    if (ui_Img) {
+        lv_img_set_src(ui_Img, &s_case_img);       
+#if CONFIG_UI_IMG_DRAW_BENCH
+        img_draw_bench_attach(ui_Img);
+#endif
+    }
+    ui_screen_cache_set_live(ui_Screen1, false);
+    ui_screen_cache_invalidate(ui_Screen1);
 }
 
-static void free_all_other_images(const lv_img_dsc_t* except_dsc)
+#if CONFIG_UI_IMG_PROGRESSIVE
+static void show_case_preview_data(uint8_t* data)
 {
-    for (int i = 0; i < CASE_TXT_COUNT; ++i) {
-        const lv_img_dsc_t* d = kVisuals[i].img;
-        if (!d || d == except_dsc) continue;
-        if (is_pinned_image(d)) continue;
+    if (!ui_Img || ui_Img != s_img_obj) {
+        heap_caps_free(data);
+        return;
+    }
+    s_case_preview.data = data;
+    lv_img_cache_invalidate_src(&s_case_preview);
+
+    /* REAL size mode: the widget (and its border) takes the zoomed size, as the full image will. */
+    s_preview_size_mode = lv_img_get_size_mode(ui_Img);
+    s_preview_antialias = lv_img_get_antialias(ui_Img);
+    lv_img_set_src(ui_Img, &s_case_preview);
+    lv_img_set_size_mode(ui_Img, LV_IMG_SIZE_MODE_REAL);
+    lv_img_set_antialias(ui_Img, false);
+    lv_img_set_zoom(ui_Img, s_case_preview_zoom);
+}
 
-        if (d->data) {
-            ESP_LOGD(TAG_UI, "free image buffer: %p (case %d)", d->data, i);
-            heap_caps_free((void*)d->data);
-            ((lv_img_dsc_t*)d)->data = NULL;
-            ((lv_img_dsc_t*)d)->data_size = 0;
+static void case_job_poll_cb(lv_timer_t* t)
+{
+    uint8_t* data;
+    if (s_case_preview_job && ui_img_job_poll(s_case_preview_job, &data)) {
+        s_case_preview_job = NULL;
+        if (data) {
+            show_case_preview_data(data);
+        } else {
+            ESP_LOGW(TAG_UI, "preview load failed, waiting for the full image");
         }
     }
+
+    if (!ui_img_job_poll(s_case_job, &data)) return;
+    s_case_job = NULL;
+    lv_timer_del(t);
+    s_case_job_timer = NULL;
+
+    if (!data) {
+        ESP_LOGE(TAG_UI, "full image load failed, keeping the preview");
+        s_case_img.data_size = 0;
+        return;
+    }
+    s_case_img.data      = data;
+    show_case_img();
+    release_case_preview();
+}
+
+/*
+ * Read the 1/8 mip of `item` and then the full image in the background.
+ * case_job_poll_cb() shows the mip zoomed to full size as soon as it is in,
+ * and the full image after it. s_case_img gets its header now and its
+ * pixels with the full image. ui_Img shows nothing in between, the LVGL task
+ * never waits for the reader. False if the item has no mips or the loader
+ * is busy.
+ */
+static bool show_case_preview(const ui_catalog_item_t* item)
+{
+    if (!ui_Img || !(item->flags & UI_CATALOG_FLAG_MIPS)) return false;
+
+    char path[UI_CATALOG_PATH_MAX + 8];
+    uint16_t pw = item->img_w >> UI_CATALOG_MIP_LEVELS;
+    uint16_t ph = item->img_h >> UI_CATALOG_MIP_LEVELS;
+    if (!pw || !ph || !ui_catalog_mip_path(item, UI_CATALOG_MIP_LEVELS, path, sizeof(path))) return false;
+
+    /* Ahead of the full reads of earlier cases that are still queued */
+    uint32_t psize     = (uint32_t)pw * ph * sizeof(lv_color_t);
+    s_case_preview_job = ui_img_load_async(path, psize, true);
+    if (!s_case_preview_job) return false;
+
+    s_case_job = ui_img_load_async(item->img_path, item->img_size, false);
+    if (!s_case_job) {
+        ui_img_job_cancel(s_case_preview_job);
+        s_case_preview_job = NULL;
+        return false;
+    }
+    s_case_job_timer = lv_timer_create(case_job_poll_cb, CASE_JOB_POLL_MS, NULL);
+    /* Not worth a snapshot until the full image is in */
+    ui_screen_cache_set_live(ui_Screen1, true);
+
+    s_case_preview.header.always_zero = 0;
+    s_case_preview.header.w  = pw;
+    s_case_preview.header.h  = ph;
+    s_case_preview.header.cf = LV_IMG_CF_TRUE_COLOR;
+    s_case_preview.data_size = psize;
+    s_case_preview_zoom      = (uint16_t)((item->img_w * LV_IMG_ZOOM_NONE + pw - 1) / pw);
+
+    /* The previous image's pixels are gone */
+    lv_img_set_src(ui_Img, NULL);
+    return true;
 }
+#endif
 
 void apply_image_for_case(builtin_text_case_t c)
 {
-    if (c < 0 || c >= CASE_TXT_COUNT) return;
+    ui_catalog_item_t item;
+    if (!ui_catalog_get(c, &item)) return;
 
-    const case_visual_t *cv = &kVisuals[c];
-    if (cv->load) cv->load();                  
+    /* Already loaded ahead of time by prepare_screen1() */
+    if (s_img_applied && s_img_case == c && s_img_obj == ui_Img) {
+        builtin_text_set(c);
+        return;
+    }
 
-    if (ui_Img) {
-        lv_img_set_src(ui_Img, cv->img);       
+    release_case_image();
+    s_img_applied = true;
+    s_img_case    = c;
+    s_img_obj     = ui_Img;
+
+    if (item.flags & UI_CATALOG_FLAG_ANIM) {
+        if (ui_Img) ui_anim_player_open(&s_case_anim, ui_Img, item.img_path);
+        ui_screen_cache_set_live(ui_Screen1, s_case_anim != NULL);
+        builtin_text_set(c);
+        return;
+    }
+
+    s_case_img.header.always_zero = 0;
+    s_case_img.header.reserved = 0;
+    s_case_img.header.w  = item.img_w;
+    s_case_img.header.h  = item.img_h;
+    s_case_img.header.cf = item.img_cf;
+    if (item.flags & UI_CATALOG_FLAG_JPEG) {
+        /* Compressed: always decoded into PSRAM, also in streaming builds. */
+        s_case_img.header.cf = LV_IMG_CF_TRUE_COLOR;
+        s_case_img.data      = ui_jpeg_load(item.img_path, item.img_size, item.img_w, item.img_h);
+        s_case_img.data_size = s_case_img.data ? (uint32_t)item.img_w * item.img_h * sizeof(lv_color_t) : 0;
+    } else {
+#if CONFIG_UI_IMG_PROGRESSIVE
+        s_case_img.data      = NULL;
+        s_case_img.data_size = item.img_size;
+        if (show_case_preview(&item)) {
+            builtin_text_set(c);
+            return;
+        }
+#endif
+        s_case_img.header.reserved = UI_LOAD_IMAGE_RESERVED;
+        s_case_img.data      = UI_LOAD_IMAGE(item.img_path, item.img_size);
+        s_case_img.data_size = s_case_img.data ? item.img_size : 0;
     }
+
+    show_case_img();
     builtin_text_set(c);                       
-    free_all_other_images(cv->img);            
 }
 
 static void fill_screen2_for_case(builtin_text_case_t c)
 {
     if (!ui_Screen2) return;
-    if (c < 0 || c >= CASE_TXT_COUNT) return;
-    const qa_t* qa = &kQA[c];
-
-    if (ui_que)   lv_label_set_text(ui_que, qa->question);
-    if (ui_labA)  lv_label_set_text(ui_labA, qa->A);
-    if (ui_LabB)  lv_label_set_text(ui_LabB, qa->B); 
-    if (ui_LabC)  lv_label_set_text(ui_LabC, qa->C);
+    if (c >= ui_catalog_count()) return;
+    if (s_qa_filled && s_qa_case == c && s_qa_obj == ui_que) return;
+
+    static const struct { lv_obj_t** label; ui_catalog_str_t str; size_t max; } fields[] = {
+        { &ui_que,  UI_CATALOG_QUESTION, QA_QUESTION_MAX },
+        { &ui_labA, UI_CATALOG_OPTION_A, QA_OPTION_MAX },
+        { &ui_LabB, UI_CATALOG_OPTION_B, QA_OPTION_MAX },
+        { &ui_LabC, UI_CATALOG_OPTION_C, QA_OPTION_MAX },
+    };
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); ++i) {
+        if (!*fields[i].label) continue;
+        ui_catalog_read_str(c, fields[i].str, s_qa_buf, fields[i].max);
+        lv_label_set_text(*fields[i].label, s_qa_buf);
+#if CONFIG_UI_LABEL_DRAW_BENCH
+        label_draw_bench_attach(i, *fields[i].label);
+#endif
+    }
+    s_qa_filled = true;
+    s_qa_case   = c;
+    s_qa_obj    = ui_que;
+    ui_screen_cache_invalidate(ui_Screen2);
+}
 
+static void schedule_question_tts(builtin_text_case_t c)
+{
     if (s_question_tts_timer) {
         lv_timer_del(s_question_tts_timer);  
         s_question_tts_timer = NULL;
     }
     s_question_tts_timer = lv_timer_create(tts_question_timer_cb, 1000 /* ms */, (void*)(uintptr_t)c);
     lv_timer_set_repeat_count(s_question_tts_timer, 1); 
+}
+
+/* Idle work for the screen cache: lay out what the hidden screen shows next. */
+static void prepare_screen1(lv_obj_t* scr)
+{
+    (void)scr;
+    if (lv_scr_act() == ui_Screen2) apply_image_for_case(builtin_text_get());
+}
 
+static void prepare_screen2(lv_obj_t* scr)
+{
+    (void)scr;
+    uint32_t count = ui_catalog_count();
+    if (count && lv_scr_act() == ui_Screen1) fill_screen2_for_case((builtin_text_get() + 1) % count);
+}
+
+static void load_screen(lv_obj_t* scr, lv_scr_load_anim_t anim)
+{
+    /* No-op for screens already cached; screens are re-created after ui_destroy() */
+    if (ui_Screen1) ui_screen_cache_add(ui_Screen1, prepare_screen1);
+    if (ui_Screen2) ui_screen_cache_add(ui_Screen2, prepare_screen2);
+    ui_screen_cache_load(scr, anim, SCREEN_ANIM_MS, 0);
 }
 
 
@@ -138,7 +445,33 @@ void on_btn_change_pressed(lv_event_t * e)
         ui_Screen2_screen_init();
     }
     fill_screen2_for_case(c);
-    lv_disp_load_scr(ui_Screen2);              
+    schedule_question_tts(c);
+    load_screen(ui_Screen2, SCREEN_ANIM_FWD);
+}
+
+void on_btn_change_long_pressed(lv_event_t * e)
+{
+    (void)e;
+    ui_gallery_open(builtin_text_get());
+}
+
+void on_btn_back_pressed(lv_event_t * e)
+{
+    (void)e;
+    ui_gallery_close();
+    if (!ui_Screen1) {
+        ui_Screen1_screen_init();
+    }
+    load_screen(ui_Screen1, SCREEN_ANIM_BACK);
+}
+
+void on_gallery_item_pressed(lv_event_t * e)
+{
+    builtin_text_case_t c = (builtin_text_case_t)ui_gallery_item_of(lv_event_get_current_target(e));
+
+    ui_gallery_close();
+    builtin_text_set(c);
+    ui_show_question_current_case();
 }
 
 void on_btn_say_pressed(lv_event_t * e)
@@ -164,7 +497,7 @@ void on_btn_answer_pressed(lv_event_t * e)
         ui_Screen1_screen_init();
     }
     apply_image_for_case(c);
-    lv_disp_load_scr(ui_Screen1);
+    load_screen(ui_Screen1, SCREEN_ANIM_FWD);
 }
 
 void on_text_update_from_uart(const char *text)
@@ -177,6 +510,7 @@ static void ui_notify_tts_finished_async(void *arg)
     (void)arg;
     if (ui_btnsay) {
         lv_obj_clear_state(ui_btnsay, LV_STATE_DISABLED);
+        ui_screen_cache_invalidate(ui_Screen1);
     }
 }
 
@@ -192,5 +526,6 @@ void ui_show_question_current_case(void)
         ui_Screen2_screen_init();
     }
     fill_screen2_for_case(c);
-    lv_disp_load_scr(ui_Screen2);
+    schedule_question_tts(c);
+    load_screen(ui_Screen2, SCREEN_ANIM_FWD);
 }
\ No newline at end of file
@@ -0,0 +1,353 @@
+#include "ui_gallery.h"
+#include "ui.h"
+#include "ui_Screen3.h"
+#include "ui_asset_reader.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+#include <string.h>
+
+static const char *TAG = "UIGAL";
+
+#define TILE_W CONFIG_UI_GALLERY_TILE_W
+#define TILE_H CONFIG_UI_GALLERY_TILE_H
+#define SLOT_NUM CONFIG_UI_GALLERY_CACHE_NUM
+#define SLOT_BYTES ((uint32_t)TILE_W * TILE_H * sizeof(lv_color_t))
+
+/* Thumbnails read per timer tick; bounds the time a tick can block the LVGL task. */
+#define LOADS_PER_TICK 2
+#define LOADER_PERIOD_MS 30
+
+#define NO_ID UINT32_MAX
+
+typedef struct {
+    lv_img_dsc_t dsc;  /* data points into s_pool */
+    uint32_t id;       /* catalog item held, NO_ID if free */
+    uint32_t last_use; /* s_tick when it was last on screen */
+} slot_t;
+
+/*
+ * The grid holds a spacer that gives it the height of all rows, and a window
+ * of win_rows * cols tiles, about two screens. Tile row k shows the item row r
+ * of the window with r % win_rows == k, so scrolling by one row re-binds one
+ * row of tiles. The grid's layout callback places each tile at its item's
+ * position: style positions stop at LV_COORD_MAX (8191 px, ~65 rows), object
+ * coordinates and the scroll offset at 32767 px (~260 rows).
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t cols;
+    uint32_t rows;
+    uint32_t win_rows;
+    uint32_t first_row; /* of the window, NO_ID to re-bind every tile */
+    lv_coord_t x0;      /* left edge of column 0, centers the rows */
+    lv_coord_t pitch_x;
+    lv_coord_t pitch_y;
+} layout_t;
+
+static slot_t s_slots[SLOT_NUM];
+static uint8_t *s_pool = NULL;
+static lv_timer_t *s_loader = NULL;
+static uint32_t s_tick;
+static bool s_dirty;
+static layout_t s_lay;
+static uint32_t s_layout_id;
+
+/* Smallest mip shift whose image fits in a tile, 0 if none. */
+static uint8_t pick_level(const ui_catalog_item_t *item)
+{
+    if (!(item->flags & UI_CATALOG_FLAG_MIPS)) return 0;
+    for (uint8_t s = 1; s <= UI_CATALOG_MIP_LEVELS; ++s) {
+        if ((item->img_w >> s) <= TILE_W && (item->img_h >> s) <= TILE_H) return s;
+    }
+    return 0;
+}
+
+/* Tile `i` of the window; child 0 of the grid is the spacer. */
+static lv_obj_t *tile_at(uint32_t i)
+{
+    return lv_obj_get_child(ui_galleryGrid, (int32_t)i + 1);
+}
+
+static uint32_t tile_num(void)
+{
+    return ui_galleryGrid ? lv_obj_get_child_cnt(ui_galleryGrid) - 1 : 0;
+}
+
+static uint32_t tile_id(const lv_obj_t *tile)
+{
+    return (uint32_t)(uintptr_t)lv_obj_get_user_data((lv_obj_t *)tile);
+}
+
+static slot_t *slot_find(uint32_t id)
+{
+    for (int i = 0; i < SLOT_NUM; ++i) {
+        if (s_slots[i].id == id) return &s_slots[i];
+    }
+    return NULL;
+}
+
+static void slot_release(slot_t *slot)
+{
+    if (slot->id == NO_ID) return;
+    for (uint32_t i = 0; i < tile_num(); ++i) {
+        lv_obj_t *img = lv_obj_get_child(tile_at(i), 0);
+        if (lv_img_get_src(img) == &slot->dsc) lv_img_set_src(img, NULL);
+    }
+    lv_img_cache_invalidate_src(&slot->dsc);
+    slot->id = NO_ID;
+}
+
+/* A free slot, or the least recently visible one that is not on screen now. */
+static slot_t *slot_take(void)
+{
+    slot_t *lru = NULL;
+    for (int i = 0; i < SLOT_NUM; ++i) {
+        slot_t *slot = &s_slots[i];
+        if (slot->id == NO_ID) return slot;
+        if (slot->last_use != s_tick && (!lru || slot->last_use < lru->last_use)) lru = slot;
+    }
+    if (lru) slot_release(lru);
+    return lru;
+}
+
+static bool load_thumb(lv_obj_t *img, uint32_t id)
+{
+    ui_catalog_item_t item;
+    if (!ui_catalog_get(id, &item)) return false;
+
+    uint8_t shift = pick_level(&item);
+    char path_S[UI_CATALOG_PATH_MAX + 8];
+    if (!shift || !ui_catalog_mip_path(&item, shift, path_S, sizeof(path_S))) {
+        ESP_LOGW(TAG, "item %u: no mip fits %ux%u", (unsigned)id, TILE_W, TILE_H);
+        return false;
+    }
+
+    slot_t *slot = slot_take();
+    if (!slot) return false; /* every slot is on screen: UI_GALLERY_CACHE_NUM is too small */
+
+    char real[256];
+    ui_img_map_path(real, sizeof(real), path_S);
+
+    lv_img_dsc_t *dsc = &slot->dsc;
+    dsc->header.always_zero = 0;
+    dsc->header.w  = item.img_w >> shift;
+    dsc->header.h  = item.img_h >> shift;
+    dsc->header.cf = LV_IMG_CF_TRUE_COLOR;
+    dsc->data_size = (uint32_t)dsc->header.w * dsc->header.h * sizeof(lv_color_t);
+    if (!ui_asset_read_file(real, (void *)dsc->data, dsc->data_size)) return false;
+
+    /* Same descriptor, new pixels. */
+    lv_img_cache_invalidate_src(dsc);
+    lv_img_set_src(img, dsc);
+    slot->id = id;
+    slot->last_use = s_tick;
+    return true;
+}
+
+static void bind_tile(lv_obj_t *tile, uint32_t id)
+{
+    if (tile_id(tile) == id) return;
+    lv_obj_set_user_data(tile, (void *)(uintptr_t)id);
+
+    lv_obj_t *img = lv_obj_get_child(tile, 0);
+    if (id >= s_lay.count) {
+        lv_img_set_src(img, NULL);
+        lv_obj_add_flag(tile, LV_OBJ_FLAG_HIDDEN);
+        return;
+    }
+    lv_obj_clear_flag(tile, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_mark_layout_as_dirty(ui_galleryGrid);
+    slot_t *slot = slot_find(id);
+    lv_img_set_src(img, slot ? &slot->dsc : NULL);
+    s_dirty = true;
+}
+
+/* Moves the window so that it covers the rows on screen, about half a screen either side. */
+static void bind_window(void)
+{
+    if (!s_lay.win_rows) return;
+    lv_coord_t h = lv_obj_get_content_height(ui_galleryGrid);
+    uint32_t top = (uint32_t)LV_MAX(lv_obj_get_scroll_y(ui_galleryGrid), 0) / s_lay.pitch_y;
+    uint32_t vis = (uint32_t)h / s_lay.pitch_y + 2;
+    uint32_t first = top > (s_lay.win_rows - LV_MIN(vis, s_lay.win_rows)) / 2
+                         ? top - (s_lay.win_rows - LV_MIN(vis, s_lay.win_rows)) / 2
+                         : 0;
+    first = LV_MIN(first, s_lay.rows - s_lay.win_rows);
+    if (first == s_lay.first_row) return;
+    s_lay.first_row = first;
+
+    for (uint32_t k = 0; k < s_lay.win_rows; ++k) {
+        uint32_t row = first + (k + s_lay.win_rows - first % s_lay.win_rows) % s_lay.win_rows;
+        for (uint32_t c = 0; c < s_lay.cols; ++c) bind_tile(tile_at(k * s_lay.cols + c), row * s_lay.cols + c);
+    }
+}
+
+static void tile_event_cb(lv_event_t *e)
+{
+    if (lv_event_get_code(e) == LV_EVENT_SHORT_CLICKED) on_gallery_item_pressed(e);
+}
+
+static lv_obj_t *tile_create(void)
+{
+    lv_obj_t *tile = lv_obj_create(ui_galleryGrid);
+    lv_obj_remove_style_all(tile);
+    lv_obj_set_size(tile, TILE_W, TILE_H);
+    lv_obj_add_flag(tile, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_clear_flag(tile, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_style_radius(tile, 10, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_bg_color(tile, lv_color_hex(0x282828), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_bg_opa(tile, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_outline_color(tile, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_PRESSED);
+    lv_obj_set_style_outline_width(tile, 4, LV_PART_MAIN | LV_STATE_PRESSED);
+    lv_obj_add_event_cb(tile, tile_event_cb, LV_EVENT_SHORT_CLICKED, NULL);
+
+    lv_obj_t *img = lv_img_create(tile);
+    lv_obj_center(img);
+    return tile;
+}
+
+/* Columns, rows and window size for the grid's current size; re-binds every tile. */
+static void relayout(void)
+{
+    lv_obj_t *grid = ui_galleryGrid;
+    lv_coord_t w = lv_obj_get_content_width(grid);
+    lv_coord_t h = lv_obj_get_content_height(grid);
+    lv_coord_t pad_col = lv_obj_get_style_pad_column(grid, LV_PART_MAIN);
+    lv_coord_t pad_row = lv_obj_get_style_pad_row(grid, LV_PART_MAIN);
+
+    layout_t *l = &s_lay;
+    l->count = ui_catalog_count();
+    l->pitch_x = TILE_W + pad_col;
+    l->pitch_y = TILE_H + pad_row;
+    l->cols = (uint32_t)LV_MAX((w + pad_col) / l->pitch_x, 1);
+    l->x0 = (lv_coord_t)LV_MAX((w - (lv_coord_t)l->cols * l->pitch_x + pad_col) / 2, 0);
+    l->rows = (l->count + l->cols - 1) / l->cols;
+    l->win_rows = LV_MIN(2 * ((uint32_t)h / l->pitch_y + 2), l->rows);
+    l->first_row = NO_ID;
+
+    if (lv_obj_get_child_cnt(grid) == 0) {
+        lv_obj_t *spacer = lv_obj_create(grid);
+        lv_obj_remove_style_all(spacer);
+        lv_obj_clear_flag(spacer, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_set_size(spacer, 1, 1);
+    }
+    lv_obj_mark_layout_as_dirty(grid);
+
+    uint32_t want = l->win_rows * l->cols;
+    while (tile_num() > want) lv_obj_del(tile_at(tile_num() - 1));
+    while (tile_num() < want) tile_create();
+    for (uint32_t i = 0; i < want; ++i) bind_tile(tile_at(i), NO_ID);
+    bind_window();
+}
+
+static void grid_layout_cb(lv_obj_t *grid, void *user_data)
+{
+    (void)user_data;
+    if (!s_lay.cols || lv_obj_get_child_cnt(grid) == 0) return;
+
+    lv_coord_t pad_row = lv_obj_get_style_pad_row(grid, LV_PART_MAIN);
+    lv_obj_move_to(lv_obj_get_child(grid, 0), 0, LV_MAX((lv_coord_t)s_lay.rows * s_lay.pitch_y - pad_row - 1, 0));
+    for (uint32_t i = 0; i < tile_num(); ++i) {
+        lv_obj_t *tile = tile_at(i);
+        uint32_t id = tile_id(tile);
+        if (id >= s_lay.count) continue;
+        lv_obj_move_to(tile, s_lay.x0 + (lv_coord_t)(id % s_lay.cols) * s_lay.pitch_x,
+                       (lv_coord_t)(id / s_lay.cols) * s_lay.pitch_y);
+    }
+}
+
+static void loader_cb(lv_timer_t *t)
+{
+    (void)t;
+    if (!s_dirty || !ui_galleryGrid || !s_lay.win_rows) return;
+
+    /* Rows within one row of the viewport are loaded ahead of time. */
+    lv_coord_t top = lv_obj_get_scroll_y(ui_galleryGrid) - s_lay.pitch_y;
+    lv_coord_t bottom = top + lv_obj_get_content_height(ui_galleryGrid) + 2 * s_lay.pitch_y;
+    uint32_t row_first = LV_MAX(s_lay.first_row, (uint32_t)LV_MAX(top, 0) / s_lay.pitch_y);
+    uint32_t row_last = LV_MIN(s_lay.first_row + s_lay.win_rows, (uint32_t)LV_MAX(bottom, 0) / s_lay.pitch_y + 1);
+
+    s_tick++;
+    uint32_t loads = 0;
+    bool pending = false;
+    for (uint32_t row = row_first; row < row_last; ++row) {
+        for (uint32_t c = 0; c < s_lay.cols; ++c) {
+            lv_obj_t *tile = tile_at((row % s_lay.win_rows) * s_lay.cols + c);
+            uint32_t id = tile_id(tile);
+            if (id >= s_lay.count) continue;
+
+            lv_obj_t *img = lv_obj_get_child(tile, 0);
+            slot_t *slot = slot_find(id);
+            if (slot) {
+                slot->last_use = s_tick;
+            } else if (loads < LOADS_PER_TICK) {
+                if (load_thumb(img, id)) loads++;
+            } else {
+                pending = true;
+            }
+        }
+    }
+    s_dirty = pending;
+}
+
+static void grid_event_cb(lv_event_t *e)
+{
+    if (lv_event_get_code(e) == LV_EVENT_SIZE_CHANGED) {
+        relayout();
+    } else {
+        bind_window();
+    }
+    s_dirty = true;
+}
+
+void ui_gallery_open(uint32_t current)
+{
+    if (!ui_Screen3) {
+        ui_Screen3_screen_init();
+        if (!s_layout_id) s_layout_id = lv_layout_register(grid_layout_cb, NULL);
+        lv_obj_set_layout(ui_galleryGrid, s_layout_id);
+        lv_obj_add_event_cb(ui_galleryGrid, grid_event_cb, LV_EVENT_SCROLL, NULL);
+        lv_obj_add_event_cb(ui_galleryGrid, grid_event_cb, LV_EVENT_SIZE_CHANGED, NULL);
+    }
+
+    if (!s_pool) {
+        s_pool = (uint8_t *)heap_caps_malloc((size_t)SLOT_BYTES * SLOT_NUM, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (!s_pool) {
+            ESP_LOGE(TAG, "heap_caps_malloc(%u) failed", (unsigned)(SLOT_BYTES * SLOT_NUM));
+            return;
+        }
+        for (int i = 0; i < SLOT_NUM; ++i) {
+            memset(&s_slots[i], 0, sizeof(s_slots[i]));
+            s_slots[i].dsc.data = s_pool + (size_t)i * SLOT_BYTES;
+            s_slots[i].id = NO_ID;
+        }
+        s_tick = 0;
+    }
+
+    lv_obj_update_layout(ui_Screen3);
+    relayout();
+    if (s_lay.cols) lv_obj_scroll_to_y(ui_galleryGrid, (lv_coord_t)(current / s_lay.cols) * s_lay.pitch_y, LV_ANIM_OFF);
+    bind_window();
+
+    s_dirty = true;
+    if (!s_loader) s_loader = lv_timer_create(loader_cb, LOADER_PERIOD_MS, NULL);
+    lv_disp_load_scr(ui_Screen3);
+}
+
+void ui_gallery_close(void)
+{
+    if (s_loader) {
+        lv_timer_del(s_loader);
+        s_loader = NULL;
+    }
+    for (int i = 0; i < SLOT_NUM; ++i) slot_release(&s_slots[i]);
+
+    heap_caps_free(s_pool);
+    s_pool = NULL;
+}
+
+uint32_t ui_gallery_item_of(const lv_obj_t *tile)
+{
+    return tile_id(tile);
+}
@@ -4,6 +4,7 @@
 // Project name: TTSimg
 
 #include "ui_helpers.h"
+#include "ui_screen_cache.h"
 
 void _ui_bar_set_property(lv_obj_t * target, int id, int val)
 {
@@ -53,7 +54,7 @@ void _ui_screen_change(lv_obj_t ** target, lv_scr_load_anim_t fademode, int spd,
 {
     if(*target == NULL)
         target_init();
-    lv_scr_load_anim(*target, fademode, spd, delay, false);
+    ui_screen_cache_load(*target, fademode, spd, delay);
 }
 
 void _ui_screen_delete(lv_obj_t ** target)
@@ -7,15 +7,18 @@
 
 
 // IMAGE DATA: assets/icons8-next-55.png
+// Black glyph on transparent background: packed as 2-bit alpha by tools/asset_packer.py
+// (source: catalog/src/ui_img_1049104300.bin), drawn in the img_recolor color (black).
 lv_img_dsc_t ui_img_1049104300 = {
     .header.always_zero = 0,
     .header.w = 55,
     .header.h = 55,
-    .header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA,
+    .header.cf = LV_IMG_CF_ALPHA_2BIT,
 };
 
 void ui_img_1049104300_load()
 {
-    ui_img_1049104300.data = UI_LOAD_IMAGE("S:assets/ui_img_1049104300.bin", 9075);
-    ui_img_1049104300.data_size = 9075;
+    ui_img_1049104300.header.reserved = UI_LOAD_IMAGE_RESERVED;
+    ui_img_1049104300.data = UI_LOAD_IMAGE("S:assets/ui_img_1049104300.bin", 770);
+    ui_img_1049104300.data_size = 770;
 }
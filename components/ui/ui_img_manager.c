@@ -1,16 +1,39 @@
+#include <stdatomic.h>
 #include <stdio.h>
 #include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
 #include "esp_log.h"
 #include "esp_heap_caps.h"
+#include "ui_img_manager.h"
+#include "ui_img_stream.h"
+#include "ui_asset_reader.h"
+#include "asset_fs.h"
 
 static const char *TAG = "UIIMG";
 
-static void map_path(char *dst, size_t dst_sz, const char *src)
+#define LOAD_TASK_STACK (3 * 1024)
+#define LOAD_TASK_PRIO  2
+/* A preview and a full image, plus the two of a case cancelled while queued */
+#define LOAD_QUEUE_LEN  4
+
+/* Whoever moves a job out of JOB_LOADING owns it afterwards. */
+enum { JOB_LOADING, JOB_DONE, JOB_ABANDONED };
+
+struct ui_img_job {
+    atomic_int state;
+    uint32_t size;
+    uint8_t* buf; /* NULL after a failed read */
+    char real[256];
+};
+
+static QueueHandle_t s_load_q = NULL;
+
+void ui_img_map_path(char *dst, size_t dst_sz, const char *src)
 {
     if (src && src[0] == 'S' && src[1] == ':') {
-        const char *p = src + 2;   
-        if (*p == '/') p++;        
-        snprintf(dst, dst_sz, "/spiffs/%s", p); 
+        asset_fs_path(dst, dst_sz, src + 2);
     } else {
         snprintf(dst, dst_sz, "%s", src ? src : "");
     }
@@ -19,31 +42,126 @@ static void map_path(char *dst, size_t dst_sz, const char *src)
 uint8_t* _ui_load_binary_direct(const char* fname_S, uint32_t size)
 {
     char real[256];
-    map_path(real, sizeof(real), fname_S);
+    ui_img_map_path(real, sizeof(real), fname_S);
 
     ESP_LOGI(TAG, "load %s (%u bytes)", real, (unsigned)size);
 
-    FILE *fp = fopen(real, "rb");
-    if (!fp) {
-        ESP_LOGE(TAG, "fopen failed: %s", real);
-        return NULL;
-    }
-
     uint8_t *buf = (uint8_t*)heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
     if (!buf) {
         ESP_LOGE(TAG, "heap_caps_malloc(%u) failed", (unsigned)size);
-        fclose(fp);
         return NULL;
     }
 
-    size_t rd = fread(buf, 1, size, fp);
-    fclose(fp);
-
-    if (rd != size) {
-        ESP_LOGE(TAG, "fread short: %u/%u", (unsigned)rd, (unsigned)size);
+    if (!ui_asset_read_file(real, buf, size)) {
         heap_caps_free(buf);
         return NULL;
     }
 
     return buf;
 }
+
+uint8_t* _ui_load_binary_stream(const char* fname_S, uint32_t size)
+{
+    char real[256];
+    ui_img_map_path(real, sizeof(real), fname_S);
+
+    ESP_LOGI(TAG, "stream %s (%u bytes)", real, (unsigned)size);
+
+    ui_img_stream_tag_t *tag = ui_img_stream_tag_create(real, size);
+    if (!tag) {
+        ESP_LOGE(TAG, "stream tag alloc failed: %s", real);
+    }
+    return (uint8_t*)tag;
+}
+
+static void job_free(ui_img_job_t* job)
+{
+    heap_caps_free(job->buf);
+    heap_caps_free(job);
+}
+
+static bool job_abandoned(void* arg)
+{
+    return atomic_load(&((ui_img_job_t*)arg)->state) == JOB_ABANDONED;
+}
+
+static void load_task(void* arg)
+{
+    (void)arg;
+    ui_img_job_t* job;
+    for (;;) {
+        xQueueReceive(s_load_q, &job, portMAX_DELAY);
+
+        /* Skip jobs cancelled while still queued. */
+        if (atomic_load(&job->state) == JOB_LOADING) {
+            job->buf = (uint8_t*)heap_caps_malloc(job->size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+            if (!job->buf) {
+                ESP_LOGE(TAG, "heap_caps_malloc(%u) failed", (unsigned)job->size);
+            } else if (!ui_asset_read_file_cancellable(job->real, job->buf, job->size, job_abandoned, job)) {
+                heap_caps_free(job->buf);
+                job->buf = NULL;
+            }
+        }
+
+        int expected = JOB_LOADING;
+        if (!atomic_compare_exchange_strong(&job->state, &expected, JOB_DONE)) job_free(job);
+    }
+}
+
+static bool load_task_init(void)
+{
+    if (s_load_q) return true;
+
+    QueueHandle_t q = xQueueCreate(LOAD_QUEUE_LEN, sizeof(ui_img_job_t*));
+    if (!q) return false;
+
+#if CONFIG_FREERTOS_UNICORE
+    BaseType_t core = tskNO_AFFINITY;
+#else
+    BaseType_t core = xPortGetCoreID() ^ 1;
+#endif
+    s_load_q = q;
+    if (xTaskCreatePinnedToCore(load_task, "img_load", LOAD_TASK_STACK, NULL, LOAD_TASK_PRIO, NULL, core) != pdPASS) {
+        ESP_LOGE(TAG, "loader task create failed");
+        vQueueDelete(q);
+        s_load_q = NULL;
+        return false;
+    }
+    return true;
+}
+
+ui_img_job_t* ui_img_load_async(const char* fname_S, uint32_t size, bool first)
+{
+    if (!load_task_init()) return NULL;
+
+    ui_img_job_t* job = (ui_img_job_t*)heap_caps_calloc(1, sizeof(*job), MALLOC_CAP_8BIT);
+    if (!job) return NULL;
+    atomic_init(&job->state, JOB_LOADING);
+    job->size = size;
+    ui_img_map_path(job->real, sizeof(job->real), fname_S);
+
+    ESP_LOGI(TAG, "load %s (%u bytes) in background%s", job->real, (unsigned)size, first ? ", first" : "");
+
+    BaseType_t queued = first ? xQueueSendToFront(s_load_q, &job, 0) : xQueueSendToBack(s_load_q, &job, 0);
+    if (queued != pdTRUE) {
+        ESP_LOGW(TAG, "loader busy: %s", job->real);
+        heap_caps_free(job);
+        return NULL;
+    }
+    return job;
+}
+
+bool ui_img_job_poll(ui_img_job_t* job, uint8_t** data)
+{
+    if (atomic_load(&job->state) != JOB_DONE) return false;
+    *data = job->buf;
+    heap_caps_free(job);
+    return true;
+}
+
+void ui_img_job_cancel(ui_img_job_t* job)
+{
+    if (!job) return;
+    int expected = JOB_LOADING;
+    if (!atomic_compare_exchange_strong(&job->state, &expected, JOB_ABANDONED)) job_free(job);
+}
@@ -0,0 +1,439 @@
+#include "ui_img_stream.h"
+#include "sdkconfig.h"
+#include "lvgl.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "UISTRM";
+
+#ifdef CONFIG_UI_IMG_STREAM_BLOCK_KB
+#define STREAM_BLOCK_SIZE  (CONFIG_UI_IMG_STREAM_BLOCK_KB * 1024)
+#define STREAM_BLOCK_NUM   CONFIG_UI_IMG_STREAM_BLOCK_NUM
+#define STREAM_READ_AHEAD  CONFIG_UI_IMG_STREAM_READ_AHEAD
+#else
+#define STREAM_BLOCK_SIZE  (8 * 1024)
+#define STREAM_BLOCK_NUM   4
+#define STREAM_READ_AHEAD  1
+#endif
+
+#if STREAM_READ_AHEAD >= STREAM_BLOCK_NUM
+#error "UI_IMG_STREAM_READ_AHEAD must be smaller than UI_IMG_STREAM_BLOCK_NUM"
+#endif
+
+typedef struct {
+    uint32_t id;      /* tag id, 0 = empty */
+    uint32_t index;   /* block index inside the file */
+    uint32_t len;     /* valid bytes */
+    uint32_t stamp;   /* LRU stamp */
+    uint8_t *data;
+} stream_block_t;
+
+/* One cache and one open file for the whole decoder: only a couple of streamed
+ * images are on screen at once, so this keeps RAM bounded regardless of how many
+ * decoder descriptors LVGL opens. */
+static stream_block_t s_blocks[STREAM_BLOCK_NUM];
+static uint8_t *s_block_mem = NULL;
+static uint32_t s_stamp = 0;
+static uint32_t s_next_id = 1;
+
+static FILE *s_fp = NULL;
+static uint32_t s_fp_id = 0;
+static uint32_t s_fp_pos = 0;
+
+static ui_img_stream_stats_t s_stats;
+
+/* Per open descriptor. Palette formats keep their converted palette here. */
+typedef struct {
+    const ui_img_stream_tag_t *tag;
+    uint32_t data_off; /* first pixel byte (after the palette) */
+    lv_color_t *palette;
+    lv_opa_t *palette_opa;
+} stream_dsc_t;
+
+static bool cf_supported(lv_img_cf_t cf)
+{
+    switch (cf) {
+    case LV_IMG_CF_TRUE_COLOR:
+    case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+    case LV_IMG_CF_TRUE_COLOR_ALPHA:
+    case LV_IMG_CF_RGB565A8:
+    case LV_IMG_CF_INDEXED_1BIT:
+    case LV_IMG_CF_INDEXED_2BIT:
+    case LV_IMG_CF_INDEXED_4BIT:
+    case LV_IMG_CF_INDEXED_8BIT:
+    case LV_IMG_CF_ALPHA_1BIT:
+    case LV_IMG_CF_ALPHA_2BIT:
+    case LV_IMG_CF_ALPHA_4BIT:
+    case LV_IMG_CF_ALPHA_8BIT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static uint32_t cf_bits(lv_img_cf_t cf)
+{
+    switch (cf) {
+    case LV_IMG_CF_INDEXED_1BIT:
+    case LV_IMG_CF_ALPHA_1BIT:
+        return 1;
+    case LV_IMG_CF_INDEXED_2BIT:
+    case LV_IMG_CF_ALPHA_2BIT:
+        return 2;
+    case LV_IMG_CF_INDEXED_4BIT:
+    case LV_IMG_CF_ALPHA_4BIT:
+        return 4;
+    default:
+        return 8;
+    }
+}
+
+static const ui_img_stream_tag_t* tag_from_src(const void *src)
+{
+    if (lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE) return NULL;
+    const lv_img_dsc_t *img = (const lv_img_dsc_t*)src;
+    if (img->header.reserved != UI_IMG_STREAM_RESERVED || !ui_img_stream_is_tag(img->data)) return NULL;
+    return (const ui_img_stream_tag_t*)img->data;
+}
+
+static bool cache_alloc(void)
+{
+    if (s_block_mem) return true;
+
+    size_t total = (size_t)STREAM_BLOCK_SIZE * STREAM_BLOCK_NUM;
+    s_block_mem = (uint8_t*)heap_caps_malloc(total, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!s_block_mem) {
+        s_block_mem = (uint8_t*)heap_caps_malloc(total, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    }
+    if (!s_block_mem) {
+        ESP_LOGE(TAG, "block cache alloc(%u) failed", (unsigned)total);
+        return false;
+    }
+
+    for (int i = 0; i < STREAM_BLOCK_NUM; ++i) {
+        s_blocks[i].id   = 0;
+        s_blocks[i].data = s_block_mem + (size_t)i * STREAM_BLOCK_SIZE;
+    }
+    s_stats.cache_bytes = total;
+    ESP_LOGI(TAG, "block cache: %d x %u bytes", STREAM_BLOCK_NUM, (unsigned)STREAM_BLOCK_SIZE);
+    return true;
+}
+
+static bool file_select(const ui_img_stream_tag_t *tag)
+{
+    if (s_fp && s_fp_id == tag->id) return true;
+
+    if (s_fp) fclose(s_fp);
+    s_fp_id = 0;
+    s_fp = fopen(tag->path, "rb");
+    if (!s_fp) {
+        ESP_LOGE(TAG, "fopen failed: %s", tag->path);
+        return false;
+    }
+    /* Blocks are read whole, stdio buffering would only add a copy. */
+    setvbuf(s_fp, NULL, _IONBF, 0);
+    s_fp_id  = tag->id;
+    s_fp_pos = 0;
+    return true;
+}
+
+static stream_block_t* block_victim(void)
+{
+    stream_block_t *victim = &s_blocks[0];
+    for (int i = 0; i < STREAM_BLOCK_NUM; ++i) {
+        if (s_blocks[i].id == 0) return &s_blocks[i];
+        if (s_blocks[i].stamp < victim->stamp) victim = &s_blocks[i];
+    }
+    return victim;
+}
+
+static stream_block_t* block_find(uint32_t id, uint32_t index)
+{
+    for (int i = 0; i < STREAM_BLOCK_NUM; ++i) {
+        if (s_blocks[i].id == id && s_blocks[i].index == index) return &s_blocks[i];
+    }
+    return NULL;
+}
+
+static bool block_fill(stream_block_t *b, const ui_img_stream_tag_t *tag, uint32_t index)
+{
+    uint32_t off = index * STREAM_BLOCK_SIZE;
+    uint32_t len = tag->size - off;
+    if (len > STREAM_BLOCK_SIZE) len = STREAM_BLOCK_SIZE;
+
+    if (s_fp_pos != off && fseek(s_fp, (long)off, SEEK_SET) != 0) {
+        ESP_LOGE(TAG, "fseek(%u) failed", (unsigned)off);
+        return false;
+    }
+
+    int64_t t0 = esp_timer_get_time();
+    size_t rd  = fread(b->data, 1, len, s_fp);
+    s_stats.read_us += (uint32_t)(esp_timer_get_time() - t0);
+
+    s_fp_pos = off + (uint32_t)rd;
+    if (rd != len) {
+        ESP_LOGE(TAG, "fread short: %u/%u", (unsigned)rd, (unsigned)len);
+        b->id = 0;
+        return false;
+    }
+
+    b->id    = tag->id;
+    b->index = index;
+    b->len   = len;
+    b->stamp = ++s_stamp;
+    s_stats.bytes_read += len;
+    return true;
+}
+
+static stream_block_t* block_get(const ui_img_stream_tag_t *tag, uint32_t index)
+{
+    stream_block_t *b = block_find(tag->id, index);
+    if (b) {
+        b->stamp = ++s_stamp;
+        s_stats.block_hits++;
+        return b;
+    }
+
+    s_stats.block_misses++;
+    b = block_victim();
+    if (!block_fill(b, tag, index)) return NULL;
+
+    /* Rows are requested top to bottom, so the next blocks are almost always
+     * needed next. Reading them now keeps the file position sequential. */
+    uint32_t last = (tag->size - 1) / STREAM_BLOCK_SIZE;
+    for (uint32_t i = 1; i <= STREAM_READ_AHEAD && index + i <= last; ++i) {
+        if (block_find(tag->id, index + i)) continue;
+        stream_block_t *ra = block_victim();
+        if (ra == b) break;
+        if (!block_fill(ra, tag, index + i)) break;
+        /* Keep read-ahead blocks older than the one being served. */
+        ra->stamp = b->stamp - 1;
+    }
+    b->stamp = ++s_stamp;
+    return b;
+}
+
+/* Copy `len` bytes at file offset `off` through the block cache. */
+static bool stream_read(const ui_img_stream_tag_t *tag, uint32_t off, uint8_t *dst, uint32_t len)
+{
+    if (off + len > tag->size) return false;
+
+    while (len) {
+        stream_block_t *b = block_get(tag, off / STREAM_BLOCK_SIZE);
+        if (!b) return false;
+
+        uint32_t in_blk = off % STREAM_BLOCK_SIZE;
+        uint32_t n      = b->len - in_blk;
+        if (n > len) n = len;
+
+        memcpy(dst, b->data + in_blk, n);
+        dst += n;
+        off += n;
+        len -= n;
+    }
+    return true;
+}
+
+static bool palette_load(stream_dsc_t *sd, lv_img_cf_t cf)
+{
+    uint32_t entries = 1u << cf_bits(cf);
+    lv_color32_t raw[256];
+    if (!stream_read(sd->tag, 0, (uint8_t*)raw, entries * sizeof(lv_color32_t))) return false;
+
+    sd->palette     = lv_mem_alloc(entries * sizeof(lv_color_t));
+    sd->palette_opa = lv_mem_alloc(entries * sizeof(lv_opa_t));
+    if (!sd->palette || !sd->palette_opa) return false;
+
+    for (uint32_t i = 0; i < entries; ++i) {
+        sd->palette[i]     = lv_color_make(raw[i].ch.red, raw[i].ch.green, raw[i].ch.blue);
+        sd->palette_opa[i] = raw[i].ch.alpha;
+    }
+    sd->data_off = entries * sizeof(lv_color32_t);
+    return true;
+}
+
+static void stream_dsc_free(stream_dsc_t *sd)
+{
+    if (!sd) return;
+    if (sd->palette) lv_mem_free(sd->palette);
+    if (sd->palette_opa) lv_mem_free(sd->palette_opa);
+    lv_mem_free(sd);
+}
+
+static inline void put_px(uint8_t *out, lv_color_t c, lv_opa_t opa)
+{
+#if LV_COLOR_DEPTH == 32
+    memcpy(out, &c, sizeof(c));
+    out[3] = opa;
+#else
+    memcpy(out, &c, sizeof(c));
+    out[sizeof(c)] = opa;
+#endif
+}
+
+/* Sub-byte and palette formats: expand to color + alpha bytes like the built-in decoder. */
+static bool read_line_packed(stream_dsc_t *sd, const lv_img_decoder_dsc_t *dsc, lv_coord_t x, lv_coord_t y,
+                             lv_coord_t len, uint8_t *buf)
+{
+    lv_img_cf_t cf   = dsc->header.cf;
+    uint32_t bits    = cf_bits(cf);
+    uint32_t stride  = ((uint32_t)dsc->header.w * bits + 7) >> 3;
+    uint32_t first   = ((uint32_t)x * bits) >> 3;
+    uint32_t last    = ((uint32_t)(x + len - 1) * bits) >> 3;
+    uint32_t nbytes  = last - first + 1;
+    uint32_t out_px  = LV_IMG_PX_SIZE_ALPHA_BYTE;
+
+    /* Packed bytes go to the tail of `buf`; expansion front to back never overtakes them. */
+    uint8_t *packed = buf + (uint32_t)len * out_px - nbytes;
+    if (!stream_read(sd->tag, sd->data_off + (uint32_t)y * stride + first, packed, nbytes)) return false;
+
+    bool is_alpha  = cf >= LV_IMG_CF_ALPHA_1BIT && cf <= LV_IMG_CF_ALPHA_8BIT;
+    uint32_t mask  = (1u << bits) - 1;
+    uint32_t bit0  = (uint32_t)x * bits;
+
+    for (lv_coord_t i = 0; i < len; ++i) {
+        uint32_t bit   = bit0 + (uint32_t)i * bits;
+        uint32_t byte  = (bit >> 3) - first;
+        uint32_t shift = 8 - bits - (bit & 7);
+        uint32_t v     = (packed[byte] >> shift) & mask;
+
+        if (is_alpha) {
+            put_px(buf + (uint32_t)i * out_px, dsc->color, (lv_opa_t)(v * 255 / mask));
+        } else {
+            put_px(buf + (uint32_t)i * out_px, sd->palette[v], sd->palette_opa[v]);
+        }
+    }
+    return true;
+}
+
+static lv_res_t stream_info(lv_img_decoder_t *decoder, const void *src, lv_img_header_t *header)
+{
+    (void)decoder;
+    if (!tag_from_src(src)) return LV_RES_INV;
+
+    const lv_img_dsc_t *img = (const lv_img_dsc_t*)src;
+    if (!cf_supported(img->header.cf)) return LV_RES_INV;
+
+    *header = img->header;
+    return LV_RES_OK;
+}
+
+static lv_res_t stream_open(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc)
+{
+    (void)decoder;
+    const ui_img_stream_tag_t *tag = tag_from_src(dsc->src);
+    if (!tag) return LV_RES_INV;
+    if (!cache_alloc()) return LV_RES_INV;
+    if (!file_select(tag)) return LV_RES_INV;
+
+    stream_dsc_t *sd = lv_mem_alloc(sizeof(*sd));
+    if (!sd) return LV_RES_INV;
+    memset(sd, 0, sizeof(*sd));
+    sd->tag = tag;
+
+    lv_img_cf_t cf = dsc->header.cf;
+    if (cf >= LV_IMG_CF_INDEXED_1BIT && cf <= LV_IMG_CF_INDEXED_8BIT && !palette_load(sd, cf)) {
+        ESP_LOGE(TAG, "palette read failed: %s", tag->path);
+        stream_dsc_free(sd);
+        return LV_RES_INV;
+    }
+
+    s_stats.opens++;
+    /* No full image in memory: LVGL falls back to read_line. */
+    dsc->img_data  = NULL;
+    dsc->user_data = sd;
+    return LV_RES_OK;
+}
+
+static lv_res_t stream_read_line(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc, lv_coord_t x, lv_coord_t y,
+                                 lv_coord_t len, uint8_t *buf)
+{
+    (void)decoder;
+    stream_dsc_t *sd = (stream_dsc_t*)dsc->user_data;
+    if (!sd || !file_select(sd->tag)) return LV_RES_INV;
+
+    lv_img_cf_t cf = dsc->header.cf;
+    uint32_t w     = dsc->header.w;
+    uint32_t pos   = (uint32_t)y * w + (uint32_t)x;
+    bool ok;
+
+    switch (cf) {
+    case LV_IMG_CF_TRUE_COLOR:
+    case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+    case LV_IMG_CF_TRUE_COLOR_ALPHA:
+    case LV_IMG_CF_ALPHA_8BIT: {
+        uint32_t px = lv_img_cf_get_px_size(cf) >> 3;
+        ok = stream_read(sd->tag, pos * px, buf, (uint32_t)len * px);
+        break;
+    }
+    case LV_IMG_CF_RGB565A8:
+        /* One line drawn as a 1-pixel-high RGB565A8 image: colors, then the alpha plane. */
+        ok = stream_read(sd->tag, pos * sizeof(lv_color_t), buf, (uint32_t)len * sizeof(lv_color_t)) &&
+             stream_read(sd->tag, w * dsc->header.h * sizeof(lv_color_t) + pos,
+                         buf + (uint32_t)len * sizeof(lv_color_t), (uint32_t)len);
+        break;
+    default:
+        ok = read_line_packed(sd, dsc, x, y, len, buf);
+        break;
+    }
+    if (!ok) return LV_RES_INV;
+
+    s_stats.lines++;
+    return LV_RES_OK;
+}
+
+static void stream_close(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc)
+{
+    (void)decoder;
+    /* File and blocks stay cached for the next open of the same image. */
+    stream_dsc_free((stream_dsc_t*)dsc->user_data);
+    dsc->user_data = NULL;
+}
+
+void ui_img_stream_init(void)
+{
+    lv_img_decoder_t *dec = lv_img_decoder_create();
+    if (!dec) {
+        ESP_LOGE(TAG, "lv_img_decoder_create failed");
+        return;
+    }
+    lv_img_decoder_set_info_cb(dec, stream_info);
+    lv_img_decoder_set_open_cb(dec, stream_open);
+    lv_img_decoder_set_read_line_cb(dec, stream_read_line);
+    lv_img_decoder_set_close_cb(dec, stream_close);
+}
+
+ui_img_stream_tag_t* ui_img_stream_tag_create(const char *real_path, uint32_t size)
+{
+    size_t plen = strlen(real_path) + 1;
+    ui_img_stream_tag_t *tag = (ui_img_stream_tag_t*)heap_caps_malloc(sizeof(*tag) + plen, MALLOC_CAP_8BIT);
+    if (!tag) return NULL;
+
+    tag->magic = UI_IMG_STREAM_MAGIC;
+    tag->id    = s_next_id++;
+    tag->check = UI_IMG_STREAM_MAGIC ^ tag->id;
+    tag->size  = size;
+    memcpy(tag->path, real_path, plen);
+    return tag;
+}
+
+bool ui_img_stream_is_tag(const void *data)
+{
+    const ui_img_stream_tag_t *tag = (const ui_img_stream_tag_t*)data;
+    return tag && tag->magic == UI_IMG_STREAM_MAGIC && tag->check == (UI_IMG_STREAM_MAGIC ^ tag->id);
+}
+
+void ui_img_stream_get_stats(ui_img_stream_stats_t *out)
+{
+    if (out) *out = s_stats;
+}
+
+void ui_img_stream_reset_stats(void)
+{
+    uint32_t cache_bytes = s_stats.cache_bytes;
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_stats.cache_bytes = cache_bytes;
+}
@@ -0,0 +1,361 @@
+#include "ui_jpeg.h"
+#include "ui_img_manager.h"
+#include "ui_asset_reader.h"
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "extra/libs/sjpg/tjpgd.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+static const char *TAG = "UIJPEG";
+
+#if LV_USE_SJPG
+
+#define JPEG_WORK_SIZE   4096 /* tjpgd work pool, as recommended by the library */
+#define JPEG_TASK_STACK  (4 * 1024)
+#define JPEG_TASK_PRIO   5
+#define JPEG_MAX_STRIPS  256
+
+/* lv_sjpg.c header layout */
+#define SJPG_MAGIC          "_SJPG__"
+#define SJPG_X_RES_OFFSET   14
+#define SJPG_FRAMES_OFFSET  18
+#define SJPG_BLOCK_H_OFFSET 20
+#define SJPG_SIZES_OFFSET   22
+
+typedef struct {
+    const uint8_t *data;
+    uint32_t size;
+    uint16_t y0;
+} jpeg_strip_t;
+
+typedef struct {
+    jpeg_strip_t strips[JPEG_MAX_STRIPS];
+    int count;
+    uint16_t w;
+    uint16_t h;
+    lv_color_t *dst;
+    atomic_int next;
+    atomic_bool failed;
+} jpeg_job_t;
+
+/* One decode session of one worker. */
+typedef struct {
+    const jpeg_strip_t *strip;
+    uint32_t pos;
+    const jpeg_job_t *job;
+} jpeg_io_t;
+
+static SemaphoreHandle_t s_lock = NULL;
+static SemaphoreHandle_t s_start = NULL;
+static SemaphoreHandle_t s_done = NULL;
+static TaskHandle_t s_helper = NULL;
+static jpeg_job_t *s_job = NULL;
+static uint8_t *s_work[2];
+
+static ui_jpeg_stats_t s_stats;
+
+static size_t jpeg_in(JDEC *jd, uint8_t *buf, size_t n)
+{
+    jpeg_io_t *io = (jpeg_io_t*)jd->device;
+    uint32_t left = io->strip->size - io->pos;
+    if (n > left) n = left;
+    if (buf) memcpy(buf, io->strip->data + io->pos, n);
+    io->pos += n;
+    return n;
+}
+
+/* tjpgd is configured for RGB888 output (JD_FORMAT 0, shared with lv_sjpg.c). */
+static int jpeg_out(JDEC *jd, void *bitmap, JRECT *rect)
+{
+    jpeg_io_t *io        = (jpeg_io_t*)jd->device;
+    const jpeg_job_t *jb = io->job;
+    const uint8_t *src   = (const uint8_t*)bitmap;
+
+    for (int y = rect->top; y <= rect->bottom; ++y) {
+        int dy = io->strip->y0 + y;
+        if (dy >= jb->h) return 0;
+        lv_color_t *d = jb->dst + (uint32_t)dy * jb->w + rect->left;
+        for (int x = rect->left; x <= rect->right; ++x, src += 3) {
+            *d++ = lv_color_make(src[0], src[1], src[2]);
+        }
+    }
+    return 1;
+}
+
+static bool decode_strip(const jpeg_job_t *job, const jpeg_strip_t *strip, uint8_t *work)
+{
+    JDEC jd;
+    jpeg_io_t io = { .strip = strip, .pos = 0, .job = job };
+
+    JRESULT rc = jd_prepare(&jd, jpeg_in, work, JPEG_WORK_SIZE, &io);
+    if (rc == JDR_OK) {
+        if (jd.width != job->w || strip->y0 + jd.height > job->h) {
+            ESP_LOGE(TAG, "strip at row %u is %ux%u, image is %ux%u", strip->y0, jd.width, jd.height, job->w,
+                     job->h);
+            return false;
+        }
+        rc = jd_decomp(&jd, jpeg_out, 0);
+    }
+    if (rc != JDR_OK) {
+        ESP_LOGE(TAG, "strip at row %u: tjpgd error %d", strip->y0, (int)rc);
+        return false;
+    }
+    return true;
+}
+
+/* Workers pull strips until none is left, so a slow strip on one core never idles the other. */
+static void run_worker(jpeg_job_t *job, uint8_t *work)
+{
+    for (;;) {
+        int i = atomic_fetch_add(&job->next, 1);
+        if (i >= job->count || atomic_load(&job->failed)) break;
+        if (!decode_strip(job, &job->strips[i], work)) atomic_store(&job->failed, true);
+    }
+}
+
+static void helper_task(void *arg)
+{
+    (void)arg;
+    for (;;) {
+        xSemaphoreTake(s_start, portMAX_DELAY);
+        run_worker(s_job, s_work[1]);
+        xSemaphoreGive(s_done);
+    }
+}
+
+/* Frees what jpeg_init() created, so a failed init leaves nothing behind and the next call starts over. */
+static void jpeg_free(void)
+{
+    if (s_helper) {
+        vTaskDelete(s_helper);
+        s_helper = NULL;
+    }
+    if (s_start) {
+        vSemaphoreDelete(s_start);
+        s_start = NULL;
+    }
+    if (s_done) {
+        vSemaphoreDelete(s_done);
+        s_done = NULL;
+    }
+    for (int i = 0; i < 2; ++i) {
+        heap_caps_free(s_work[i]);
+        s_work[i] = NULL;
+    }
+}
+
+/* s_lock is created last: once it exists, everything else does. */
+static bool jpeg_init(void)
+{
+    if (s_lock) return true;
+
+    for (int i = 0; i < 2; ++i) {
+        s_work[i] = (uint8_t*)heap_caps_malloc(JPEG_WORK_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (!s_work[i]) {
+            ESP_LOGE(TAG, "work buffer alloc failed");
+            goto fail;
+        }
+    }
+    s_start = xSemaphoreCreateBinary();
+    s_done  = xSemaphoreCreateBinary();
+    if (!s_start || !s_done) goto fail;
+
+#if CONFIG_FREERTOS_UNICORE
+    BaseType_t core = tskNO_AFFINITY;
+#else
+    BaseType_t core = xPortGetCoreID() ^ 1;
+#endif
+    if (xTaskCreatePinnedToCore(helper_task, "jpeg_dec", JPEG_TASK_STACK, NULL, JPEG_TASK_PRIO, &s_helper, core) !=
+        pdPASS) {
+        ESP_LOGE(TAG, "helper task create failed");
+        s_helper = NULL;
+        goto fail;
+    }
+
+    s_lock = xSemaphoreCreateMutex();
+    if (s_lock) return true;
+
+fail:
+    jpeg_free();
+    return false;
+}
+
+static bool parse_strips(jpeg_job_t *job, const uint8_t *data, uint32_t size)
+{
+    if (size > SJPG_SIZES_OFFSET && memcmp(data, SJPG_MAGIC, sizeof(SJPG_MAGIC)) == 0) {
+        uint16_t w       = data[SJPG_X_RES_OFFSET] | data[SJPG_X_RES_OFFSET + 1] << 8;
+        uint16_t frames  = data[SJPG_FRAMES_OFFSET] | data[SJPG_FRAMES_OFFSET + 1] << 8;
+        uint16_t block_h = data[SJPG_BLOCK_H_OFFSET] | data[SJPG_BLOCK_H_OFFSET + 1] << 8;
+        if (w != job->w || frames == 0 || frames > JPEG_MAX_STRIPS) {
+            ESP_LOGE(TAG, "sjpg: width %u, %u strips not supported", w, frames);
+            return false;
+        }
+
+        const uint8_t *sizes = data + SJPG_SIZES_OFFSET;
+        uint32_t off = SJPG_SIZES_OFFSET + (uint32_t)frames * 2;
+        for (int i = 0; i < frames; ++i) {
+            uint32_t len = sizes[i * 2] | sizes[i * 2 + 1] << 8;
+            if (off + len > size) {
+                ESP_LOGE(TAG, "sjpg: strip %d truncated", i);
+                return false;
+            }
+            job->strips[i] = (jpeg_strip_t){ .data = data + off, .size = len, .y0 = (uint16_t)(i * block_h) };
+            off += len;
+        }
+        job->count = frames;
+        return true;
+    }
+
+    job->strips[0] = (jpeg_strip_t){ .data = data, .size = size, .y0 = 0 };
+    job->count     = 1;
+    return true;
+}
+
+bool ui_jpeg_decode(const uint8_t *data, uint32_t size, uint16_t w, uint16_t h, lv_color_t *dst, int workers)
+{
+    if (!data || !dst || !jpeg_init()) return false;
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+
+    int64_t t0 = esp_timer_get_time();
+    jpeg_job_t *job = (jpeg_job_t*)heap_caps_malloc(sizeof(*job), MALLOC_CAP_8BIT);
+    bool ok = false;
+    if (!job) goto out;
+
+    job->w   = w;
+    job->h   = h;
+    job->dst = dst;
+    atomic_init(&job->next, 0);
+    atomic_init(&job->failed, false);
+    if (!parse_strips(job, data, size)) goto out;
+
+    bool parallel = workers > 1 && job->count > 1;
+    if (parallel) {
+        s_job = job;
+        xSemaphoreGive(s_start);
+    }
+    run_worker(job, s_work[0]);
+    if (parallel) xSemaphoreTake(s_done, portMAX_DELAY);
+
+    ok = !atomic_load(&job->failed);
+    if (ok) {
+        s_stats.images++;
+        s_stats.strips += job->count;
+        s_stats.decode_us += (uint32_t)(esp_timer_get_time() - t0);
+        s_stats.in_bytes += size;
+        s_stats.out_bytes += (uint32_t)w * h * sizeof(lv_color_t);
+    }
+
+out:
+    heap_caps_free(job);
+    xSemaphoreGive(s_lock);
+    return ok;
+}
+
+#if CONFIG_UI_JPEG_BENCH
+/* Must match raw_twin_path() in tools/asset_packer.py: "x/img.sjpg" -> "x/img.raw.bin" */
+static bool raw_twin_path(const char *real, char *buf, size_t size)
+{
+    const char *dot   = strrchr(real, '.');
+    const char *slash = strrchr(real, '/');
+    if (!dot || (slash && dot < slash)) dot = real + strlen(real);
+    int n = snprintf(buf, size, "%.*s.raw.bin", (int)(dot - real), real);
+    return n > 0 && (size_t)n < size;
+}
+
+static void jpeg_bench(const char *real, const uint8_t *data, uint32_t size, uint16_t w, uint16_t h,
+                       lv_color_t *dst, uint32_t read_us, uint32_t dual_us)
+{
+    int64_t t0 = esp_timer_get_time();
+    ui_jpeg_decode(data, size, w, h, dst, 1);
+    uint32_t single_us = (uint32_t)(esp_timer_get_time() - t0);
+
+    /* The RGB565 frame the packer writes next to the JPEG with "raw": true, read the same way */
+    uint32_t raw_bytes = (uint32_t)w * h * sizeof(lv_color_t);
+    char raw[256];
+    struct stat st;
+    if (!raw_twin_path(real, raw, sizeof(raw)) || stat(raw, &st) != 0 || (uint32_t)st.st_size != raw_bytes) {
+        ESP_LOGI(TAG, "%s: %u -> %u bytes; read %u us, decode 2 cores %u us, 1 core %u us; no RAW twin", real,
+                 (unsigned)size, (unsigned)raw_bytes, (unsigned)read_us, (unsigned)dual_us, (unsigned)single_us);
+        return;
+    }
+    uint8_t *buf = (uint8_t*)heap_caps_malloc(raw_bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    t0 = esp_timer_get_time();
+    bool ok = buf && ui_asset_read_file(raw, buf, raw_bytes);
+    uint32_t raw_us = (uint32_t)(esp_timer_get_time() - t0);
+    heap_caps_free(buf);
+
+    ESP_LOGI(TAG, "%s: %u -> %u bytes; read %u us, decode 2 cores %u us, 1 core %u us; RAW read %s%u us", real,
+             (unsigned)size, (unsigned)raw_bytes, (unsigned)read_us, (unsigned)dual_us, (unsigned)single_us,
+             ok ? "" : "failed after ", (unsigned)raw_us);
+}
+#endif
+
+#else /* !LV_USE_SJPG */
+
+static ui_jpeg_stats_t s_stats;
+
+bool ui_jpeg_decode(const uint8_t *data, uint32_t size, uint16_t w, uint16_t h, lv_color_t *dst, int workers)
+{
+    (void)data; (void)size; (void)w; (void)h; (void)dst; (void)workers;
+    ESP_LOGE(TAG, "JPEG assets need LV_USE_SJPG (tjpgd)");
+    return false;
+}
+
+#endif /* LV_USE_SJPG */
+
+uint8_t* ui_jpeg_load(const char *path_S, uint32_t file_size, uint16_t w, uint16_t h)
+{
+    char real[256];
+    ui_img_map_path(real, sizeof(real), path_S);
+
+    uint8_t *in = (uint8_t*)heap_caps_malloc(file_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    uint8_t *out = (uint8_t*)heap_caps_malloc((size_t)w * h * sizeof(lv_color_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!in || !out) {
+        ESP_LOGE(TAG, "alloc failed for %s", real);
+        goto fail;
+    }
+
+    int64_t t0 = esp_timer_get_time();
+    if (!ui_asset_read_file(real, in, file_size)) goto fail;
+    uint32_t read_us = (uint32_t)(esp_timer_get_time() - t0);
+    s_stats.read_us += read_us;
+
+    t0 = esp_timer_get_time();
+    if (!ui_jpeg_decode(in, file_size, w, h, (lv_color_t*)out, 2)) {
+        ESP_LOGE(TAG, "decode failed: %s", real);
+        goto fail;
+    }
+    uint32_t dual_us = (uint32_t)(esp_timer_get_time() - t0);
+    (void)dual_us;
+
+#if CONFIG_UI_JPEG_BENCH
+    jpeg_bench(real, in, file_size, w, h, (lv_color_t*)out, read_us, dual_us);
+#endif
+
+    heap_caps_free(in);
+    return out;
+
+fail:
+    heap_caps_free(in);
+    heap_caps_free(out);
+    return NULL;
+}
+
+void ui_jpeg_get_stats(ui_jpeg_stats_t *out)
+{
+    if (out) *out = s_stats;
+}
+
+void ui_jpeg_reset_stats(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+}
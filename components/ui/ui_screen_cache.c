@@ -0,0 +1,421 @@
+#include "ui_screen_cache.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+#include <string.h>
+
+#if CONFIG_UI_SCREEN_CACHE
+
+static const char *TAG = "UISCR";
+
+#define ENTRY_NUM 4
+#define IDLE_PERIOD_MS 100
+/* Resolution of the transition progress */
+#define STAGE_RES 1024
+
+typedef struct {
+    lv_obj_t *scr;
+    lv_obj_t *cover; /* lv_img child of scr showing snap, hidden except for the first frame after a switch */
+    ui_screen_cache_prepare_cb_t prepare;
+    lv_img_dsc_t snap;
+    uint8_t *buf;    /* PSRAM */
+    uint32_t buf_size;
+    bool valid;      /* snap shows what the objects would draw */
+    bool live;
+} entry_t;
+
+/* Where each snapshot starts (to) or ends (from), in screen sizes, per lv_scr_load_anim_t */
+typedef struct {
+    int8_t to_x, to_y;
+    int8_t from_x, from_y;
+    uint8_t fade;
+} stage_motion_t;
+
+enum { FADE_NONE, FADE_TO, FADE_FROM };
+
+static const stage_motion_t s_motions[] = {
+    [LV_SCR_LOAD_ANIM_NONE]        = { 0, 0, 0, 0, FADE_NONE },
+    [LV_SCR_LOAD_ANIM_OVER_LEFT]   = { 1, 0, 0, 0, FADE_NONE },
+    [LV_SCR_LOAD_ANIM_OVER_RIGHT]  = { -1, 0, 0, 0, FADE_NONE },
+    [LV_SCR_LOAD_ANIM_OVER_TOP]    = { 0, 1, 0, 0, FADE_NONE },
+    [LV_SCR_LOAD_ANIM_OVER_BOTTOM] = { 0, -1, 0, 0, FADE_NONE },
+    [LV_SCR_LOAD_ANIM_MOVE_LEFT]   = { 1, 0, -1, 0, FADE_NONE },
+    [LV_SCR_LOAD_ANIM_MOVE_RIGHT]  = { -1, 0, 1, 0, FADE_NONE },
+    [LV_SCR_LOAD_ANIM_MOVE_TOP]    = { 0, 1, 0, -1, FADE_NONE },
+    [LV_SCR_LOAD_ANIM_MOVE_BOTTOM] = { 0, -1, 0, 1, FADE_NONE },
+    [LV_SCR_LOAD_ANIM_FADE_IN]     = { 0, 0, 0, 0, FADE_TO },
+    [LV_SCR_LOAD_ANIM_FADE_OUT]    = { 0, 0, 0, 0, FADE_FROM },
+    [LV_SCR_LOAD_ANIM_OUT_LEFT]    = { 0, 0, -1, 0, FADE_NONE },
+    [LV_SCR_LOAD_ANIM_OUT_RIGHT]   = { 0, 0, 1, 0, FADE_NONE },
+    [LV_SCR_LOAD_ANIM_OUT_TOP]     = { 0, 0, 0, -1, FADE_NONE },
+    [LV_SCR_LOAD_ANIM_OUT_BOTTOM]  = { 0, 0, 0, 1, FADE_NONE },
+};
+
+static entry_t s_entries[ENTRY_NUM];
+static lv_timer_t *s_idle_timer = NULL;
+static lv_disp_drv_t *s_drv = NULL;
+static void (*s_prev_monitor_cb)(lv_disp_drv_t *, uint32_t, uint32_t);
+static entry_t *s_covered = NULL; /* Cover shown until the frame drawn from it is out */
+
+/* Transitions: the two snapshots are moved on this screen, then s_stage_target is loaded */
+static lv_obj_t *s_stage = NULL;
+static lv_obj_t *s_stage_from, *s_stage_to;
+static entry_t *s_stage_target = NULL;
+static lv_scr_load_anim_t s_stage_anim;
+static int64_t s_stage_t0;
+
+static ui_screen_cache_stats_t s_stats;
+
+static entry_t *entry_of(const lv_obj_t *scr)
+{
+    if (!scr) return NULL;
+    for (int i = 0; i < ENTRY_NUM; ++i) {
+        if (s_entries[i].scr == scr) return &s_entries[i];
+    }
+    return NULL;
+}
+
+/* Put the cover where lv_snapshot rendered the screen, whatever the screen's padding and scroll. */
+static void cover_place(entry_t *e)
+{
+    lv_coord_t ext = _lv_obj_get_ext_draw_size(e->scr);
+    lv_obj_set_pos(e->cover, 0, 0);
+    lv_obj_update_layout(e->cover);
+    lv_obj_set_pos(e->cover, e->scr->coords.x1 - ext - e->cover->coords.x1,
+                   e->scr->coords.y1 - ext - e->cover->coords.y1);
+}
+
+static void cover_show(entry_t *e)
+{
+    lv_img_set_src(e->cover, &e->snap);
+    cover_place(e);
+    lv_obj_move_foreground(e->cover);
+    lv_obj_clear_flag(e->cover, LV_OBJ_FLAG_HIDDEN);
+    s_covered = e;
+}
+
+/* `redraw` false: the screen already shows what the objects below would draw. */
+static void cover_hide(entry_t *e, bool redraw)
+{
+    if (s_covered == e) s_covered = NULL;
+    if (lv_obj_has_flag(e->cover, LV_OBJ_FLAG_HIDDEN)) return;
+
+    if (!redraw) lv_disp_enable_invalidation(NULL, false);
+    lv_obj_add_flag(e->cover, LV_OBJ_FLAG_HIDDEN);
+    if (!redraw) lv_disp_enable_invalidation(NULL, true);
+}
+
+static bool snapshot_take(entry_t *e)
+{
+    if (e->live) return false;
+
+    uint32_t size = lv_snapshot_buf_size_needed(e->scr, LV_IMG_CF_TRUE_COLOR);
+    if (size > e->buf_size) {
+        heap_caps_free(e->buf);
+        e->buf = heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+        e->buf_size = e->buf ? size : 0;
+        if (!e->buf) {
+            ESP_LOGE(TAG, "no PSRAM for a %u byte snapshot", (unsigned)size);
+            e->valid = false;
+            return false;
+        }
+    }
+
+    int64_t t0 = esp_timer_get_time();
+    e->valid = lv_snapshot_take_to_buf(e->scr, LV_IMG_CF_TRUE_COLOR, &e->snap, e->buf, e->buf_size) == LV_RES_OK;
+    /* Same descriptor, new pixels */
+    lv_img_cache_invalidate_src(&e->snap);
+    s_stats.snapshots++;
+    s_stats.snapshot_us += (uint32_t)(esp_timer_get_time() - t0);
+    return e->valid;
+}
+
+static void stage_anim_cb(void *var, int32_t v)
+{
+    (void)var;
+    const stage_motion_t *m = &s_motions[s_stage_anim];
+    int32_t w = lv_obj_get_width(s_stage);
+    int32_t h = lv_obj_get_height(s_stage);
+    int32_t rest = STAGE_RES - v;
+
+    lv_obj_set_pos(s_stage_to, m->to_x * w * rest / STAGE_RES, m->to_y * h * rest / STAGE_RES);
+    lv_obj_set_pos(s_stage_from, m->from_x * w * v / STAGE_RES, m->from_y * h * v / STAGE_RES);
+    if (m->fade == FADE_TO) lv_obj_set_style_img_opa(s_stage_to, v * LV_OPA_COVER / STAGE_RES, 0);
+    if (m->fade == FADE_FROM) lv_obj_set_style_img_opa(s_stage_from, rest * LV_OPA_COVER / STAGE_RES, 0);
+}
+
+/*
+ * Load the target of the transition. `done`: the last stage frame, drawn or
+ * pending, shows the target's snapshot, so the switch needs no redraw.
+ */
+static void stage_end(bool done)
+{
+    entry_t *e = s_stage_target;
+    s_stage_target = NULL;
+    s_stats.transitions++;
+    s_stats.transition_us += (uint32_t)(esp_timer_get_time() - s_stage_t0);
+
+    /* Positions are applied on the next layout update: invalidate the last step now */
+    if (done) lv_obj_update_layout(s_stage);
+    /* Areas still pending from the last step are drawn from the cover */
+    cover_show(e);
+    if (!done) {
+        lv_disp_load_scr(e->scr);
+        return;
+    }
+    lv_disp_enable_invalidation(NULL, false);
+    lv_disp_load_scr(e->scr);
+    lv_disp_enable_invalidation(NULL, true);
+    if (lv_disp_get_default()->inv_p == 0) cover_hide(e, false);
+}
+
+static void stage_ready_cb(lv_anim_t *a)
+{
+    (void)a;
+    if (s_stage_target) stage_end(true);
+}
+
+/* A new switch while a transition runs: jump to its end first. */
+static void stage_finish(void)
+{
+    if (!s_stage_target) return;
+    lv_anim_del(s_stage, stage_anim_cb);
+    stage_end(false);
+}
+
+static void stage_start(entry_t *from, entry_t *to, lv_scr_load_anim_t anim, uint32_t time, uint32_t delay)
+{
+    if (!s_stage) {
+        s_stage = lv_obj_create(NULL);
+        lv_obj_remove_style_all(s_stage);
+        lv_obj_set_style_bg_color(s_stage, lv_color_black(), 0);
+        lv_obj_set_style_bg_opa(s_stage, LV_OPA_COVER, 0);
+        lv_obj_clear_flag(s_stage, LV_OBJ_FLAG_SCROLLABLE);
+        s_stage_from = lv_img_create(s_stage);
+        s_stage_to   = lv_img_create(s_stage);
+    }
+
+    const stage_motion_t *m = &s_motions[anim];
+    lv_img_set_src(s_stage_from, &from->snap);
+    lv_img_set_src(s_stage_to, &to->snap);
+    lv_obj_set_style_img_opa(s_stage_from, LV_OPA_COVER, 0);
+    lv_obj_set_style_img_opa(s_stage_to, LV_OPA_COVER, 0);
+    /* The snapshot that moves or fades is drawn on top */
+    if (m->to_x || m->to_y || m->fade == FADE_TO) {
+        lv_obj_move_foreground(s_stage_to);
+    } else {
+        lv_obj_move_foreground(s_stage_from);
+    }
+
+    s_stage_anim   = anim;
+    s_stage_target = to;
+    s_stage_t0     = esp_timer_get_time();
+    stage_anim_cb(NULL, 0);
+    lv_disp_load_scr(s_stage);
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, s_stage);
+    lv_anim_set_exec_cb(&a, stage_anim_cb);
+    lv_anim_set_values(&a, 0, STAGE_RES);
+    lv_anim_set_time(&a, time);
+    lv_anim_set_delay(&a, delay);
+    lv_anim_set_ready_cb(&a, stage_ready_cb);
+    lv_anim_start(&a);
+}
+
+static void monitor_cb(lv_disp_drv_t *drv, uint32_t time, uint32_t px)
+{
+    if (s_prev_monitor_cb) s_prev_monitor_cb(drv, time, px);
+
+    lv_obj_t *act = lv_scr_act();
+    if (s_stage_target && act == s_stage) {
+        s_stats.transition_frames++;
+        return;
+    }
+    if (s_covered) {
+        /* The frame drawn from the snapshot is out: the objects below look the same */
+        cover_hide(s_covered, false);
+        return;
+    }
+    /* Anything redrawn on a shown screen may differ from its snapshot */
+    entry_t *e = entry_of(act);
+    if (e) e->valid = false;
+}
+
+static void idle_cb(lv_timer_t *t)
+{
+    (void)t;
+    lv_disp_t *disp = lv_disp_get_default();
+    if (s_stage_target || s_covered || disp->inv_p || lv_anim_count_running()) return;
+    if (lv_disp_get_inactive_time(disp) < CONFIG_UI_SCREEN_CACHE_IDLE_MS) return;
+
+    lv_obj_t *act = lv_disp_get_scr_act(disp);
+    for (int i = 0; i < ENTRY_NUM; ++i) {
+        entry_t *e = &s_entries[i];
+        if (!e->scr || e->scr == act) continue;
+        if (e->prepare) e->prepare(e->scr);
+        if (!e->valid && !e->live) {
+            /* One per tick: each is a full render */
+            snapshot_take(e);
+            return;
+        }
+    }
+}
+
+static void scr_event_cb(lv_event_t *ev)
+{
+    entry_t *e = (entry_t *)lv_event_get_user_data(ev);
+    lv_event_code_t code = lv_event_get_code(ev);
+
+    if (code == LV_EVENT_SCREEN_UNLOAD_START) {
+        cover_hide(e, false);
+    } else if (code == LV_EVENT_DELETE) {
+        if (s_covered == e) s_covered = NULL;
+        if (s_stage_target == e) {
+            lv_anim_del(s_stage, stage_anim_cb);
+            s_stage_target = NULL;
+        }
+        if (s_stage && (lv_img_get_src(s_stage_from) == &e->snap || lv_img_get_src(s_stage_to) == &e->snap)) {
+            lv_img_set_src(s_stage_from, NULL);
+            lv_img_set_src(s_stage_to, NULL);
+        }
+        lv_img_cache_invalidate_src(&e->snap);
+        heap_caps_free(e->buf);
+        memset(e, 0, sizeof(*e));
+    }
+}
+
+bool ui_screen_cache_add(lv_obj_t *scr, ui_screen_cache_prepare_cb_t prepare)
+{
+    entry_t *e = entry_of(scr);
+    if (e) {
+        e->prepare = prepare;
+        return true;
+    }
+    for (int i = 0; i < ENTRY_NUM && !e; ++i) {
+        if (!s_entries[i].scr) e = &s_entries[i];
+    }
+    if (!e) {
+        ESP_LOGE(TAG, "more than %d cached screens", ENTRY_NUM);
+        return false;
+    }
+
+    e->buf_size = lv_snapshot_buf_size_needed(scr, LV_IMG_CF_TRUE_COLOR);
+    e->buf = heap_caps_malloc(e->buf_size, MALLOC_CAP_SPIRAM);
+    if (!e->buf) {
+        ESP_LOGE(TAG, "no PSRAM for a %u byte snapshot", (unsigned)e->buf_size);
+        memset(e, 0, sizeof(*e));
+        return false;
+    }
+    e->scr     = scr;
+    e->prepare = prepare;
+
+    e->cover = lv_img_create(scr);
+    lv_obj_add_flag(e->cover, LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_FLOATING);
+    lv_obj_add_event_cb(scr, scr_event_cb, LV_EVENT_ALL, e);
+
+    if (!s_drv) {
+        s_drv = lv_disp_get_default()->driver;
+        s_prev_monitor_cb = s_drv->monitor_cb;
+        s_drv->monitor_cb = monitor_cb;
+    }
+    if (!s_idle_timer) s_idle_timer = lv_timer_create(idle_cb, IDLE_PERIOD_MS, NULL);
+
+    ESP_LOGI(TAG, "caching screen %p, %u byte snapshot", (void *)scr, (unsigned)e->buf_size);
+    return true;
+}
+
+void ui_screen_cache_invalidate(lv_obj_t *scr)
+{
+    entry_t *e = entry_of(scr);
+    if (!e) return;
+    e->valid = false;
+    cover_hide(e, true);
+}
+
+void ui_screen_cache_set_live(lv_obj_t *scr, bool live)
+{
+    entry_t *e = entry_of(scr);
+    if (!e) return;
+    e->live = live;
+    if (live) ui_screen_cache_invalidate(scr);
+}
+
+void ui_screen_cache_load(lv_obj_t *scr, lv_scr_load_anim_t anim, uint32_t time, uint32_t delay)
+{
+    stage_finish();
+
+    entry_t *to = entry_of(scr);
+    lv_obj_t *act = lv_scr_act();
+    if (!to || to->live || act == scr || delay) {
+        lv_scr_load_anim(scr, anim, time, delay, false);
+        return;
+    }
+
+    if (anim == LV_SCR_LOAD_ANIM_NONE || time == 0) {
+        if (to->valid) {
+            s_stats.hits++;
+            cover_show(to);
+        } else {
+            s_stats.misses++;
+        }
+        lv_disp_load_scr(scr);
+        return;
+    }
+
+    /* Both looks are needed for the whole transition: take the stale ones now */
+    entry_t *from = entry_of(act);
+    bool hit = to->valid;
+    if (!from || !(from->valid || snapshot_take(from)) || !(to->valid || snapshot_take(to))) {
+        s_stats.misses++;
+        lv_scr_load_anim(scr, anim, time, delay, false);
+        return;
+    }
+    if (hit) {
+        s_stats.hits++;
+    } else {
+        s_stats.misses++;
+    }
+    stage_start(from, to, anim, time, delay);
+}
+
+void ui_screen_cache_get_stats(ui_screen_cache_stats_t *out, bool reset)
+{
+    *out = s_stats;
+    if (reset) memset(&s_stats, 0, sizeof(s_stats));
+}
+
+#else /* !CONFIG_UI_SCREEN_CACHE */
+
+bool ui_screen_cache_add(lv_obj_t *scr, ui_screen_cache_prepare_cb_t prepare)
+{
+    (void)scr;
+    (void)prepare;
+    return false;
+}
+
+void ui_screen_cache_invalidate(lv_obj_t *scr)
+{
+    (void)scr;
+}
+
+void ui_screen_cache_set_live(lv_obj_t *scr, bool live)
+{
+    (void)scr;
+    (void)live;
+}
+
+void ui_screen_cache_load(lv_obj_t *scr, lv_scr_load_anim_t anim, uint32_t time, uint32_t delay)
+{
+    lv_scr_load_anim(scr, anim, time, delay, false);
+}
+
+void ui_screen_cache_get_stats(ui_screen_cache_stats_t *out, bool reset)
+{
+    (void)reset;
+    memset(out, 0, sizeof(*out));
+}
+
+#endif
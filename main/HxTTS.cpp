@@ -6,6 +6,7 @@
 #include "string.h"
 
 #include "HxTTS.h"
+#include "lvgl_v8_port.h"
 #include "uart.h"
 
 extern "C" {
@@ -14,6 +15,12 @@ extern "C" {
 
 #define HM_INT_GPIO_PIN GPIO_NUM_2
 
+#if CONFIG_FREERTOS_UNICORE || !defined(CONFIG_APP_TTS_TASK_CORE) || (CONFIG_APP_TTS_TASK_CORE < 0)
+#define TTS_TASK_CORE tskNO_AFFINITY
+#else
+#define TTS_TASK_CORE CONFIG_APP_TTS_TASK_CORE
+#endif
+
 #define CHECK_COMM_CALL(st)                                                                                            \
     do {                                                                                                               \
         int ret = st;                                                                                                  \
@@ -36,7 +43,10 @@ static void tts_monitor_task(void *arg)
         ESP_LOGW("HxTTS", "waitReady returned %d", static_cast<int>(err));
     }
 
+    // lv_async_call() is not thread-safe; the unlock also wakes the LVGL task to run it
+    lvgl_port_lock(-1);
     ui_notify_tts_finished();
+    lvgl_port_unlock();
 
    
     vTaskDelete(NULL);
@@ -107,13 +117,14 @@ HxTTS::Error HxTTS::startPlayback()
     CHECK_COMM_CALL(hm_comm_reg_write_u8(&transport, HM_REG_CMD_ADDR, HM_DEV_CMD_START, HX_REQ_TIMEOUT_MS));
 
     
-    BaseType_t r = xTaskCreate(
+    BaseType_t r = xTaskCreatePinnedToCore(
         tts_monitor_task,    
         "tts_mon",           
         4096,                
         this,                
         tskIDLE_PRIORITY + 3,
-        NULL                 
+        NULL,
+        TTS_TASK_CORE
     );
     if (r != pdPASS) {
         ESP_LOGW(TAG, "Failed to create tts_monitor_task");
@@ -0,0 +1,113 @@
+#include "lvgl_port_blend.h"
+#include "src/draw/sw/lv_draw_sw.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+
+typedef struct {
+    lv_draw_sw_ctx_t ctx; /* Copy of the LVGL draw context, `clip_area` points to `clip` */
+    lv_area_t clip;
+    const lv_draw_sw_blend_dsc_t *dsc;
+} blend_job_t;
+
+static const char *TAG = "LvBlend";
+
+static blend_job_t s_job;
+static TaskHandle_t s_task      = NULL;
+static SemaphoreHandle_t s_done = NULL;
+static uint32_t s_min_px;
+static void (*s_blend_base)(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc) = NULL;
+static lvgl_port_blend_stats_t s_stats;
+
+static void blend_task(void *arg)
+{
+    (void)arg;
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        s_blend_base((lv_draw_ctx_t *)&s_job.ctx, s_job.dsc);
+        xSemaphoreGive(s_done);
+    }
+}
+
+static void blend_split(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc)
+{
+    lv_area_t area;
+    if (!_lv_area_intersect(&area, dsc->blend_area, draw_ctx->clip_area)) return;
+    if (dsc->mask_buf && dsc->mask_res == LV_DRAW_MASK_RES_TRANSP) return;
+
+    /* Without antialiasing the base blend rounds the whole mask in place, which both bands would do. The ARGB
+     * (screen_transp) kernels cache their last result in static variables. */
+    lv_disp_drv_t *drv = _lv_refr_get_disp_refreshing()->driver;
+    lv_coord_t h       = lv_area_get_height(&area);
+    if (h < 2 || lv_area_get_size(&area) < s_min_px || !drv->antialiasing || drv->set_px_cb || drv->screen_transp) {
+        s_blend_base(draw_ctx, dsc);
+        return;
+    }
+
+    lv_area_t top = area;
+    top.y2        = area.y1 + h / 2 - 1;
+
+    s_job.ctx                     = *(lv_draw_sw_ctx_t *)draw_ctx;
+    s_job.clip                    = area;
+    s_job.clip.y1                 = top.y2 + 1;
+    s_job.ctx.base_draw.clip_area = &s_job.clip;
+    s_job.dsc                     = dsc;
+    xTaskNotifyGive(s_task);
+
+    const lv_area_t *clip_area = draw_ctx->clip_area;
+    draw_ctx->clip_area        = &top;
+    s_blend_base(draw_ctx, dsc);
+    draw_ctx->clip_area = clip_area;
+
+    xSemaphoreTake(s_done, portMAX_DELAY);
+    s_stats.blends++;
+    s_stats.split_px += lv_area_get_size(&s_job.clip);
+}
+
+bool lvgl_port_blend_init(uint32_t stack_size, unsigned priority, int core)
+{
+    s_done = xSemaphoreCreateBinary();
+    if (!s_done) {
+        ESP_LOGE(TAG, "Create semaphore failed");
+        return false;
+    }
+    if (xTaskCreatePinnedToCore(blend_task, "lvgl_blend", stack_size, NULL, priority, &s_task, core) != pdPASS) {
+        ESP_LOGE(TAG, "Create blend task failed");
+        lvgl_port_blend_deinit();
+        return false;
+    }
+    return true;
+}
+
+void lvgl_port_blend_deinit(void)
+{
+    if (s_task) {
+        vTaskDelete(s_task);
+        s_task = NULL;
+    }
+    if (s_done) {
+        vSemaphoreDelete(s_done);
+        s_done = NULL;
+    }
+}
+
+void lvgl_port_blend_attach(lv_draw_ctx_t *draw_ctx, uint32_t min_px)
+{
+    lv_draw_sw_ctx_t *sw_ctx = (lv_draw_sw_ctx_t *)draw_ctx;
+    if (!s_task || sw_ctx->blend == blend_split) return;
+
+    /* Every software context starts with the same base blend */
+    s_blend_base  = sw_ctx->blend;
+    s_min_px      = min_px;
+    sw_ctx->blend = blend_split;
+}
+
+void lvgl_port_blend_get_stats(lvgl_port_blend_stats_t *out, bool reset)
+{
+    *out = s_stats;
+    if (reset) {
+        s_stats.blends   = 0;
+        s_stats.split_px = 0;
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Parallel blends for the LVGL port.
+ *
+ * Only the final pixel loop of a draw is parallel: fills and image blends of
+ * at least `min_px` pixels are cut in two row bands, the LVGL task blends the
+ * top band while the blend task on the other core blends the bottom one, and
+ * `blend` returns when both are done. The bands never share a pixel, so the
+ * output is the serial one. Object traversal, masks, glyphs and image decoding
+ * use LVGL state that is not thread-safe and stay on the LVGL task; the
+ * display is still rendered one area at a time.
+ */
+
+typedef struct {
+    uint32_t blends;   /* Blends cut in two */
+    uint32_t split_px; /* Pixels blended by the blend task */
+} lvgl_port_blend_stats_t;
+
+/* Create the blend task on `core` */
+bool lvgl_port_blend_init(uint32_t stack_size, unsigned priority, int core);
+void lvgl_port_blend_deinit(void);
+
+/*
+ * Hook the blend of a software draw context. Blends smaller than `min_px`
+ * pixels, and the ones the base blend can't run twice (no antialiasing,
+ * set_px_cb, screen_transp), are left to the previous blend.
+ */
+void lvgl_port_blend_attach(lv_draw_ctx_t* draw_ctx, uint32_t min_px);
+
+void lvgl_port_blend_get_stats(lvgl_port_blend_stats_t* out, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
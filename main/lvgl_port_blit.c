@@ -0,0 +1,306 @@
+#include "lvgl_port_blit.h"
+#include "src/draw/sw/lv_draw_sw.h"
+#include <string.h>
+
+#include "sdkconfig.h"
+#ifdef ESP_PLATFORM
+#include "esp_cpu.h"
+#endif
+
+/* On a host, tools/host/idf emulates the GDMA with a thread */
+#if CONFIG_LVGL_PORT_ASYNC_BLIT
+#define BLIT_GDMA 1
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_async_memcpy.h"
+#include "esp_attr.h"
+#include "esp_cache.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_memory_utils.h"
+#else
+#define BLIT_GDMA 0
+#endif
+
+#define BLIT_BUF_NUM   2
+#define BLIT_BACKLOG   16 /* Copies the GDMA driver holds at once; a band has at most LVGL_PORT_BUFFER_SIZE_HEIGHT rows */
+#define CAL_SRC_BYTES  (128 * 1024)
+#define CAL_ROW_BYTES  1024
+
+typedef struct {
+    const void *buf;       /* LVGL draw buffer */
+    volatile uint32_t seq; /* Last copy queued into it */
+    volatile bool pending;
+    lv_area_t area;        /* Bounding box of the pending copies, screen coordinates */
+} blit_buf_t;
+
+static blit_buf_t s_bufs[BLIT_BUF_NUM];
+static lv_disp_drv_t *s_drv = NULL;
+static uint32_t s_min_px;
+static void (*s_blend_next)(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc) = NULL;
+static lvgl_port_blit_stats_t s_stats; /* spent_cycles is also updated by the flush task */
+static uint32_t s_memcpy_cycles_per_kb;
+
+#if BLIT_GDMA
+static const char *TAG = "LvBlit";
+
+static async_memcpy_handle_t s_mcp = NULL;
+static SemaphoreHandle_t s_slots   = NULL; /* One per copy the driver can take */
+static SemaphoreHandle_t s_done    = NULL; /* Given after each copy */
+static uint32_t s_seq;                     /* Copies queued, LVGL task only */
+static volatile uint32_t s_seq_done;       /* Copies finished; the GDMA finishes them in order */
+#endif
+
+static inline uint32_t cycles_now(void)
+{
+#ifdef ESP_PLATFORM
+    return esp_cpu_get_cycle_count();
+#else
+    return 0;
+#endif
+}
+
+static inline void add_spent(uint32_t start)
+{
+    __atomic_fetch_add(&s_stats.spent_cycles, cycles_now() - start, __ATOMIC_RELAXED);
+}
+
+#if BLIT_GDMA
+static IRAM_ATTR bool gdma_done_cb(async_memcpy_handle_t mcp, async_memcpy_event_t *event, void *args)
+{
+    BaseType_t need_yield = pdFALSE;
+    s_seq_done++;
+    xSemaphoreGiveFromISR(s_slots, &need_yield);
+    xSemaphoreGiveFromISR(s_done, &need_yield);
+    return need_yield == pdTRUE;
+}
+
+static bool gdma_copy(void *dst, const void *src, size_t n)
+{
+    /* The image was written through the cache */
+    if (esp_ptr_external_ram(src)) {
+        esp_cache_msync((void *)src, n, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+    }
+    xSemaphoreTake(s_slots, portMAX_DELAY);
+    s_seq++;
+    if (esp_async_memcpy(s_mcp, dst, (void *)src, n, gdma_done_cb, NULL) != ESP_OK) {
+        s_seq--;
+        xSemaphoreGive(s_slots);
+        return false;
+    }
+    return true;
+}
+
+static bool gdma_can_copy(const void *dst, const void *src)
+{
+    if (!s_mcp || !esp_ptr_dma_capable(dst)) return false;
+#if SOC_PSRAM_DMA_CAPABLE
+    if (esp_ptr_dma_ext_capable(src)) return true;
+#endif
+    return esp_ptr_dma_capable(src);
+}
+
+/* Cycles memcpy() needs per KB to copy image rows from PSRAM into SRAM. */
+static void calibrate(void)
+{
+    uint8_t *src = heap_caps_malloc(CAL_SRC_BYTES, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    uint8_t *dst = heap_caps_malloc(CAL_ROW_BYTES, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (src && dst) {
+        /* Larger than the data cache, so the rows copied first miss like the rows of an image do */
+        memset(src, 0x5a, CAL_SRC_BYTES);
+        uint32_t start = cycles_now();
+        for (uint32_t off = 0; off < CAL_SRC_BYTES; off += CAL_ROW_BYTES) {
+            memcpy(dst, src + off, CAL_ROW_BYTES);
+        }
+        s_memcpy_cycles_per_kb = (cycles_now() - start) / (CAL_SRC_BYTES / 1024);
+        ESP_LOGI(TAG, "memcpy PSRAM -> SRAM: %u cycles/KB", (unsigned)s_memcpy_cycles_per_kb);
+    }
+    heap_caps_free(src);
+    heap_caps_free(dst);
+}
+#endif
+
+static void wait_seq(uint32_t seq)
+{
+#if BLIT_GDMA
+    uint32_t start = cycles_now();
+    while ((int32_t)(s_seq_done - seq) < 0) {
+        /* The flush task and the LVGL task may both wait; don't rely on getting every give */
+        xSemaphoreTake(s_done, 1);
+    }
+    add_spent(start);
+#endif
+}
+
+/* Returns true if at least one row was queued to the GDMA; `*seq` is then the last queued copy. */
+static bool copy_rows(uint8_t *dst, size_t dst_stride, const uint8_t *src, size_t src_stride, size_t row_bytes,
+                      size_t rows, uint32_t *seq)
+{
+    size_t queued = 0;
+#if BLIT_GDMA
+    if (gdma_can_copy(dst, src)) {
+        uint32_t start = cycles_now();
+        size_t n = row_bytes;
+        size_t copies = rows;
+        /* Rows as wide as both buffers are one block */
+        if (dst_stride == row_bytes && src_stride == row_bytes) {
+            n *= rows;
+            copies = 1;
+        }
+        while (queued < copies && gdma_copy(dst + queued * dst_stride, src + queued * src_stride, n)) {
+            queued++;
+        }
+        if (copies == 1 && queued == 1) {
+            queued = rows;
+        }
+        *seq = s_seq;
+        s_stats.dma_bytes += queued * row_bytes;
+        add_spent(start);
+    }
+#endif
+    for (size_t i = queued; i < rows; i++) {
+        memcpy(dst + i * dst_stride, src + i * src_stride, row_bytes);
+    }
+    s_stats.cpu_bytes += (rows - queued) * row_bytes;
+    return queued > 0;
+}
+
+static blit_buf_t *buf_of(const void *buf)
+{
+    for (int i = 0; i < BLIT_BUF_NUM; i++) {
+        if (buf && s_bufs[i].buf == buf) return &s_bufs[i];
+    }
+    return NULL;
+}
+
+static void blend_blit(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc)
+{
+    lv_area_t area;
+    if (!_lv_area_intersect(&area, dsc->blend_area, draw_ctx->clip_area)) return;
+
+    /* Whatever is drawn over a pending copy waits for it. Layers render into their own buffer. */
+    blit_buf_t *b = buf_of(draw_ctx->buf);
+    if (b && b->pending && _lv_area_is_on(&area, &b->area)) {
+        wait_seq(b->seq);
+        b->pending = false;
+    }
+
+    /* The cases map_normal() handles with one memcpy() per row */
+    lv_disp_drv_t *drv = _lv_refr_get_disp_refreshing()->driver;
+    bool copy = dsc->src_buf && (dsc->opa >= LV_OPA_MAX) && (dsc->blend_mode == LV_BLEND_MODE_NORMAL) &&
+                (dsc->mask_buf == NULL || dsc->mask_res == LV_DRAW_MASK_RES_FULL_COVER);
+    /* LVGL reads the buffer itself before flush_cb only for software rotation */
+    if (!copy || !b || (drv != s_drv) || drv->set_px_cb || drv->screen_transp ||
+        (drv->sw_rotate && drv->rotated != LV_DISP_ROT_NONE) || (lv_area_get_size(&area) < s_min_px)) {
+        s_blend_next(draw_ctx, dsc);
+        return;
+    }
+
+    lv_coord_t dest_stride = lv_area_get_width(draw_ctx->buf_area);
+    lv_color_t *dest_buf   = (lv_color_t *)draw_ctx->buf;
+    dest_buf += dest_stride * (area.y1 - draw_ctx->buf_area->y1) + (area.x1 - draw_ctx->buf_area->x1);
+    lv_coord_t src_stride      = lv_area_get_width(dsc->blend_area);
+    const lv_color_t *src_buf = dsc->src_buf;
+    src_buf += src_stride * (area.y1 - dsc->blend_area->y1) + (area.x1 - dsc->blend_area->x1);
+
+    uint32_t seq;
+    if (copy_rows((uint8_t *)dest_buf, dest_stride * sizeof(lv_color_t), (const uint8_t *)src_buf,
+                  src_stride * sizeof(lv_color_t), lv_area_get_width(&area) * sizeof(lv_color_t),
+                  lv_area_get_height(&area), &seq)) {
+        if (b->pending) {
+            _lv_area_join(&b->area, &b->area, &area);
+        } else {
+            b->area = area;
+        }
+        b->seq     = seq;
+        b->pending = true;
+    }
+    if (area.y1 == dsc->blend_area->y1) {
+        s_stats.images++;
+    }
+}
+
+bool lvgl_port_blit_init(void)
+{
+#if BLIT_GDMA
+    s_slots = xSemaphoreCreateCounting(BLIT_BACKLOG, BLIT_BACKLOG);
+    s_done  = xSemaphoreCreateBinary();
+    if (!s_slots || !s_done) {
+        ESP_LOGE(TAG, "Create semaphores failed");
+        lvgl_port_blit_deinit();
+        return false;
+    }
+
+    async_memcpy_config_t config = ASYNC_MEMCPY_DEFAULT_CONFIG();
+    config.backlog               = BLIT_BACKLOG;
+    esp_err_t err                = esp_async_memcpy_install(&config, &s_mcp);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "esp_async_memcpy_install() failed (%s), images are copied with memcpy()", esp_err_to_name(err));
+        lvgl_port_blit_deinit();
+        return false;
+    }
+    s_seq      = 0;
+    s_seq_done = 0;
+    calibrate();
+    return true;
+#else
+    return false;
+#endif
+}
+
+void lvgl_port_blit_deinit(void)
+{
+#if BLIT_GDMA
+    if (s_mcp) {
+        wait_seq(s_seq);
+        esp_async_memcpy_uninstall(s_mcp);
+        s_mcp = NULL;
+    }
+    if (s_slots) {
+        vSemaphoreDelete(s_slots);
+        s_slots = NULL;
+    }
+    if (s_done) {
+        vSemaphoreDelete(s_done);
+        s_done = NULL;
+    }
+#endif
+    memset(s_bufs, 0, sizeof(s_bufs));
+    s_drv = NULL;
+}
+
+void lvgl_port_blit_attach(lv_disp_drv_t *drv, lv_draw_ctx_t *draw_ctx, uint32_t min_px)
+{
+    /* Canvas and snapshot contexts are created through the same driver: keep the plain blend there */
+    if (s_drv && s_drv != drv) return;
+
+    lv_draw_sw_ctx_t *sw_ctx = (lv_draw_sw_ctx_t *)draw_ctx;
+    memset(s_bufs, 0, sizeof(s_bufs));
+    s_bufs[0].buf = drv->draw_buf->buf1;
+    s_bufs[1].buf = drv->draw_buf->buf2;
+    s_drv         = drv;
+    s_min_px      = min_px;
+    s_blend_next  = sw_ctx->blend;
+    sw_ctx->blend = blend_blit;
+}
+
+void lvgl_port_blit_wait_buf(const void *buf)
+{
+    blit_buf_t *b = buf_of(buf);
+    if (b && b->pending) {
+        wait_seq(b->seq);
+        b->pending = false;
+    }
+}
+
+void lvgl_port_blit_get_stats(lvgl_port_blit_stats_t *out, bool reset)
+{
+    *out = s_stats;
+    if (reset) {
+        out->spent_cycles = __atomic_exchange_n(&s_stats.spent_cycles, 0, __ATOMIC_RELAXED);
+        s_stats.images    = 0;
+        s_stats.dma_bytes = 0;
+        s_stats.cpu_bytes = 0;
+    }
+    out->memcpy_cycles = (uint32_t)((uint64_t)out->dma_bytes * s_memcpy_cycles_per_kb / 1024);
+}
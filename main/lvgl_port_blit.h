@@ -0,0 +1,50 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Asynchronous image blits for the LVGL port.
+ *
+ * Opaque TRUE_COLOR images drawn without zoom, rotation, recolor or mask end
+ * up in map_normal(), which copies them row by row into the draw buffer. With
+ * the blend hook attached, those rows are queued to the GDMA
+ * (esp_async_memcpy) instead, and LVGL goes on drawing. A later blend that
+ * touches a pending area waits for the copies first, and so does the flush of
+ * the buffer (lvgl_port_blit_wait_buf()).
+ *
+ * Without GDMA (builds without CONFIG_LVGL_PORT_ASYNC_BLIT, IDF without async
+ * memcpy, buffers the DMA can't reach, or a full transaction queue) the rows
+ * are copied with memcpy() on the spot, so the output is the same either way.
+ */
+
+typedef struct {
+    uint32_t images;        /* Images whose first row was blitted */
+    uint32_t dma_bytes;     /* Bytes copied by the GDMA */
+    uint32_t cpu_bytes;     /* Bytes copied with memcpy() by the fallback */
+    uint32_t spent_cycles;  /* CPU cycles spent queueing copies and waiting for them */
+    uint32_t memcpy_cycles; /* CPU cycles memcpy() would have needed for dma_bytes, from the calibration in init */
+} lvgl_port_blit_stats_t;
+
+/* Install the GDMA engine. Returns false if it is not available; blits then use memcpy(). */
+bool lvgl_port_blit_init(void);
+void lvgl_port_blit_deinit(void);
+
+/*
+ * Hook the blend of a software draw context created for `drv`. Blits smaller
+ * than `min_px` pixels are left to the previous blend.
+ */
+void lvgl_port_blit_attach(lv_disp_drv_t* drv, lv_draw_ctx_t* draw_ctx, uint32_t min_px);
+
+/* Wait until every copy into the draw buffer `buf` has landed. Call before reading the buffer. */
+void lvgl_port_blit_wait_buf(const void* buf);
+
+void lvgl_port_blit_get_stats(lvgl_port_blit_stats_t* out, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,91 @@
+#include "lvgl_port_damage.h"
+
+typedef struct {
+    uint16_t num;
+    lv_area_t areas[LV_INV_BUF_SIZE];
+} damage_t;
+
+static damage_t s_damage[LVGL_PORT_DAMAGE_FRAMES]; // Areas drawn in the last frames, ring
+static uint8_t s_damage_last = 0;                  // Slot of the last frame
+static uint8_t s_age[2]      = { 0 };              // Frames since the buffer got one, 0: never written
+
+static void damage_save(const lv_disp_t *disp)
+{
+    s_damage_last = (s_damage_last + 1) % LVGL_PORT_DAMAGE_FRAMES;
+    damage_t *dmg = &s_damage[s_damage_last];
+    dmg->num      = 0;
+    for (int i = 0; i < disp->inv_p; i++) {
+        if (disp->inv_area_joined[i] == 0) {
+            dmg->areas[dmg->num++] = disp->inv_areas[i];
+        }
+    }
+}
+
+/* Add `area` to `out`, joined with the areas it covers or that take no more pixels joined. False if full. */
+static bool damage_add(damage_t *out, const lv_area_t *area)
+{
+    lv_area_t add = *area;
+    for (int i = 0; i < out->num;) {
+        lv_area_t joined;
+        if (_lv_area_is_in(&add, &out->areas[i], 0)) {
+            return true;
+        }
+        _lv_area_join(&joined, &add, &out->areas[i]);
+        if (lv_area_get_size(&joined) <= lv_area_get_size(&add) + lv_area_get_size(&out->areas[i])) {
+            // The joined area may now cover earlier ones
+            add           = joined;
+            out->areas[i] = out->areas[--out->num];
+            i             = 0;
+            continue;
+        }
+        i++;
+    }
+    if (out->num >= LV_INV_BUF_SIZE) {
+        return false;
+    }
+    out->areas[out->num++] = add;
+    return true;
+}
+
+/* Copy into `dst` what it misses, `age` frames old */
+static void damage_copy(lv_disp_t *disp, const void *src, void *dst, uint8_t age, lvgl_port_damage_copy_t copy)
+{
+    static damage_t out;
+    bool full = (age == 0) || (age > LVGL_PORT_DAMAGE_FRAMES);
+
+    out.num = 0;
+    for (int f = 0; (f < age) && !full; f++) {
+        const damage_t *dmg = &s_damage[(s_damage_last + LVGL_PORT_DAMAGE_FRAMES - f) % LVGL_PORT_DAMAGE_FRAMES];
+        for (int i = 0; (i < dmg->num) && !full; i++) {
+            full = !damage_add(&out, &dmg->areas[i]);
+        }
+    }
+    if (full) {
+        copy(src, dst, 0, 0, lv_disp_get_hor_res(disp) - 1, lv_disp_get_ver_res(disp) - 1);
+        return;
+    }
+    for (int i = 0; i < out.num; i++) {
+        const lv_area_t *a = &out.areas[i];
+        copy(src, dst, a->x1, a->y1, a->x2, a->y2);
+    }
+}
+
+void lvgl_port_damage_reset(void)
+{
+    s_damage_last = 0;
+    s_age[0]      = 0;
+    s_age[1]      = 0;
+    for (int f = 0; f < LVGL_PORT_DAMAGE_FRAMES; f++) {
+        s_damage[f].num = 0;
+    }
+}
+
+void lvgl_port_damage_frame(lv_disp_t *disp, int fb, const void *src, void *dst, lvgl_port_damage_copy_t copy)
+{
+    damage_save(disp);
+    damage_copy(disp, src, dst, s_age[fb], copy);
+    s_age[fb] = 1;
+    if ((s_age[1 - fb] != 0) && (s_age[1 - fb] <= LVGL_PORT_DAMAGE_FRAMES)) {
+        s_age[1 - fb]++;
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <stdint.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Frame buffer age for the LVGL port in direct mode with rotation.
+ *
+ * LVGL draws into a third, unrotated buffer that always holds the whole
+ * frame, and each frame is rotated into the LCD frame buffer that is not on
+ * the panel. That buffer last got a frame `age` frames ago, so it only misses
+ * the areas drawn in the last `age` frames: the union of their damage is
+ * copied into it, and nothing is copied again after the VSYNC. An unknown
+ * age, or more areas than fit, copies the whole screen.
+ *
+ * The copy is a callback, so the bookkeeping also runs on a host (tools/host)
+ * against a plain copy.
+ */
+
+#define LVGL_PORT_DAMAGE_FRAMES 2 /* One per LCD frame buffer */
+
+typedef void (*lvgl_port_damage_copy_t)(const void* from, void* to, lv_coord_t x1, lv_coord_t y1, lv_coord_t x2,
+                                        lv_coord_t y2);
+
+/* Forget the saved areas and the buffer ages: each buffer gets the whole screen next */
+void lvgl_port_damage_reset(void);
+
+/*
+ * On the last flush of a frame of `disp`: save the areas it drew, then copy
+ * from `src` into `dst`, LCD frame buffer `fb` (0 or 1), what it misses.
+ */
+void lvgl_port_damage_frame(lv_disp_t* disp, int fb, const void* src, void* dst, lvgl_port_damage_copy_t copy);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,137 @@
+#include "lvgl_port_rotate.h"
+#include <stdbool.h>
+
+#ifdef ESP_PLATFORM
+#include "esp_attr.h"
+#else
+#define IRAM_ATTR
+#endif
+
+#define TILE LVGL_PORT_ROTATE_TILE
+
+#if (TILE & 1) != 0
+#error "LVGL_PORT_ROTATE_TILE must be even"
+#endif
+
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+
+static inline int dst_index(int x, int y, int w, int h, int rotate)
+{
+    switch (rotate) {
+    case 90:
+        return (w - 1 - x) * h + y;
+    case 180:
+        return (h - 1 - y) * w + (w - 1 - x);
+    default: // 270
+        return x * h + (h - 1 - y);
+    }
+}
+
+/* One pixel at a time, still by tiles */
+static IRAM_ATTR void rotate_px(const uint16_t *from, uint16_t *to, int w, int h, int x1, int y1, int x2, int y2,
+                                int rotate)
+{
+    for (int ty = y1; ty <= y2; ty += TILE) {
+        int tye = MIN(ty + TILE - 1, y2);
+        for (int tx = x1; tx <= x2; tx += TILE) {
+            int txe = MIN(tx + TILE - 1, x2);
+            for (int y = ty; y <= tye; y++) {
+                for (int x = tx; x <= txe; x++) {
+                    to[dst_index(x, y, w, h, rotate)] = from[y * w + x];
+                }
+            }
+        }
+    }
+}
+
+/* [xa, xb) x [ya, yb), all even, `w` and `h` even */
+static IRAM_ATTR void rotate_90_270_2x2(const uint16_t *from, uint16_t *to, int w, int h, int xa, int ya, int xb,
+                                        int yb, int rotate)
+{
+    const int words_per_2_rows = h; // Two destination rows of `h` pixels
+    for (int ty = ya; ty < yb; ty += TILE) {
+        int tye = MIN(ty + TILE, yb);
+        for (int tx = xa; tx < xb; tx += TILE) {
+            int txe = MIN(tx + TILE, xb);
+            for (int y = ty; y < tye; y += 2) {
+                const uint32_t *s0 = (const uint32_t *)(from + y * w + tx);
+                const uint32_t *s1 = (const uint32_t *)(from + (y + 1) * w + tx);
+                if (rotate == 90) {
+                    // Column x goes to row w - 1 - x, pixel y to column y
+                    uint32_t *d = (uint32_t *)(to + (w - 1 - tx) * h + y);
+                    for (int x = tx; x < txe; x += 2) {
+                        uint32_t a = *s0++;
+                        uint32_t b = *s1++;
+                        d[0]        = (a & 0xFFFF) | (b << 16);
+                        d[-h / 2]   = (a >> 16) | (b & 0xFFFF0000);
+                        d -= words_per_2_rows;
+                    }
+                } else {
+                    // Column x goes to row x, pixel y to column h - 1 - y
+                    uint32_t *d = (uint32_t *)(to + tx * h + (h - 2 - y));
+                    for (int x = tx; x < txe; x += 2) {
+                        uint32_t a = *s0++;
+                        uint32_t b = *s1++;
+                        d[0]       = (b & 0xFFFF) | (a << 16);
+                        d[h / 2]   = (b >> 16) | (a & 0xFFFF0000);
+                        d += words_per_2_rows;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* Rows y1..y2, columns [xa, xb) even, `w` even */
+static IRAM_ATTR void rotate_180_2x1(const uint16_t *from, uint16_t *to, int w, int h, int xa, int y1, int xb,
+                                     int y2)
+{
+    for (int y = y1; y <= y2; y++) {
+        const uint32_t *s = (const uint32_t *)(from + y * w + xa);
+        uint32_t *d       = (uint32_t *)(to + (h - 1 - y) * w + (w - 2 - xa));
+        for (int x = xa; x < xb; x += 2) {
+            uint32_t a = *s++;
+            *d--       = (a >> 16) | (a << 16);
+        }
+    }
+}
+
+IRAM_ATTR void lvgl_port_rotate_rgb565(const uint16_t *from, uint16_t *to, int w, int h, int x1, int y1, int x2,
+                                       int y2, int rotate)
+{
+    if ((rotate != 90) && (rotate != 180) && (rotate != 270)) {
+        return;
+    }
+    bool paired = (((w | h) & 1) == 0) && ((((uintptr_t)from | (uintptr_t)to) & 3) == 0);
+    if (!paired) {
+        rotate_px(from, to, w, h, x1, y1, x2, y2, rotate);
+        return;
+    }
+
+    // Even-aligned core, odd edges one pixel at a time
+    int xa = (x1 + 1) & ~1;
+    int xb = (x2 + 1) & ~1;
+    int ya = (rotate == 180) ? y1 : (y1 + 1) & ~1;
+    int yb = (rotate == 180) ? y2 + 1 : (y2 + 1) & ~1;
+    if ((xa >= xb) || (ya >= yb)) {
+        rotate_px(from, to, w, h, x1, y1, x2, y2, rotate);
+        return;
+    }
+    if (rotate == 180) {
+        rotate_180_2x1(from, to, w, h, xa, y1, xb, y2);
+    } else {
+        rotate_90_270_2x2(from, to, w, h, xa, ya, xb, yb, rotate);
+    }
+    if (x1 < xa) {
+        rotate_px(from, to, w, h, x1, y1, x1, y2, rotate);
+    }
+    if (xb <= x2) {
+        rotate_px(from, to, w, h, xb, y1, x2, y2, rotate);
+    }
+    if (y1 < ya) {
+        rotate_px(from, to, w, h, xa, y1, xb - 1, y1, rotate);
+    }
+    if (yb <= y2) {
+        rotate_px(from, to, w, h, xa, yb, xb - 1, y2, rotate);
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Blocked RGB565 rotation for the LVGL port.
+ *
+ * Copies the area (x1, y1)-(x2, y2), inclusive, of a `w` x `h` frame `from`
+ * into the frame `to` rotated by 90, 180 or 270 degrees clockwise. The
+ * rotated frame is `h` x `w` pixels (90, 270) or `w` x `h` pixels (180), and
+ * only the pixels of the area are written.
+ *
+ * 90 and 270 walk the area in LVGL_PORT_ROTATE_TILE x LVGL_PORT_ROTATE_TILE
+ * tiles, so the source and destination rows a tile touches stay in the cache.
+ * Within a tile, 2 x 2 pixels are read as two 32-bit words and written as two
+ * 32-bit words. 180 reverses each row one 32-bit word at a time. Odd edges,
+ * odd frame sizes and unaligned frames fall back to one pixel at a time.
+ */
+
+#define LVGL_PORT_ROTATE_TILE 16
+
+void lvgl_port_rotate_rgb565(const uint16_t* from, uint16_t* to, int w, int h, int x1, int y1, int x2, int y2,
+                             int rotate);
+
+#ifdef __cplusplus
+}
+#endif
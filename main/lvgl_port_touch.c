@@ -0,0 +1,177 @@
+#include "lvgl_port_touch.h"
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#define RING_MASK (LVGL_PORT_TOUCH_RING_SIZE - 1)
+
+#if (LVGL_PORT_TOUCH_RING_SIZE & RING_MASK) != 0
+#error "LVGL_PORT_TOUCH_RING_SIZE must be a power of two"
+#endif
+
+static lvgl_port_touch_config_t s_cfg;
+static lvgl_port_touch_sample_t s_ring[LVGL_PORT_TOUCH_RING_SIZE];
+static uint32_t s_head;                 /* Next slot written, sampler only */
+static uint32_t s_tail;                 /* Next slot read; the sampler also moves it when the ring is full */
+static lvgl_port_touch_sample_t s_last; /* Last sample queued, sampler only */
+static lvgl_port_touch_stats_t s_stats; /* irqs is updated by the ISR */
+
+static const char *TAG = "LvTouch";
+
+static TaskHandle_t s_task = NULL; /* Set by xTaskCreate() before the task runs */
+static volatile bool s_stop;
+static int64_t s_irq_us; /* Time of the last INT edge */
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+#define RING_LOCK()   portENTER_CRITICAL(&s_lock)
+#define RING_UNLOCK() portEXIT_CRITICAL(&s_lock)
+
+static void ring_push(const lvgl_port_touch_sample_t *sample)
+{
+    RING_LOCK();
+    if (s_head - s_tail == LVGL_PORT_TOUCH_RING_SIZE) {
+        /* LVGL is behind: keep the newest state, which is the one that must not be lost */
+        s_tail++;
+        s_stats.dropped++;
+    }
+    s_ring[s_head & RING_MASK] = *sample;
+    s_head++;
+    RING_UNLOCK();
+}
+
+bool lvgl_port_touch_pop(lvgl_port_touch_sample_t *out)
+{
+    bool ok = false;
+    RING_LOCK();
+    if (s_tail != s_head) {
+        *out = s_ring[s_tail & RING_MASK];
+        s_tail++;
+        ok = true;
+    }
+    RING_UNLOCK();
+    return ok;
+}
+
+uint32_t lvgl_port_touch_pending(void)
+{
+    RING_LOCK();
+    uint32_t n = s_head - s_tail;
+    RING_UNLOCK();
+    return n;
+}
+
+bool lvgl_port_touch_sample(int64_t time_us)
+{
+    int16_t x = 0, y = 0;
+    int ret = s_cfg.read(s_cfg.ctx, &x, &y);
+    s_stats.reads++;
+    if (ret < 0) {
+        s_stats.errors++;
+        return s_last.pressed;
+    }
+
+    lvgl_port_touch_sample_t sample = {
+        .time_us = time_us,
+        .x       = ret > 0 ? x : s_last.x, /* LVGL reports the release where the finger left */
+        .y       = ret > 0 ? y : s_last.y,
+        .pressed = ret > 0,
+    };
+    if (sample.pressed == s_last.pressed && sample.x == s_last.x && sample.y == s_last.y) {
+        return sample.pressed;
+    }
+    ring_push(&sample);
+    s_last = sample;
+    s_stats.samples++;
+    if (s_cfg.ready) {
+        s_cfg.ready();
+    }
+    return sample.pressed;
+}
+
+IRAM_ATTR bool lvgl_port_touch_irq(void)
+{
+    BaseType_t need_yield = pdFALSE;
+    portENTER_CRITICAL_ISR(&s_lock);
+    s_irq_us = esp_timer_get_time();
+    s_stats.irqs++;
+    portEXIT_CRITICAL_ISR(&s_lock);
+    if (s_task) {
+        vTaskNotifyGiveFromISR(s_task, &need_yield);
+    }
+    return need_yield == pdTRUE;
+}
+
+static void touch_task(void *arg)
+{
+    /* The INT edges before the task existed notified nobody: read what they reported */
+    bool pressed = lvgl_port_touch_sample(esp_timer_get_time());
+    while (!s_stop) {
+        /* While pressed, also read on a timeout: a missed report would leave the finger down */
+        TickType_t wait = (s_cfg.irq && !pressed) ? portMAX_DELAY : pdMS_TO_TICKS(s_cfg.poll_ms);
+        int64_t time_us;
+        if (ulTaskNotifyTake(pdTRUE, wait) > 0 && s_cfg.irq) {
+            RING_LOCK();
+            time_us = s_irq_us;
+            RING_UNLOCK();
+        } else {
+            time_us = esp_timer_get_time();
+        }
+        if (!s_stop) {
+            pressed = lvgl_port_touch_sample(time_us);
+        }
+    }
+    s_task = NULL;
+    vTaskDelete(NULL);
+}
+
+bool lvgl_port_touch_init(const lvgl_port_touch_config_t *config)
+{
+    if (!config->read || config->poll_ms == 0) {
+        return false;
+    }
+    s_cfg  = *config;
+    s_head = 0;
+    s_tail = 0;
+    memset(&s_last, 0, sizeof(s_last));
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_stop = false;
+    /* The handle goes straight to s_task, so lvgl_port_touch_irq() can notify the task from its first instruction */
+    BaseType_t ret;
+    if (config->task_core < 0) {
+        ret = xTaskCreate(touch_task, "lvgl_touch", config->task_stack, NULL, config->task_priority, &s_task);
+    } else {
+        ret = xTaskCreatePinnedToCore(touch_task, "lvgl_touch", config->task_stack, NULL, config->task_priority,
+                                      &s_task, config->task_core);
+    }
+    if (ret != pdPASS) {
+        ESP_LOGE(TAG, "Create touch task failed");
+        s_task = NULL;
+        return false;
+    }
+    ESP_LOGI(TAG, "Touch sampled %s", config->irq ? "on INT" : "by polling");
+    return true;
+}
+
+void lvgl_port_touch_deinit(void)
+{
+    if (s_task) {
+        s_stop = true;
+        xTaskNotifyGive(s_task);
+        while (s_task) {
+            vTaskDelay(1);
+        }
+    }
+    memset(&s_cfg, 0, sizeof(s_cfg));
+}
+
+void lvgl_port_touch_get_stats(lvgl_port_touch_stats_t *out, bool reset)
+{
+    RING_LOCK();
+    *out = s_stats;
+    if (reset) {
+        memset(&s_stats, 0, sizeof(s_stats));
+    }
+    RING_UNLOCK();
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Touch sampler for the LVGL port.
+ *
+ * A task reads the touch controller only when the controller signals new data
+ * on its INT pin (lvgl_port_touch_irq() from the interrupt). While a finger
+ * is down it also reads every `poll_ms`, so a lost release report can't leave
+ * the pointer pressed. Without INT it reads every `poll_ms`. Each change is
+ * queued with its timestamp in a small ring, which the LVGL indev read
+ * callback drains with lvgl_port_touch_pop() without any bus I/O.
+ *
+ * The controller is reached through a read callback, so the sampler also
+ * runs on a host (tools/host) against a fake controller.
+ */
+
+#define LVGL_PORT_TOUCH_RING_SIZE 16 /* Power of two */
+
+typedef struct {
+    int64_t time_us; /* esp_timer time of the interrupt, or of the read when polling */
+    int16_t x;
+    int16_t y;
+    bool pressed;
+} lvgl_port_touch_sample_t;
+
+/* Read one point: > 0 pressed at (*x, *y), 0 released, < 0 bus error. */
+typedef int (*lvgl_port_touch_read_cb_t)(void* ctx, int16_t* x, int16_t* y);
+
+/* Called by the sampler after queuing a sample, e.g. to wake the LVGL task. */
+typedef void (*lvgl_port_touch_ready_cb_t)(void);
+
+typedef struct {
+    uint32_t irqs;    /* INT interrupts */
+    uint32_t reads;   /* Controller reads (bus transactions) */
+    uint32_t errors;  /* Failed reads */
+    uint32_t samples; /* Changes queued */
+    uint32_t dropped; /* Oldest samples overwritten because the ring was full */
+} lvgl_port_touch_stats_t;
+
+typedef struct {
+    lvgl_port_touch_read_cb_t read;
+    void* ctx;
+    lvgl_port_touch_ready_cb_t ready; /* May be NULL */
+    bool irq;                         /* lvgl_port_touch_irq() is called on the INT edge */
+    uint32_t poll_ms;                 /* Read period while pressed, or always without INT */
+    uint32_t task_stack;
+    uint32_t task_priority;
+    int task_core;                    /* -1: no affinity */
+} lvgl_port_touch_config_t;
+
+/* Start the sampler task. It reads the controller once when it starts, which covers INT edges seen before. */
+bool lvgl_port_touch_init(const lvgl_port_touch_config_t* config);
+void lvgl_port_touch_deinit(void);
+
+/* From the INT interrupt handler. Returns true if a higher priority task was woken. */
+bool lvgl_port_touch_irq(void);
+
+/*
+ * Read the controller once and queue the result if it differs from the last
+ * sample. Called by the sampler task; `time_us` is when the data was ready.
+ * Returns whether the panel is pressed.
+ */
+bool lvgl_port_touch_sample(int64_t time_us);
+
+/* Oldest queued sample. False if none. */
+bool lvgl_port_touch_pop(lvgl_port_touch_sample_t* out);
+
+/* Samples left to pop. */
+uint32_t lvgl_port_touch_pending(void);
+
+void lvgl_port_touch_get_stats(lvgl_port_touch_stats_t* out, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
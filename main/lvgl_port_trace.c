@@ -0,0 +1,294 @@
+#include "lvgl_port_trace.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#include "esp_attr.h"
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+/* Also taken from the VSYNC interrupt */
+#define TRACE_LOCK()   portENTER_CRITICAL_SAFE(&s_lock)
+#define TRACE_UNLOCK() portEXIT_CRITICAL_SAFE(&s_lock)
+#else
+#define IRAM_ATTR
+#define TRACE_LOCK()
+#define TRACE_UNLOCK()
+#endif
+
+#define STALE_US      1000000 /* An interaction still in flight after this long is abandoned */
+#define SUB_BUCKETS   4
+#define LINEAR_SHIFT  4       /* Below 64 us: 16 us buckets */
+#define FIRST_OCTAVE  6
+#define LAST_OCTAVE   19      /* From 2^20 us (~1 s) on: the last bucket */
+
+typedef struct {
+    uint32_t id;    /* 0: free */
+    uint8_t next;   /* Next stamp expected */
+    uint32_t frame; /* Frame drawn for it, once rendered */
+    int64_t stamp_us[LVGL_PORT_TRACE_STAMPS];
+} trace_slot_t;
+
+static trace_slot_t s_slots[LVGL_PORT_TRACE_SLOTS];
+static lvgl_port_trace_stats_t s_stats;
+static uint32_t s_next_id = 1;
+static bool s_async_flush;
+static bool s_vsync;
+static bool s_flushed_seen;      /* A frame was flushed since init */
+static uint32_t s_flushed_frame; /* Last frame flushed, and when */
+static int64_t s_flushed_us;
+
+static IRAM_ATTR uint32_t bucket_of(uint32_t us)
+{
+    if (us < (SUB_BUCKETS << LINEAR_SHIFT)) {
+        return us >> LINEAR_SHIFT;
+    }
+    uint32_t octave = 31 - __builtin_clz(us);
+    if (octave > LAST_OCTAVE) {
+        return LVGL_PORT_TRACE_BUCKETS - 1;
+    }
+    uint32_t sub = (us >> (octave - 2)) & (SUB_BUCKETS - 1);
+    return SUB_BUCKETS + (octave - FIRST_OCTAVE) * SUB_BUCKETS + sub;
+}
+
+static uint32_t bucket_top(uint32_t bucket)
+{
+    if (bucket < SUB_BUCKETS) {
+        return (bucket + 1) << LINEAR_SHIFT;
+    }
+    if (bucket >= LVGL_PORT_TRACE_BUCKETS - 1) {
+        return UINT32_MAX;
+    }
+    uint32_t octave = FIRST_OCTAVE + (bucket - SUB_BUCKETS) / SUB_BUCKETS;
+    uint32_t sub    = (bucket - SUB_BUCKETS) % SUB_BUCKETS;
+    return (SUB_BUCKETS + sub + 1) << (octave - 2);
+}
+
+static IRAM_ATTR void hist_add(lvgl_port_trace_histogram_t *hist, int64_t us)
+{
+    uint32_t v = (us <= 0) ? 0 : (us >= UINT32_MAX) ? UINT32_MAX : (uint32_t)us;
+    hist->count++;
+    hist->sum_us += v;
+    if (v > hist->max_us) {
+        hist->max_us = v;
+    }
+    hist->buckets[bucket_of(v)]++;
+}
+
+/* Lock held */
+static IRAM_ATTR void complete(trace_slot_t *slot)
+{
+    const int64_t *t = slot->stamp_us;
+    for (int i = LVGL_PORT_TRACE_H_DISPATCH; i <= LVGL_PORT_TRACE_H_SCANOUT; ++i) {
+        hist_add(&s_stats.hist[i], t[i + 1] - t[i]);
+    }
+    int64_t total = t[LVGL_PORT_TRACE_PHOTON] - t[LVGL_PORT_TRACE_TOUCH];
+    hist_add(&s_stats.hist[LVGL_PORT_TRACE_H_TOTAL], total);
+    const int64_t *w = s_stats.worst.stamp_us;
+    if ((s_stats.worst.id == 0) || (total > w[LVGL_PORT_TRACE_PHOTON] - w[LVGL_PORT_TRACE_TOUCH])) {
+        s_stats.worst.id = slot->id;
+        memcpy(s_stats.worst.stamp_us, t, sizeof(s_stats.worst.stamp_us));
+    }
+    s_stats.completed++;
+    slot->id = 0;
+}
+
+/* Lock held. Record `stamp` for `slot`, and the stamps that follow from it. */
+static IRAM_ATTR void stamp_slot(trace_slot_t *slot, uint8_t stamp, int64_t now_us)
+{
+    slot->stamp_us[stamp] = now_us;
+    slot->next            = stamp + 1;
+    if ((slot->next == LVGL_PORT_TRACE_PHOTON) && !s_vsync) {
+        slot->stamp_us[LVGL_PORT_TRACE_PHOTON] = slot->stamp_us[LVGL_PORT_TRACE_FLUSHED];
+        slot->next                             = LVGL_PORT_TRACE_STAMPS;
+    }
+    if (slot->next == LVGL_PORT_TRACE_STAMPS) {
+        complete(slot);
+    }
+}
+
+/* Lock held. Stamp every interaction waiting for `stamp`. */
+static IRAM_ATTR void mark(uint8_t stamp, int64_t now_us)
+{
+    for (int i = 0; i < LVGL_PORT_TRACE_SLOTS; ++i) {
+        trace_slot_t *slot = &s_slots[i];
+        if ((slot->id != 0) && (slot->next == stamp)) {
+            stamp_slot(slot, stamp, now_us);
+        }
+    }
+}
+
+void lvgl_port_trace_init(bool async_flush, bool vsync)
+{
+    TRACE_LOCK();
+    memset(s_slots, 0, sizeof(s_slots));
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_next_id      = 1;
+    s_async_flush  = async_flush;
+    s_vsync        = vsync;
+    s_flushed_seen = false;
+    TRACE_UNLOCK();
+}
+
+uint32_t lvgl_port_trace_input(int64_t time_us)
+{
+    TRACE_LOCK();
+    trace_slot_t *slot = NULL;
+    for (int i = 0; i < LVGL_PORT_TRACE_SLOTS; ++i) {
+        trace_slot_t *s = &s_slots[i];
+        if ((s->id != 0) && (time_us - s->stamp_us[LVGL_PORT_TRACE_TOUCH] > STALE_US)) {
+            s->id = 0;
+            s_stats.abandoned++;
+        }
+        if ((s->id == 0) && (slot == NULL)) {
+            slot = s;
+        }
+    }
+    if (slot == NULL) {
+        // Push out the oldest
+        slot = &s_slots[0];
+        for (int i = 1; i < LVGL_PORT_TRACE_SLOTS; ++i) {
+            if (s_slots[i].stamp_us[LVGL_PORT_TRACE_TOUCH] < slot->stamp_us[LVGL_PORT_TRACE_TOUCH]) {
+                slot = &s_slots[i];
+            }
+        }
+        s_stats.abandoned++;
+    }
+    uint32_t id = s_next_id++;
+    if (s_next_id == 0) {
+        s_next_id = 1;
+    }
+    slot->id                              = id;
+    slot->next                            = LVGL_PORT_TRACE_DISPATCH;
+    slot->stamp_us[LVGL_PORT_TRACE_TOUCH] = time_us;
+    TRACE_UNLOCK();
+    return id;
+}
+
+void lvgl_port_trace_dispatch(int64_t now_us)
+{
+    TRACE_LOCK();
+    mark(LVGL_PORT_TRACE_DISPATCH, now_us);
+    TRACE_UNLOCK();
+}
+
+void lvgl_port_trace_invalid(int64_t now_us)
+{
+    TRACE_LOCK();
+    mark(LVGL_PORT_TRACE_INVALID, now_us);
+    TRACE_UNLOCK();
+}
+
+void lvgl_port_trace_rendered(int64_t now_us, uint32_t frame)
+{
+    TRACE_LOCK();
+    // The flush task may have flushed the last area before the refresh timer returned
+    bool flushed       = !s_async_flush || (s_flushed_seen && (s_flushed_frame == frame));
+    int64_t flushed_us = s_async_flush ? s_flushed_us : now_us;
+    for (int i = 0; i < LVGL_PORT_TRACE_SLOTS; ++i) {
+        trace_slot_t *slot = &s_slots[i];
+        if ((slot->id == 0) || (slot->next != LVGL_PORT_TRACE_RENDERED)) {
+            continue;
+        }
+        slot->frame = frame;
+        if (!flushed) {
+            stamp_slot(slot, LVGL_PORT_TRACE_RENDERED, now_us);
+            continue;
+        }
+        slot->stamp_us[LVGL_PORT_TRACE_RENDERED] = (flushed_us < now_us) ? flushed_us : now_us;
+        stamp_slot(slot, LVGL_PORT_TRACE_FLUSHED, flushed_us);
+    }
+    TRACE_UNLOCK();
+}
+
+void lvgl_port_trace_flushed(int64_t now_us, uint32_t frame)
+{
+    TRACE_LOCK();
+    s_flushed_seen  = true;
+    s_flushed_frame = frame;
+    s_flushed_us    = now_us;
+    for (int i = 0; i < LVGL_PORT_TRACE_SLOTS; ++i) {
+        trace_slot_t *slot = &s_slots[i];
+        // Slots rendered in a later frame wait for that frame's flush
+        if ((slot->id != 0) && (slot->next == LVGL_PORT_TRACE_FLUSHED) && ((int32_t)(frame - slot->frame) >= 0)) {
+            stamp_slot(slot, LVGL_PORT_TRACE_FLUSHED, now_us);
+        }
+    }
+    TRACE_UNLOCK();
+}
+
+IRAM_ATTR void lvgl_port_trace_vsync(int64_t now_us)
+{
+    TRACE_LOCK();
+    mark(LVGL_PORT_TRACE_PHOTON, now_us);
+    TRACE_UNLOCK();
+}
+
+void lvgl_port_trace_idle(void)
+{
+    TRACE_LOCK();
+    for (int i = 0; i < LVGL_PORT_TRACE_SLOTS; ++i) {
+        if ((s_slots[i].id != 0) && (s_slots[i].next == LVGL_PORT_TRACE_INVALID)) {
+            s_slots[i].id = 0;
+            s_stats.no_redraw++;
+        }
+    }
+    TRACE_UNLOCK();
+}
+
+void lvgl_port_trace_get_stats(lvgl_port_trace_stats_t *out, bool reset)
+{
+    TRACE_LOCK();
+    *out = s_stats;
+    if (reset) {
+        memset(&s_stats, 0, sizeof(s_stats));
+    }
+    TRACE_UNLOCK();
+}
+
+uint32_t lvgl_port_trace_percentile(const lvgl_port_trace_histogram_t *hist, uint32_t permille)
+{
+    if (hist->count == 0) {
+        return 0;
+    }
+    uint32_t rank = (uint32_t)(((uint64_t)hist->count * permille + 999) / 1000);
+    uint32_t seen = 0;
+    for (uint32_t i = 0; i < LVGL_PORT_TRACE_BUCKETS; ++i) {
+        seen += hist->buckets[i];
+        if ((seen >= rank) && (seen > 0)) {
+            // The bucket top can exceed the largest value seen
+            uint32_t top = bucket_top(i);
+            return (top < hist->max_us) ? top : hist->max_us;
+        }
+    }
+    return hist->max_us;
+}
+
+size_t lvgl_port_trace_format(const lvgl_port_trace_stats_t *stats, char *buf, size_t size)
+{
+    static const char *const names[LVGL_PORT_TRACE_H_NUM] = {"dispatch", "handle", "render",
+                                                             "flush",    "scanout", "total"};
+    int n = snprintf(buf, size, "{\"bench\":\"latency\",\"n\":%u,\"no_redraw\":%u,\"abandoned\":%u",
+                     (unsigned)stats->completed, (unsigned)stats->no_redraw, (unsigned)stats->abandoned);
+    for (int i = 0; i < LVGL_PORT_TRACE_H_NUM && n < (int)size; ++i) {
+        const lvgl_port_trace_histogram_t *h = &stats->hist[i];
+        n += snprintf(buf + n, size - n, ",\"%s_ms\":[%.1f,%.1f,%.1f,%.1f]", names[i],
+                      lvgl_port_trace_percentile(h, 500) / 1000.0, lvgl_port_trace_percentile(h, 900) / 1000.0,
+                      lvgl_port_trace_percentile(h, 990) / 1000.0, h->max_us / 1000.0);
+    }
+    const lvgl_port_trace_record_t *w = &stats->worst;
+    if ((w->id != 0) && (n < (int)size)) {
+        n += snprintf(buf + n, size - n, ",\"worst\":{\"id\":%u", (unsigned)w->id);
+        for (int i = LVGL_PORT_TRACE_DISPATCH; i < LVGL_PORT_TRACE_STAMPS && n < (int)size; ++i) {
+            n += snprintf(buf + n, size - n, ",\"%s_ms\":%.1f", names[i - 1],
+                          (w->stamp_us[i] - w->stamp_us[i - 1]) / 1000.0);
+        }
+        if (n < (int)size) {
+            n += snprintf(buf + n, size - n, ",\"total_ms\":%.1f}",
+                          (w->stamp_us[LVGL_PORT_TRACE_PHOTON] - w->stamp_us[LVGL_PORT_TRACE_TOUCH]) / 1000.0);
+        }
+    }
+    if (n < (int)size) {
+        n += snprintf(buf + n, size - n, "}\n");
+    }
+    return (n < (int)size) ? (size_t)n : size - 1;
+}
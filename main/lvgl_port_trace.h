@@ -0,0 +1,116 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Touch-to-photon latency tracing for the LVGL port.
+ *
+ * Every touch press or release starts an interaction with a new ID. The port
+ * stamps it as it goes through the pipeline:
+ *
+ *   touch     time of the touch sample (the INT edge with the touch task)
+ *   dispatch  LVGL sends the first event for it (indev `feedback_cb`)
+ *   invalid   the display has something to draw after the event handlers ran
+ *             (invalidation or screen load), or the refresh starts
+ *   rendered  the refresh timer returns, or the last area is flushed if
+ *             that comes first
+ *   flushed   the last area is in the frame buffer
+ *   photon    the next VSYNC after that, or `flushed` when the port has no
+ *             VSYNC to wait for (the tearing modes wait for it in flush_cb)
+ *
+ * Completed interactions add the time between consecutive stamps to
+ * log-linear histograms (four buckets per octave, from 16 us to ~1 s), from
+ * which the percentiles of a report are read. An input that draws nothing is
+ * dropped. Each hook is a few compares under a spinlock, so tracing can stay
+ * on in the field. Hooks take the time so host builds can replay a sequence
+ * (tools/host/trace_test.c).
+ */
+
+#define LVGL_PORT_TRACE_SLOTS   4  /* Interactions in flight at once */
+#define LVGL_PORT_TRACE_BUCKETS 61
+
+typedef enum {
+    LVGL_PORT_TRACE_TOUCH = 0,
+    LVGL_PORT_TRACE_DISPATCH,
+    LVGL_PORT_TRACE_INVALID,
+    LVGL_PORT_TRACE_RENDERED,
+    LVGL_PORT_TRACE_FLUSHED,
+    LVGL_PORT_TRACE_PHOTON,
+    LVGL_PORT_TRACE_STAMPS,
+} lvgl_port_trace_stamp_t;
+
+/* Histograms: the time from the previous stamp to each stamp, and touch to photon */
+typedef enum {
+    LVGL_PORT_TRACE_H_DISPATCH = 0,
+    LVGL_PORT_TRACE_H_HANDLE,
+    LVGL_PORT_TRACE_H_RENDER,
+    LVGL_PORT_TRACE_H_FLUSH,
+    LVGL_PORT_TRACE_H_SCANOUT,
+    LVGL_PORT_TRACE_H_TOTAL,
+    LVGL_PORT_TRACE_H_NUM,
+} lvgl_port_trace_hist_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t max_us;
+    uint64_t sum_us;
+    uint32_t buckets[LVGL_PORT_TRACE_BUCKETS];
+} lvgl_port_trace_histogram_t;
+
+typedef struct {
+    uint32_t id;
+    int64_t stamp_us[LVGL_PORT_TRACE_STAMPS];
+} lvgl_port_trace_record_t;
+
+typedef struct {
+    uint32_t completed; /* Interactions that reached the screen */
+    uint32_t no_redraw; /* Inputs that drew nothing */
+    uint32_t abandoned; /* Interactions pushed out by newer ones or stuck for over a second */
+    lvgl_port_trace_record_t worst; /* Slowest completed interaction, id 0 if none */
+    lvgl_port_trace_histogram_t hist[LVGL_PORT_TRACE_H_NUM];
+} lvgl_port_trace_stats_t;
+
+/*
+ * `async_flush`: the last area is flushed by another task, and
+ * lvgl_port_trace_flushed() is called then; otherwise `rendered` is also
+ * `flushed`. `vsync`: lvgl_port_trace_vsync() is called on every VSYNC.
+ */
+void lvgl_port_trace_init(bool async_flush, bool vsync);
+
+/* Touch press or release sampled at `time_us`. Returns the interaction ID. */
+uint32_t lvgl_port_trace_input(int64_t time_us);
+void lvgl_port_trace_dispatch(int64_t now_us);
+void lvgl_port_trace_invalid(int64_t now_us);
+/*
+ * The refresh timer returned from drawing frame `frame`, a number the port
+ * increments for every frame it draws. With `async_flush` the last area of the
+ * frame may already have been flushed, before the timer returned.
+ */
+void lvgl_port_trace_rendered(int64_t now_us, uint32_t frame);
+/* The last area of frame `frame` is in the frame buffer */
+void lvgl_port_trace_flushed(int64_t now_us, uint32_t frame);
+/* From the VSYNC interrupt */
+void lvgl_port_trace_vsync(int64_t now_us);
+/* Input processing is over and nothing is invalid: dispatched inputs drew nothing */
+void lvgl_port_trace_idle(void);
+
+void lvgl_port_trace_get_stats(lvgl_port_trace_stats_t* out, bool reset);
+
+/* Upper bound of the bucket holding the `permille`-th value, 0 if empty. */
+uint32_t lvgl_port_trace_percentile(const lvgl_port_trace_histogram_t* hist, uint32_t permille);
+
+/*
+ * One JSON line ("\n"-terminated) with counts, p50/p90/p99/max of every
+ * histogram in ms and the phases of the slowest interaction. Returns its
+ * length, truncated to `size - 1`.
+ */
+size_t lvgl_port_trace_format(const lvgl_port_trace_stats_t* stats, char* buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
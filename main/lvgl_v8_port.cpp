@@ -4,11 +4,20 @@
  * SPDX-License-Identifier: CC0-1.0
  */
 
+#include <atomic>
+
 #include "esp_timer.h"
 #undef ESP_UTILS_LOG_TAG
 #define ESP_UTILS_LOG_TAG "LvPort"
 #include "esp_lib_utils.h"
 #include "lvgl_v8_port.h"
+#include "lvgl_port_blend.h"
+#include "lvgl_port_blit.h"
+#include "lvgl_port_damage.h"
+#include "lvgl_port_rotate.h"
+#include "lvgl_port_touch.h"
+#include "lvgl_port_trace.h"
+#include "src/draw/sw/lv_draw_sw.h"
 
 using namespace esp_panel::drivers;
 
@@ -19,6 +28,12 @@ static SemaphoreHandle_t lvgl_mux               = nullptr; // LVGL mutex
 static TaskHandle_t lvgl_task_handle            = nullptr;
 static esp_timer_handle_t lvgl_tick_timer       = NULL;
 static void* lvgl_buf[LVGL_PORT_BUFFER_NUM_MAX] = {};
+static LCD* global_lcd_ptr                      = nullptr; // For the VSYNC callback attached in lvgl_port_start()
+static Touch* global_tp_ptr                     = nullptr; // For the touch interrupt attached in lvgl_port_start()
+#if CONFIG_LVGL_PORT_STATS
+static lvgl_port_stats_t port_stats = {};
+static int64_t input_t0             = 0; // Time of the touch press or release not drawn yet, 0 if none
+#endif
 
 #if LVGL_PORT_ROTATION_DEGREE != 0
 static void* get_next_frame_buffer(LCD* lcd)
@@ -69,33 +84,6 @@ __attribute__((always_inline)) static inline void copy_pixel_24bpp(uint8_t* to,
         }                                                                                                              \
     }
 
-/**
- * @brief Optimized transpose function for RGB565 format.
- *
- * @note  ESP32-P4 1024x600 full-screen: 738ms -> 34ms
- * @note  ESP32-S3 480x480  full-screen: 380ms -> 37ms
- */
-#define ROTATE_90_OPTIMIZED_16BPP(block_w, block_h)                                                                    \
-    {                                                                                                                  \
-        for (int i = 0; i < h; i += block_h) {                                                                         \
-            max_height = (i + block_h > h) ? h : (i + block_h);                                                        \
-            for (int j = 0; j < w; j += block_w) {                                                                     \
-                max_width = (j + block_w > w) ? w : (j + block_w);                                                     \
-                start_y   = w - 1 - j;                                                                                 \
-                for (int x = i; x < max_height; x++) {                                                                 \
-                    from_next = (uint16_t*)from + x * w;                                                               \
-                    for (int y = j, mirrored_y = start_y; y < max_width; y += 4, mirrored_y -= 4) {                    \
-                        ((uint16_t*)to)[(mirrored_y)*h + x]       = *((uint32_t*)(from_next + y)) & 0xFFFF;            \
-                        ((uint16_t*)to)[(mirrored_y - 1) * h + x] = (*((uint32_t*)(from_next + y)) >> 16) & 0xFFFF;    \
-                        ((uint16_t*)to)[(mirrored_y - 2) * h + x] = *((uint32_t*)(from_next + y + 2)) & 0xFFFF;        \
-                        ((uint16_t*)to)[(mirrored_y - 3) * h + x] =                                                    \
-                            (*((uint32_t*)(from_next + y + 2)) >> 16) & 0xFFFF;                                        \
-                    }                                                                                                  \
-                }                                                                                                      \
-            }                                                                                                          \
-        }                                                                                                              \
-    }
-
 #define ROTATE_180_ALL_BPP()                                                                                           \
     {                                                                                                                  \
         to_bytes_per_line = w * to_bytes_per_piexl;                                                                    \
@@ -111,26 +99,6 @@ __attribute__((always_inline)) static inline void copy_pixel_24bpp(uint8_t* to,
         }                                                                                                              \
     }
 
-#define ROTATE_270_OPTIMIZED_16BPP(block_w, block_h)                                                                   \
-    {                                                                                                                  \
-        for (int i = 0; i < h; i += block_h) {                                                                         \
-            max_height = i + block_h > h ? h : i + block_h;                                                            \
-            for (int j = 0; j < w; j += block_w) {                                                                     \
-                max_width = j + block_w > w ? w : j + block_w;                                                         \
-                for (int x = i; x < max_height; x++) {                                                                 \
-                    from_next = (uint16_t*)from + x * w;                                                               \
-                    for (int y = j; y < max_width; y += 4) {                                                           \
-                        ((uint16_t*)to)[y * h + (h - 1 - x)]       = *((uint32_t*)(from_next + y)) & 0xFFFF;           \
-                        ((uint16_t*)to)[(y + 1) * h + (h - 1 - x)] = (*((uint32_t*)(from_next + y)) >> 16) & 0xFFFF;   \
-                        ((uint16_t*)to)[(y + 2) * h + (h - 1 - x)] = *((uint32_t*)(from_next + y + 2)) & 0xFFFF;       \
-                        ((uint16_t*)to)[(y + 3) * h + (h - 1 - x)] =                                                   \
-                            (*((uint32_t*)(from_next + y + 2)) >> 16) & 0xFFFF;                                        \
-                    }                                                                                                  \
-                }                                                                                                      \
-            }                                                                                                          \
-        }                                                                                                              \
-    }
-
 #define ROTATE_270_ALL_BPP()                                                                                           \
     {                                                                                                                  \
         to_bytes_per_line = h * to_bytes_per_piexl;                                                                    \
@@ -152,6 +120,10 @@ __attribute__((always_inline)) IRAM_ATTR static inline void rotate_copy_pixel(co
                                                                               uint16_t x_end, uint16_t y_end,
                                                                               uint16_t w, uint16_t h, uint16_t rotate)
 {
+#if (LV_COLOR_DEPTH == 16) && LVGL_PORT_ENABLE_ROTATION_OPTIMIZED
+    // Blocked kernels, only the area
+    lvgl_port_rotate_rgb565((const uint16_t*)from, (uint16_t*)to, w, h, x_start, y_start, x_end, y_end, rotate);
+#else
     int from_bytes_per_piexl = sizeof(lv_color_t);
     int from_bytes_per_line  = w * from_bytes_per_piexl;
     int from_index           = 0;
@@ -161,44 +133,66 @@ __attribute__((always_inline)) IRAM_ATTR static inline void rotate_copy_pixel(co
     int to_index       = 0;
     int to_index_const = 0;
 
-#if (LV_COLOR_DEPTH == 16) && LVGL_PORT_ENABLE_ROTATION_OPTIMIZED
-    int max_height      = 0;
-    int max_width       = 0;
-    int start_y         = 0;
-    uint16_t* from_next = NULL;
-#endif
-
     // uint32_t time = esp_log_timestamp();
     switch (rotate) {
     case 90:
-#if (LV_COLOR_DEPTH == 16) && LVGL_PORT_ENABLE_ROTATION_OPTIMIZED
-        ROTATE_90_OPTIMIZED_16BPP(32, 256);
-#else
         ROTATE_90_ALL_BPP();
-#endif
         break;
     case 180:
         ROTATE_180_ALL_BPP();
         break;
-    case 270:
-#if (LV_COLOR_DEPTH == 16) && LVGL_PORT_ENABLE_ROTATION_OPTIMIZED
-        ROTATE_270_OPTIMIZED_16BPP(32, 256);
-#else
+    case 270: {
         int from_index_const = 0;
         ROTATE_270_ALL_BPP();
-#endif
         break;
+    }
     default:
         break;
     }
+#endif
     // ESP_LOGI(TAG, "rotate: end, time used:%d", (int)(esp_log_timestamp() -
     // time));
 }
+
+// Rotate an area of the LVGL buffer into an LCD frame buffer
+static void rotate_area(const void* from, void* to, lv_coord_t x1, lv_coord_t y1, lv_coord_t x2, lv_coord_t y2)
+{
+    rotate_copy_pixel((const uint8_t*)from, (uint8_t*)to, x1, y1, x2, y2, LV_HOR_RES, LV_VER_RES,
+                      LVGL_PORT_ROTATION_DEGREE);
+#if CONFIG_LVGL_PORT_STATS
+    port_stats.rotate_px += (uint32_t)(x2 - x1 + 1) * (uint32_t)(y2 - y1 + 1);
+#endif
+}
 #endif /* LVGL_PORT_ROTATION_DEGREE */
 
 #if LVGL_PORT_AVOID_TEAR
 #if LVGL_PORT_DIRECT_MODE
 #if LVGL_PORT_ROTATION_DEGREE != 0
+#if LVGL_PORT_BUFFER_AGE
+static void flush_callback(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* color_map)
+{
+    LCD* lcd = (LCD*)drv->user_data;
+
+    /* Action after last area refresh */
+    if (lv_disp_flush_is_last(drv)) {
+        void* next_fb = get_next_frame_buffer(lcd);
+        int fb        = (next_fb == lcd->getFrameBufferByIndex(0)) ? 0 : 1;
+
+        /* Rotate into `next_fb` only the areas it missed since it was last on the panel */
+        lvgl_port_damage_frame(_lv_refr_get_disp_refreshing(), fb, color_map, next_fb, rotate_area);
+
+        /* Switch the current LCD frame buffer to `next_fb` */
+        lcd->switchFrameBufferTo(next_fb);
+
+        /* Waiting for the current frame buffer to complete transmission, the other one is written next */
+        ulTaskNotifyValueClear(NULL, ULONG_MAX);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+
+    lv_disp_flush_ready(drv);
+}
+
+#else
 typedef struct {
     uint16_t inv_p;
     uint8_t inv_area_joined[LV_INV_BUF_SIZE];
@@ -287,8 +281,7 @@ static void flush_dirty_copy(void* dst, void* src, lv_port_dirty_area_t* dirty_a
             y_start = dirty_area->inv_areas[i].y1;
             y_end   = dirty_area->inv_areas[i].y2;
 
-            rotate_copy_pixel((uint8_t*)src, (uint8_t*)dst, x_start, y_start, x_end, y_end, LV_HOR_RES, LV_VER_RES,
-                              LVGL_PORT_ROTATION_DEGREE);
+            rotate_area(src, dst, x_start, y_start, x_end, y_end);
         }
     }
 }
@@ -314,8 +307,7 @@ static void flush_callback(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t
             // Rotate and copy data from the whole screen LVGL's buffer to the
             // next frame buffer
             next_fb = flush_get_next_buf(lcd);
-            rotate_copy_pixel((uint8_t*)color_map, (uint8_t*)next_fb, offsetx1, offsety1, offsetx2, offsety2,
-                              LV_HOR_RES, LV_VER_RES, LVGL_PORT_ROTATION_DEGREE);
+            rotate_area(color_map, next_fb, offsetx1, offsety1, offsetx2, offsety2);
 
             /* Switch the current LCD frame buffer to `next_fb` */
             lcd->switchFrameBufferTo(next_fb);
@@ -370,6 +362,7 @@ static void flush_callback(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t
 
     lv_disp_flush_ready(drv);
 }
+#endif /* LVGL_PORT_BUFFER_AGE */
 
 #else
 
@@ -428,8 +421,7 @@ void flush_callback(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* color
 
     /* Rotate and copy dirty area from the current LVGL's buffer to the next LCD
      * frame buffer */
-    rotate_copy_pixel((uint8_t*)color_map, (uint8_t*)next_fb, offsetx1, offsety1, offsetx2, offsety2, LV_HOR_RES,
-                      LV_VER_RES, LVGL_PORT_ROTATION_DEGREE);
+    rotate_area(color_map, next_fb, offsetx1, offsety1, offsetx2, offsety2);
 
     /* Switch the current LCD frame buffer to `next_fb` */
     lcd->switchFrameBufferTo(next_fb);
@@ -474,6 +466,10 @@ void flush_callback(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* color
     const int offsety1 = area->y1;
     const int offsety2 = area->y2;
 
+#if LVGL_PORT_ASYNC_BLIT
+    // Image rows may still be on their way into `color_map`
+    lvgl_port_blit_wait_buf(color_map);
+#endif
     lcd->drawBitmap(offsetx1, offsety1, offsetx2 - offsetx1 + 1, offsety2 - offsety1 + 1, (const uint8_t*)color_map);
     // For RGB LCD, directly notify LVGL that the buffer is ready
     if (lcd->getBus()->getBasicAttributes().type == ESP_PANEL_BUS_TYPE_RGB) {
@@ -526,6 +522,130 @@ static void update_callback(lv_disp_drv_t* drv)
 
 #endif /* LVGL_PORT_AVOID_TEAR */
 
+#if LVGL_PORT_TRACE
+static uint32_t trace_frame = 0; // Frames drawn, counted by the LVGL task
+#endif
+
+#if LVGL_PORT_FLUSH_TASK
+/**
+ * Single-producer/single-consumer ring between the LVGL task (`flush_cb`) and
+ * the flush task. LVGL waits for `flushing` to clear before it queues the next
+ * buffer, so at most both draw buffers are in the ring at once.
+ */
+typedef struct {
+    lv_disp_drv_t* drv;
+    lv_area_t area;
+    lv_color_t* color_map;
+    bool last; // Last area of the frame
+#if LVGL_PORT_TRACE
+    uint32_t frame;
+#endif
+} lv_port_flush_job_t;
+
+static lv_port_flush_job_t flush_jobs[LVGL_PORT_BUFFER_NUM_MAX];
+static std::atomic<uint32_t> flush_head{0}; // Written by the LVGL task only
+static std::atomic<uint32_t> flush_tail{0}; // Written by the flush task only
+static TaskHandle_t flush_task_handle = nullptr;
+static SemaphoreHandle_t flush_done   = nullptr; // Given after each flushed buffer, wakes `wait_cb`
+#if CONFIG_LVGL_PORT_STATS
+static std::atomic<uint32_t> flush_task_us{0};
+#endif
+
+static void flush_task(void* arg)
+{
+    ESP_UTILS_LOGD("Starting LVGL flush task");
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        uint32_t tail = flush_tail.load(std::memory_order_relaxed);
+        while (tail != flush_head.load(std::memory_order_acquire)) {
+            lv_port_flush_job_t* job = &flush_jobs[tail % LVGL_PORT_BUFFER_NUM_MAX];
+#if CONFIG_LVGL_PORT_STATS
+            int64_t start = esp_timer_get_time();
+#endif
+            flush_callback(job->drv, &job->area, job->color_map);
+#if CONFIG_LVGL_PORT_STATS
+            flush_task_us.fetch_add((uint32_t)(esp_timer_get_time() - start), std::memory_order_relaxed);
+#endif
+#if LVGL_PORT_TRACE
+            if (job->last) {
+                lvgl_port_trace_flushed(esp_timer_get_time(), job->frame);
+            }
+#endif
+            flush_tail.store(++tail, std::memory_order_release);
+            xSemaphoreGive(flush_done);
+        }
+    }
+}
+
+static void flush_callback_async(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* color_map)
+{
+    uint32_t head = flush_head.load(std::memory_order_relaxed);
+    while (head - flush_tail.load(std::memory_order_acquire) >= LVGL_PORT_BUFFER_NUM_MAX) {
+        xSemaphoreTake(flush_done, pdMS_TO_TICKS(LVGL_PORT_TASK_MIN_DELAY_MS));
+    }
+
+    lv_port_flush_job_t* job = &flush_jobs[head % LVGL_PORT_BUFFER_NUM_MAX];
+    job->drv                 = drv;
+    job->area                = *area;
+    job->color_map           = color_map;
+    job->last                = lv_disp_flush_is_last(drv);
+#if LVGL_PORT_TRACE
+    job->frame = trace_frame;
+#endif
+    flush_head.store(head + 1, std::memory_order_release);
+    xTaskNotifyGive(flush_task_handle);
+}
+
+// Called by LVGL while it waits for `lv_disp_flush_ready()`, instead of spinning
+static void flush_wait_callback(lv_disp_drv_t* drv)
+{
+    xSemaphoreTake(flush_done, pdMS_TO_TICKS(LVGL_PORT_TASK_MIN_DELAY_MS));
+}
+
+static bool flush_task_init(void)
+{
+    flush_done = xSemaphoreCreateBinary();
+    ESP_UTILS_CHECK_NULL_RETURN(flush_done, false, "Create flush semaphore failed");
+
+    BaseType_t ret = xTaskCreatePinnedToCore(flush_task, "lvgl_flush", LVGL_PORT_FLUSH_TASK_STACK_SIZE, NULL,
+                                             LVGL_PORT_FLUSH_TASK_PRIORITY, &flush_task_handle,
+                                             LVGL_PORT_FLUSH_TASK_CORE);
+    ESP_UTILS_CHECK_FALSE_RETURN(ret == pdPASS, false, "Create LVGL flush task failed");
+    return true;
+}
+
+static void flush_task_deinit(void)
+{
+    if (flush_task_handle != nullptr) {
+        vTaskDelete(flush_task_handle);
+        flush_task_handle = nullptr;
+    }
+    if (flush_done != nullptr) {
+        vSemaphoreDelete(flush_done);
+        flush_done = nullptr;
+    }
+    flush_head.store(0);
+    flush_tail.store(0);
+}
+#endif /* LVGL_PORT_FLUSH_TASK */
+
+#if LVGL_PORT_PARALLEL_BLEND || LVGL_PORT_ASYNC_BLIT
+static void draw_ctx_init(lv_disp_drv_t* drv, lv_draw_ctx_t* draw_ctx)
+{
+    lv_draw_sw_init_ctx(drv, draw_ctx);
+
+#if LVGL_PORT_PARALLEL_BLEND
+    lvgl_port_blend_attach(draw_ctx, LVGL_PORT_PARALLEL_BLEND_MIN_PX);
+#endif
+#if LVGL_PORT_ASYNC_BLIT
+    // Outermost, so a blend waits for the copies it overlaps before it is split, and blits are never split
+    lvgl_port_blit_attach(drv, draw_ctx, LVGL_PORT_ASYNC_BLIT_MIN_PX);
+#endif
+}
+#endif
+
 void rounder_callback(lv_disp_drv_t* drv, lv_area_t* area)
 {
     LCD* lcd        = (LCD*)drv->user_data;
@@ -547,6 +667,120 @@ void rounder_callback(lv_disp_drv_t* drv, lv_area_t* area)
     }
 }
 
+#if CONFIG_LVGL_PORT_STATS
+static void flush_callback_stats(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* color_map)
+{
+#if LVGL_PORT_FLUSH_TASK
+    // The copy is timed on the flush task
+    flush_callback_async(drv, area, color_map);
+#else
+    int64_t start = esp_timer_get_time();
+    flush_callback(drv, area, color_map);
+    port_stats.flush_us += (uint32_t)(esp_timer_get_time() - start);
+#endif
+    port_stats.flush_calls++;
+    port_stats.flush_px += lv_area_get_size(area);
+}
+
+static void refr_timer_stats(lv_timer_t* timer)
+{
+    uint32_t flush_calls = port_stats.flush_calls;
+    int64_t start        = esp_timer_get_time();
+    _lv_disp_refr_timer(timer);
+    int64_t end = esp_timer_get_time();
+
+    // Nothing was invalid
+    if (port_stats.flush_calls == flush_calls) {
+        return;
+    }
+    port_stats.frames++;
+    port_stats.refr_us += (uint32_t)(end - start);
+    if (input_t0 != 0) {
+        port_stats.input_events++;
+        port_stats.input_latency_us += (uint32_t)(end - input_t0);
+        input_t0 = 0;
+    }
+    if (port_stats.first_frame_end == 0) {
+        port_stats.first_frame_end = end;
+    }
+    port_stats.last_frame_end = end;
+}
+#endif
+
+#if CONFIG_LVGL_PORT_STATS || LVGL_PORT_TRACE
+static void refr_timer_cb(lv_timer_t* timer)
+{
+#if LVGL_PORT_TRACE
+    lv_disp_t* disp = (lv_disp_t*)timer->user_data;
+    bool invalid    = (disp->inv_p > 0);
+    if (invalid) {
+        trace_frame++;
+        lvgl_port_trace_invalid(esp_timer_get_time());
+    }
+#endif
+#if CONFIG_LVGL_PORT_STATS
+    refr_timer_stats(timer);
+#else
+    _lv_disp_refr_timer(timer);
+#endif
+#if LVGL_PORT_TRACE
+    if (invalid) {
+        lvgl_port_trace_rendered(esp_timer_get_time(), trace_frame);
+    }
+#endif
+}
+#endif
+
+#if CONFIG_LVGL_PORT_STATS
+void lvgl_port_get_stats(lvgl_port_stats_t* out, bool reset)
+{
+    lvgl_port_lock(-1);
+    *out = port_stats;
+#if LVGL_PORT_FLUSH_TASK
+    out->flush_us = reset ? flush_task_us.exchange(0) : flush_task_us.load();
+#endif
+#if LVGL_PORT_PARALLEL_BLEND
+    lvgl_port_blend_stats_t blend;
+    lvgl_port_blend_get_stats(&blend, reset);
+    out->split_px = blend.split_px;
+#endif
+#if LV_REFR_OCCLUSION
+    out->occluded_px = lv_refr_get_occluded_px(reset);
+#endif
+#if LVGL_PORT_ASYNC_BLIT
+    lvgl_port_blit_stats_t blit;
+    lvgl_port_blit_get_stats(&blit, reset);
+    out->blit_images        = blit.images;
+    out->blit_px            = blit.dma_bytes / sizeof(lv_color_t);
+    out->blit_saved_kcycles = (int32_t)(((int64_t)blit.memcpy_cycles - blit.spent_cycles) / 1000);
+#endif
+#if LV_TXT_LAYOUT_CACHE_NUM
+    lv_txt_layout_cache_stats_t txt;
+    lv_txt_layout_cache_get_stats(&txt, reset);
+    out->txt_layout_hits      = txt.hits;
+    out->txt_layout_misses    = txt.misses;
+    out->txt_layout_hit_bytes = txt.hit_bytes;
+#endif
+#if LV_FONT_FMT_TXT_A8_CACHE_SIZE
+    lv_font_fmt_txt_a8_cache_stats_t glyph;
+    lv_font_fmt_txt_a8_cache_get_stats(&glyph, reset);
+    out->glyph_hits   = glyph.hits;
+    out->glyph_misses = glyph.misses;
+#endif
+#if LVGL_PORT_TOUCH_TASK
+    lvgl_port_touch_stats_t touch;
+    lvgl_port_touch_get_stats(&touch, reset);
+    out->touch_reads   = touch.reads;
+    out->touch_samples = touch.samples;
+    out->touch_dropped = touch.dropped;
+#endif
+    if (reset) {
+        port_stats = {};
+    }
+    lvgl_port_unlock();
+}
+#endif
+
 static lv_disp_t* display_init(LCD* lcd)
 {
     ESP_UTILS_CHECK_FALSE_RETURN(lcd != nullptr, nullptr, "Invalid LCD device");
@@ -627,19 +861,70 @@ static lv_disp_t* display_init(LCD* lcd)
 #endif /* LVGL_PORT_AVOID_TEAR */
     disp_drv.draw_buf  = &disp_buf;
     disp_drv.user_data = (void*)lcd;
+#if LVGL_PORT_FLUSH_TASK
+    disp_drv.flush_cb = flush_callback_async;
+    disp_drv.wait_cb  = flush_wait_callback;
+#endif
+#if LVGL_PORT_PARALLEL_BLEND || LVGL_PORT_ASYNC_BLIT
+    disp_drv.draw_ctx_init   = draw_ctx_init;
+    disp_drv.draw_ctx_deinit = lv_draw_sw_deinit_ctx;
+#endif
     // Only available when the coordinate alignment is enabled
     if ((lcd->getBasicAttributes().basic_bus_spec.x_coord_align > 1) ||
         (lcd->getBasicAttributes().basic_bus_spec.y_coord_align > 1)) {
         disp_drv.rounder_cb = rounder_callback;
     }
 
+#if CONFIG_LVGL_PORT_STATS
+    disp_drv.flush_cb = flush_callback_stats;
+#endif
+#if CONFIG_LVGL_PORT_STATS || LVGL_PORT_TRACE
+    lv_disp_t* disp = lv_disp_drv_register(&disp_drv);
+    if (disp != nullptr) {
+        _lv_disp_get_refr_timer(disp)->timer_cb = refr_timer_cb;
+    }
+    return disp;
+#else
     return lv_disp_drv_register(&disp_drv);
+#endif
+}
+
+#if LVGL_PORT_TOUCH_TASK
+// Called by the touch task
+static int touch_read_point(void* ctx, int16_t* x, int16_t* y)
+{
+    TouchPoint point;
+    int ret = ((Touch*)ctx)->readPoints(&point, 1, 0);
+    if (ret > 0) {
+        *x = point.x;
+        *y = point.y;
+    }
+    return ret;
 }
 
+IRAM_ATTR static bool onTouchInterruptCallback(void* user_data)
+{
+    return lvgl_port_touch_irq();
+}
+#endif
+
 static void touchpad_read(lv_indev_drv_t* indev_drv, lv_indev_data_t* data)
 {
+#if LVGL_PORT_TOUCH_TASK
+    // Hand the queued points to LVGL one per read, in order; keep the last one when none is queued
+    static lvgl_port_touch_sample_t sample = {};
+    int64_t time_us                        = 0;
+    if (lvgl_port_touch_pop(&sample)) {
+        time_us                = sample.time_us;
+        data->continue_reading = (lvgl_port_touch_pending() > 0);
+    }
+    data->point.x = sample.x;
+    data->point.y = sample.y;
+    data->state   = sample.pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+#else
     Touch* tp = (Touch*)indev_drv->user_data;
     TouchPoint point;
+    int64_t time_us = 0;
 
     /* Read data from touch controller */
     int read_touch_result = tp->readPoints(&point, 1, 0);
@@ -650,7 +935,48 @@ static void touchpad_read(lv_indev_drv_t* indev_drv, lv_indev_data_t* data)
     } else {
         data->state = LV_INDEV_STATE_RELEASED;
     }
+#endif
+
+#if CONFIG_LVGL_PORT_STATS || LVGL_PORT_TRACE
+    static lv_indev_state_t last_state = LV_INDEV_STATE_RELEASED;
+    if (data->state != last_state) {
+        if (time_us == 0) {
+            time_us = esp_timer_get_time();
+        }
+#if CONFIG_LVGL_PORT_STATS
+        if (input_t0 == 0) {
+            input_t0 = time_us;
+        }
+#endif
+#if LVGL_PORT_TRACE
+        lvgl_port_trace_input(time_us);
+#endif
+    }
+    last_state = data->state;
+#else
+    (void)time_us;
+#endif
+}
+
+#if LVGL_PORT_TRACE
+// Called by LVGL before each event it sends while processing the touch
+static void indev_feedback(lv_indev_drv_t* indev_drv, uint8_t code)
+{
+    if ((code >= LV_EVENT_PRESSED) && (code <= LV_EVENT_RELEASED) && (code != LV_EVENT_PRESSING)) {
+        lvgl_port_trace_dispatch(esp_timer_get_time());
+    }
+}
+
+// Whatever is invalid once the touch is processed is what the event handlers changed
+static void indev_read_timer_trace(lv_timer_t* timer)
+{
+    lv_indev_read_timer_cb(timer);
+    lv_disp_t* disp = lv_disp_get_default();
+    if ((disp != NULL) && (disp->inv_p > 0)) {
+        lvgl_port_trace_invalid(esp_timer_get_time());
+    }
 }
+#endif
 
 static lv_indev_t* indev_init(Touch* tp)
 {
@@ -664,8 +990,16 @@ static lv_indev_t* indev_init(Touch* tp)
     indev_drv_tp.type      = LV_INDEV_TYPE_POINTER;
     indev_drv_tp.read_cb   = touchpad_read;
     indev_drv_tp.user_data = (void*)tp;
-
+#if LVGL_PORT_TRACE
+    indev_drv_tp.feedback_cb = indev_feedback;
+    lv_indev_t* indev        = lv_indev_drv_register(&indev_drv_tp);
+    if ((indev != nullptr) && (indev->driver->read_timer != nullptr)) {
+        indev->driver->read_timer->timer_cb = indev_read_timer_trace;
+    }
+    return indev;
+#else
     return lv_indev_drv_register(&indev_drv_tp);
+#endif
 }
 
 #if ! LV_TICK_CUSTOM
@@ -695,22 +1029,208 @@ static bool tick_deinit(void)
 }
 #endif
 
+#if LVGL_PORT_EVENT_WAKE
+#if configTASK_NOTIFICATION_ARRAY_ENTRIES < 2
+#error "CONFIG_LVGL_PORT_EVENT_WAKE needs CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES >= 2"
+#endif
+
+static std::atomic<bool> touch_irq{false};
+static bool touch_irq_enabled = false; // New touch data wakes the LVGL task
+
+#if LVGL_PORT_TOUCH_TASK
+// Called by the touch task after queuing a point
+static void onTouchSampleCallback(void)
+{
+    touch_irq.store(true);
+    lvgl_port_wake();
+}
+#else
+IRAM_ATTR static bool onTouchInterruptCallback(void* user_data)
+{
+    BaseType_t need_yield = pdFALSE;
+    touch_irq.store(true);
+    vTaskNotifyGiveIndexedFromISR((TaskHandle_t)user_data, LVGL_PORT_WAKE_NOTIFY_INDEX, &need_yield);
+    return (need_yield == pdTRUE);
+}
+#endif
+
+/*
+ * When new touch data wakes the LVGL task (touch interrupt or touch task), the read timer is paused while
+ * nothing touches the panel and no scroll is being thrown, and read at once on new data instead of at the
+ * next `LV_INDEV_DEF_READ_PERIOD` tick.
+ */
+static void indev_read_on_irq(void)
+{
+    if (! touch_irq_enabled) {
+        return;
+    }
+    bool irq = touch_irq.exchange(false);
+    for (lv_indev_t* indev = lv_indev_get_next(NULL); indev != NULL; indev = lv_indev_get_next(indev)) {
+        lv_timer_t* read_timer = indev->driver->read_timer;
+        if ((indev->driver->type != LV_INDEV_TYPE_POINTER) || (read_timer == NULL)) {
+            continue;
+        }
+        if (irq) {
+            lv_timer_resume(read_timer);
+            lv_timer_ready(read_timer);
+        } else if ((indev->proc.state == LV_INDEV_STATE_RELEASED) && (lv_indev_get_scroll_obj(indev) == NULL)) {
+            lv_timer_pause(read_timer);
+        }
+    }
+}
+
+/*
+ * The refresh timer pauses itself when nothing is invalid and an invalidation resumes it, but it still runs
+ * on its `LV_DISP_DEF_REFR_PERIOD` ticks. Make it due as soon as an area is invalid, at most every
+ * `LVGL_PORT_REFR_MIN_PERIOD_MS`. Returns how long the task may sleep.
+ */
+static uint32_t refr_when_invalid(uint32_t delay_ms)
+{
+    lv_disp_t* disp  = lv_disp_get_default();
+    lv_timer_t* refr = (disp != NULL) ? disp->refr_timer : NULL;
+    if ((refr == NULL) || refr->paused || (disp->inv_p == 0)) {
+        return delay_ms;
+    }
+    uint32_t elapsed = lv_tick_elaps(refr->last_run);
+    if (elapsed < LVGL_PORT_REFR_MIN_PERIOD_MS) {
+        return LV_MIN(delay_ms, LVGL_PORT_REFR_MIN_PERIOD_MS - elapsed);
+    }
+    lv_timer_ready(refr);
+    return 0;
+}
+#endif
+
+#if LVGL_PORT_TRACE
+static void (*trace_output)(const char* line, size_t len) = nullptr;
+
+#if ! LVGL_PORT_AVOID_TEAR
+// The frame flushed before this VSYNC is on the panel from now on
+IRAM_ATTR static bool onLcdTraceVsyncCallback(void* user_data)
+{
+    lvgl_port_trace_vsync(esp_timer_get_time());
+    return false;
+}
+#endif
+
+static void trace_report_timer(lv_timer_t* timer)
+{
+    static lvgl_port_trace_stats_t stats; // LVGL task only
+    static char line[640];
+    lvgl_port_trace_get_stats(&stats, true);
+    if ((stats.completed == 0) && (stats.no_redraw == 0) && (stats.abandoned == 0)) {
+        return;
+    }
+    size_t len = lvgl_port_trace_format(&stats, line, sizeof(line));
+    if (trace_output != nullptr) {
+        trace_output(line, len);
+    } else {
+        ESP_UTILS_LOGI("%.*s", (int)len - 1, line);
+    }
+}
+
+#if LVGL_PORT_TRACE_OVERLAY
+static void trace_overlay_timer(lv_timer_t* timer)
+{
+    static lvgl_port_trace_stats_t stats; // LVGL task only
+    lv_obj_t* label = (lv_obj_t*)timer->user_data;
+    lvgl_port_trace_get_stats(&stats, false);
+
+    const lvgl_port_trace_histogram_t* total = &stats.hist[LVGL_PORT_TRACE_H_TOTAL];
+    char text[48];
+    lv_snprintf(text, sizeof(text), "touch %u: p50 %u p99 %u ms", (unsigned)total->count,
+                (unsigned)(lvgl_port_trace_percentile(total, 500) / 1000),
+                (unsigned)(lvgl_port_trace_percentile(total, 990) / 1000));
+    // Don't redraw the screen for nothing
+    if (strcmp(lv_label_get_text(label), text) != 0) {
+        lv_label_set_text(label, text);
+    }
+}
+#endif
+
+static void trace_timers_init(void)
+{
+#if LVGL_PORT_TRACE_REPORT_S > 0
+    lv_timer_create(trace_report_timer, LVGL_PORT_TRACE_REPORT_S * 1000, NULL);
+#endif
+#if LVGL_PORT_TRACE_OVERLAY
+    lv_obj_t* label = lv_label_create(lv_layer_sys());
+    lv_label_set_text(label, "");
+    lv_obj_set_style_bg_color(label, lv_color_black(), 0);
+    lv_obj_set_style_bg_opa(label, LV_OPA_70, 0);
+    lv_obj_set_style_text_color(label, lv_color_white(), 0);
+    lv_obj_set_style_pad_all(label, 4, 0);
+    lv_obj_align(label, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+    lv_timer_create(trace_overlay_timer, LVGL_PORT_TRACE_OVERLAY_MS, label);
+#endif
+}
+#endif
+
+void lvgl_port_set_trace_output(void (*output)(const char* line, size_t len))
+{
+#if LVGL_PORT_TRACE
+    trace_output = output;
+#endif
+}
+
+void lvgl_port_wake(void)
+{
+#if LVGL_PORT_EVENT_WAKE
+    TaskHandle_t task = lvgl_task_handle;
+    if ((task != nullptr) && (task != xTaskGetCurrentTaskHandle())) {
+        xTaskNotifyGiveIndexed(task, LVGL_PORT_WAKE_NOTIFY_INDEX);
+    }
+#endif
+}
+
 static void lvgl_port_task(void* arg)
 {
     ESP_UTILS_LOGD("Starting LVGL task");
 
     uint32_t task_delay_ms = LVGL_PORT_TASK_MAX_DELAY_MS;
+    bool woken            = false;
     while (1) {
         if (lvgl_port_lock(-1)) {
+#if LVGL_PORT_EVENT_WAKE
+            indev_read_on_irq();
+#endif
             task_delay_ms = lv_timer_handler();
+#if LVGL_PORT_EVENT_WAKE
+            task_delay_ms = refr_when_invalid(task_delay_ms);
+#endif
+#if LVGL_PORT_TRACE
+            if (lv_disp_get_default()->inv_p == 0) {
+                lvgl_port_trace_idle();
+            }
+#endif
+#if CONFIG_LVGL_PORT_STATS
+            port_stats.wakeups++;
+            port_stats.wake_events += woken ? 1 : 0;
+            // The touch changed nothing on the screen
+            if (lv_disp_get_default()->inv_p == 0) {
+                input_t0 = 0;
+            }
+#endif
             lvgl_port_unlock();
         }
+#if LVGL_PORT_EVENT_WAKE
+        if (task_delay_ms == 0) {
+            // A refresh is due
+            woken = false;
+            continue;
+        }
+        // Sleep until the next timer is due or an event comes. Tearing modes wait for VSYNC on index 0.
+        TickType_t ticks = (task_delay_ms == LV_NO_TIMER_READY)
+                               ? portMAX_DELAY
+                               : pdMS_TO_TICKS(LV_MAX(task_delay_ms, LVGL_PORT_TASK_MIN_DELAY_MS));
+        woken = (ulTaskNotifyTakeIndexed(LVGL_PORT_WAKE_NOTIFY_INDEX, pdTRUE, ticks) != 0);
+#else
         if (task_delay_ms > LVGL_PORT_TASK_MAX_DELAY_MS) {
             task_delay_ms = LVGL_PORT_TASK_MAX_DELAY_MS;
         } else if (task_delay_ms < LVGL_PORT_TASK_MIN_DELAY_MS) {
             task_delay_ms = LVGL_PORT_TASK_MIN_DELAY_MS;
         }
         vTaskDelay(pdMS_TO_TICKS(task_delay_ms));
+#endif
     }
 }
 
@@ -729,6 +1249,7 @@ IRAM_ATTR bool onDrawBitmapFinishCallback(void* user_data)
 bool lvgl_port_init(LCD* lcd, Touch* tp)
 {
     ESP_UTILS_CHECK_FALSE_RETURN(lcd != nullptr, false, "Invalid LCD device");
+    global_lcd_ptr = lcd;
 
     auto bus_type = lcd->getBus()->getBasicAttributes().type;
 #if LVGL_PORT_AVOID_TEAR
@@ -747,6 +1268,29 @@ bool lvgl_port_init(LCD* lcd, Touch* tp)
     ESP_UTILS_CHECK_FALSE_RETURN(tick_init(), false, "Initialize LVGL tick failed");
 #endif
 
+#if LVGL_PORT_FLUSH_TASK
+    ESP_UTILS_CHECK_FALSE_RETURN(flush_task_init(), false, "Initialize LVGL flush task failed");
+    ESP_UTILS_LOGI("Flush task on core %d", LVGL_PORT_FLUSH_TASK_CORE);
+#endif
+#if LVGL_PORT_PARALLEL_BLEND
+    ESP_UTILS_CHECK_FALSE_RETURN(lvgl_port_blend_init(LVGL_PORT_BLEND_TASK_STACK_SIZE, LVGL_PORT_BLEND_TASK_PRIORITY,
+                                                      LVGL_PORT_PARALLEL_BLEND_CORE),
+                                 false, "Initialize LVGL blend task failed");
+    ESP_UTILS_LOGI("Parallel blend on core %d, blends >= %d px", LVGL_PORT_PARALLEL_BLEND_CORE,
+                   LVGL_PORT_PARALLEL_BLEND_MIN_PX);
+#endif
+#if LVGL_PORT_ASYNC_BLIT
+    // Without the GDMA, images are still copied by the blit hook, with memcpy()
+    if (lvgl_port_blit_init()) {
+        ESP_UTILS_LOGI("Async blit of images >= %d px", LVGL_PORT_ASYNC_BLIT_MIN_PX);
+    }
+#endif
+
+#if LVGL_PORT_AVOID_TEAR && LVGL_PORT_DIRECT_MODE && (LVGL_PORT_ROTATION_DEGREE != 0) && LVGL_PORT_BUFFER_AGE
+    // Both LCD frame buffers get the whole first frame, also after a deinit
+    lvgl_port_damage_reset();
+#endif
+
     ESP_UTILS_LOGI("Initializing LVGL display driver");
     disp = display_init(lcd);
     ESP_UTILS_CHECK_NULL_RETURN(disp, false, "Initialize LVGL display driver failed");
@@ -763,6 +1307,7 @@ bool lvgl_port_init(LCD* lcd, Touch* tp)
     if (tp != nullptr) {
         ESP_UTILS_LOGD("Initialize LVGL input driver");
         indev = indev_init(tp);
+        global_tp_ptr = tp;
         ESP_UTILS_CHECK_NULL_RETURN(indev, false, "Initialize LVGL input driver failed");
 
 #if LVGL_PORT_ROTATION_DEGREE != 0
@@ -780,6 +1325,10 @@ bool lvgl_port_init(LCD* lcd, Touch* tp)
 #endif
     }
 
+#if LVGL_PORT_TRACE
+    trace_timers_init();
+#endif
+
     ESP_UTILS_LOGD("Create mutex for LVGL");
     lvgl_mux = xSemaphoreCreateRecursiveMutex();
     ESP_UTILS_CHECK_NULL_RETURN(lvgl_mux, false, "Create LVGL mutex failed");
@@ -814,6 +1363,47 @@ bool lvgl_port_start(void)
         ESP_UTILS_LOGW("lvgl_port_start: global_lcd_ptr is null, cannot attach refresh finish callback");
     }
 #endif
+#if LVGL_PORT_TRACE
+#if LVGL_PORT_AVOID_TEAR
+    // flush_cb waits for the VSYNC that shows the frame
+    bool trace_vsync = false;
+#else
+    bool trace_vsync = (global_lcd_ptr != nullptr) &&
+                       (global_lcd_ptr->getBus()->getBasicAttributes().type == ESP_PANEL_BUS_TYPE_RGB) &&
+                       global_lcd_ptr->attachRefreshFinishCallback(onLcdTraceVsyncCallback, nullptr);
+#endif
+    lvgl_port_trace_init(LVGL_PORT_FLUSH_TASK, trace_vsync);
+#endif
+#if LVGL_PORT_TOUCH_TASK
+    if (global_tp_ptr != nullptr) {
+        bool irq = global_tp_ptr->isInterruptEnabled() &&
+                   global_tp_ptr->attachInterruptCallback(onTouchInterruptCallback, nullptr);
+        lvgl_port_touch_config_t touch_config = {
+            .read          = touch_read_point,
+            .ctx           = global_tp_ptr,
+#if LVGL_PORT_EVENT_WAKE
+            .ready         = onTouchSampleCallback,
+#else
+            .ready         = nullptr,
+#endif
+            .irq           = irq,
+            .poll_ms       = LVGL_PORT_TOUCH_POLL_MS,
+            .task_stack    = LVGL_PORT_TOUCH_TASK_STACK_SIZE,
+            .task_priority = LVGL_PORT_TOUCH_TASK_PRIORITY,
+            .task_core     = -1,
+        };
+        ESP_UTILS_CHECK_FALSE_RETURN(lvgl_port_touch_init(&touch_config), false, "Start touch task failed");
+#if LVGL_PORT_EVENT_WAKE
+        touch_irq_enabled = true;
+#endif
+    }
+#elif LVGL_PORT_EVENT_WAKE
+    // Without the touch interrupt, the read timer keeps polling
+    if ((global_tp_ptr != nullptr) && global_tp_ptr->isInterruptEnabled()) {
+        touch_irq_enabled = global_tp_ptr->attachInterruptCallback(onTouchInterruptCallback, (void*)lvgl_task_handle);
+        ESP_UTILS_LOGI("Touch interrupt wakes the LVGL task: %d", touch_irq_enabled);
+    }
+#endif
 
     ESP_UTILS_LOGI("LVGL task started");
     return true;
@@ -833,6 +1423,8 @@ bool lvgl_port_unlock(void)
     ESP_UTILS_CHECK_NULL_RETURN(lvgl_mux, false, "LVGL mutex is not initialized");
 
     xSemaphoreGiveRecursive(lvgl_mux);
+    // Let the LVGL task handle what was changed under the lock now
+    lvgl_port_wake();
 
     return true;
 }
@@ -849,6 +1441,21 @@ bool lvgl_port_deinit(void)
         lvgl_task_handle = nullptr;
     }
     ESP_UTILS_CHECK_FALSE_RETURN(lvgl_port_unlock(), false, "Unlock LVGL failed");
+#if LVGL_PORT_FLUSH_TASK
+    flush_task_deinit();
+#endif
+#if LVGL_PORT_PARALLEL_BLEND
+    lvgl_port_blend_deinit();
+#endif
+#if LVGL_PORT_ASYNC_BLIT
+    lvgl_port_blit_deinit();
+#endif
+#if LVGL_PORT_TOUCH_TASK
+    lvgl_port_touch_deinit();
+#endif
+#if LVGL_PORT_AVOID_TEAR && LVGL_PORT_DIRECT_MODE && (LVGL_PORT_ROTATION_DEGREE != 0) && LVGL_PORT_BUFFER_AGE
+    lvgl_port_damage_reset();
+#endif
 
 #if LV_ENABLE_GC || ! LV_MEM_CUSTOM
     lv_deinit();
@@ -38,11 +38,21 @@
  * Maximum buffer size is `width * height`.
  *      - The number of buffers should be 1 or 2.
  */
+#if CONFIG_LVGL_PORT_BUFFER_PSRAM
+#define LVGL_PORT_BUFFER_MALLOC_CAPS (MALLOC_CAP_SPIRAM) // Allocate LVGL buffer in PSRAM
+#else
 #define LVGL_PORT_BUFFER_MALLOC_CAPS (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT) // Allocate LVGL buffer in SRAM
-// #define LVGL_PORT_BUFFER_MALLOC_CAPS            (MALLOC_CAP_SPIRAM)      //
-// Allocate LVGL buffer in PSRAM
+#endif
+#ifdef CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT
+#define LVGL_PORT_BUFFER_SIZE_HEIGHT (CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT)
+#else
 #define LVGL_PORT_BUFFER_SIZE_HEIGHT (20)
-#define LVGL_PORT_BUFFER_NUM         (2)
+#endif
+#ifdef CONFIG_LVGL_PORT_BUFFER_NUM
+#define LVGL_PORT_BUFFER_NUM (CONFIG_LVGL_PORT_BUFFER_NUM)
+#else
+#define LVGL_PORT_BUFFER_NUM (2)
+#endif
 
 /**
  * LVGL timer handle task related parameters, can be adjusted by users
@@ -53,14 +63,123 @@
 #define LVGL_PORT_TASK_PRIORITY     (1)        // The priority of the LVGL timer task
 #ifdef ARDUINO_RUNNING_CORE
 #define LVGL_PORT_TASK_CORE (ARDUINO_RUNNING_CORE) // Valid if using Arduino
+#elif defined(CONFIG_LVGL_PORT_TASK_CORE)
+#define LVGL_PORT_TASK_CORE (CONFIG_LVGL_PORT_TASK_CORE) // Valid if using ESP-IDF
 #else
-#define LVGL_PORT_TASK_CORE (-1) // Valid if using ESP-IDF
+#define LVGL_PORT_TASK_CORE (-1)
 #endif
 // The core of the LVGL timer task, `-1` means the don't specify the core
 // Default is the same as the main core
 // This can be set to `1` only if the SoCs support dual-core,
 // otherwise it should be set to `-1` or `0`
 
+/**
+ * Event wakeup: the LVGL task sleeps on a task notification until its next
+ * timer is due, instead of waking every few milliseconds. Another task that
+ * releases the LVGL lock, `lvgl_port_wake()` and new touch data wake it
+ * at once, and invalid areas are drawn right away instead of on the next
+ * `LV_DISP_DEF_REFR_PERIOD` tick, at most every `LVGL_PORT_REFR_MIN_PERIOD_MS`.
+ * Notification index 0 stays the VSYNC notification of the avoid tearing modes.
+ */
+#if CONFIG_LVGL_PORT_EVENT_WAKE
+#define LVGL_PORT_EVENT_WAKE          (1)
+#else
+#define LVGL_PORT_EVENT_WAKE          (0)
+#endif
+#define LVGL_PORT_WAKE_NOTIFY_INDEX   (1)
+#define LVGL_PORT_REFR_MIN_PERIOD_MS  (16)
+
+/**
+ * Touch task: the touch controller is read by a task woken by its INT pin (or
+ * polling every `LVGL_PORT_TOUCH_POLL_MS` without it) and the points are queued
+ * with their timestamps; the LVGL read callback only drains the queue. With
+ * event wakeup, the LVGL task sleeps until a point is queued. See
+ * `lvgl_port_touch.h`.
+ */
+#if CONFIG_LVGL_PORT_TOUCH_TASK
+#define LVGL_PORT_TOUCH_TASK            (1)
+#define LVGL_PORT_TOUCH_POLL_MS         (CONFIG_LVGL_PORT_TOUCH_POLL_MS)
+#else
+#define LVGL_PORT_TOUCH_TASK            (0)
+#endif
+#define LVGL_PORT_TOUCH_TASK_STACK_SIZE (3 * 1024)
+#define LVGL_PORT_TOUCH_TASK_PRIORITY   (LVGL_PORT_TASK_PRIORITY + 3)
+
+/**
+ * Latency trace: every touch press or release is followed to the VSYNC that
+ * shows its effect, and the phases go to histograms reported as one JSON line
+ * every `LVGL_PORT_TRACE_REPORT_S` seconds (see `lvgl_port_trace.h` and
+ * `lvgl_port_set_trace_output()`). The overlay shows the touch-to-photon
+ * percentiles in a corner of the screen.
+ */
+#if CONFIG_LVGL_PORT_TRACE
+#define LVGL_PORT_TRACE                 (1)
+#define LVGL_PORT_TRACE_REPORT_S        (CONFIG_LVGL_PORT_TRACE_REPORT_S)
+#if CONFIG_LVGL_PORT_TRACE_OVERLAY
+#define LVGL_PORT_TRACE_OVERLAY         (1)
+#else
+#define LVGL_PORT_TRACE_OVERLAY         (0)
+#endif
+#else
+#define LVGL_PORT_TRACE                 (0)
+#define LVGL_PORT_TRACE_OVERLAY         (0)
+#endif
+#define LVGL_PORT_TRACE_OVERLAY_MS      (1000)
+
+/**
+ * Flush task, only without avoid tearing and with two draw buffers: `flush_cb`
+ * hands the rendered buffer to a task on the other core, which copies it to
+ * the LCD and calls `lv_disp_flush_ready()`. LVGL renders into the other
+ * buffer meanwhile.
+ */
+#if CONFIG_LVGL_PORT_FLUSH_TASK
+#define LVGL_PORT_FLUSH_TASK            (1)
+#define LVGL_PORT_FLUSH_TASK_CORE       (CONFIG_LVGL_PORT_FLUSH_TASK_CORE)
+#else
+#define LVGL_PORT_FLUSH_TASK            (0)
+#endif
+#define LVGL_PORT_FLUSH_TASK_STACK_SIZE (3 * 1024)
+#define LVGL_PORT_FLUSH_TASK_PRIORITY   (LVGL_PORT_TASK_PRIORITY + 1)
+
+/**
+ * Parallel blend: blends of at least `LVGL_PORT_PARALLEL_BLEND_MIN_PX` pixels are
+ * split in two row bands, the bottom one blended by a task on the other core.
+ * Drawing itself stays serial, see `lvgl_port_blend.h`. The LVGL task waits for
+ * the blend task, so it has a higher priority than the flush task.
+ */
+#if CONFIG_LVGL_PORT_PARALLEL_BLEND
+#define LVGL_PORT_PARALLEL_BLEND          (1)
+#define LVGL_PORT_PARALLEL_BLEND_MIN_PX   (CONFIG_LVGL_PORT_PARALLEL_BLEND_MIN_PX)
+#define LVGL_PORT_PARALLEL_BLEND_CORE     (CONFIG_LVGL_PORT_PARALLEL_BLEND_CORE)
+#else
+#define LVGL_PORT_PARALLEL_BLEND          (0)
+#endif
+#define LVGL_PORT_BLEND_TASK_STACK_SIZE   (3 * 1024)
+#define LVGL_PORT_BLEND_TASK_PRIORITY     (LVGL_PORT_TASK_PRIORITY + 2)
+
+/**
+ * Async blit: opaque images drawn 1:1 of at least `LVGL_PORT_ASYNC_BLIT_MIN_PX`
+ * pixels are copied into the draw buffer by the GDMA while LVGL draws on.
+ * `flush_cb` waits for the copies. See `lvgl_port_blit.h`.
+ */
+#if CONFIG_LVGL_PORT_ASYNC_BLIT
+#define LVGL_PORT_ASYNC_BLIT              (1)
+#define LVGL_PORT_ASYNC_BLIT_MIN_PX       (CONFIG_LVGL_PORT_ASYNC_BLIT_MIN_PX)
+#else
+#define LVGL_PORT_ASYNC_BLIT              (0)
+#endif
+
+/**
+ * Buffer age, only in direct mode with rotation: each LCD frame buffer knows
+ * how many frames old it is, and only the areas drawn since then are rotated
+ * into it.
+ */
+#if CONFIG_LVGL_PORT_BUFFER_AGE
+#define LVGL_PORT_BUFFER_AGE              (1)
+#else
+#define LVGL_PORT_BUFFER_AGE              (0)
+#endif
+
 /**
  * Avoid tering related configurations, can be adjusted by users.
  *
@@ -184,6 +303,64 @@ bool lvgl_port_lock(int timeout_ms);
  */
 bool lvgl_port_unlock(void);
 
+/**
+ * @brief Wake the LVGL task to run its due timers now, e.g. after
+ * `lv_async_call()`. `lvgl_port_unlock()` from another task already does it.
+ * Does nothing without `CONFIG_LVGL_PORT_EVENT_WAKE`.
+ */
+void lvgl_port_wake(void);
+
+/**
+ * @brief Where latency reports go, e.g. a UART. Called on the LVGL task with
+ * one "\n"-terminated JSON line. Without it, reports go to the log.
+ * Does nothing without `CONFIG_LVGL_PORT_TRACE`.
+ */
+void lvgl_port_set_trace_output(void (*output)(const char* line, size_t len));
+
+#if CONFIG_LVGL_PORT_STATS
+/**
+ * Rendering counters, see `lvgl_port_get_stats()`. A frame is one run of the
+ * display refresh timer that flushed at least one area.
+ */
+typedef struct {
+    uint32_t frames;
+    uint32_t refr_us;         // Time in the refresh timer: rendering + flushing
+    uint32_t flush_calls;
+    uint32_t flush_us;        // Time in `flush_cb`: rotation, copies and waiting for VSYNC; with the flush
+                              // task, the copy time on that task
+    uint32_t flush_px;
+    uint32_t rotate_px;       // Pixels rotated into the LCD frame buffers (avoid tearing with rotation)
+    uint32_t split_px;        // Pixels blended by the parallel blend task
+    uint32_t occluded_px;     // Pixels drawn from an opaque object down, without the background (LV_REFR_OCCLUSION)
+    uint32_t blit_images;     // Images copied by the async blit
+    uint32_t blit_px;         // Pixels copied by the GDMA
+    // memcpy() cycles replaced by GDMA copies, minus the cycles spent queueing and waiting for them, in thousands
+    int32_t blit_saved_kcycles;
+    uint32_t txt_layout_hits;      // Label draws and size queries served by the text layout cache (LV_TXT_LAYOUT_CACHE_NUM)
+    uint32_t txt_layout_misses;
+    uint32_t txt_layout_hit_bytes; // Text bytes not broken into lines and measured again thanks to the cache
+    uint32_t glyph_hits;           // Glyphs drawn from the A8 glyph cache (LV_FONT_FMT_TXT_A8_CACHE_SIZE)
+    uint32_t glyph_misses;         // Glyphs unpacked, and decompressed for compressed fonts, into the cache
+    uint32_t wakeups;         // Runs of `lv_timer_handler()`
+    uint32_t wake_events;     // Wakeups by another task or new touch data rather than a timer
+    uint32_t input_events;    // Touch presses and releases that were drawn
+    uint32_t input_latency_us; // Touch sample -> end of the frame drawing its effect, summed over input_events
+    uint32_t touch_reads;     // Touch controller reads (I2C transactions)
+    uint32_t touch_samples;   // Touch points queued by the touch task
+    uint32_t touch_dropped;   // Touch points overwritten before LVGL read them
+    int64_t first_frame_end;  // esp_timer time at the end of the first frame, 0 if none
+    int64_t last_frame_end;   // esp_timer time at the end of the last frame, 0 if none
+} lvgl_port_stats_t;
+
+/**
+ * @brief Read the rendering counters accumulated since the last reset.
+ *
+ * @param out   Destination, mustn't be nullptr
+ * @param reset Clear the counters after reading
+ */
+void lvgl_port_get_stats(lvgl_port_stats_t* out, bool reset);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,13 +9,17 @@
 
 #include "HxTTS.h"
 
+#include "uart.h"
 #include "uart_manager.h"
 
 #include "ui.h"
 #include "ui_events.h"   
 #include "tts_bridge.h"  
 
-#include "esp_spiffs.h"
+#include "asset_fs.h"
+#include "render_bench.h"
+
+#include "esp_heap_caps.h"
 
 #include "lvgl.h"
 #include <stdio.h>
@@ -38,7 +42,7 @@ static bool fs_ready_cb(lv_fs_drv_t*) { return true; }
 
 static void* fs_open_cb(lv_fs_drv_t*, const char* path, lv_fs_mode_t mode) {
     char real[256];
-    snprintf(real, sizeof real, "/spiffs/%s", path);
+    asset_fs_path(real, sizeof real, path);
 
     const char* m = (mode & LV_FS_MODE_WR) ? ((mode & LV_FS_MODE_RD) ? "rb+" : "wb")
                                            : "rb";
@@ -105,6 +109,13 @@ static void checkError(HxTTS& tts)
     ESP_LOGI(TAG, "error=%s", hm_err_to_str(error));
 }
 
+#if CONFIG_LVGL_PORT_TRACE_UART1
+static void trace_to_uart1(const char* line, size_t len)
+{
+    uart_write((void*)line, (uint32_t)len, 0);
+}
+#endif
+
 extern "C" void start_tts_playback_impl(const char *text)
 {
     if (!text) return;
@@ -121,22 +132,39 @@ extern "C" void start_tts_playback_impl(const char *text)
 
 extern "C" void app_main()
 {
-    esp_vfs_spiffs_conf_t conf = {
-        .base_path = "/spiffs",
-        .partition_label = "spiffs",
-        .max_files = 12,
-        .format_if_mount_failed = false
-    };
-    ESP_ERROR_CHECK(esp_vfs_spiffs_register(&conf));
+    ESP_ERROR_CHECK(asset_fs_mount());
+#if CONFIG_ASSET_FS_BENCH
+    asset_fs_bench_run();
+#endif
+
+#if CONFIG_RENDER_BENCH
+    size_t sram_before  = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    size_t psram_before = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+#endif
 
     Board* board = new Board();
     ESP_UTILS_CHECK_FALSE_EXIT(board->init(),  "Board init failed");
+#if LVGL_PORT_AVOID_TEARING_MODE
+    // The tearing modes render into the LCD frame buffers
+    board->getLCD()->configFrameBufferNumber(LVGL_PORT_DISP_BUFFER_NUM);
+#endif
     ESP_UTILS_CHECK_FALSE_EXIT(board->begin(), "Board begin failed");
     ESP_UTILS_CHECK_FALSE_EXIT(lvgl_port_init(board->getLCD(), board->getTouch()),
                                "LVGL init failed");
 
     lvgl_register_drive_S();
 
+#if CONFIG_RENDER_BENCH
+    render_bench_mem_t port_mem = {
+        .sram  = sram_before - heap_caps_get_free_size(MALLOC_CAP_INTERNAL),
+        .psram = psram_before - heap_caps_get_free_size(MALLOC_CAP_SPIRAM),
+    };
+    ESP_UTILS_CHECK_FALSE_EXIT(lvgl_port_start(), "LVGL start failed");
+    // No TTS: UART1 carries the results
+    render_bench_start(&port_mem);
+    return;
+#endif
+
     ui_init();
 
     ESP_UTILS_CHECK_FALSE_EXIT(lvgl_port_start(), "LVGL start failed");
@@ -146,4 +174,8 @@ extern "C" void app_main()
     register_start_tts_cb(start_tts_playback_impl);
     checkStatus(*g_hx_tts);
     checkError(*g_hx_tts);
+#if CONFIG_LVGL_PORT_TRACE_UART1
+    // UART1 is installed by the TTS driver
+    lvgl_port_set_trace_output(trace_to_uart1);
+#endif
 }
\ No newline at end of file
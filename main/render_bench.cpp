@@ -0,0 +1,362 @@
+#include "render_bench.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "lv_demos.h"
+#include "lv_mem_psram.h"
+#include "lvgl_v8_port.h"
+#include "uart.h"
+#include "ui.h"
+#include "ui_events.h"
+#include "ui_screen_cache.h"
+
+static const char* TAG = "BENCH";
+
+#define BENCH_TASK_STACK (4 * 1024)
+#define BENCH_TASK_PRIO  2
+#define BENCH_STYLE_RUNS 50
+
+#if CONFIG_LVGL_PORT_BUFFER_PSRAM
+#define BENCH_BUFFER_PSRAM 1
+#else
+#define BENCH_BUFFER_PSRAM 0
+#endif
+
+#if CONFIG_UI_FONT_SUBSET
+#define BENCH_FONT_SUBSET 1
+#else
+#define BENCH_FONT_SUBSET 0
+#endif
+
+#if CONFIG_LVGL_PORT_EVENT_WAKE
+#define BENCH_EVENT_WAKE 1
+#else
+#define BENCH_EVENT_WAKE 0
+#endif
+
+#if CONFIG_LVGL_PORT_TOUCH_TASK
+#define BENCH_TOUCH_TASK 1
+#else
+#define BENCH_TOUCH_TASK 0
+#endif
+
+#if CONFIG_UI_SCREEN_CACHE
+#define BENCH_SCREEN_CACHE 1
+#else
+#define BENCH_SCREEN_CACHE 0
+#endif
+
+#if CONFIG_UI_SCREEN_TRANSITION_NONE
+#define BENCH_SCREEN_TRANSITION "none"
+#elif CONFIG_UI_SCREEN_TRANSITION_FADE
+#define BENCH_SCREEN_TRANSITION "fade"
+#else
+#define BENCH_SCREEN_TRANSITION "slide"
+#endif
+
+/* With the flush task, flush_us is spent on the other core and is not part of refr_us. */
+#if LVGL_PORT_FLUSH_TASK
+#define BENCH_FLUSH_ON_LVGL_TASK_US(s) 0
+#else
+#define BENCH_FLUSH_ON_LVGL_TASK_US(s) ((s)->flush_us)
+#endif
+
+typedef struct {
+    const char* phase;
+    uint32_t runs;
+    uint32_t wall_us;
+    uint32_t first_frame_us; /* trigger -> end of the first frame, summed over runs */
+    uint32_t settle_us;      /* trigger -> end of the last frame */
+    lvgl_port_stats_t port;
+    ui_screen_cache_stats_t scr;
+    uint32_t idle_us[portNUM_PROCESSORS];
+} phase_result_t;
+
+static render_bench_mem_t s_port_mem;
+static SemaphoreHandle_t s_demo_done;
+
+static void idle_sample(uint32_t idle_us[portNUM_PROCESSORS])
+{
+    for (int i = 0; i < portNUM_PROCESSORS; ++i) {
+        idle_us[i] = ulTaskGetRunTimeCounter(xTaskGetIdleTaskHandleForCore(i));
+    }
+}
+
+static void phase_add(phase_result_t* r, const lvgl_port_stats_t* s)
+{
+    r->port.frames      += s->frames;
+    r->port.refr_us     += s->refr_us;
+    r->port.flush_calls += s->flush_calls;
+    r->port.flush_us    += s->flush_us;
+    r->port.flush_px    += s->flush_px;
+    r->port.rotate_px   += s->rotate_px;
+    r->port.split_px    += s->split_px;
+    r->port.occluded_px += s->occluded_px;
+    r->port.blit_images += s->blit_images;
+    r->port.blit_px     += s->blit_px;
+    r->port.blit_saved_kcycles += s->blit_saved_kcycles;
+    r->port.txt_layout_hits      += s->txt_layout_hits;
+    r->port.txt_layout_misses    += s->txt_layout_misses;
+    r->port.txt_layout_hit_bytes += s->txt_layout_hit_bytes;
+    r->port.glyph_hits           += s->glyph_hits;
+    r->port.glyph_misses         += s->glyph_misses;
+    r->port.wakeups              += s->wakeups;
+    r->port.wake_events          += s->wake_events;
+    r->port.input_events         += s->input_events;
+    r->port.input_latency_us     += s->input_latency_us;
+    r->port.touch_reads          += s->touch_reads;
+}
+
+static void phase_add_scr(phase_result_t* r, const ui_screen_cache_stats_t* c)
+{
+    r->scr.hits              += c->hits;
+    r->scr.misses            += c->misses;
+    r->scr.snapshots         += c->snapshots;
+    r->scr.snapshot_us       += c->snapshot_us;
+    r->scr.transitions       += c->transitions;
+    r->scr.transition_frames += c->transition_frames;
+    r->scr.transition_us     += c->transition_us;
+}
+
+static void emit(const phase_result_t* r)
+{
+    const lvgl_port_stats_t* s = &r->port;
+    uint32_t frames = s->frames ? s->frames : 1;
+    uint32_t runs   = r->runs ? r->runs : 1;
+    uint32_t wall   = r->wall_us ? r->wall_us : 1;
+    const ui_screen_cache_stats_t* c = &r->scr;
+
+    char line[1024];
+    int n = snprintf(line, sizeof(line),
+                     "{\"bench\":\"render\",\"phase\":\"%s\",\"mode\":%d,\"rot\":%d,\"buf_age\":%d,\"buf_rows\":%d,"
+                     "\"buf_num\":%d,\"buf_psram\":%d,\"flush_task\":%d,\"par_blend\":%d,\"frames\":%u,\"fps\":%.1f,"
+                     "\"render_us\":%u,\"flush_us\":%u,\"flush_px\":%u,\"rotate_bytes\":%u,\"split_px\":%u,"
+                     "\"occl_fill_bytes\":%u,"
+                     "\"async_blit\":%d,\"blit_px\":%u,\"blit_saved_kcyc_per_img\":%d,"
+                     "\"txt_cache\":%d,\"txt_hits\":%u,\"txt_misses\":%u,\"txt_hit_bytes\":%u,"
+                     "\"font_subset\":%d,\"glyph_hits\":%u,\"glyph_misses\":%u,"
+                     "\"scr_cache\":%d,\"scr_anim\":\"%s\",\"scr_hits\":%u,\"scr_misses\":%u,\"snap_ms\":%.1f,"
+                     "\"anim_fps\":%.1f,\"event_wake\":%d,\"wakeups_per_s\":%.1f,\"input_ms\":%.1f,"
+                     "\"touch_task\":%d,\"touch_reads_per_s\":%.1f,"
+                     "\"first_frame_ms\":%.1f,\"settle_ms\":%.1f",
+                     r->phase, LVGL_PORT_AVOID_TEARING_MODE, CONFIG_LVGL_PORT_ROTATION_DEGREE, LVGL_PORT_BUFFER_AGE,
+                     LVGL_PORT_BUFFER_SIZE_HEIGHT, LVGL_PORT_BUFFER_NUM, BENCH_BUFFER_PSRAM, LVGL_PORT_FLUSH_TASK,
+                     LVGL_PORT_PARALLEL_BLEND, (unsigned)s->frames, s->frames * 1e6 / wall,
+                     (unsigned)((s->refr_us - BENCH_FLUSH_ON_LVGL_TASK_US(s)) / frames),
+                     (unsigned)(s->flush_us / frames), (unsigned)(s->flush_px / frames),
+                     (unsigned)(s->rotate_px / frames * sizeof(lv_color_t)),
+                     (unsigned)(s->split_px / frames),
+                     (unsigned)(s->occluded_px / frames * sizeof(lv_color_t)),
+                     LVGL_PORT_ASYNC_BLIT, (unsigned)(s->blit_px / frames),
+                     (int)(s->blit_images ? s->blit_saved_kcycles / (int32_t)s->blit_images : 0),
+                     LV_TXT_LAYOUT_CACHE_NUM, (unsigned)(s->txt_layout_hits / frames),
+                     (unsigned)(s->txt_layout_misses / frames), (unsigned)(s->txt_layout_hit_bytes / frames),
+                     BENCH_FONT_SUBSET, (unsigned)(s->glyph_hits / frames), (unsigned)(s->glyph_misses / frames),
+                     BENCH_SCREEN_CACHE, BENCH_SCREEN_TRANSITION, (unsigned)c->hits, (unsigned)c->misses,
+                     c->snapshots ? c->snapshot_us / 1000.0 / c->snapshots : 0.0,
+                     c->transition_us ? c->transition_frames * 1e6 / c->transition_us : 0.0,
+                     BENCH_EVENT_WAKE, s->wakeups * 1e6 / wall,
+                     s->input_events ? s->input_latency_us / 1000.0 / s->input_events : 0.0,
+                     BENCH_TOUCH_TASK, s->touch_reads * 1e6 / wall,
+                     r->first_frame_us / 1000.0 / runs, r->settle_us / 1000.0 / runs);
+    for (int i = 0; i < portNUM_PROCESSORS && n < (int)sizeof(line); ++i) {
+        uint32_t idle = r->idle_us[i] < wall ? r->idle_us[i] : wall;
+        n += snprintf(line + n, sizeof(line) - n, ",\"cpu%d\":%.1f", i, 100.0 * (wall - idle) / wall);
+    }
+    if (n < (int)sizeof(line)) {
+        n += snprintf(line + n, sizeof(line) - n, ",\"sram_port\":%u,\"psram_port\":%u,\"sram_free\":%u,\"psram_free\":%u}\n",
+                      (unsigned)s_port_mem.sram, (unsigned)s_port_mem.psram,
+                      (unsigned)heap_caps_get_free_size(MALLOC_CAP_INTERNAL),
+                      (unsigned)heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
+    }
+    if (n >= (int)sizeof(line)) n = sizeof(line) - 1;
+
+    ESP_LOGI(TAG, "%.*s", n - 1, line);
+    uart_write(line, (uint32_t)n, 0);
+}
+
+static void demo_finished_cb(void)
+{
+    xSemaphoreGive(s_demo_done);
+}
+
+static void run_demo(void)
+{
+    phase_result_t r = { .phase = "lv_demo_benchmark", .runs = 1 };
+    lvgl_port_stats_t s;
+    uint32_t idle0[portNUM_PROCESSORS], idle1[portNUM_PROCESSORS];
+
+    lvgl_port_lock(-1);
+    lv_demo_benchmark_set_finished_cb(demo_finished_cb);
+    lv_demo_benchmark_set_max_speed(true);
+    lvgl_port_get_stats(&s, true);
+    idle_sample(idle0);
+    int64_t start = esp_timer_get_time();
+    lv_demo_benchmark();
+    lvgl_port_unlock();
+
+    xSemaphoreTake(s_demo_done, portMAX_DELAY);
+
+    lvgl_port_lock(-1);
+    r.wall_us = (uint32_t)(esp_timer_get_time() - start);
+    lvgl_port_get_stats(&s, true);
+    idle_sample(idle1);
+    lv_demo_benchmark_close();
+    lvgl_port_unlock();
+
+    phase_add(&r, &s);
+    for (int i = 0; i < portNUM_PROCESSORS; ++i) r.idle_us[i] = idle1[i] - idle0[i];
+    emit(&r);
+}
+
+/* One transition: run `handler` as a button press would, then measure until the screen settles. */
+static void run_transition(phase_result_t* r, void (*handler)(lv_event_t*))
+{
+    lvgl_port_stats_t s;
+    ui_screen_cache_stats_t c;
+    uint32_t idle0[portNUM_PROCESSORS], idle1[portNUM_PROCESSORS];
+
+    lvgl_port_lock(-1);
+    lvgl_port_get_stats(&s, true);
+    ui_screen_cache_get_stats(&c, true);
+    idle_sample(idle0);
+    int64_t start = esp_timer_get_time();
+    handler(NULL);
+    lvgl_port_unlock();
+
+    vTaskDelay(pdMS_TO_TICKS(CONFIG_RENDER_BENCH_SETTLE_MS));
+
+    lvgl_port_get_stats(&s, true);
+    idle_sample(idle1);
+    /* Includes the snapshots refreshed on idle after the switch */
+    lvgl_port_lock(-1);
+    ui_screen_cache_get_stats(&c, true);
+    lvgl_port_unlock();
+    r->wall_us += (uint32_t)(esp_timer_get_time() - start);
+    r->runs++;
+    if (s.frames) {
+        r->first_frame_us += (uint32_t)(s.first_frame_end - start);
+        r->settle_us      += (uint32_t)(s.last_frame_end - start);
+    }
+    phase_add(r, &s);
+    phase_add_scr(r, &c);
+    for (int i = 0; i < portNUM_PROCESSORS; ++i) r->idle_us[i] += idle1[i] - idle0[i];
+}
+
+/* Properties read for every object as layout and drawing do */
+static const lv_style_prop_t s_style_props[] = {
+    LV_STYLE_BG_COLOR, LV_STYLE_BG_OPA, LV_STYLE_BORDER_WIDTH, LV_STYLE_RADIUS,
+    LV_STYLE_PAD_TOP, LV_STYLE_TEXT_COLOR, LV_STYLE_TEXT_FONT, LV_STYLE_TRANSFORM_WIDTH,
+};
+static volatile int32_t s_style_sink;
+
+static uint32_t style_walk(lv_obj_t* obj, uint32_t* objs)
+{
+    if (obj == NULL) return 0;
+    int32_t sink = 0;
+    for (size_t i = 0; i < sizeof(s_style_props) / sizeof(s_style_props[0]); ++i) {
+        sink ^= lv_obj_get_style_prop(obj, LV_PART_MAIN, s_style_props[i]).num;
+    }
+    s_style_sink = sink;
+    (*objs)++;
+    uint32_t lookups = sizeof(s_style_props) / sizeof(s_style_props[0]);
+    for (uint32_t i = 0; i < lv_obj_get_child_cnt(obj); ++i) {
+        lookups += style_walk(lv_obj_get_child(obj, i), objs);
+    }
+    return lookups;
+}
+
+/* Style lookups over both screens, where objects and style lists sit per the LVGL allocator */
+static void run_style(void)
+{
+    uint32_t objs = 0, lookups = 0;
+    lv_mem_psram_stats_t mem;
+
+    lvgl_port_lock(-1);
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < BENCH_STYLE_RUNS; ++i) {
+        objs = 0;
+        lookups += style_walk(ui_Screen1, &objs) + style_walk(ui_Screen2, &objs);
+    }
+    uint32_t us = (uint32_t)(esp_timer_get_time() - start);
+    lv_mem_psram_get_stats(&mem, false);
+    lvgl_port_unlock();
+
+    char line[256];
+    int n = snprintf(line, sizeof(line),
+                     "{\"bench\":\"style\",\"lv_mem\":\"%s\",\"objs\":%u,\"lookups\":%u,\"ns_per_lookup\":%.1f,"
+                     "\"pool_kb\":%u,\"pool_peak_kb\":%.1f,\"pool_allocs\":%u,\"psram_allocs\":%u,\"spills\":%u}\n",
+                     lv_mem_psram_mode(), (unsigned)objs, (unsigned)lookups, lookups ? us * 1000.0 / lookups : 0.0,
+                     (unsigned)(mem.pool_size / 1024), mem.pool_peak / 1024.0, (unsigned)mem.pool_allocs,
+                     (unsigned)mem.psram_allocs, (unsigned)mem.spills);
+    if (n >= (int)sizeof(line)) n = sizeof(line) - 1;
+    ESP_LOGI(TAG, "%.*s", n - 1, line);
+    uart_write(line, (uint32_t)n, 0);
+}
+
+static void run_ui(void)
+{
+    phase_result_t to_img = { .phase = "ui_screen2_to_screen1" };
+    phase_result_t to_qa  = { .phase = "ui_screen1_to_screen2" };
+
+    lvgl_port_lock(-1);
+    lv_obj_clean(lv_scr_act());
+    ui_init(); /* shows Screen2 */
+    lvgl_port_unlock();
+    vTaskDelay(pdMS_TO_TICKS(CONFIG_RENDER_BENCH_SETTLE_MS));
+
+    for (int i = 0; i < CONFIG_RENDER_BENCH_TRANSITIONS / 2; ++i) {
+        run_transition(&to_img, on_btn_answer_pressed);
+        run_transition(&to_qa, on_btn_change_pressed);
+    }
+    emit(&to_img);
+    emit(&to_qa);
+    run_style();
+
+    // Nothing happens on screen: LVGL task wakeups and CPU load at rest
+    phase_result_t idle = { .phase = "ui_idle", .runs = 1 };
+    lvgl_port_stats_t s;
+    uint32_t idle0[portNUM_PROCESSORS], idle1[portNUM_PROCESSORS];
+    vTaskDelay(pdMS_TO_TICKS(CONFIG_RENDER_BENCH_SETTLE_MS));
+    lvgl_port_get_stats(&s, true);
+    idle_sample(idle0);
+    int64_t start = esp_timer_get_time();
+    vTaskDelay(pdMS_TO_TICKS(5 * CONFIG_RENDER_BENCH_SETTLE_MS));
+    lvgl_port_get_stats(&s, true);
+    idle_sample(idle1);
+    idle.wall_us = (uint32_t)(esp_timer_get_time() - start);
+    phase_add(&idle, &s);
+    for (int i = 0; i < portNUM_PROCESSORS; ++i) idle.idle_us[i] = idle1[i] - idle0[i];
+    emit(&idle);
+}
+
+static void bench_task(void*)
+{
+    uart_init();
+
+    run_demo();
+    run_ui();
+
+    ESP_LOGI(TAG, "done");
+    char done[] = "{\"bench\":\"done\"}\n";
+    uart_write(done, sizeof(done) - 1, 0);
+    vTaskDelete(NULL);
+}
+
+void render_bench_start(const render_bench_mem_t* port_mem)
+{
+    s_port_mem  = *port_mem;
+    s_demo_done = xSemaphoreCreateBinary();
+    if (!s_demo_done || xTaskCreate(bench_task, "render_bench", BENCH_TASK_STACK, NULL, BENCH_TASK_PRIO, NULL) != pdPASS) {
+        ESP_LOGE(TAG, "bench task create failed");
+    }
+}
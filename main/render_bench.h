@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Heap used by the display (LCD frame buffers, LVGL draw buffers, LVGL init). */
+typedef struct {
+    size_t sram;
+    size_t psram;
+} render_bench_mem_t;
+
+/*
+ * Start the render benchmark task (CONFIG_RENDER_BENCH). Call instead of
+ * ui_init(), after lvgl_port_start(). Results go to UART1 and the log as one
+ * JSON object per line.
+ */
+void render_bench_start(const render_bench_mem_t* port_mem);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,650 @@
+#!/usr/bin/env python3
+"""
+Asset packer for the quiz content.
+
+Builds the runtime content catalog (assets/assets/catalog.bin) read by
+components/ui/ui_catalog.c from a JSON description:
+
+    python tools/asset_packer.py catalog catalog/catalog.json
+
+Every item of the JSON file has:
+    image     path of the RAW frame relative to the S: drive ("assets/ui_img_01_png.bin")
+    w, h      frame size in pixels
+    cf        LVGL color format name without the LV_IMG_CF_ prefix ("TRUE_COLOR");
+              ignored when "source" is given
+    question  question shown on the question screen
+    options   exactly three answer options
+    tts       text spoken by "Learn more"
+    source    optional: source image (PNG, or RAW with "source_cf") relative to
+              the repository. When present, "image" is (re)encoded from it in
+              the smallest format meeting --psnr (or the item's "psnr"), and
+              w/h/cf are taken from it. RAW sources use w/h as their size.
+    jpeg      optional with "source": {"quality": 85, "strip": 16}. The image is
+              stored as split JPEG (.sjpg, independent strips of "strip" rows)
+              and decoded on both cores by components/ui/ui_jpeg.c. With
+              "raw": true, the RGB565 frame is also written as "img.raw.bin",
+              which UI_JPEG_BENCH reads to time against the decode.
+    cover     optional, default true: keep opaque images of COVER_MIN_PX pixels
+              or more in TRUE_COLOR (see below); false lets them be indexed.
+    mips      optional, default true: also write RGB565 copies at 1/2, 1/4 and
+              1/8 scale ("img.mip2.bin", ...) for the gallery thumbnails.
+    anim      optional: {"frames": [...], "delay": 100, "keyframe_interval": 0}.
+              "image" becomes an animation (see ui_anim.h) built from the frame
+              sources (PNG, or RAW with "source_cf" and w/h); "source" is not used.
+
+Animations are built from image sequences with:
+
+    python tools/asset_packer.py anim f_000.png f_001.png ... --delay 80 -o assets/assets/cat.anim
+
+Single images are converted with:
+
+    python tools/asset_packer.py image icon.png -o assets/assets/icon.bin
+    python tools/asset_packer.py image frame.bin --size 578x339 --src-cf TRUE_COLOR -o out.bin
+
+Candidate formats, smallest first: INDEXED_1/2/4/8BIT (palette with alpha),
+ALPHA_1/2/4/8BIT (only for single-color images, see --allow-alpha-only),
+TRUE_COLOR (RGB565) for opaque images and RGB565A8 otherwise. Quality is the
+PSNR of the alpha-premultiplied RGBA result against the source.
+
+Opaque images of COVER_MIN_PX pixels or more stay TRUE_COLOR unless "cover" is
+false (--no-cover): only TRUE_COLOR passes lv_img's cover check, so an indexed
+photo has the background drawn under it (LV_REFR_OCCLUSION skips nothing), is
+not copied by the GDMA (LVGL_PORT_ASYNC_BLIT) and goes through the palette
+lookup. tools/host/img_format_bench measures the 578x339 quiz photo at about
+3.3x the draw time of TRUE_COLOR as INDEXED_8BIT, for half the bytes.
+
+PNG input and JPEG output need Pillow. The binary layout must match ui_catalog.h.
+"""
+
+import argparse
+import json
+import math
+import os
+import struct
+import sys
+from collections import Counter
+
+REPO_ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+ASSETS_ROOT = os.path.join(REPO_ROOT, "assets")  # mounted as the S: drive
+
+CATALOG_MAGIC = 0x54434955  # "UICT"
+CATALOG_VERSION = 1
+
+DEFAULT_PSNR = 38.0
+COVER_MIN_PX = 4096  # LVGL_PORT_ASYNC_BLIT_MIN_PX: smaller images are not blitted either
+
+# ui_catalog_record_t::flags
+FLAG_JPEG = 0x01
+
+FLAG_ANIM = 0x02
+FLAG_MIPS = 0x04
+MIP_LEVELS = 3  # 1/2, 1/4, 1/8
+
+# ui_anim.h
+ANIM_MAGIC = 0x4E414955  # "UIAN"
+ANIM_VERSION = 1
+ANIM_HEADER_FMT = "<IHHHHIII"
+ANIM_FRAME_FMT = "<IIHBx"
+ANIM_RECT_FMT = "<HHHH"
+ANIM_KEY, ANIM_DELTA = 0, 1
+ANIM_TILE = 16
+
+# lv_sjpg.c container
+SJPG_MAGIC = b"_SJPG__\0V1.00\0"
+
+HEADER_FMT = "<IHHIIII8x"
+RECORD_FMT = "<6IIHHBBH"
+
+# lv_img_cf_t values (LVGL v8)
+LV_IMG_CF = {
+    "TRUE_COLOR": 4,
+    "TRUE_COLOR_ALPHA": 5,
+    "TRUE_COLOR_CHROMA_KEYED": 6,
+    "INDEXED_1BIT": 7,
+    "INDEXED_2BIT": 8,
+    "INDEXED_4BIT": 9,
+    "INDEXED_8BIT": 10,
+    "ALPHA_1BIT": 11,
+    "ALPHA_2BIT": 12,
+    "ALPHA_4BIT": 13,
+    "ALPHA_8BIT": 14,
+    "RGB565A8": 20,
+}
+
+
+# --------------------------------------------------------------------------
+# Image encoding. Pixels are lists of (r, g, b, a) tuples, 8 bits per channel.
+# LV_COLOR_DEPTH 16 without byte swap: RGB565 little-endian.
+# --------------------------------------------------------------------------
+
+def to565(r, g, b):
+    return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+
+
+def from565(c):
+    r, g, b = (c >> 11) & 0x1F, (c >> 5) & 0x3F, c & 0x1F
+    return (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)
+
+
+def as_rendered(r, g, b):
+    """Color as it ends up on an RGB565 display."""
+    return from565(to565(r, g, b))
+
+
+def decode_raw(data, w, h, cf):
+    n = w * h
+    if cf == "TRUE_COLOR":
+        return [from565(v) + (255,) for v in struct.unpack_from("<%dH" % n, data)]
+    if cf == "TRUE_COLOR_ALPHA":
+        return [from565(data[i] | data[i + 1] << 8) + (data[i + 2],) for i in range(0, n * 3, 3)]
+    if cf == "RGB565A8":
+        colors = struct.unpack_from("<%dH" % n, data)
+        return [from565(c) + (data[n * 2 + i],) for i, c in enumerate(colors)]
+    raise ValueError("unsupported RAW source format %s" % cf)
+
+
+def load_source(path, size=None, src_cf=None):
+    if path.lower().endswith(".png"):
+        try:
+            from PIL import Image
+        except ImportError:
+            sys.exit("PNG input needs Pillow (pip install pillow)")
+        img = Image.open(path).convert("RGBA")
+        return img.width, img.height, list(img.getdata())
+    if not size or not src_cf:
+        raise ValueError("%s: RAW input needs --size and --src-cf" % path)
+    w, h = size
+    with open(path, "rb") as f:
+        return w, h, decode_raw(f.read(), w, h, src_cf)
+
+
+def psnr(src, out):
+    """PSNR of alpha-premultiplied RGBA, so invisible color differences do not count."""
+    err = 0
+    for (r0, g0, b0, a0), (r1, g1, b1, a1) in zip(src, out):
+        err += ((r0 * a0 - r1 * a1) // 255) ** 2 + ((g0 * a0 - g1 * a1) // 255) ** 2 + \
+               ((b0 * a0 - b1 * a1) // 255) ** 2 + (a0 - a1) ** 2
+    if err == 0:
+        return math.inf
+    mse = err / (len(src) * 4.0)
+    return 10 * math.log10(255.0 * 255.0 / mse)
+
+
+def pack_bits(values, w, h, bits):
+    """Rows start on a byte boundary, first pixel in the most significant bits."""
+    out = bytearray()
+    per_byte = 8 // bits
+    for y in range(h):
+        row = values[y * w:(y + 1) * w]
+        for x in range(0, w, per_byte):
+            byte = 0
+            for k in range(per_byte):
+                byte <<= bits
+                if x + k < w:
+                    byte |= row[x + k]
+            out.append(byte)
+    return bytes(out)
+
+
+def median_cut(counts, n):
+    """Weighted median cut in RGBA. Returns (palette, {color: index})."""
+    boxes = [list(counts.items())]
+    while len(boxes) < n:
+        best, best_score, best_ch = None, 0, 0
+        for i, box in enumerate(boxes):
+            if len(box) < 2:
+                continue
+            pop = sum(c for _, c in box)
+            for ch in range(4):
+                vals = [col[ch] for col, _ in box]
+                score = (max(vals) - min(vals)) * math.sqrt(pop)
+                if score > best_score:
+                    best, best_score, best_ch = i, score, ch
+        if best is None:
+            break
+        box = sorted(boxes[best], key=lambda e: e[0][best_ch])
+        half = sum(c for _, c in box) / 2.0
+        acc, cut = 0, 1
+        for k, (_, c) in enumerate(box):
+            acc += c
+            if acc >= half:
+                cut = min(max(k, 1), len(box) - 1)
+                break
+        boxes[best:best + 1] = [box[:cut], box[cut:]]
+
+    palette, index = [], {}
+    for i, box in enumerate(boxes):
+        pop = sum(c for _, c in box)
+        palette.append(tuple(int(round(sum(col[ch] * c for col, c in box) / pop)) for ch in range(4)))
+        for col, _ in box:
+            index[col] = i
+    return palette, index
+
+
+def refine_palette(counts, palette, iters):
+    """A few k-means steps over the unique colors; median cut alone leaves ~1.5 dB on the table."""
+    items = list(counts.items())
+    index = {}
+    for it in range(iters + 1):
+        sums = [[0, 0, 0, 0, 0] for _ in palette]
+        for col, c in items:
+            r, g, b, a = col
+            best, best_d = 0, 1 << 30
+            for i, (pr, pg, pb, pa) in enumerate(palette):
+                d = (r - pr) ** 2 + (g - pg) ** 2 + (b - pb) ** 2 + (a - pa) ** 2
+                if d < best_d:
+                    best, best_d = i, d
+            index[col] = best
+            acc = sums[best]
+            acc[0] += r * c
+            acc[1] += g * c
+            acc[2] += b * c
+            acc[3] += a * c
+            acc[4] += c
+        if it == iters:
+            break
+        palette = [tuple(int(round(acc[k] / acc[4])) for k in range(4)) if acc[4] else p
+                   for acc, p in zip(sums, palette)]
+    return palette, index
+
+
+def enc_indexed(px, w, h, bits):
+    counts = Counter(px)
+    palette, index = median_cut(counts, 1 << bits)
+    if len(counts) > len(palette):
+        palette, index = refine_palette(counts, palette, 2)
+    palette += [(0, 0, 0, 0)] * ((1 << bits) - len(palette))
+    blob = b"".join(struct.pack("<BBBB", b, g, r, a) for r, g, b, a in palette)
+    blob += pack_bits([index[p] for p in px], w, h, bits)
+    shown = [as_rendered(*palette[i][:3]) + (palette[i][3],) for i in range(len(palette))]
+    return blob, [shown[index[p]] for p in px]
+
+
+def enc_alpha(px, w, h, bits, color):
+    levels = (1 << bits) - 1
+    q = [(a * levels + 127) // 255 for _, _, _, a in px]
+    blob = bytes(q) if bits == 8 else pack_bits(q, w, h, bits)
+    return blob, [color + (v * 255 // levels,) for v in q]
+
+
+def enc_true_color(px, w, h):
+    colors = [to565(r, g, b) for r, g, b, _ in px]
+    return struct.pack("<%dH" % len(colors), *colors), [from565(c) + (255,) for c in colors]
+
+
+def enc_rgb565a8(px, w, h):
+    colors = [to565(r, g, b) for r, g, b, _ in px]
+    blob = struct.pack("<%dH" % len(colors), *colors) + bytes(a for _, _, _, a in px)
+    return blob, [from565(c) + (p[3],) for c, p in zip(colors, px)]
+
+
+def candidates(px, w, h, allow_alpha_only):
+    """(cf, size, encoder) tuples, smallest first."""
+    opaque = all(a == 255 for _, _, _, a in px)
+    cands = []
+    for bits, cf in ((1, "INDEXED_1BIT"), (2, "INDEXED_2BIT"), (4, "INDEXED_4BIT"), (8, "INDEXED_8BIT")):
+        size = (1 << bits) * 4 + (w * bits + 7) // 8 * h
+        cands.append((cf, size, lambda b=bits: enc_indexed(px, w, h, b)))
+
+    visible = {as_rendered(r, g, b) for r, g, b, a in px if a}
+    if not opaque and len(visible) <= 1:
+        color = visible.pop() if visible else (0, 0, 0)
+        # Alpha-only images take their color from the img_recolor style (black by default).
+        if allow_alpha_only or color == (0, 0, 0):
+            for bits, cf in ((1, "ALPHA_1BIT"), (2, "ALPHA_2BIT"), (4, "ALPHA_4BIT"), (8, "ALPHA_8BIT")):
+                size = (w * bits + 7) // 8 * h
+                cands.append((cf, size, lambda b=bits, c=color: enc_alpha(px, w, h, b, c)))
+
+    if opaque:
+        cands.append(("TRUE_COLOR", w * h * 2, lambda: enc_true_color(px, w, h)))
+    else:
+        cands.append(("RGB565A8", w * h * 3, lambda: enc_rgb565a8(px, w, h)))
+    return sorted(cands, key=lambda c: c[1])
+
+
+def choose_format(px, w, h, min_psnr, allow_alpha_only=False, force=None, cover=True):
+    """Returns (cf name, blob, psnr) of the smallest candidate meeting min_psnr.
+    With `cover`, opaque images of COVER_MIN_PX pixels or more are TRUE_COLOR."""
+    cands = candidates(px, w, h, allow_alpha_only)
+    if cover and not force and w * h >= COVER_MIN_PX:
+        cands = [c for c in cands if c[0] == "TRUE_COLOR"] or cands
+    if force:
+        cands = [c for c in cands if c[0] == force]
+        if not cands:
+            raise ValueError("format %s is not applicable to this image" % force)
+    for cf, _, encode in cands:
+        blob, shown = encode()
+        q = psnr(px, shown)
+        if q >= min_psnr or cf in ("TRUE_COLOR", "RGB565A8") or force:
+            return cf, blob, q
+    raise AssertionError("no lossless fallback")
+
+
+def write_blob(out, blob):
+    os.makedirs(os.path.dirname(os.path.abspath(out)), exist_ok=True)
+    with open(out, "wb") as f:
+        f.write(blob)
+
+
+def encode_pixels(px, w, h, out, min_psnr, allow_alpha_only=False, force=None, cover=True):
+    cf, blob, q = choose_format(px, w, h, min_psnr, allow_alpha_only, force, cover)
+    write_blob(out, blob)
+    print("%s: %dx%d -> %s, %d bytes, PSNR %s" % (os.path.relpath(out, REPO_ROOT), w, h, cf, len(blob),
+                                                   "inf" if q == math.inf else "%.1f dB" % q))
+    return cf, len(blob)
+
+
+def encode_image(src, out, min_psnr, size=None, src_cf=None, allow_alpha_only=False, force=None, cover=True):
+    w, h, px = load_source(src, size, src_cf)
+    cf, n = encode_pixels(px, w, h, out, min_psnr, allow_alpha_only, force, cover)
+    return w, h, cf, n
+
+
+def mip_path(path, shift):
+    """Must match ui_catalog_mip_path(): "x/img.bin" -> "x/img.mip4.bin"."""
+    stem, ext = os.path.splitext(path)
+    return "%s.mip%d%s" % (stem, 1 << shift, ext)
+
+
+def downscale2(px, w, h):
+    """2x2 box filter; an odd last row/column is dropped. Transparent pixels are flattened on black."""
+    nw, nh = w // 2, h // 2
+    out = []
+    for y in range(nh):
+        r0, r1 = (2 * y) * w, (2 * y + 1) * w
+        for x in range(nw):
+            quad = (px[r0 + 2 * x], px[r0 + 2 * x + 1], px[r1 + 2 * x], px[r1 + 2 * x + 1])
+            out.append(tuple((sum(p[c] * p[3] // 255 for p in quad) + 2) // 4 for c in range(3)) + (255,))
+    return out, nw, nh
+
+
+def encode_mips(px, w, h, out):
+    """RGB565 copies at 1/2, 1/4 and 1/8 scale next to `out`, for thumbnails."""
+    for shift in range(1, MIP_LEVELS + 1):
+        px, w, h = downscale2(px, w, h)
+        blob, _ = enc_true_color(px, w, h)
+        write_blob(mip_path(out, shift), blob)
+    print("%s: mips down to %dx%d" % (os.path.relpath(out, REPO_ROOT), w, h))
+
+
+def raw_twin_path(path):
+    """Must match raw_twin_path() in components/ui/ui_jpeg.c: "x/img.sjpg" -> "x/img.raw.bin"."""
+    return os.path.splitext(path)[0] + ".raw.bin"
+
+
+def encode_sjpg(px, w, h, out, quality=85, strip=16, raw=False):
+    """Baseline JPEG strips in LVGL's split-JPEG container; every strip decodes on its own.
+    With `raw`, the RGB565 frame is written next to it for UI_JPEG_BENCH."""
+    try:
+        from io import BytesIO
+        from PIL import Image
+    except ImportError:
+        sys.exit("JPEG output needs Pillow (pip install pillow)")
+    # Transparent pixels are flattened on black, JPEG has no alpha.
+    flat = [(r * a // 255, g * a // 255, b * a // 255, 255) for r, g, b, a in px]
+    img = Image.new("RGB", (w, h))
+    img.putdata([p[:3] for p in flat])
+
+    frames = []
+    for y in range(0, h, strip):
+        buf = BytesIO()
+        img.crop((0, y, w, min(h, y + strip))).save(buf, "JPEG", quality=quality, progressive=False,
+                                                    optimize=True, subsampling="4:2:0")
+        if len(buf.getvalue()) > 0xFFFF:
+            raise ValueError("JPEG strip larger than 64 KB, reduce 'strip'")
+        frames.append(buf.getvalue())
+
+    blob = SJPG_MAGIC + struct.pack("<HHHH", w, h, len(frames), strip)
+    blob += struct.pack("<%dH" % len(frames), *map(len, frames)) + b"".join(frames)
+    os.makedirs(os.path.dirname(os.path.abspath(out)), exist_ok=True)
+    with open(out, "wb") as f:
+        f.write(blob)
+    print("%s: %dx%d -> split JPEG q%d, %d strips, %d bytes (RGB565 %d)" % (
+        os.path.relpath(out, REPO_ROOT), w, h, quality, len(frames), len(blob), w * h * 2))
+    if raw:
+        write_blob(raw_twin_path(out), enc_true_color(flat, w, h)[0])
+    return len(blob)
+
+
+def dirty_rects(prev, cur, w, h, tile=ANIM_TILE):
+    """Changed pixels as rectangles on a tile grid: tiles merged into row spans,
+    then spans with the same columns merged across consecutive tile rows."""
+    cols, rows = (w + tile - 1) // tile, (h + tile - 1) // tile
+    spans = []  # per tile row: list of (c0, c1)
+    for ty in range(rows):
+        dirty = [False] * cols
+        for y in range(ty * tile, min(h, (ty + 1) * tile)):
+            a, b = prev[y * w:(y + 1) * w], cur[y * w:(y + 1) * w]
+            if a == b:
+                continue
+            for x in range(w):
+                if a[x] != b[x]:
+                    dirty[x // tile] = True
+        row, c = [], 0
+        while c < cols:
+            if dirty[c]:
+                c0 = c
+                while c + 1 < cols and dirty[c + 1]:
+                    c += 1
+                row.append((c0, c))
+            c += 1
+        spans.append(row)
+
+    rects, open_rects = [], {}
+    for ty, row in enumerate(spans + [[]]):
+        still_open = {}
+        for span in row:
+            start = open_rects.pop(span, ty)
+            still_open[span] = start
+        for (c0, c1), start in open_rects.items():
+            rects.append((c0, start, c1, ty - 1))
+        open_rects = still_open
+
+    out = []
+    for c0, t0, c1, t1 in rects:
+        x, y = c0 * tile, t0 * tile
+        out.append((x, y, min(w, (c1 + 1) * tile) - x, min(h, (t1 + 1) * tile) - y))
+    return out
+
+
+def encode_anim(frames, w, h, delays, out, keyframe_interval=0):
+    """frames: list of RGB565 value lists. Returns the file size."""
+    key_size = w * h * 2
+    entries, blobs = [], []
+    since_key = 0
+    for i, cur in enumerate(frames):
+        blob, kind = None, ANIM_KEY
+        if i > 0 and not (keyframe_interval and since_key >= keyframe_interval):
+            rects = dirty_rects(frames[i - 1], cur, w, h)
+            delta = bytearray(struct.pack("<H", len(rects)))
+            for x, y, rw, rh in rects:
+                delta += struct.pack(ANIM_RECT_FMT, x, y, rw, rh)
+                for yy in range(y, y + rh):
+                    delta += struct.pack("<%dH" % rw, *cur[yy * w + x:yy * w + x + rw])
+            # A delta larger than half a key frame costs more to apply than it saves.
+            if len(delta) < key_size // 2:
+                blob, kind = bytes(delta), ANIM_DELTA
+        if blob is None:
+            blob = struct.pack("<%dH" % len(cur), *cur)
+            since_key = 0
+        since_key += 1
+        entries.append((kind, delays[i]))
+        blobs.append(blob)
+
+    header_size = struct.calcsize(ANIM_HEADER_FMT)
+    index_off = header_size
+    off = index_off + struct.calcsize(ANIM_FRAME_FMT) * len(frames)
+    index = bytearray()
+    for (kind, delay), blob in zip(entries, blobs):
+        index += struct.pack(ANIM_FRAME_FMT, off, len(blob), delay, kind)
+        off += len(blob)
+    max_delta = max([len(b) for (k, _), b in zip(entries, blobs) if k == ANIM_DELTA] or [0])
+    header = struct.pack(ANIM_HEADER_FMT, ANIM_MAGIC, ANIM_VERSION, len(frames), w, h, index_off, max_delta, 0)
+
+    data = header + index + b"".join(blobs)
+    os.makedirs(os.path.dirname(os.path.abspath(out)), exist_ok=True)
+    with open(out, "wb") as f:
+        f.write(data)
+    keys = sum(1 for k, _ in entries if k == ANIM_KEY)
+    print("%s: %dx%d, %d frames (%d key), %d bytes (%d as key frames only)" % (
+        os.path.relpath(out, REPO_ROOT), w, h, len(frames), keys, len(data), key_size * len(frames)))
+    return len(data)
+
+
+def load_frames(paths, size=None, src_cf=None):
+    frames, dims = [], None
+    for path in paths:
+        w, h, px = load_source(path, size, src_cf)
+        if dims and dims != (w, h):
+            raise ValueError("%s: frame size %dx%d differs from %dx%d" % ((path, w, h) + dims))
+        dims = (w, h)
+        frames.append([to565(r, g, b) for r, g, b, _ in px])
+    return dims[0], dims[1], frames
+
+
+class StringTable:
+    """Deduplicating table of { uint16 len; bytes; '\\0' } entries."""
+
+    def __init__(self):
+        self.data = bytearray()
+        self.offsets = {}
+
+    def add(self, text):
+        if text in self.offsets:
+            return self.offsets[text]
+        raw = text.encode("utf-8")
+        if len(raw) > 0xFFFF:
+            raise ValueError("string too long: %r..." % text[:32])
+        off = len(self.data)
+        self.data += struct.pack("<H", len(raw)) + raw + b"\0"
+        self.offsets[text] = off
+        return off
+
+
+def image_size(item):
+    return os.path.getsize(os.path.join(ASSETS_ROOT, item["image"]))
+
+
+def encode_sources(items, min_psnr):
+    for item in items:
+        if "source" not in item and "anim" not in item:
+            continue
+        size = (item["w"], item["h"]) if "source_cf" in item else None
+        src_cf = item.get("source_cf")
+        out = os.path.join(ASSETS_ROOT, item["image"])
+        flags = 0
+
+        if "anim" in item:
+            anim = item["anim"]
+            paths = [os.path.join(REPO_ROOT, f) for f in anim["frames"]]
+            w, h, frames = load_frames(paths, size, src_cf)
+            encode_anim(frames, w, h, [anim.get("delay", 100)] * len(frames), out, anim.get("keyframe_interval", 0))
+            _, _, px = load_source(paths[0], size, src_cf)
+            cf, flags = "TRUE_COLOR", FLAG_ANIM
+        else:
+            w, h, px = load_source(os.path.join(REPO_ROOT, item["source"]), size, src_cf)
+            if "jpeg" in item:
+                encode_sjpg(px, w, h, out, **item["jpeg"])
+                cf, flags = "TRUE_COLOR", FLAG_JPEG
+            else:
+                cf, _ = encode_pixels(px, w, h, out, item.get("psnr", min_psnr), cover=item.get("cover", True))
+
+        if item.get("mips", True):
+            encode_mips(px, w, h, out)
+            flags |= FLAG_MIPS
+        item.update(w=w, h=h, cf=cf, flags=flags)
+
+
+def build_catalog(items):
+    strings = StringTable()
+    records = bytearray()
+
+    for n, item in enumerate(items):
+        options = item["options"]
+        if len(options) != 3:
+            raise ValueError("item %d: exactly three options are required" % n)
+        cf = LV_IMG_CF[item.get("cf", "TRUE_COLOR")]
+        offs = [
+            strings.add(item["image"]),
+            strings.add(item["question"]),
+            strings.add(options[0]),
+            strings.add(options[1]),
+            strings.add(options[2]),
+            strings.add(item["tts"]),
+        ]
+        records += struct.pack(RECORD_FMT, *offs, image_size(item), item["w"], item["h"], cf,
+                               item.get("flags", 0), 0)
+
+    record_size = struct.calcsize(RECORD_FMT)
+    index_off = struct.calcsize(HEADER_FMT)
+    strings_off = index_off + len(records)
+    header = struct.pack(HEADER_FMT, CATALOG_MAGIC, CATALOG_VERSION, record_size, len(items), index_off,
+                         strings_off, len(strings.data))
+    return header + records + strings.data
+
+
+def cmd_catalog(args):
+    with open(args.source, encoding="utf-8") as f:
+        items = json.load(f)["items"]
+
+    encode_sources(items, args.psnr)
+    blob = build_catalog(items)
+    os.makedirs(os.path.dirname(args.output), exist_ok=True)
+    with open(args.output, "wb") as f:
+        f.write(blob)
+    print("%s: %d items, %d bytes" % (os.path.relpath(args.output, REPO_ROOT), len(items), len(blob)))
+
+
+def parse_size(text):
+    w, h = text.lower().split("x")
+    return int(w), int(h)
+
+
+def cmd_image(args):
+    encode_image(args.source, args.output, args.psnr, args.size, args.src_cf, args.allow_alpha_only, args.force,
+                 args.cover)
+
+
+def cmd_anim(args):
+    w, h, frames = load_frames(args.frames, args.size, args.src_cf)
+    encode_anim(frames, w, h, [args.delay] * len(frames), args.output, args.keyframe_interval)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="cmd", required=True)
+
+    p = sub.add_parser("catalog", help="build the content catalog")
+    p.add_argument("source", help="catalog JSON")
+    p.add_argument("-o", "--output", default=os.path.join(ASSETS_ROOT, "assets", "catalog.bin"))
+    p.add_argument("--psnr", type=float, default=DEFAULT_PSNR, help="quality threshold for items with a source")
+    p.set_defaults(func=cmd_catalog)
+
+    p = sub.add_parser("image", help="encode one image in the smallest format meeting --psnr")
+    p.add_argument("source", help="PNG, or RAW LVGL frame with --size and --src-cf")
+    p.add_argument("-o", "--output", required=True)
+    p.add_argument("--psnr", type=float, default=DEFAULT_PSNR, help="minimum PSNR in dB (default %(default)s)")
+    p.add_argument("--size", type=parse_size, help="RAW input size, WxH")
+    p.add_argument("--src-cf", choices=("TRUE_COLOR", "TRUE_COLOR_ALPHA", "RGB565A8"), help="RAW input format")
+    p.add_argument("--allow-alpha-only", action="store_true",
+                   help="allow ALPHA_* for single-color images that are not black (needs img_recolor)")
+    p.add_argument("--force", choices=sorted(LV_IMG_CF), help="skip the search and use this format")
+    p.add_argument("--no-cover", dest="cover", action="store_false",
+                   help="let large opaque images be indexed (they then never cover what is under them)")
+    p.set_defaults(func=cmd_image)
+
+    p = sub.add_parser("anim", help="build a key/delta frame animation from an image sequence")
+    p.add_argument("frames", nargs="+", help="frames in order: PNG, or RAW with --size and --src-cf")
+    p.add_argument("-o", "--output", required=True)
+    p.add_argument("--delay", type=int, default=100, help="ms per frame (default %(default)s)")
+    p.add_argument("--keyframe-interval", type=int, default=0, help="force a key frame every N frames (0: never)")
+    p.add_argument("--size", type=parse_size, help="RAW input size, WxH")
+    p.add_argument("--src-cf", choices=("TRUE_COLOR", "TRUE_COLOR_ALPHA", "RGB565A8"), help="RAW input format")
+    p.set_defaults(func=cmd_anim)
+
+    args = parser.parse_args()
+    return args.func(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,588 @@
+#!/usr/bin/env python3
+"""
+Font subsetter for the SquareLine fonts (components/ui/ui_font_*.c).
+
+The fonts are generated by lv_font_conv for the whole 0x20-0x7E range with
+--no-compress. This tool keeps only the glyphs of the strings the UI can show
+and stores their bitmaps compressed (LVGL's RLE with line prefilter,
+bitmap_format 1). LVGL decompresses a glyph the first time it is drawn, and
+with LV_FONT_FMT_TXT_A8_CACHE_SIZE keeps it expanded in RAM, so only cache
+misses pay for the decompression.
+
+Write the subset of every font of FONTS into a directory (what the ui
+component does at build time with CONFIG_UI_FONT_SUBSET):
+
+    python tools/font_subset.py build -o build/fonts --report build/fonts/report.txt
+
+Print the size of each font before and after without writing anything:
+
+    python tools/font_subset.py report
+
+Check that every string of the catalog can be drawn with the subset fonts,
+e.g. after editing catalog/catalog.json without rebuilding the firmware:
+
+    python tools/font_subset.py check build/fonts
+
+The catalog lives in the asset partition and can be reflashed on its own;
+characters it gains after the firmware was built are not drawn. --keep adds
+characters to every font to leave room for that.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+REPO_ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+UI_DIR = os.path.join(REPO_ROOT, "components", "ui")
+CATALOG = os.path.join(REPO_ROOT, "catalog", "catalog.json")
+
+# font -> strings drawn with it. Fixed UI strings come from the SquareLine
+# screens, "question" / "options" pull every item of the catalog.
+FONTS = {
+    "ui_font_Font1": ["Learn    More", "Back"],     # ui_Label1 (Screen1), ui_Label5 (Screen3)
+    "ui_font_Font3": ["question"],                  # ui_que
+    "ui_font_Font4": ["A.", "B.", "C.", "options"],  # ui_LabelA/B/C, ui_labA, ui_LabB, ui_LabC
+    "ui_font_Font5": ["Show Answer"],               # ui_Label4
+}
+
+# Size of the LVGL descriptors, to report the flash used by each font
+GLYPH_DSC_SIZE = 8  # lv_font_fmt_txt_glyph_dsc_t
+CMAP_SIZE = 20      # lv_font_fmt_txt_cmap_t
+
+
+# ---------------------------------------------------------------------------
+# Parsing of lv_font_conv output
+# ---------------------------------------------------------------------------
+
+def _strip_comments(s):
+    return re.sub(r"/\*.*?\*/", "", s, flags=re.S)
+
+
+def _array(src, name, required=True):
+    m = re.search(r"\b%s\[\]\s*=\s*\{(.*?)\};" % re.escape(name), src, re.S)
+    if not m:
+        if required:
+            raise SystemExit("array %s not found" % name)
+        return None
+    body = _strip_comments(m.group(1))
+    return [int(v, 0) for v in re.findall(r"-?(?:0x[0-9a-fA-F]+|\d+)", body)]
+
+
+def _field(block, name, default=None):
+    m = re.search(r"\.%s\s*=\s*([^,\n]+)" % re.escape(name), block)
+    if not m:
+        if default is None:
+            raise SystemExit("field .%s not found" % name)
+        return default
+    return m.group(1).strip()
+
+
+class Font:
+    """The data of one lv_font_conv C file, indexed by code point."""
+
+    def __init__(self, path):
+        self.path = path
+        src = open(path, encoding="utf-8").read()
+        self.name = re.search(r"lv_font_t\s+(\w+)\s*=", src).group(1)
+
+        dsc = re.search(r"font_dsc\s*=\s*\{(.*?)\};", src, re.S).group(1)
+        self.bpp = int(_field(dsc, "bpp"))
+        self.kern_scale = int(_field(dsc, "kern_scale", "16"))
+        if int(_field(dsc, "bitmap_format", "0")) != 0:
+            raise SystemExit("%s: already compressed, subset the lv_font_conv output" % path)
+
+        pub = re.search(r"lv_font_t\s+%s\s*=\s*\{(.*?)\};" % self.name, src, re.S).group(1)
+        self.line_height = int(_field(pub, "line_height"))
+        self.base_line = int(_field(pub, "base_line"))
+        self.subpx = _field(pub, "subpx", "LV_FONT_SUBPX_NONE")
+        self.underline_position = int(_field(pub, "underline_position", "0"))
+        self.underline_thickness = int(_field(pub, "underline_thickness", "0"))
+        self.header = src[:src.index("*/") + 2]
+
+        bitmap = _array(src, "glyph_bitmap")
+        dscs = re.findall(r"\{\.bitmap_index = (\d+), \.adv_w = (\d+), \.box_w = (\d+), \.box_h = (\d+), "
+                          r"\.ofs_x = (-?\d+), \.ofs_y = (-?\d+)\}", src)
+        dscs = [tuple(int(v) for v in d) for d in dscs]
+
+        # glyph id -> code point
+        self.glyph_cp = {}
+        cmaps = re.search(r"cmaps\[\]\s*=\s*\{(.*?)\n\};", src, re.S).group(1)
+        for block in re.findall(r"\{([^{}]*)\}", cmaps):
+            start = int(_field(block, "range_start"))
+            length = int(_field(block, "range_length"))
+            gid_start = int(_field(block, "glyph_id_start"))
+            ctype = _field(block, "type").replace("LV_FONT_FMT_TXT_CMAP_", "")
+            if ctype == "FORMAT0_TINY":
+                for i in range(length):
+                    self.glyph_cp[gid_start + i] = start + i
+            elif ctype == "SPARSE_TINY":
+                for i, ofs in enumerate(_array(src, _field(block, "unicode_list"))):
+                    self.glyph_cp[gid_start + i] = start + ofs
+            else:
+                raise SystemExit("%s: cmap type %s is not supported" % (path, ctype))
+
+        # code point -> (bitmap bytes, adv_w, box_w, box_h, ofs_x, ofs_y)
+        self.glyphs = {}
+        for gid, cp in self.glyph_cp.items():
+            idx, adv_w, box_w, box_h, ofs_x, ofs_y = dscs[gid]
+            size = (box_w * box_h * self.bpp + 7) // 8
+            self.glyphs[cp] = (bytes(bitmap[idx:idx + size]), adv_w, box_w, box_h, ofs_x, ofs_y)
+
+        # Kerning keyed by code point, in the same form as the input
+        self.kern_pairs = None
+        self.kern_classes = None
+        if re.search(r"\.kern_classes\s*=\s*1", dsc):
+            left = _array(src, "kern_left_class_mapping")
+            right = _array(src, "kern_right_class_mapping")
+            kern = re.search(r"kern_classes\s*=\s*\{(.*?)\};", src, re.S).group(1)
+            self.kern_classes = {
+                "left": {cp: left[gid] for gid, cp in self.glyph_cp.items() if gid < len(left)},
+                "right": {cp: right[gid] for gid, cp in self.glyph_cp.items() if gid < len(right)},
+                "values": _array(src, "kern_class_values"),
+                "left_cnt": int(_field(kern, "left_class_cnt")),
+                "right_cnt": int(_field(kern, "right_class_cnt")),
+            }
+        elif re.search(r"\.kern_dsc\s*=\s*&kern_pairs", src):
+            ids = _array(src, "kern_pair_glyph_ids")
+            kern = re.search(r"kern_pairs\s*=\s*\{(.*?)\};", src, re.S).group(1)
+            if int(_field(kern, "glyph_ids_size")) != 0:
+                raise SystemExit("%s: 16 bit kern pair ids are not supported" % path)
+            values = _array(src, "kern_pair_values")
+            self.kern_pairs = [(self.glyph_cp[ids[2 * i]], self.glyph_cp[ids[2 * i + 1]], v)
+                               for i, v in enumerate(values)]
+
+        self.flash_bytes = (len(bitmap) + len(dscs) * GLYPH_DSC_SIZE + self._kern_bytes(self.kern_pairs, self.kern_classes)
+                            + CMAP_SIZE)
+
+    @staticmethod
+    def _kern_bytes(pairs, classes):
+        if pairs is not None:
+            return len(pairs) * 3
+        if classes is not None:
+            return len(classes["values"]) + len(classes["left"]) + len(classes["right"]) + 2
+        return 0
+
+
+# ---------------------------------------------------------------------------
+# Compression, the inverse of rle_next() / decompress() in lv_font_fmt_txt.c
+# ---------------------------------------------------------------------------
+
+class _BitWriter:
+    def __init__(self):
+        self.out = bytearray()
+        self.bits = 0
+
+    def write(self, val, n):
+        for i in range(n - 1, -1, -1):
+            if self.bits % 8 == 0:
+                self.out.append(0)
+            if (val >> i) & 1:
+                self.out[-1] |= 0x80 >> (self.bits % 8)
+            self.bits += 1
+
+
+def _unpack(data, n, bpp):
+    mask = (1 << bpp) - 1
+    px = []
+    for i in range(n):
+        bit = i * bpp
+        px.append((data[bit // 8] >> (8 - bpp - bit % 8)) & mask)
+    return px
+
+
+def compress(data, w, h, bpp):
+    """RLE-compress a glyph stored as lv_font_conv plain bitmap, rows XORed with the previous one."""
+    px = _unpack(data, w * h, bpp)
+    pre = px[:w] + [px[i] ^ px[i - w] for i in range(w, w * h)]
+
+    bw = _BitWriter()
+    n = len(pre)
+    i = 0
+    prev = None
+    repeat = False  # RLE_STATE_REPEATE: one flag bit per pixel
+    cnt = 0
+    while i < n:
+        v = pre[i]
+        if not repeat:
+            bw.write(v, bpp)
+            if i != 0 and v == prev:
+                repeat = True
+                cnt = 0
+            prev = v
+            i += 1
+        elif v != prev:
+            bw.write(0, 1)
+            bw.write(v, bpp)
+            prev = v
+            repeat = False
+            i += 1
+        else:
+            bw.write(1, 1)
+            cnt += 1
+            i += 1
+            if cnt == 11:
+                # The counter c covers c - 1 more repeats, the c-th pixel is a literal
+                run = 0
+                while i + run < n and pre[i + run] == prev and run < 62:
+                    run += 1
+                bw.write(run + 1, 6)
+                i += run
+                if i < n:
+                    prev = pre[i]
+                    bw.write(prev, bpp)
+                    i += 1
+                repeat = False
+    return bytes(bw.out)
+
+
+def decompress(data, w, h, bpp):
+    """Python model of LVGL's decoder, used to check compress()."""
+    state = "single"
+    rdp = 0
+    prev = 0
+    cnt = 0
+
+    def bits(pos, n):
+        v = 0
+        for k in range(n):
+            byte = data[(pos + k) // 8] if (pos + k) // 8 < len(data) else 0
+            v = (v << 1) | ((byte >> (7 - (pos + k) % 8)) & 1)
+        return v
+
+    out = []
+    for _ in range(w * h):
+        if state == "single":
+            ret = bits(rdp, bpp)
+            if rdp != 0 and prev == ret:
+                cnt = 0
+                state = "repeat"
+            prev = ret
+            rdp += bpp
+        elif state == "repeat":
+            v = bits(rdp, 1)
+            cnt += 1
+            rdp += 1
+            if v:
+                ret = prev
+                if cnt == 11:
+                    cnt = bits(rdp, 6)
+                    rdp += 6
+                    if cnt:
+                        state = "counter"
+                    else:
+                        ret = prev = bits(rdp, bpp)
+                        rdp += bpp
+                        state = "single"
+            else:
+                ret = prev = bits(rdp, bpp)
+                rdp += bpp
+                state = "single"
+        else:
+            ret = prev
+            cnt -= 1
+            if cnt == 0:
+                ret = prev = bits(rdp, bpp)
+                rdp += bpp
+                state = "single"
+        out.append(ret)
+
+    for i in range(w, w * h):
+        out[i] ^= out[i - w]
+    return out
+
+
+# ---------------------------------------------------------------------------
+# Subsetting
+# ---------------------------------------------------------------------------
+
+def used_chars(sources, catalog, keep):
+    chars = set(keep)
+    for s in sources:
+        if s == "question":
+            for item in catalog:
+                chars.update(item["question"])
+        elif s == "options":
+            for item in catalog:
+                for o in item["options"]:
+                    chars.update(o)
+        else:
+            chars.update(s)
+    chars.discard("\n")
+    return sorted(ord(c) for c in chars)
+
+
+def _c_array(values, per_line, fmt):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append("    " + ", ".join(fmt % v for v in values[i:i + per_line]))
+    return ",\n".join(lines)
+
+
+def subset(font, cps):
+    """Write the C source of `font` reduced to the code points `cps`, with compressed bitmaps."""
+    missing = [cp for cp in cps if cp not in font.glyphs]
+    if missing:
+        print("%s: no glyph for %s" % (font.name, " ".join("U+%04X" % cp for cp in missing)), file=sys.stderr)
+    cps = [cp for cp in cps if cp in font.glyphs]
+    if not cps:
+        raise SystemExit("%s: no glyph to keep" % font.name)
+
+    bitmap = []
+    bitmap_src = []
+    dscs = ["    {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */"]
+    for cp in cps:
+        data, adv_w, box_w, box_h, ofs_x, ofs_y = font.glyphs[cp]
+        comp = compress(data, box_w, box_h, font.bpp) if box_w * box_h else b""
+        if comp and decompress(comp, box_w, box_h, font.bpp) != _unpack(data, box_w * box_h, font.bpp):
+            raise SystemExit("%s: U+%04X does not survive compression" % (font.name, cp))
+        dscs.append("    {.bitmap_index = %d, .adv_w = %d, .box_w = %d, .box_h = %d, .ofs_x = %d, .ofs_y = %d}"
+                    % (len(bitmap), adv_w, box_w, box_h, ofs_x, ofs_y))
+        ch = chr(cp).replace("\\", "\\\\").replace("*/", "*\\/")
+        bitmap_src.append("\n    /* U+%04X \"%s\" */" % (cp, ch))
+        if comp:
+            bitmap_src.append(_c_array(list(comp), 16, "0x%x") + ",")
+        bitmap += comp
+    # get_bits() may read one byte past the last glyph
+    bitmap.append(0)
+    bitmap_src.append("    0x0")
+
+    # FORMAT0_FULL with glyph_id_start 0: one byte per code point of the range
+    # holds the glyph id, 0 for the dropped ones, so they stay "not found"
+    if len(cps) > 255:
+        raise SystemExit("%s: more than 255 glyphs" % font.name)
+    start = cps[0]
+    gid = {cp: i + 1 for i, cp in enumerate(cps)}
+    # get_glyph_dsc_id() also reads the entry at range_length
+    ofs_list = [gid.get(cp, 0) for cp in range(start, cps[-1] + 1)] + [0]
+
+    kern_src = ""
+    kern_dsc = "NULL"
+    kern_classes = 0
+    kern_bytes = 0
+    if font.kern_pairs is not None:
+        pairs = [(gid[l], gid[r], v) for l, r, v in font.kern_pairs if l in gid and r in gid]
+        if pairs:
+            kern_src = ("/*Pair left and right glyphs for kerning*/\n"
+                        "static const uint8_t kern_pair_glyph_ids[] =\n{\n%s\n};\n\n"
+                        "/* Kerning between the respective left and right glyphs\n"
+                        " * 4.4 format which needs to scaled with `kern_scale`*/\n"
+                        "static const int8_t kern_pair_values[] =\n{\n%s\n};\n\n"
+                        "/*Collect the kern pair's data in one place*/\n"
+                        "static const lv_font_fmt_txt_kern_pair_t kern_pairs =\n{\n"
+                        "    .glyph_ids = kern_pair_glyph_ids,\n"
+                        "    .values = kern_pair_values,\n"
+                        "    .pair_cnt = %d,\n"
+                        "    .glyph_ids_size = 0\n};\n"
+                        % (_c_array([g for l, r, _ in pairs for g in (l, r)], 8, "%d"),
+                           _c_array([v for _, _, v in pairs], 8, "%d"), len(pairs)))
+            kern_dsc = "&kern_pairs"
+            kern_bytes = len(pairs) * 3
+    elif font.kern_classes is not None:
+        kc = font.kern_classes
+        left = [0] + [kc["left"].get(cp, 0) for cp in cps]
+        right = [0] + [kc["right"].get(cp, 0) for cp in cps]
+        kern_src = ("/*Map glyph_ids to kern left classes*/\n"
+                    "static const uint8_t kern_left_class_mapping[] =\n{\n%s\n};\n\n"
+                    "/*Map glyph_ids to kern right classes*/\n"
+                    "static const uint8_t kern_right_class_mapping[] =\n{\n%s\n};\n\n"
+                    "/*Kern values between classes*/\n"
+                    "static const int8_t kern_class_values[] =\n{\n%s\n};\n\n"
+                    "/*Collect the kern class' data in one place*/\n"
+                    "static const lv_font_fmt_txt_kern_classes_t kern_classes =\n{\n"
+                    "    .class_pair_values   = kern_class_values,\n"
+                    "    .left_class_mapping  = kern_left_class_mapping,\n"
+                    "    .right_class_mapping = kern_right_class_mapping,\n"
+                    "    .left_class_cnt      = %d,\n"
+                    "    .right_class_cnt     = %d,\n};\n"
+                    % (_c_array(left, 16, "%d"), _c_array(right, 16, "%d"), _c_array(kc["values"], 8, "%d"),
+                       kc["left_cnt"], kc["right_cnt"]))
+        kern_dsc = "&kern_classes"
+        kern_classes = 1
+        kern_bytes = len(kc["values"]) + len(left) + len(right)
+
+    guard = "UI_FONT_" + font.name[len("ui_font_"):].upper()
+    src = """%(header)s
+
+/* Subset by tools/font_subset.py: %(count)d glyphs, bitmaps compressed. Do not edit. */
+
+#include "ui.h"
+
+#ifndef %(guard)s
+#define %(guard)s 1
+#endif
+
+#if %(guard)s
+
+#if !LV_USE_FONT_COMPRESSED
+#error "%(name)s is compressed, enable LV_USE_FONT_COMPRESSED"
+#endif
+
+/*-----------------
+ *    BITMAPS
+ *----------------*/
+
+/*Store the image of the glyphs*/
+static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {%(bitmap)s
+};
+
+
+/*---------------------
+ *  GLYPH DESCRIPTION
+ *--------------------*/
+
+static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
+%(dscs)s
+};
+
+/*---------------------
+ *  CHARACTER MAPPING
+ *--------------------*/
+
+static const uint8_t glyph_id_ofs_list_0[] = {
+%(ofs_list)s
+};
+
+/*Collect the unicode lists and glyph_id offsets*/
+static const lv_font_fmt_txt_cmap_t cmaps[] =
+{
+    {
+        .range_start = %(start)d, .range_length = %(length)d, .glyph_id_start = 0,
+        .unicode_list = NULL, .glyph_id_ofs_list = glyph_id_ofs_list_0, .list_length = %(length)d, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL
+    }
+};
+
+/*-----------------
+ *    KERNING
+ *----------------*/
+
+%(kern)s
+/*--------------------
+ *  ALL CUSTOM DATA
+ *--------------------*/
+
+/*Store all the custom data of the font*/
+static lv_font_fmt_txt_glyph_cache_t cache;
+
+static const lv_font_fmt_txt_dsc_t font_dsc = {
+    .glyph_bitmap = glyph_bitmap,
+    .glyph_dsc = glyph_dsc,
+    .cmaps = cmaps,
+    .kern_dsc = %(kern_dsc)s,
+    .kern_scale = %(kern_scale)d,
+    .cmap_num = 1,
+    .bpp = %(bpp)d,
+    .kern_classes = %(kern_classes)d,
+    .bitmap_format = 1,
+    .cache = &cache
+};
+
+
+/*-----------------
+ *  PUBLIC FONT
+ *----------------*/
+
+/*Initialize a public general font descriptor*/
+const lv_font_t %(name)s = {
+    .get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,    /*Function pointer to get glyph's data*/
+    .get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,    /*Function pointer to get glyph's bitmap*/
+    .line_height = %(line_height)d,          /*The maximum line height required by the font*/
+    .base_line = %(base_line)d,             /*Baseline measured from the bottom of the line*/
+    .subpx = %(subpx)s,
+    .underline_position = %(underline_position)d,
+    .underline_thickness = %(underline_thickness)d,
+    .dsc = &font_dsc           /*The custom font data. Will be accessed by `get_glyph_bitmap/dsc` */
+};
+
+
+
+#endif /*#if %(guard)s*/
+""" % dict(header=font.header, name=font.name, guard=guard, count=len(cps), bitmap="\n".join(bitmap_src),
+           dscs=",\n".join(dscs), ofs_list=_c_array(ofs_list, 16, "%d"), start=start,
+           length=len(ofs_list) - 1, kern=kern_src + "\n" if kern_src else "", kern_dsc=kern_dsc,
+           kern_scale=font.kern_scale, bpp=font.bpp, kern_classes=kern_classes, line_height=font.line_height,
+           base_line=font.base_line, subpx=font.subpx, underline_position=font.underline_position,
+           underline_thickness=font.underline_thickness)
+
+    flash = len(bitmap) + len(dscs) * GLYPH_DSC_SIZE + kern_bytes + CMAP_SIZE + len(ofs_list)
+    return src, {"glyphs": len(cps), "bitmap": len(bitmap), "flash": flash}
+
+
+def load_catalog(path):
+    with open(path, encoding="utf-8") as f:
+        return json.load(f)["items"]
+
+
+def run(out_dir, catalog_path, keep, report_path):
+    catalog = load_catalog(catalog_path)
+    lines = ["%-14s %13s %15s %13s %9s" % ("font", "glyphs", "bitmap bytes", "flash bytes", "saved")]
+    total_before = total_after = 0
+    for name, sources in FONTS.items():
+        font = Font(os.path.join(UI_DIR, name + ".c"))
+        src, st = subset(font, used_chars(sources, catalog, keep))
+        if out_dir:
+            with open(os.path.join(out_dir, name + ".c"), "w", encoding="utf-8") as f:
+                f.write(src)
+        before_bitmap = sum(len(g[0]) for g in font.glyphs.values())
+        lines.append("%-14s %5d -> %4d %6d -> %6d %6d -> %6d %8.1f%%" % (
+            name[len("ui_font_"):], len(font.glyphs), st["glyphs"], before_bitmap, st["bitmap"],
+            font.flash_bytes, st["flash"], 100.0 * (font.flash_bytes - st["flash"]) / font.flash_bytes))
+        total_before += font.flash_bytes
+        total_after += st["flash"]
+    lines.append("%-14s %13s %15s %6d -> %6d %8.1f%%" % ("total", "", "", total_before, total_after,
+                                                         100.0 * (total_before - total_after) / total_before))
+    text = "\n".join(lines) + "\n"
+    sys.stdout.write(text)
+    if report_path:
+        with open(report_path, "w") as f:
+            f.write(text)
+
+
+def check(font_dir, catalog_path):
+    catalog = load_catalog(catalog_path)
+    ok = True
+    for name, sources in FONTS.items():
+        src = open(os.path.join(font_dir, name + ".c"), encoding="utf-8").read()
+        start = int(re.search(r"\.range_start = (\d+)", src).group(1))
+        have = {start + i for i, g in enumerate(_array(src, "glyph_id_ofs_list_0")) if g}
+        need = used_chars(sources, catalog, "")
+        missing = [cp for cp in need if cp not in have]
+        if missing:
+            ok = False
+            print("%s: missing %s" % (name, "".join(chr(cp) for cp in missing)))
+    if not ok:
+        raise SystemExit("rebuild the firmware with the new catalog")
+    print("all catalog strings are covered")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="cmd", required=True)
+
+    p = sub.add_parser("build", help="write the subset fonts")
+    p.add_argument("-o", "--output", required=True, help="directory of the generated ui_font_*.c")
+    p.add_argument("--catalog", default=CATALOG)
+    p.add_argument("--keep", default="", help="characters kept in every font")
+    p.add_argument("--report", help="also write the size report to this file")
+
+    p = sub.add_parser("report", help="print the savings without writing the fonts")
+    p.add_argument("--catalog", default=CATALOG)
+    p.add_argument("--keep", default="")
+
+    p = sub.add_parser("check", help="check that subset fonts cover the catalog")
+    p.add_argument("font_dir")
+    p.add_argument("--catalog", default=CATALOG)
+
+    args = parser.parse_args()
+    if args.cmd == "build":
+        os.makedirs(args.output, exist_ok=True)
+        run(args.output, args.catalog, args.keep, args.report)
+    elif args.cmd == "report":
+        run(None, args.catalog, args.keep, None)
+    else:
+        check(args.font_dir, args.catalog)
+
+
+if __name__ == "__main__":
+    main()
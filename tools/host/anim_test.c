@@ -0,0 +1,133 @@
+/*
+ * ui_anim_player against a small generated animation: the key frame and the
+ * deltas land in the image source, closing clears the handle, and deleting the
+ * image's screen while the player runs stops and frees it.
+ */
+#include "ui_anim.h"
+#include "lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define W 8
+#define H 6
+
+static lv_color_t s_fb[W * H * 4];
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *px)
+{
+    (void)area;
+    (void)px;
+    lv_disp_flush_ready(drv);
+}
+
+static void disp_init(void)
+{
+    static lv_disp_draw_buf_t buf;
+    static lv_disp_drv_t drv;
+    lv_init();
+    lv_disp_draw_buf_init(&buf, s_fb, NULL, sizeof(s_fb) / sizeof(s_fb[0]));
+    lv_disp_drv_init(&drv);
+    drv.hor_res  = W * 2;
+    drv.ver_res  = H * 2;
+    drv.draw_buf = &buf;
+    drv.flush_cb = flush_cb;
+    lv_disp_drv_register(&drv);
+}
+
+/* Frame 0: every pixel 1. Frame 1: a 2x2 rect of 2 at (3,2). Frame 2: pixel (0,0) = 3. */
+static void write_anim(const char *path)
+{
+    FILE *f = fopen(path, "wb");
+    ui_anim_header_t hdr = { .magic = UI_ANIM_MAGIC, .version = UI_ANIM_VERSION, .frame_count = 3,
+                             .w = W, .h = H, .index_off = sizeof(hdr) };
+    ui_anim_frame_t idx[3];
+    uint32_t off = sizeof(hdr) + sizeof(idx);
+
+    uint16_t key[W * H];
+    for (int i = 0; i < W * H; ++i) key[i] = 1;
+    uint8_t d1[2 + sizeof(ui_anim_rect_t) + 4 * 2], d2[2 + sizeof(ui_anim_rect_t) + 2];
+    uint16_t n = 1, p1[4] = { 2, 2, 2, 2 }, p2 = 3;
+    ui_anim_rect_t r1 = { 3, 2, 2, 2 }, r2 = { 0, 0, 1, 1 };
+    memcpy(d1, &n, 2), memcpy(d1 + 2, &r1, sizeof(r1)), memcpy(d1 + 2 + sizeof(r1), p1, sizeof(p1));
+    memcpy(d2, &n, 2), memcpy(d2 + 2, &r2, sizeof(r2)), memcpy(d2 + 2 + sizeof(r2), &p2, sizeof(p2));
+
+    idx[0] = (ui_anim_frame_t){ off, sizeof(key), 1, UI_ANIM_FRAME_KEY, 0 };
+    idx[1] = (ui_anim_frame_t){ off + sizeof(key), sizeof(d1), 1, UI_ANIM_FRAME_DELTA, 0 };
+    idx[2] = (ui_anim_frame_t){ off + sizeof(key) + sizeof(d1), sizeof(d2), 1, UI_ANIM_FRAME_DELTA, 0 };
+    hdr.max_delta_size = sizeof(d1);
+
+    fwrite(&hdr, sizeof(hdr), 1, f);
+    fwrite(idx, sizeof(idx), 1, f);
+    fwrite(key, sizeof(key), 1, f);
+    fwrite(d1, sizeof(d1), 1, f);
+    fwrite(d2, sizeof(d2), 1, f);
+    fclose(f);
+}
+
+static uint16_t px(lv_obj_t *img, int x, int y)
+{
+    const lv_img_dsc_t *dsc = lv_img_get_src(img);
+    return ((const uint16_t *)dsc->data)[y * W + x];
+}
+
+/* Run LVGL until the player has shown `frames` more frames */
+static void run_frames(ui_anim_player_t *p, uint32_t frames)
+{
+    ui_anim_stats_t s;
+    ui_anim_player_get_stats(p, &s);
+    uint32_t until = s.frames + frames;
+    for (int i = 0; i < 1000 && s.frames < until; ++i) {
+        usleep(1000);
+        lv_timer_handler();
+        ui_anim_player_get_stats(p, &s);
+    }
+}
+
+#define CHECK(c)                                                    \
+    do {                                                            \
+        if (!(c)) {                                                 \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #c); \
+            return 1;                                               \
+        }                                                           \
+    } while (0)
+
+int main(void)
+{
+    char path[] = "/tmp/anim_test_XXXXXX";
+    int fd      = mkstemp(path);
+    close(fd);
+    write_anim(path);
+    disp_init();
+
+    lv_obj_t *scr = lv_obj_create(NULL);
+    lv_obj_t *img = lv_img_create(scr);
+    lv_scr_load(scr);
+
+    ui_anim_player_t *p = NULL;
+    CHECK(ui_anim_player_open(&p, img, path));
+    CHECK(p != NULL && px(img, 0, 0) == 1 && px(img, 3, 2) == 1);
+    run_frames(p, 1);
+    CHECK(px(img, 3, 2) == 2 && px(img, 4, 3) == 2 && px(img, 0, 0) == 1);
+    run_frames(p, 1);
+    CHECK(px(img, 0, 0) == 3);
+    ui_anim_player_close(p);
+    CHECK(lv_img_get_src(img) == NULL);
+
+    /* The screen goes away under a running player */
+    CHECK(ui_anim_player_open(&p, img, path));
+    run_frames(p, 2);
+    lv_obj_t *blank = lv_obj_create(NULL);
+    lv_scr_load(blank);
+    lv_obj_del(scr);
+    CHECK(p == NULL);
+    for (int i = 0; i < 20; ++i) {
+        usleep(1000);
+        lv_timer_handler();
+    }
+
+    unlink(path);
+    printf("{\"test\":\"anim\",\"ok\":1}\n");
+    return 0;
+}
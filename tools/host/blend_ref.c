@@ -0,0 +1,8 @@
+/*
+ * The software blend of the vendored LVGL without LV_DRAW_SW_SWAR, that is
+ * with stock lv_color_mix(), as ref_draw_sw_blend_basic() for swar_bench.
+ */
+#define LV_DRAW_SW_SWAR        0
+#define lv_draw_sw_blend       ref_draw_sw_blend
+#define lv_draw_sw_blend_basic ref_draw_sw_blend_basic
+#include "src/draw/sw/lv_draw_sw_blend.c"
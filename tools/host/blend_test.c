@@ -0,0 +1,166 @@
+/*
+ * main/lvgl_port_blend.c against the serial blend of the vendored LVGL: the
+ * same screen is rendered on two 800x480 displays with 20-row draw buffers,
+ * one with the parallel blend attached, and both frames must be equal after a
+ * full refresh and after partial redraws of random areas. Fills, gradients,
+ * opaque, translucent and rotated images, rounded and shadowed buttons and
+ * text are drawn, and enough blends must be split to cover them.
+ */
+#include "lvgl_port_blend.h"
+#include "lvgl.h"
+#include "src/draw/sw/lv_draw_sw.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define W      800
+#define H      480
+#define ROWS   20
+#define MIN_PX 4096
+#define IMG_W  300
+#define IMG_H  200
+
+#define CHECK(c)                                                    \
+    do {                                                            \
+        if (!(c)) {                                                 \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #c); \
+            return 1;                                               \
+        }                                                           \
+    } while (0)
+
+typedef struct {
+    lv_disp_drv_t drv;
+    lv_disp_draw_buf_t draw_buf;
+    lv_color_t buf[2][W * ROWS];
+    lv_color_t fb[W * H];
+    lv_disp_t *disp;
+} display_t;
+
+static display_t s_serial, s_split;
+static lv_color_t s_img_px[IMG_W * IMG_H];
+static const lv_img_dsc_t s_img = {
+    .header    = { .cf = LV_IMG_CF_TRUE_COLOR, .w = IMG_W, .h = IMG_H },
+    .data_size = sizeof(s_img_px),
+    .data      = (const uint8_t *)s_img_px,
+};
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *px)
+{
+    display_t *d = drv->user_data;
+    int32_t w    = lv_area_get_width(area);
+    for (int32_t y = area->y1; y <= area->y2; ++y, px += w) {
+        memcpy(&d->fb[y * W + area->x1], px, w * sizeof(lv_color_t));
+    }
+    lv_disp_flush_ready(drv);
+}
+
+static void split_ctx_init(lv_disp_drv_t *drv, lv_draw_ctx_t *draw_ctx)
+{
+    lv_draw_sw_init_ctx(drv, draw_ctx);
+    lvgl_port_blend_attach(draw_ctx, MIN_PX);
+}
+
+static void display_init(display_t *d, bool split)
+{
+    lv_disp_draw_buf_init(&d->draw_buf, d->buf[0], d->buf[1], W * ROWS);
+    lv_disp_drv_init(&d->drv);
+    d->drv.hor_res   = W;
+    d->drv.ver_res   = H;
+    d->drv.draw_buf  = &d->draw_buf;
+    d->drv.flush_cb  = flush_cb;
+    d->drv.user_data = d;
+    if (split) {
+        d->drv.draw_ctx_init   = split_ctx_init;
+        d->drv.draw_ctx_deinit = lv_draw_sw_deinit_ctx;
+    }
+    d->disp = lv_disp_drv_register(&d->drv);
+}
+
+static void build(lv_disp_t *disp)
+{
+    lv_disp_set_default(disp);
+    lv_obj_t *scr = lv_obj_create(NULL);
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x101820), 0);
+    lv_obj_set_style_bg_grad_color(scr, lv_color_hex(0x3050a0), 0);
+    lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_VER, 0);
+
+    lv_obj_t *img = lv_img_create(scr);
+    lv_img_set_src(img, &s_img);
+    lv_obj_set_pos(img, 37, 41);
+    img = lv_img_create(scr);
+    lv_img_set_src(img, &s_img);
+    lv_obj_set_pos(img, 420, 200);
+    lv_obj_set_style_img_opa(img, 150, 0);
+    lv_img_set_angle(img, 150);
+
+    for (int i = 0; i < 6; ++i) {
+        lv_obj_t *btn = lv_btn_create(scr);
+        lv_obj_set_size(btn, 180 + i * 13, 60 + i * 7);
+        lv_obj_set_pos(btn, 20 + i * 120, 250 + (i % 3) * 60);
+        lv_obj_set_style_radius(btn, 5 + i * 6, 0);
+        lv_obj_set_style_bg_opa(btn, 120 + i * 20, 0);
+        lv_obj_set_style_shadow_width(btn, 10 * i, 0);
+        lv_obj_t *label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "Button %d quick brown fox", i);
+        lv_obj_set_style_text_font(label, i & 1 ? &lv_font_montserrat_28 : &lv_font_montserrat_14, 0);
+    }
+
+    lv_obj_t *panel = lv_obj_create(scr);
+    lv_obj_set_size(panel, 500, 150);
+    lv_obj_set_pos(panel, 250, 20);
+    lv_obj_set_style_bg_opa(panel, 180, 0);
+    lv_obj_set_style_radius(panel, 30, 0);
+    lv_obj_set_style_border_width(panel, 7, 0);
+    lv_scr_load(scr);
+}
+
+static uint32_t diff_px(void)
+{
+    uint32_t n = 0;
+    for (size_t i = 0; i < W * H; ++i) n += s_serial.fb[i].full != s_split.fb[i].full;
+    return n;
+}
+
+int main(void)
+{
+    srand(1);
+    for (size_t i = 0; i < IMG_W * IMG_H; ++i) s_img_px[i].full = (uint16_t)rand();
+
+    lv_init();
+    CHECK(lvgl_port_blend_init(4096, 1, 1));
+    display_init(&s_serial, false);
+    display_init(&s_split, true);
+    build(s_serial.disp);
+    build(s_split.disp);
+
+    lv_refr_now(s_serial.disp);
+    lv_refr_now(s_split.disp);
+    uint32_t diff = diff_px();
+    CHECK(diff == 0);
+
+    /* Partial redraws start and end bands on other rows than the draw buffers */
+    for (int i = 0; i < 50; ++i) {
+        lv_area_t a;
+        a.x1 = rand() % W;
+        a.y1 = rand() % H;
+        a.x2 = a.x1 + rand() % (W - a.x1);
+        a.y2 = a.y1 + rand() % (H - a.y1);
+        memset(s_serial.fb, 0, sizeof(s_serial.fb));
+        memset(s_split.fb, 0, sizeof(s_split.fb));
+        _lv_inv_area(s_serial.disp, &a);
+        _lv_inv_area(s_split.disp, &a);
+        lv_refr_now(s_serial.disp);
+        lv_refr_now(s_split.disp);
+        diff += diff_px();
+    }
+    CHECK(diff == 0);
+
+    lvgl_port_blend_stats_t stats;
+    lvgl_port_blend_get_stats(&stats, true);
+    CHECK(stats.blends > 0 && stats.split_px > W * H / 4);
+    lvgl_port_blend_deinit();
+
+    printf("{\"test\":\"blend\",\"blends\":%u,\"split_px\":%u,\"ok\":1}\n", (unsigned)stats.blends,
+           (unsigned)stats.split_px);
+    return 0;
+}
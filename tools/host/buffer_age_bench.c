@@ -0,0 +1,142 @@
+/*
+ * main/lvgl_port_damage.c replaying the frames of a direct-mode display with
+ * two LCD frame buffers, with the real lv_area.c and a plain copy in place of
+ * the rotation. After every frame, the frame buffer put on the panel must
+ * equal the LVGL buffer. Four scenarios of 600 frames each: random areas with
+ * a full-screen frame one time in 20, a 200x100 animation and a label, the
+ * same with a screen switch every 30 frames, and a 400x300 scrolling list.
+ * For each, the bytes copied per frame are printed next to what the path
+ * without buffer age (LVGL_PORT_BUFFER_AGE=n) copies for the same frames, and
+ * must not be more.
+ */
+#include "lvgl_port_damage.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define W      800
+#define H      480
+#define FRAMES 600
+
+#define CHECK(c)                                                    \
+    do {                                                            \
+        if (!(c)) {                                                 \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #c); \
+            return 1;                                               \
+        }                                                           \
+    } while (0)
+
+typedef enum {
+    SCENARIO_RANDOM,
+    SCENARIO_ANIM,
+    SCENARIO_ANIM_SWITCH,
+    SCENARIO_SCROLL,
+} scenario_t;
+
+static const char *const s_names[] = { "random", "anim", "anim_switch", "scroll" };
+
+static lv_color_t s_lvgl[W * H];
+static lv_color_t s_fb[2][W * H];
+static uint64_t s_copied_px;
+
+static void copy_area(const void *from, void *to, lv_coord_t x1, lv_coord_t y1, lv_coord_t x2, lv_coord_t y2)
+{
+    for (lv_coord_t y = y1; y <= y2; y++) {
+        memcpy((lv_color_t *)to + y * W + x1, (const lv_color_t *)from + y * W + x1,
+               (x2 - x1 + 1) * sizeof(lv_color_t));
+    }
+    s_copied_px += (uint64_t)(x2 - x1 + 1) * (y2 - y1 + 1);
+}
+
+/*
+ * Pixels the path without buffer age copies for the frame: the areas into the
+ * back buffer, then again into the other one after the VSYNC. The first
+ * partial frame after a full-screen one is redrawn as a full-screen frame,
+ * copied whole, and its areas copied into the other buffer.
+ */
+static uint32_t old_path_px(const lv_disp_t *disp, bool full, bool *prev_full)
+{
+    uint32_t px = 0;
+    for (int i = 0; i < disp->inv_p; i++) {
+        if (!disp->inv_area_joined[i]) px += lv_area_get_size(&disp->inv_areas[i]);
+    }
+    if (*prev_full && !full) {
+        px += W * H;
+    } else if (!*prev_full) {
+        px *= 2;
+    }
+    *prev_full = full;
+    return px;
+}
+
+/* The areas LVGL would have invalidated for frame `f` */
+static bool frame_areas(lv_disp_t *disp, scenario_t sc, int f)
+{
+    bool full = (f == 0) || (sc == SCENARIO_RANDOM && rand() % 20 == 0) || (sc == SCENARIO_ANIM_SWITCH && f % 30 == 0);
+    memset(disp->inv_area_joined, 0, sizeof(disp->inv_area_joined));
+    if (full) {
+        disp->inv_p = 1;
+        lv_area_set(&disp->inv_areas[0], 0, 0, W - 1, H - 1);
+    } else if (sc == SCENARIO_RANDOM) {
+        disp->inv_p = 1 + rand() % LV_INV_BUF_SIZE;
+        for (int i = 0; i < disp->inv_p; i++) {
+            lv_coord_t x1 = rand() % W, y1 = rand() % H;
+            lv_area_set(&disp->inv_areas[i], x1, y1, x1 + rand() % (W - x1), y1 + rand() % (H - y1));
+            disp->inv_area_joined[i] = rand() % 4 == 0;
+        }
+    } else if (sc == SCENARIO_SCROLL) {
+        disp->inv_p = 1;
+        lv_area_set(&disp->inv_areas[0], 200, 100, 599, 399);
+    } else {
+        disp->inv_p = 2;
+        lv_area_set(&disp->inv_areas[0], 300, 190, 499, 289);
+        lv_area_set(&disp->inv_areas[1], 10, 10, 89, 29);
+    }
+    return full;
+}
+
+/* Draw frame `f` into the LVGL buffer: every area not joined into another */
+static void frame_draw(const lv_disp_t *disp, int f)
+{
+    for (int i = 0; i < disp->inv_p; i++) {
+        if (disp->inv_area_joined[i]) continue;
+        const lv_area_t *a = &disp->inv_areas[i];
+        for (lv_coord_t y = a->y1; y <= a->y2; y++) {
+            for (lv_coord_t x = a->x1; x <= a->x2; x++) s_lvgl[y * W + x].full = (uint16_t)(f * 7 + x + y);
+        }
+    }
+}
+
+int main(void)
+{
+    static lv_disp_drv_t drv;
+    static lv_disp_t disp;
+    drv.hor_res = W;
+    drv.ver_res = H;
+    disp.driver = &drv;
+
+    srand(1);
+    for (scenario_t sc = SCENARIO_RANDOM; sc <= SCENARIO_SCROLL; sc++) {
+        lvgl_port_damage_reset();
+        memset(s_fb, 0, sizeof(s_fb));
+        s_copied_px       = 0;
+        uint64_t old_px   = 0;
+        bool prev_full    = false;
+        uint32_t mismatch = 0;
+        for (int f = 0; f < FRAMES; f++) {
+            bool full = frame_areas(&disp, sc, f);
+            frame_draw(&disp, f);
+            int fb = (f + 1) & 1;
+            lvgl_port_damage_frame(&disp, fb, s_lvgl, s_fb[fb], copy_area);
+            mismatch += memcmp(s_fb[fb], s_lvgl, sizeof(s_lvgl)) != 0;
+            old_px += old_path_px(&disp, full, &prev_full);
+        }
+        printf("{\"bench\":\"buffer_age\",\"scenario\":\"%s\",\"frames\":%d,\"old_bytes\":%u,\"age_bytes\":%u}\n",
+               s_names[sc], FRAMES, (unsigned)(old_px * sizeof(lv_color_t) / FRAMES),
+               (unsigned)(s_copied_px * sizeof(lv_color_t) / FRAMES));
+        CHECK(mismatch == 0);
+        CHECK(s_copied_px <= old_px);
+    }
+    printf("{\"test\":\"buffer_age\",\"ok\":1}\n");
+    return 0;
+}
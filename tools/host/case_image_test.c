@@ -0,0 +1,234 @@
+/*
+ * The repository catalog and the case image on Screen1.
+ *
+ * Every file an item reads must have the size the firmware reads from it: the
+ * image its catalog img_size, each mip level (w >> s) * (h >> s) RGB565 pixels.
+ * The progressive preview reads the 1/8 level with an exact size before the
+ * full image, so a stale level fails here rather than on the panel.
+ *
+ * The asset reader, cancelled after two blocks of a full image, must stop
+ * there and read the whole file on the next call. The loader must read a job
+ * queued first (a preview) before a full image queued earlier.
+ *
+ * Then two cases are shown back to back, the first one's loads cancelled by
+ * the second. ui_Img shows nothing until the preview is read, without the
+ * LVGL task waiting for it, and once the full image is in, ui_Img must have
+ * the size mode, anti-aliasing and zoom it had before either preview.
+ */
+#include "ui.h"
+#include "ui_catalog.h"
+#include "ui_events.h"
+#include "ui_asset_reader.h"
+#include "esp_heap_caps.h"
+#include "lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static lv_color_t s_buf[800 * 40];
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *px)
+{
+    (void)area;
+    (void)px;
+    lv_disp_flush_ready(drv);
+}
+
+static void disp_init(void)
+{
+    static lv_disp_draw_buf_t buf;
+    static lv_disp_drv_t drv;
+    lv_init();
+    lv_disp_draw_buf_init(&buf, s_buf, NULL, sizeof(s_buf) / sizeof(s_buf[0]));
+    lv_disp_drv_init(&drv);
+    drv.hor_res  = 800;
+    drv.ver_res  = 480;
+    drv.draw_buf = &buf;
+    drv.flush_cb = flush_cb;
+    lv_disp_drv_register(&drv);
+}
+
+static bool check_size(const char *path_S, long want)
+{
+    char real[256];
+    struct stat st;
+    ui_img_map_path(real, sizeof(real), path_S);
+    if (stat(real, &st) != 0 || st.st_size != want) {
+        fprintf(stderr, "%s: %ld bytes, expected %ld\n", real, stat(real, &st) == 0 ? (long)st.st_size : -1L, want);
+        return false;
+    }
+    return true;
+}
+
+static bool check_catalog(uint32_t *mips_items)
+{
+    bool ok = ui_catalog_count() > 0;
+    for (uint32_t id = 0; id < ui_catalog_count(); ++id) {
+        ui_catalog_item_t item;
+        if (!ui_catalog_get(id, &item)) return false;
+        ok &= check_size(item.img_path, item.img_size);
+        if (!(item.flags & UI_CATALOG_FLAG_MIPS)) continue;
+        for (uint8_t s = 1; s <= UI_CATALOG_MIP_LEVELS; ++s) {
+            char path[UI_CATALOG_PATH_MAX + 8];
+            ok &= ui_catalog_mip_path(&item, s, path, sizeof(path)) &&
+                  check_size(path, (long)(item.img_w >> s) * (item.img_h >> s) * (long)sizeof(lv_color_t));
+        }
+        (*mips_items)++;
+    }
+    return ok;
+}
+
+/* The first two items shown with a preview */
+static bool preview_cases(uint32_t out[2])
+{
+    int n = 0;
+    for (uint32_t id = 0; id < ui_catalog_count() && n < 2; ++id) {
+        ui_catalog_item_t item;
+        if (ui_catalog_get(id, &item) && (item.flags & UI_CATALOG_FLAG_MIPS) &&
+            !(item.flags & (UI_CATALOG_FLAG_JPEG | UI_CATALOG_FLAG_ANIM))) {
+            out[n++] = id;
+        }
+    }
+    return n == 2;
+}
+
+#define CHECK(c)                                                    \
+    do {                                                            \
+        if (!(c)) {                                                 \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #c); \
+            return 1;                                               \
+        }                                                           \
+    } while (0)
+
+static bool cancel_after_two(void *arg)
+{
+    return ++*(int *)arg > 2;
+}
+
+static int check_cancel(const ui_catalog_item_t *item)
+{
+    char real[256];
+    ui_img_map_path(real, sizeof(real), item->img_path);
+    uint8_t *buf = malloc(item->img_size), *ref = malloc(item->img_size);
+    CHECK(buf && ref);
+
+    FILE *f = fopen(real, "rb");
+    CHECK(f && fread(ref, 1, item->img_size, f) == item->img_size);
+    fclose(f);
+
+    int polls = 0;
+    memset(buf, 0, item->img_size);
+    CHECK(!ui_asset_read_file_cancellable(real, buf, item->img_size, cancel_after_two, &polls));
+    CHECK(polls <= 4);
+    CHECK(ui_asset_read_file(real, buf, item->img_size) && memcmp(buf, ref, item->img_size) == 0);
+    free(buf);
+    free(ref);
+    return 0;
+}
+
+/* Reads of the asset reader in order, through -Wl,--wrap */
+#define READS_MAX 8
+static char s_reads[READS_MAX][256];
+static int s_read_num;
+
+bool __real_ui_asset_read_file_cancellable(const char *real_path, void *dst, uint32_t size,
+                                           ui_asset_read_cancel_t cancelled, void *arg);
+
+bool __wrap_ui_asset_read_file_cancellable(const char *real_path, void *dst, uint32_t size,
+                                           ui_asset_read_cancel_t cancelled, void *arg)
+{
+    if (s_read_num < READS_MAX) snprintf(s_reads[s_read_num++], sizeof(s_reads[0]), "%s", real_path);
+    return __real_ui_asset_read_file_cancellable(real_path, dst, size, cancelled, arg);
+}
+
+typedef struct {
+    const ui_catalog_item_t *item;
+    ui_img_job_t *jobs[3];
+} first_ctx_t;
+
+/* Called with the reader held: the loader cannot take a job before all three are queued */
+static bool queue_jobs(void *arg)
+{
+    first_ctx_t *ctx = arg;
+    if (ctx->jobs[0]) return false;
+    char mip[UI_CATALOG_PATH_MAX + 8];
+    ui_catalog_mip_path(ctx->item, UI_CATALOG_MIP_LEVELS, mip, sizeof(mip));
+    uint32_t msize = (uint32_t)(ctx->item->img_w >> UI_CATALOG_MIP_LEVELS) *
+                     (ctx->item->img_h >> UI_CATALOG_MIP_LEVELS) * sizeof(lv_color_t);
+    ctx->jobs[0] = ui_img_load_async(ctx->item->img_path, ctx->item->img_size, false);
+    ctx->jobs[1] = ui_img_load_async(ctx->item->img_path, ctx->item->img_size, false);
+    ctx->jobs[2] = ui_img_load_async(mip, msize, true);
+    return false;
+}
+
+static int check_first(const ui_catalog_item_t *item)
+{
+    char real[256];
+    ui_img_map_path(real, sizeof(real), item->img_path);
+    uint8_t *buf   = malloc(item->img_size);
+    first_ctx_t ctx = { .item = item };
+    s_read_num      = 0;
+    CHECK(buf && ui_asset_read_file_cancellable(real, buf, item->img_size, queue_jobs, &ctx));
+    free(buf);
+    CHECK(ctx.jobs[0] && ctx.jobs[1] && ctx.jobs[2]);
+
+    for (int i = 0; i < 3; ++i) {
+        uint8_t *data;
+        while (!ui_img_job_poll(ctx.jobs[i], &data)) usleep(1000);
+        CHECK(data != NULL);
+        heap_caps_free(data);
+    }
+    /* The loader may have taken the first job before the preview was queued, not the second */
+    CHECK(s_read_num == 4 && strcmp(s_reads[3], real) == 0);
+    CHECK(strstr(s_reads[1], ".mip") != NULL || strstr(s_reads[2], ".mip") != NULL);
+    return 0;
+}
+
+int main(void)
+{
+    disp_init();
+    ui_init();
+    CHECK(ui_Img != NULL);
+
+    uint32_t mips_items = 0;
+    CHECK(check_catalog(&mips_items));
+
+    uint32_t ids[2];
+    CHECK(preview_cases(ids));
+
+    /* Not the defaults, so a restore to the defaults is caught too */
+    lv_img_set_size_mode(ui_Img, LV_IMG_SIZE_MODE_VIRTUAL);
+    lv_img_set_antialias(ui_Img, true);
+    lv_img_set_zoom(ui_Img, LV_IMG_ZOOM_NONE);
+
+    ui_catalog_item_t item;
+    CHECK(ui_catalog_get(ids[0], &item));
+    CHECK(check_cancel(&item) == 0);
+    CHECK(check_first(&item) == 0);
+
+    apply_image_for_case((builtin_text_case_t)ids[0]);
+    CHECK(lv_img_get_src(ui_Img) == NULL);
+
+    /* Cancels the first case's loads */
+    apply_image_for_case((builtin_text_case_t)ids[1]);
+    CHECK(lv_img_get_src(ui_Img) == NULL);
+
+    CHECK(ui_catalog_get(ids[1], &item));
+    const lv_img_dsc_t *src = NULL;
+    for (int i = 0; i < 2000; ++i) {
+        usleep(1000);
+        lv_timer_handler();
+        src = lv_img_get_src(ui_Img);
+        if (src && src->header.w == item.img_w && lv_img_get_zoom(ui_Img) == LV_IMG_ZOOM_NONE) break;
+    }
+    CHECK(src && src->header.w == item.img_w && src->header.h == item.img_h && src->data);
+    CHECK(lv_img_get_zoom(ui_Img) == LV_IMG_ZOOM_NONE);
+    CHECK(lv_img_get_size_mode(ui_Img) == LV_IMG_SIZE_MODE_VIRTUAL);
+    CHECK(lv_img_get_antialias(ui_Img));
+
+    printf("{\"test\":\"case_image\",\"items\":%u,\"mips_items\":%u,\"ok\":1}\n", (unsigned)ui_catalog_count(),
+           (unsigned)mips_items);
+    return 0;
+}
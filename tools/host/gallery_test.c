@@ -0,0 +1,180 @@
+/*
+ * ui_gallery over a catalog of 600 items (the repository's ten, repeated):
+ * the grid keeps a bounded window of tiles, each tile on screen shows the item
+ * of its grid position with its thumbnail loaded, after opening on an item and
+ * after scrolling to the top, the middle and the end.
+ */
+#include "ui.h"
+#include "ui_Screen3.h"
+#include "ui_asset_reader.h"
+#include "ui_catalog.h"
+#include "ui_gallery.h"
+#include "lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define HOR_RES 800
+#define VER_RES 480
+#define ITEMS   600
+
+static lv_color_t s_buf[HOR_RES * 40];
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *px)
+{
+    (void)area;
+    (void)px;
+    lv_disp_flush_ready(drv);
+}
+
+static void disp_init(void)
+{
+    static lv_disp_draw_buf_t buf;
+    static lv_disp_drv_t drv;
+    lv_init();
+    lv_disp_draw_buf_init(&buf, s_buf, NULL, sizeof(s_buf) / sizeof(s_buf[0]));
+    lv_disp_drv_init(&drv);
+    drv.hor_res  = HOR_RES;
+    drv.ver_res  = VER_RES;
+    drv.draw_buf = &buf;
+    drv.flush_cb = flush_cb;
+    lv_disp_drv_register(&drv);
+}
+
+/* The repository catalog with its records repeated up to `count` */
+static bool write_catalog(const char *path, uint32_t count)
+{
+    char src[256];
+    ui_img_map_path(src, sizeof(src), UI_CATALOG_FILE);
+    FILE *f = fopen(src, "rb");
+    if (!f) return false;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    rewind(f);
+    uint8_t *in = malloc(size);
+    bool ok     = fread(in, 1, size, f) == (size_t)size;
+    fclose(f);
+
+    ui_catalog_header_t hdr;
+    memcpy(&hdr, in, sizeof(hdr));
+    uint32_t n = hdr.count;
+    const uint8_t *recs = in + hdr.index_off;
+    const uint8_t *strs = in + hdr.strings_off;
+    hdr.count       = count;
+    hdr.index_off   = sizeof(hdr);
+    hdr.strings_off = hdr.index_off + count * hdr.record_size;
+
+    f = fopen(path, "wb");
+    ok &= f && fwrite(&hdr, sizeof(hdr), 1, f) == 1;
+    for (uint32_t i = 0; ok && i < count; ++i) ok = fwrite(recs + (i % n) * hdr.record_size, hdr.record_size, 1, f) == 1;
+    ok &= fwrite(strs, hdr.strings_size, 1, f) == 1;
+    if (f) fclose(f);
+    free(in);
+    return ok;
+}
+
+static void run(int ms)
+{
+    for (int i = 0; i < ms; i += 5) {
+        usleep(5000);
+        lv_timer_handler();
+    }
+}
+
+/*
+ * Every tile that intersects the grid's viewport must show the item of its
+ * position, loaded; `want` must be among them. Returns the number checked.
+ */
+static int check_visible(uint32_t want, bool *ok)
+{
+    lv_obj_t *grid = ui_galleryGrid;
+    lv_area_t view;
+    lv_obj_get_coords(grid, &view);
+    lv_coord_t pitch_x = 0, pitch_y = 0, x0 = 0;
+    uint32_t cols = 0;
+
+    /* Column count and pitch from two tiles of the same row */
+    uint32_t n = lv_obj_get_child_cnt(grid);
+    for (uint32_t i = 1; i < n && !cols; ++i) {
+        lv_obj_t *a = lv_obj_get_child(grid, i);
+        uint32_t ia = ui_gallery_item_of(a);
+        if (ia >= ITEMS || ia % 2) continue;
+        for (uint32_t j = 1; j < n; ++j) {
+            lv_obj_t *b = lv_obj_get_child(grid, j);
+            if (ui_gallery_item_of(b) != ia + 1 || lv_obj_get_y(b) != lv_obj_get_y(a)) continue;
+            pitch_x = lv_obj_get_x(b) - lv_obj_get_x(a);
+            pitch_y = lv_obj_get_height(a) + lv_obj_get_style_pad_row(grid, LV_PART_MAIN);
+            x0      = lv_obj_get_x(a) - pitch_x * (lv_coord_t)(ia % 2);
+            cols    = (uint32_t)((lv_obj_get_content_width(grid) - x0 + lv_obj_get_style_pad_column(grid, 0)) / pitch_x);
+        }
+    }
+    if (!cols) {
+        *ok = false;
+        return 0;
+    }
+
+    int seen      = 0;
+    bool has_want = false;
+    for (uint32_t i = 1; i < n; ++i) {
+        lv_obj_t *tile = lv_obj_get_child(grid, i);
+        lv_area_t a;
+        lv_obj_get_coords(tile, &a);
+        if (lv_obj_has_flag(tile, LV_OBJ_FLAG_HIDDEN) || a.y2 < view.y1 || a.y1 > view.y2) continue;
+        uint32_t id = ui_gallery_item_of(tile);
+        uint32_t at = (uint32_t)(lv_obj_get_y(tile) / pitch_y) * cols + (uint32_t)((lv_obj_get_x(tile) - x0) / pitch_x);
+        if (id != at || lv_img_get_src(lv_obj_get_child(tile, 0)) == NULL) {
+            fprintf(stderr, "tile at item %u shows %u, src %p\n", (unsigned)at, (unsigned)id,
+                    lv_img_get_src(lv_obj_get_child(tile, 0)));
+            *ok = false;
+        }
+        has_want |= id == want;
+        seen++;
+    }
+    if (!has_want) {
+        fprintf(stderr, "item %u not on screen\n", (unsigned)want);
+        *ok = false;
+    }
+    return seen;
+}
+
+int main(void)
+{
+    char path[] = "/tmp/gallery_test_XXXXXX";
+    close(mkstemp(path));
+    disp_init();
+    ui_asset_reader_init();
+    if (!write_catalog(path, ITEMS) || !ui_catalog_open(path)) {
+        fprintf(stderr, "cannot build the test catalog\n");
+        return 2;
+    }
+
+    bool ok = true;
+    ui_gallery_open(300);
+    run(600);
+    uint32_t tiles = lv_obj_get_child_cnt(ui_galleryGrid) - 1;
+    int seen       = check_visible(300, &ok);
+
+    lv_obj_scroll_to_y(ui_galleryGrid, 0, LV_ANIM_OFF);
+    run(600);
+    seen += check_visible(0, &ok);
+
+    /* Row by row, so every step re-binds one row of tiles */
+    for (int i = 0; i < 40; ++i) {
+        lv_obj_scroll_by(ui_galleryGrid, 0, -31, LV_ANIM_OFF);
+        run(10);
+    }
+    run(600);
+    lv_obj_scroll_to_y(ui_galleryGrid, 30000, LV_ANIM_OFF);
+    run(600);
+    seen += check_visible(ITEMS - 1, &ok);
+    ok &= lv_obj_get_child_cnt(ui_galleryGrid) - 1 == tiles && tiles < ITEMS / 4;
+
+    ui_gallery_close();
+    ui_Screen3_screen_destroy();
+    ui_catalog_close();
+    unlink(path);
+    printf("{\"test\":\"gallery\",\"items\":%u,\"tiles\":%u,\"checked\":%d,\"ok\":%d}\n", ITEMS, (unsigned)tiles,
+           seen, ok);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,46 @@
+#pragma once
+/*
+ * esp_async_memcpy on the host: a thread copies the queued blocks in order,
+ * each one host_async_memcpy_delay_us after the previous, and then calls its
+ * callback, so copies land well after esp_async_memcpy() returns as they do
+ * with the GDMA. A block from or to a flash region (esp_memory_utils.h) is
+ * written as zeros.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct host_async_memcpy *async_memcpy_handle_t;
+
+typedef struct {
+    void *data;
+} async_memcpy_event_t;
+
+typedef bool (*async_memcpy_isr_cb_t)(async_memcpy_handle_t mcp, async_memcpy_event_t *event, void *cb_args);
+
+typedef struct {
+    uint32_t backlog;
+    size_t sram_trans_align;
+    size_t psram_trans_align;
+    uint32_t flags;
+} async_memcpy_config_t;
+
+#define ASYNC_MEMCPY_DEFAULT_CONFIG() { .backlog = 8, .sram_trans_align = 0, .psram_trans_align = 0, .flags = 0 }
+
+esp_err_t esp_async_memcpy_install(const async_memcpy_config_t *config, async_memcpy_handle_t *mcp);
+/* Waits for the queued copies */
+esp_err_t esp_async_memcpy_uninstall(async_memcpy_handle_t mcp);
+/* ESP_ERR_INVALID_STATE when `backlog` copies are already queued */
+esp_err_t esp_async_memcpy(async_memcpy_handle_t mcp, void *dst, void *src, size_t n, async_memcpy_isr_cb_t cb,
+                           void *cb_args);
+
+extern uint32_t host_async_memcpy_delay_us;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,154 @@
+#pragma once
+/*
+ * The esp_panel::drivers classes main/lvgl_v8_port.cpp uses, on the host: an
+ * RGB LCD whose frame buffers are in memory and a touch panel that is never
+ * pressed. A thread stands for the VSYNC interrupt: once begun, the LCD calls
+ * its refresh-finish callback every host_lcd_frame_us, by default the frame
+ * time of the board's 800x480 timings at its 16 MHz pixel clock.
+ */
+#include <bitset>
+#include <pthread.h>
+#include <stdint.h>
+
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#define ESP_PANEL_BUS_TYPE_RGB      (2)
+#define ESP_PANEL_BUS_TYPE_MIPI_DSI (5)
+
+extern "C" uint32_t host_lcd_frame_us;
+
+namespace esp_panel::drivers {
+
+class Bus {
+public:
+    struct BasicAttributes {
+        int type         = -1;
+        const char *name = "";
+    };
+
+    explicit Bus(int type) { _basic_attributes.type = type; }
+    const BasicAttributes &getBasicAttributes() const { return _basic_attributes; }
+
+private:
+    BasicAttributes _basic_attributes;
+};
+
+class LCD {
+public:
+    using FunctionRefreshFinishCallback = bool (*)(void *user_data);
+
+    /* No mirror or swap function: LVGL rotates in software, as on an RGB panel without a control panel */
+    struct BasicBusSpecification {
+        enum Function : uint8_t {
+            FUNC_INVERT_COLOR = 0,
+            FUNC_MIRROR_X,
+            FUNC_MIRROR_Y,
+            FUNC_SWAP_XY,
+            FUNC_GAP,
+            FUNC_DISPLAY_ON_OFF,
+            FUNC_MAX,
+        };
+
+        bool isFunctionValid(Function func) const { return functions.test(func); }
+
+        int x_coord_align = 1;
+        int y_coord_align = 1;
+        std::bitset<FUNC_MAX> functions;
+    };
+
+    struct BasicAttributes {
+        const char *name = "HOST";
+        BasicBusSpecification basic_bus_spec;
+    };
+
+    struct Transformation {
+        bool swap_xy  = false;
+        bool mirror_x = false;
+        bool mirror_y = false;
+        int gap_x     = 0;
+        int gap_y     = 0;
+    };
+
+    LCD(int width, int height);
+    ~LCD();
+
+    /* Before begin(): 1 to 3 frame buffers, 1 by default */
+    bool configFrameBufferNumber(int num);
+    bool begin();
+    bool del();
+
+    /* Copies the area into the first frame buffer, as the RGB panel driver does */
+    bool drawBitmap(int x_start, int y_start, int width, int height, const uint8_t *color_data, int timeout_ms = 0);
+    bool mirrorX(bool en);
+    bool mirrorY(bool en);
+    bool swapXY(bool en);
+    bool attachRefreshFinishCallback(FunctionRefreshFinishCallback callback, void *user_data = nullptr);
+    /* Scanned out from the next VSYNC on */
+    bool switchFrameBufferTo(void *frame_buffer);
+    void *getFrameBufferByIndex(uint8_t index);
+
+    int getFrameWidth() { return _width; }
+    int getFrameHeight() { return _height; }
+    const BasicAttributes &getBasicAttributes() { return _basic_attributes; }
+    const Transformation &getTransformation() { return _transformation; }
+    Bus *getBus() { return &_bus; }
+    void *getRefreshPanelHandle() { return _began ? this : nullptr; }
+
+private:
+    static void *vsyncMain(void *arg);
+
+    int _width;
+    int _height;
+    int _fb_num = 1;
+    void *_fbs[3] = {};
+    bool _began   = false;
+    bool _stop    = false;
+    Bus _bus{ESP_PANEL_BUS_TYPE_RGB};
+    BasicAttributes _basic_attributes;
+    Transformation _transformation;
+    pthread_t _vsync_thread;
+    pthread_mutex_t _lock = PTHREAD_MUTEX_INITIALIZER;
+    FunctionRefreshFinishCallback _refresh_cb = nullptr;
+    void *_refresh_arg                        = nullptr;
+    void *_next_fb                            = nullptr;
+};
+
+struct TouchPoint {
+    TouchPoint() = default;
+    TouchPoint(int x, int y, int strength) : x(x), y(y), strength(strength) {}
+
+    int x        = 0;
+    int y        = 0;
+    int strength = 0;
+};
+
+class Touch {
+public:
+    using FunctionInterruptCallback = bool (*)(void *user_data);
+
+    struct Transformation {
+        bool swap_xy  = false;
+        bool mirror_x = false;
+        bool mirror_y = false;
+    };
+
+    /* Never pressed: no point, and no INT pin, so it is polled */
+    int readPoints(TouchPoint points[], int num, int timeout_ms);
+    bool isInterruptEnabled() { return false; }
+    bool attachInterruptCallback(FunctionInterruptCallback callback, void *user_data = nullptr);
+    bool swapXY(bool en);
+    bool mirrorX(bool en);
+    bool mirrorY(bool en);
+
+    const Transformation &getTransformation() { return _transformation; }
+    void *getPanelHandle() { return this; }
+
+private:
+    Transformation _transformation;
+};
+
+} // namespace esp_panel::drivers
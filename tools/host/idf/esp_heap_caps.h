@@ -0,0 +1,36 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* One heap on the host: the capabilities are ignored */
+#define MALLOC_CAP_EXEC     (1 << 0)
+#define MALLOC_CAP_32BIT    (1 << 1)
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_DMA      (1 << 3)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT  (1 << 12)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static inline void *heap_caps_malloc(size_t size, uint32_t caps) { (void)caps; return malloc(size); }
+static inline void *heap_caps_calloc(size_t n, size_t size, uint32_t caps) { (void)caps; return calloc(n, size); }
+static inline void *heap_caps_realloc(void *p, size_t size, uint32_t caps) { (void)caps; return realloc(p, size); }
+static inline void heap_caps_free(void *p) { free(p); }
+
+static inline void *heap_caps_aligned_alloc(size_t align, size_t size, uint32_t caps)
+{
+    (void)caps;
+    return aligned_alloc(align, (size + align - 1) / align * align);
+}
+
+/* Not tracked on the host */
+static inline size_t heap_caps_get_free_size(uint32_t caps) { (void)caps; return 0; }
+static inline size_t heap_caps_get_largest_free_block(uint32_t caps) { (void)caps; return 0; }
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,43 @@
+#pragma once
+/*
+ * The logging and checking macros of esp-lib-utils used by main/, on the host
+ * log (esp_log.h). Debug messages are compiled out, as with the default
+ * ESP_UTILS_CONF_LOG_LEVEL.
+ */
+#include <assert.h>
+
+#include "esp_err.h"
+#include "esp_log.h"
+
+#ifndef ESP_UTILS_LOG_TAG
+#define ESP_UTILS_LOG_TAG "Utils"
+#endif
+
+#define ESP_UTILS_LOG_LEVEL_DEBUG 0
+#define ESP_UTILS_LOG_LEVEL_INFO  1
+#define ESP_UTILS_CONF_LOG_LEVEL  ESP_UTILS_LOG_LEVEL_INFO
+
+#define ESP_UTILS_LOGD(fmt, ...) ESP_LOGD(ESP_UTILS_LOG_TAG, fmt, ##__VA_ARGS__)
+#define ESP_UTILS_LOGI(fmt, ...) ESP_LOGI(ESP_UTILS_LOG_TAG, fmt, ##__VA_ARGS__)
+#define ESP_UTILS_LOGW(fmt, ...) ESP_LOGW(ESP_UTILS_LOG_TAG, fmt, ##__VA_ARGS__)
+#define ESP_UTILS_LOGE(fmt, ...) ESP_LOGE(ESP_UTILS_LOG_TAG, fmt, ##__VA_ARGS__)
+
+#define ESP_UTILS_CHECK_FALSE_RETURN(x, ret, fmt, ...) \
+    do {                                               \
+        if (!(x)) {                                    \
+            ESP_UTILS_LOGE(fmt, ##__VA_ARGS__);        \
+            return ret;                                \
+        }                                              \
+    } while (0)
+
+#define ESP_UTILS_CHECK_NULL_RETURN(x, ret, fmt, ...) ESP_UTILS_CHECK_FALSE_RETURN((x) != NULL, ret, fmt, ##__VA_ARGS__)
+#define ESP_UTILS_CHECK_ERROR_RETURN(x, ret, fmt, ...) \
+    ESP_UTILS_CHECK_FALSE_RETURN((x) == ESP_OK, ret, fmt, ##__VA_ARGS__)
+
+#define ESP_UTILS_CHECK_FALSE_EXIT(x, fmt, ...) \
+    do {                                        \
+        if (!(x)) {                             \
+            ESP_UTILS_LOGE(fmt, ##__VA_ARGS__); \
+            return;                             \
+        }                                       \
+    } while (0)
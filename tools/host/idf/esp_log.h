@@ -0,0 +1,13 @@
+#pragma once
+#include <stdio.h>
+#include "esp_timer.h"
+
+/* To stderr, so benchmarks can print their results alone on stdout */
+#define HOST_LOG(letter, tag, fmt, ...) \
+    fprintf(stderr, letter " (%lld) %s: " fmt "\n", (long long)(esp_timer_get_time() / 1000), tag, ##__VA_ARGS__)
+
+#define ESP_LOGE(tag, fmt, ...) HOST_LOG("E", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) HOST_LOG("W", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) HOST_LOG("I", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...) ((void)(tag))
+#define ESP_LOGV(tag, fmt, ...) ((void)(tag))
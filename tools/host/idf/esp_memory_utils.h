@@ -0,0 +1,21 @@
+#pragma once
+/*
+ * Memory regions on the host: nothing is external RAM, and everything is
+ * DMA-capable internal RAM except the ranges added with
+ * host_flash_region_add(), which play flash.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void host_flash_region_add(const void *start, size_t size);
+bool esp_ptr_dma_capable(const void *p);
+
+static inline bool esp_ptr_external_ram(const void *p) { (void)p; return false; }
+
+#ifdef __cplusplus
+}
+#endif
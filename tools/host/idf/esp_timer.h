@@ -0,0 +1,16 @@
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Declared only: LV_TICK_CUSTOM leaves LVGL without a tick timer on the host */
+typedef struct host_esp_timer *esp_timer_handle_t;
+
+/* CLOCK_MONOTONIC, in microseconds */
+int64_t esp_timer_get_time(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,50 @@
+#pragma once
+/*
+ * The FreeRTOS calls used by the modules under test, on pthreads. Every task
+ * is a thread and every core is the host CPU: priorities and affinity are
+ * ignored, and a tick is one millisecond.
+ */
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int32_t BaseType_t;
+typedef uint32_t UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void (*TaskFunction_t)(void *);
+typedef struct host_task *TaskHandle_t;
+typedef struct host_sem *SemaphoreHandle_t;
+typedef struct host_queue *QueueHandle_t;
+typedef int portMUX_TYPE;
+
+#define pdFALSE             ((BaseType_t)0)
+#define pdTRUE              ((BaseType_t)1)
+#define pdPASS              pdTRUE
+#define pdFAIL              pdFALSE
+#define portMAX_DELAY       ((TickType_t)0xffffffffUL)
+#define portTICK_PERIOD_MS  ((TickType_t)1)
+#define configTICK_RATE_HZ  1000
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(ms))
+#define portNUM_PROCESSORS  1
+#define tskNO_AFFINITY      ((BaseType_t)0x7fffffff)
+#define portYIELD_FROM_ISR(x) ((void)(x))
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 2
+
+#define portMUX_INITIALIZER_UNLOCKED 0
+void host_critical_enter(void);
+void host_critical_exit(void);
+#define portENTER_CRITICAL(mux)     ((void)(mux), host_critical_enter())
+#define portEXIT_CRITICAL(mux)      ((void)(mux), host_critical_exit())
+#define portENTER_CRITICAL_ISR(mux) portENTER_CRITICAL(mux)
+#define portEXIT_CRITICAL_ISR(mux)  portEXIT_CRITICAL(mux)
+
+static inline BaseType_t xPortGetCoreID(void) { return 0; }
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,20 @@
+#pragma once
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+QueueHandle_t xQueueCreate(UBaseType_t len, UBaseType_t item_size);
+void vQueueDelete(QueueHandle_t q);
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t ticks);
+BaseType_t xQueueSendToFront(QueueHandle_t q, const void *item, TickType_t ticks);
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t ticks);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q);
+
+#define xQueueSendToBack(q, item, ticks)  xQueueSend(q, item, ticks)
+#define xQueueSendFromISR(q, item, woken) ((void)(woken), xQueueSend(q, item, 0))
+
+#ifdef __cplusplus
+}
+#endif
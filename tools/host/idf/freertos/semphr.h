@@ -0,0 +1,22 @@
+#pragma once
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max, UBaseType_t initial);
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void);
+void vSemaphoreDelete(SemaphoreHandle_t sem);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t sem);
+
+#define xSemaphoreCreateBinary()          xSemaphoreCreateCounting(1, 0)
+#define xSemaphoreCreateMutex()           xSemaphoreCreateCounting(1, 1)
+#define xSemaphoreGiveFromISR(sem, woken) ((void)(woken), xSemaphoreGive(sem))
+
+#ifdef __cplusplus
+}
+#endif
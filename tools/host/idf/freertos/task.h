@@ -0,0 +1,51 @@
+#pragma once
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack, void *arg,
+                                   UBaseType_t prio, TaskHandle_t *out, BaseType_t core);
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *arg, UBaseType_t prio,
+                       TaskHandle_t *out);
+/* NULL ends the calling task. Another task is cancelled at its next wait. */
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount(void);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+
+typedef enum {
+    eNoAction = 0,
+    eSetBits,
+    eIncrement,
+    eSetValueWithOverwrite,
+    eSetValueWithoutOverwrite,
+} eNotifyAction;
+
+/*
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES notifications per task. A take waits
+ * until the value is not zero or a notification, eNoAction included, comes
+ * after the wait started.
+ */
+BaseType_t xTaskNotifyIndexed(TaskHandle_t task, UBaseType_t index, uint32_t value, eNotifyAction action);
+BaseType_t xTaskNotifyGiveIndexed(TaskHandle_t task, UBaseType_t index);
+void vTaskNotifyGiveIndexedFromISR(TaskHandle_t task, UBaseType_t index, BaseType_t *woken);
+uint32_t ulTaskNotifyTakeIndexed(UBaseType_t index, BaseType_t clear, TickType_t ticks);
+/* Values are unsigned long, as wide as ULONG_MAX, which is 32 bits on the chip; only the low 32 bits are kept */
+BaseType_t xTaskNotify(TaskHandle_t task, unsigned long value, eNotifyAction action);
+BaseType_t xTaskNotifyFromISR(TaskHandle_t task, unsigned long value, eNotifyAction action, BaseType_t *woken);
+/* NULL is the calling task */
+uint32_t ulTaskNotifyValueClear(TaskHandle_t task, unsigned long bits);
+
+#define xTaskNotifyGive(task)                 xTaskNotifyGiveIndexed(task, 0)
+#define vTaskNotifyGiveFromISR(task, woken)   vTaskNotifyGiveIndexedFromISR(task, 0, woken)
+#define ulTaskNotifyTake(clear, ticks)        ulTaskNotifyTakeIndexed(0, clear, ticks)
+
+/* The idle "task" of the host: its run time is the wall time the process spent off the CPU */
+TaskHandle_t xTaskGetIdleTaskHandleForCore(BaseType_t core);
+uint32_t ulTaskGetRunTimeCounter(TaskHandle_t task);
+
+#ifdef __cplusplus
+}
+#endif
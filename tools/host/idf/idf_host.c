@@ -0,0 +1,550 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "esp_async_memcpy.h"
+#include "esp_memory_utils.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+struct host_task {
+    pthread_t thread;
+    TaskFunction_t fn;
+    void *arg;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t notify[configTASK_NOTIFICATION_ARRAY_ENTRIES];
+    uint32_t events[configTASK_NOTIFICATION_ARRAY_ENTRIES]; /* Notifications received, eNoAction included */
+};
+
+struct host_sem {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    UBaseType_t count;
+    UBaseType_t max;
+    pthread_t owner; /* Recursive mutex only */
+    UBaseType_t depth;
+};
+
+struct host_queue {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint8_t *items;
+    UBaseType_t len;
+    UBaseType_t item_size;
+    UBaseType_t head;
+    UBaseType_t count;
+};
+
+static __thread struct host_task *s_self;
+static struct host_task s_idle;
+static pthread_mutex_t s_critical = PTHREAD_MUTEX_INITIALIZER;
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (int64_t)t.tv_sec * 1000000 + t.tv_nsec / 1000;
+}
+
+void host_critical_enter(void)
+{
+    pthread_mutex_lock(&s_critical);
+}
+
+void host_critical_exit(void)
+{
+    pthread_mutex_unlock(&s_critical);
+}
+
+static void cond_init(pthread_cond_t *cond)
+{
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+static struct timespec deadline(TickType_t ticks)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    t.tv_sec += ticks / 1000;
+    t.tv_nsec += (long)(ticks % 1000) * 1000000;
+    if (t.tv_nsec >= 1000000000) {
+        t.tv_sec++;
+        t.tv_nsec -= 1000000000;
+    }
+    return t;
+}
+
+/* Lock held. Returns false on timeout. */
+static bool wait_until(pthread_cond_t *cond, pthread_mutex_t *lock, TickType_t ticks, const struct timespec *until)
+{
+    if (ticks == portMAX_DELAY) {
+        pthread_cond_wait(cond, lock);
+        return true;
+    }
+    return pthread_cond_timedwait(cond, lock, until) != ETIMEDOUT;
+}
+
+/* ---- Tasks ---- */
+
+static void task_init(struct host_task *t)
+{
+    memset(t, 0, sizeof(*t));
+    pthread_mutex_init(&t->lock, NULL);
+    cond_init(&t->cond);
+}
+
+static void *task_main(void *arg)
+{
+    s_self = (struct host_task *)arg;
+    s_self->fn(s_self->arg);
+    return NULL;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack, void *arg,
+                                   UBaseType_t prio, TaskHandle_t *out, BaseType_t core)
+{
+    (void)name;
+    (void)stack;
+    (void)prio;
+    (void)core;
+    struct host_task *t = malloc(sizeof(*t));
+    if (!t) return pdFAIL;
+    task_init(t);
+    t->fn  = fn;
+    t->arg = arg;
+    /* The handle is published before the task runs, as FreeRTOS does */
+    if (out) *out = t;
+    if (pthread_create(&t->thread, NULL, task_main, t) != 0) {
+        free(t);
+        if (out) *out = NULL;
+        return pdFAIL;
+    }
+    pthread_detach(t->thread);
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *arg, UBaseType_t prio,
+                       TaskHandle_t *out)
+{
+    return xTaskCreatePinnedToCore(fn, name, stack, arg, prio, out, tskNO_AFFINITY);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    if (!s_self) {
+        /* A thread not created by xTaskCreate(), such as main() */
+        s_self = malloc(sizeof(*s_self));
+        task_init(s_self);
+        s_self->thread = pthread_self();
+    }
+    return s_self;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    if (task == NULL || task == s_self) {
+        pthread_exit(NULL);
+    }
+    pthread_cancel(task->thread);
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    struct timespec t = { .tv_sec = ticks / 1000, .tv_nsec = (long)(ticks % 1000) * 1000000 };
+    while (nanosleep(&t, &t) != 0 && errno == EINTR) {
+    }
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(esp_timer_get_time() / 1000);
+}
+
+BaseType_t xTaskNotifyIndexed(TaskHandle_t task, UBaseType_t index, uint32_t value, eNotifyAction action)
+{
+    pthread_mutex_lock(&task->lock);
+    BaseType_t ok = pdPASS;
+    switch (action) {
+    case eNoAction:
+        break;
+    case eSetBits:
+        task->notify[index] |= value;
+        break;
+    case eIncrement:
+        task->notify[index]++;
+        break;
+    case eSetValueWithoutOverwrite:
+        /* A notification still pending is one not taken yet */
+        if (task->notify[index] != 0) {
+            ok = pdFAIL;
+            break;
+        }
+        /* fallthrough */
+    case eSetValueWithOverwrite:
+        task->notify[index] = value;
+        break;
+    }
+    if (ok) {
+        task->events[index]++;
+        pthread_cond_signal(&task->cond);
+    }
+    pthread_mutex_unlock(&task->lock);
+    return ok;
+}
+
+BaseType_t xTaskNotify(TaskHandle_t task, unsigned long value, eNotifyAction action)
+{
+    return xTaskNotifyIndexed(task, 0, (uint32_t)value, action);
+}
+
+BaseType_t xTaskNotifyFromISR(TaskHandle_t task, unsigned long value, eNotifyAction action, BaseType_t *woken)
+{
+    if (woken) *woken = pdFALSE;
+    return xTaskNotifyIndexed(task, 0, (uint32_t)value, action);
+}
+
+BaseType_t xTaskNotifyGiveIndexed(TaskHandle_t task, UBaseType_t index)
+{
+    return xTaskNotifyIndexed(task, index, 0, eIncrement);
+}
+
+void vTaskNotifyGiveIndexedFromISR(TaskHandle_t task, UBaseType_t index, BaseType_t *woken)
+{
+    xTaskNotifyGiveIndexed(task, index);
+    if (woken) *woken = pdFALSE;
+}
+
+uint32_t ulTaskNotifyTakeIndexed(UBaseType_t index, BaseType_t clear, TickType_t ticks)
+{
+    struct host_task *t   = xTaskGetCurrentTaskHandle();
+    struct timespec until = deadline(ticks);
+    pthread_mutex_lock(&t->lock);
+    uint32_t events = t->events[index];
+    while (t->notify[index] == 0 && t->events[index] == events && wait_until(&t->cond, &t->lock, ticks, &until)) {
+    }
+    uint32_t n = t->notify[index];
+    if (n) t->notify[index] = clear ? 0 : n - 1;
+    pthread_mutex_unlock(&t->lock);
+    return n;
+}
+
+uint32_t ulTaskNotifyValueClear(TaskHandle_t task, unsigned long bits)
+{
+    struct host_task *t = task ? task : xTaskGetCurrentTaskHandle();
+    pthread_mutex_lock(&t->lock);
+    uint32_t n = t->notify[0];
+    t->notify[0] &= ~(uint32_t)bits;
+    pthread_mutex_unlock(&t->lock);
+    return n;
+}
+
+TaskHandle_t xTaskGetIdleTaskHandleForCore(BaseType_t core)
+{
+    (void)core;
+    return &s_idle;
+}
+
+uint32_t ulTaskGetRunTimeCounter(TaskHandle_t task)
+{
+    if (task != &s_idle) return 0;
+    struct timespec cpu;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu);
+    int64_t busy = (int64_t)cpu.tv_sec * 1000000 + cpu.tv_nsec / 1000;
+    int64_t idle = esp_timer_get_time() - busy;
+    return (uint32_t)(idle > 0 ? idle : 0);
+}
+
+/* ---- Semaphores ---- */
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max, UBaseType_t initial)
+{
+    struct host_sem *s = calloc(1, sizeof(*s));
+    if (!s) return NULL;
+    pthread_mutex_init(&s->lock, NULL);
+    cond_init(&s->cond);
+    s->max   = max;
+    s->count = initial;
+    return s;
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void)
+{
+    return xSemaphoreCreateCounting(1, 1);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem)
+{
+    if (!sem) return;
+    pthread_mutex_destroy(&sem->lock);
+    pthread_cond_destroy(&sem->cond);
+    free(sem);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    struct timespec until = deadline(ticks);
+    pthread_mutex_lock(&sem->lock);
+    while (sem->count == 0 && wait_until(&sem->cond, &sem->lock, ticks, &until)) {
+    }
+    BaseType_t ok = sem->count > 0;
+    if (ok) sem->count--;
+    pthread_mutex_unlock(&sem->lock);
+    return ok;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    pthread_mutex_lock(&sem->lock);
+    BaseType_t ok = sem->count < sem->max;
+    if (ok) {
+        sem->count++;
+        pthread_cond_signal(&sem->cond);
+    }
+    pthread_mutex_unlock(&sem->lock);
+    return ok;
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    pthread_mutex_lock(&sem->lock);
+    if (sem->depth && pthread_equal(sem->owner, pthread_self())) {
+        sem->depth++;
+        pthread_mutex_unlock(&sem->lock);
+        return pdTRUE;
+    }
+    pthread_mutex_unlock(&sem->lock);
+    if (!xSemaphoreTake(sem, ticks)) return pdFALSE;
+    pthread_mutex_lock(&sem->lock);
+    sem->owner = pthread_self();
+    sem->depth = 1;
+    pthread_mutex_unlock(&sem->lock);
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t sem)
+{
+    pthread_mutex_lock(&sem->lock);
+    bool last = --sem->depth == 0;
+    pthread_mutex_unlock(&sem->lock);
+    return last ? xSemaphoreGive(sem) : pdTRUE;
+}
+
+/* ---- Queues ---- */
+
+QueueHandle_t xQueueCreate(UBaseType_t len, UBaseType_t item_size)
+{
+    struct host_queue *q = calloc(1, sizeof(*q));
+    if (!q) return NULL;
+    q->items = malloc((size_t)len * item_size);
+    if (!q->items) {
+        free(q);
+        return NULL;
+    }
+    pthread_mutex_init(&q->lock, NULL);
+    cond_init(&q->cond);
+    q->len       = len;
+    q->item_size = item_size;
+    return q;
+}
+
+void vQueueDelete(QueueHandle_t q)
+{
+    if (!q) return;
+    pthread_mutex_destroy(&q->lock);
+    pthread_cond_destroy(&q->cond);
+    free(q->items);
+    free(q);
+}
+
+static BaseType_t queue_put(QueueHandle_t q, const void *item, TickType_t ticks, bool front)
+{
+    struct timespec until = deadline(ticks);
+    pthread_mutex_lock(&q->lock);
+    while (q->count == q->len && wait_until(&q->cond, &q->lock, ticks, &until)) {
+    }
+    BaseType_t ok = q->count < q->len;
+    if (ok) {
+        if (front) q->head = (q->head + q->len - 1) % q->len;
+        UBaseType_t slot = front ? q->head : (q->head + q->count) % q->len;
+        memcpy(q->items + (size_t)slot * q->item_size, item, q->item_size);
+        q->count++;
+        pthread_cond_broadcast(&q->cond);
+    }
+    pthread_mutex_unlock(&q->lock);
+    return ok;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t ticks)
+{
+    return queue_put(q, item, ticks, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t q, const void *item, TickType_t ticks)
+{
+    return queue_put(q, item, ticks, true);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t ticks)
+{
+    struct timespec until = deadline(ticks);
+    pthread_mutex_lock(&q->lock);
+    while (q->count == 0 && wait_until(&q->cond, &q->lock, ticks, &until)) {
+    }
+    BaseType_t ok = q->count > 0;
+    if (ok) {
+        memcpy(item, q->items + (size_t)q->head * q->item_size, q->item_size);
+        q->head = (q->head + 1) % q->len;
+        q->count--;
+        pthread_cond_broadcast(&q->cond);
+    }
+    pthread_mutex_unlock(&q->lock);
+    return ok;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q)
+{
+    pthread_mutex_lock(&q->lock);
+    UBaseType_t n = q->count;
+    pthread_mutex_unlock(&q->lock);
+    return n;
+}
+
+/* ---- Async memcpy ---- */
+
+#define HOST_FLASH_REGIONS 8
+
+typedef struct {
+    void *dst;
+    const void *src;
+    size_t n;
+    async_memcpy_isr_cb_t cb;
+    void *cb_args;
+} host_copy_t;
+
+struct host_async_memcpy {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    host_copy_t *copies;
+    uint32_t len;
+    uint32_t head;
+    uint32_t count;
+    bool stop;
+};
+
+uint32_t host_async_memcpy_delay_us = 200;
+
+static struct {
+    const uint8_t *start;
+    size_t size;
+} s_flash_regions[HOST_FLASH_REGIONS];
+
+void host_flash_region_add(const void *start, size_t size)
+{
+    for (int i = 0; i < HOST_FLASH_REGIONS; ++i) {
+        if (!s_flash_regions[i].start) {
+            s_flash_regions[i].start = start;
+            s_flash_regions[i].size  = size;
+            return;
+        }
+    }
+}
+
+bool esp_ptr_dma_capable(const void *p)
+{
+    for (int i = 0; i < HOST_FLASH_REGIONS; ++i) {
+        const uint8_t *start = s_flash_regions[i].start;
+        if (start && (const uint8_t *)p >= start && (const uint8_t *)p < start + s_flash_regions[i].size) return false;
+    }
+    return true;
+}
+
+static void *async_memcpy_main(void *arg)
+{
+    struct host_async_memcpy *mcp = arg;
+    pthread_mutex_lock(&mcp->lock);
+    while (1) {
+        while (mcp->count == 0 && !mcp->stop) pthread_cond_wait(&mcp->cond, &mcp->lock);
+        if (mcp->count == 0) break;
+        host_copy_t copy = mcp->copies[mcp->head];
+        pthread_mutex_unlock(&mcp->lock);
+
+        struct timespec t = { .tv_sec = 0, .tv_nsec = (long)host_async_memcpy_delay_us * 1000 };
+        while (nanosleep(&t, &t) != 0 && errno == EINTR) {
+        }
+        /* What a GDMA reads from flash is garbage */
+        if (esp_ptr_dma_capable(copy.dst) && esp_ptr_dma_capable(copy.src)) {
+            memcpy(copy.dst, copy.src, copy.n);
+        } else {
+            memset(copy.dst, 0, copy.n);
+        }
+        async_memcpy_event_t event = { 0 };
+        if (copy.cb) copy.cb(mcp, &event, copy.cb_args);
+
+        pthread_mutex_lock(&mcp->lock);
+        mcp->head = (mcp->head + 1) % mcp->len;
+        mcp->count--;
+        pthread_cond_broadcast(&mcp->cond);
+    }
+    pthread_mutex_unlock(&mcp->lock);
+    return NULL;
+}
+
+esp_err_t esp_async_memcpy_install(const async_memcpy_config_t *config, async_memcpy_handle_t *out)
+{
+    struct host_async_memcpy *mcp = calloc(1, sizeof(*mcp));
+    if (!mcp) return ESP_ERR_NO_MEM;
+    mcp->len    = config->backlog ? config->backlog : 1;
+    mcp->copies = calloc(mcp->len, sizeof(host_copy_t));
+    if (!mcp->copies) {
+        free(mcp);
+        return ESP_ERR_NO_MEM;
+    }
+    pthread_mutex_init(&mcp->lock, NULL);
+    cond_init(&mcp->cond);
+    if (pthread_create(&mcp->thread, NULL, async_memcpy_main, mcp) != 0) {
+        free(mcp->copies);
+        free(mcp);
+        return ESP_FAIL;
+    }
+    *out = mcp;
+    return ESP_OK;
+}
+
+esp_err_t esp_async_memcpy_uninstall(async_memcpy_handle_t mcp)
+{
+    pthread_mutex_lock(&mcp->lock);
+    mcp->stop = true;
+    pthread_cond_broadcast(&mcp->cond);
+    pthread_mutex_unlock(&mcp->lock);
+    pthread_join(mcp->thread, NULL);
+    pthread_mutex_destroy(&mcp->lock);
+    pthread_cond_destroy(&mcp->cond);
+    free(mcp->copies);
+    free(mcp);
+    return ESP_OK;
+}
+
+esp_err_t esp_async_memcpy(async_memcpy_handle_t mcp, void *dst, void *src, size_t n, async_memcpy_isr_cb_t cb,
+                           void *cb_args)
+{
+    pthread_mutex_lock(&mcp->lock);
+    esp_err_t err = ESP_ERR_INVALID_STATE;
+    if (mcp->count < mcp->len) {
+        mcp->copies[(mcp->head + mcp->count) % mcp->len] = (host_copy_t){ dst, src, n, cb, cb_args };
+        mcp->count++;
+        pthread_cond_broadcast(&mcp->cond);
+        err = ESP_OK;
+    }
+    pthread_mutex_unlock(&mcp->lock);
+    return err;
+}
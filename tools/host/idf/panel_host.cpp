@@ -0,0 +1,173 @@
+#include "esp_display_panel.hpp"
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+/* (800 + 4 + 8 + 8) x (480 + 4 + 8 + 8) pixel clocks at 16 MHz: HPW/HBP/HFP and VPW/VBP/VFP of sdkconfig.defaults */
+uint32_t host_lcd_frame_us = 25625;
+
+namespace esp_panel::drivers {
+
+LCD::LCD(int width, int height) : _width(width), _height(height) {}
+
+LCD::~LCD()
+{
+    del();
+}
+
+bool LCD::configFrameBufferNumber(int num)
+{
+    if (_began || (num < 1) || (num > 3)) return false;
+    _fb_num = num;
+    return true;
+}
+
+bool LCD::begin()
+{
+    if (_began) return true;
+    size_t size = (size_t)_width * _height * 2;
+    for (int i = 0; i < _fb_num; ++i) {
+        _fbs[i] = heap_caps_calloc(1, size, MALLOC_CAP_SPIRAM);
+        if (_fbs[i] == nullptr) {
+            del();
+            return false;
+        }
+    }
+    _next_fb = _fbs[0];
+    _stop    = false;
+    if (pthread_create(&_vsync_thread, nullptr, vsyncMain, this) != 0) {
+        del();
+        return false;
+    }
+    _began = true;
+    return true;
+}
+
+bool LCD::del()
+{
+    if (_began) {
+        pthread_mutex_lock(&_lock);
+        _stop = true;
+        pthread_mutex_unlock(&_lock);
+        pthread_join(_vsync_thread, nullptr);
+        _began = false;
+    }
+    for (int i = 0; i < 3; ++i) {
+        heap_caps_free(_fbs[i]);
+        _fbs[i] = nullptr;
+    }
+    return true;
+}
+
+void *LCD::vsyncMain(void *arg)
+{
+    LCD *lcd = (LCD *)arg;
+    while (1) {
+        struct timespec t = { .tv_sec = 0, .tv_nsec = (long)host_lcd_frame_us * 1000 };
+        while (nanosleep(&t, &t) != 0 && errno == EINTR) {
+        }
+        pthread_mutex_lock(&lcd->_lock);
+        bool stop                             = lcd->_stop;
+        FunctionRefreshFinishCallback callback = lcd->_refresh_cb;
+        void *user_data                       = lcd->_refresh_arg;
+        pthread_mutex_unlock(&lcd->_lock);
+        if (stop) break;
+        if (callback != nullptr) callback(user_data);
+    }
+    return nullptr;
+}
+
+bool LCD::drawBitmap(int x_start, int y_start, int width, int height, const uint8_t *color_data, int timeout_ms)
+{
+    (void)timeout_ms;
+    if (!_began || (x_start < 0) || (y_start < 0) || (x_start + width > _width) || (y_start + height > _height)) {
+        return false;
+    }
+    uint16_t *fb          = (uint16_t *)_fbs[0];
+    const uint16_t *from = (const uint16_t *)color_data;
+    for (int y = y_start; y < y_start + height; ++y) {
+        memcpy(fb + (size_t)y * _width + x_start, from, width * sizeof(uint16_t));
+        from += width;
+    }
+    return true;
+}
+
+bool LCD::mirrorX(bool en)
+{
+    _transformation.mirror_x = en;
+    return true;
+}
+
+bool LCD::mirrorY(bool en)
+{
+    _transformation.mirror_y = en;
+    return true;
+}
+
+bool LCD::swapXY(bool en)
+{
+    _transformation.swap_xy = en;
+    return true;
+}
+
+bool LCD::attachRefreshFinishCallback(FunctionRefreshFinishCallback callback, void *user_data)
+{
+    pthread_mutex_lock(&_lock);
+    _refresh_cb  = callback;
+    _refresh_arg = user_data;
+    pthread_mutex_unlock(&_lock);
+    return true;
+}
+
+bool LCD::switchFrameBufferTo(void *frame_buffer)
+{
+    for (int i = 0; i < _fb_num; ++i) {
+        if (_fbs[i] == frame_buffer) {
+            pthread_mutex_lock(&_lock);
+            _next_fb = frame_buffer;
+            pthread_mutex_unlock(&_lock);
+            return true;
+        }
+    }
+    return false;
+}
+
+void *LCD::getFrameBufferByIndex(uint8_t index)
+{
+    return (index < _fb_num) ? _fbs[index] : nullptr;
+}
+
+int Touch::readPoints(TouchPoint points[], int num, int timeout_ms)
+{
+    (void)points;
+    (void)num;
+    (void)timeout_ms;
+    return 0;
+}
+
+bool Touch::attachInterruptCallback(FunctionInterruptCallback callback, void *user_data)
+{
+    (void)callback;
+    (void)user_data;
+    return false;
+}
+
+bool Touch::swapXY(bool en)
+{
+    _transformation.swap_xy = en;
+    return true;
+}
+
+bool Touch::mirrorX(bool en)
+{
+    _transformation.mirror_x = en;
+    return true;
+}
+
+bool Touch::mirrorY(bool en)
+{
+    _transformation.mirror_y = en;
+    return true;
+}
+
+} // namespace esp_panel::drivers
@@ -0,0 +1,76 @@
+#pragma once
+/*
+ * Kconfig values of the host build: the defaults of components/ui,
+ * components/asset_fs and main with sdkconfig.defaults applied. Each one can
+ * be overridden with -D, as the benchmark matrix does.
+ */
+
+/* components/asset_fs: HOST_ASSET_ROOT is the repository's assets/ directory */
+#define CONFIG_ASSET_FS_SPIFFS 1
+#ifndef CONFIG_ASSET_FS_BASE_PATH
+#define CONFIG_ASSET_FS_BASE_PATH HOST_ASSET_ROOT
+#endif
+#define CONFIG_ASSET_FS_PARTITION_LABEL "spiffs"
+#define CONFIG_ASSET_FS_MAX_FILES 12
+
+/* components/ui */
+#ifndef CONFIG_UI_IMG_PROGRESSIVE
+#define CONFIG_UI_IMG_PROGRESSIVE 1
+#endif
+#define CONFIG_UI_IMG_STREAM_BLOCK_KB 8
+#define CONFIG_UI_IMG_STREAM_BLOCK_NUM 4
+#define CONFIG_UI_IMG_STREAM_READ_AHEAD 1
+#define CONFIG_UI_SCREEN_CACHE_IDLE_MS 300
+#if !defined(CONFIG_UI_SCREEN_TRANSITION_FADE) && !defined(CONFIG_UI_SCREEN_TRANSITION_SLIDE)
+#define CONFIG_UI_SCREEN_TRANSITION_NONE 1
+#endif
+#define CONFIG_UI_SCREEN_TRANSITION_MS 300
+#define CONFIG_UI_GALLERY_TILE_W 144
+#define CONFIG_UI_GALLERY_TILE_H 108
+#define CONFIG_UI_GALLERY_CACHE_NUM 24
+#define CONFIG_UI_ASSET_READ_BLOCK_KB 32
+#ifndef CONFIG_UI_ASSET_READ_DOUBLE_BUFFER
+#define CONFIG_UI_ASSET_READ_DOUBLE_BUFFER 1
+#endif
+
+/*
+ * main: the LVGL port of main/lvgl_v8_port.cpp, on the LCD and touch panel of
+ * esp_display_panel.hpp. As on the board: flush task, event wakeup and touch
+ * task on, parallel blend, async blit and buffer age off. The latency trace
+ * stays off, lvgl_port_trace.c has no lock on the host.
+ */
+#ifndef CONFIG_LVGL_PORT_AVOID_TEARING_MODE
+#define CONFIG_LVGL_PORT_AVOID_TEARING_MODE 0
+#endif
+#ifndef CONFIG_LVGL_PORT_ROTATION_DEGREE
+#define CONFIG_LVGL_PORT_ROTATION_DEGREE 0
+#endif
+#ifndef CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT
+#define CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT 20
+#endif
+#ifndef CONFIG_LVGL_PORT_BUFFER_NUM
+#define CONFIG_LVGL_PORT_BUFFER_NUM 2
+#endif
+#define CONFIG_LVGL_PORT_TASK_CORE 0
+#ifndef CONFIG_LVGL_PORT_EVENT_WAKE
+#define CONFIG_LVGL_PORT_EVENT_WAKE 1
+#endif
+#ifndef CONFIG_LVGL_PORT_TOUCH_TASK
+#define CONFIG_LVGL_PORT_TOUCH_TASK 1
+#endif
+#define CONFIG_LVGL_PORT_TOUCH_POLL_MS 20
+/* Only without avoid tearing and with two draw buffers */
+#ifndef CONFIG_LVGL_PORT_FLUSH_TASK
+#define CONFIG_LVGL_PORT_FLUSH_TASK (CONFIG_LVGL_PORT_AVOID_TEARING_MODE == 0 && CONFIG_LVGL_PORT_BUFFER_NUM == 2)
+#endif
+#define CONFIG_LVGL_PORT_FLUSH_TASK_CORE 1
+#define CONFIG_LVGL_PORT_PARALLEL_BLEND_MIN_PX 4096
+#define CONFIG_LVGL_PORT_PARALLEL_BLEND_CORE 1
+#define CONFIG_LVGL_PORT_ASYNC_BLIT_MIN_PX 4096
+#define CONFIG_LVGL_PORT_STATS 1
+#ifndef CONFIG_RENDER_BENCH_TRANSITIONS
+#define CONFIG_RENDER_BENCH_TRANSITIONS 20
+#endif
+#ifndef CONFIG_RENDER_BENCH_SETTLE_MS
+#define CONFIG_RENDER_BENCH_SETTLE_MS 1000
+#endif
@@ -0,0 +1,170 @@
+/*
+ * Drawing the quiz photo in the color formats tools/asset_packer.py picks
+ * from, on an 800x480 display with 800x20 draw buffers.
+ *
+ * The photo is catalog/src/ui_img_02_png.bin (578x339 RGB565), placed and
+ * styled like ui_Img on Screen1. INDEXED_8BIT and INDEXED_4BIT versions use a
+ * fixed palette: the draw cost does not depend on the colors in it. For each
+ * format, the median time of a redraw of the photo is printed with the pixels
+ * LV_REFR_OCCLUSION skipped under it and the bytes lvgl_port_blit.c would
+ * take over (counted on its memcpy() fallback, without the GDMA). Only
+ * TRUE_COLOR passes lv_img's cover check, so only it must get both.
+ *
+ *   img_format_bench [-n runs]
+ */
+#include "lvgl_port_blit.h"
+#include "lvgl.h"
+#include "src/draw/sw/lv_draw_sw.h"
+#include "esp_timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define W      800
+#define H      480
+#define ROWS   20
+#define IMG_W  578
+#define IMG_H  339
+#define MIN_PX 4096
+
+#define CHECK(c)                                                    \
+    do {                                                            \
+        if (!(c)) {                                                 \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #c); \
+            return 1;                                               \
+        }                                                           \
+    } while (0)
+
+static lv_disp_drv_t s_drv;
+static lv_disp_draw_buf_t s_draw_buf;
+static lv_color_t s_buf[2][W * ROWS];
+static lv_color_t s_px[IMG_W * IMG_H];
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *px)
+{
+    (void)area;
+    lvgl_port_blit_wait_buf(px);
+    lv_disp_flush_ready(drv);
+}
+
+static void blit_ctx_init(lv_disp_drv_t *drv, lv_draw_ctx_t *draw_ctx)
+{
+    lv_draw_sw_init_ctx(drv, draw_ctx);
+    lvgl_port_blit_attach(drv, draw_ctx, MIN_PX);
+}
+
+static bool load_photo(void)
+{
+    FILE *f = fopen(HOST_REPO_ROOT "/catalog/src/ui_img_02_png.bin", "rb");
+    if (!f) return false;
+    bool ok = fread(s_px, sizeof(s_px), 1, f) == 1;
+    fclose(f);
+    return ok;
+}
+
+/* `bits` per pixel: palette of 1 << bits ARGB8888 entries, then the rows, bytes padded */
+static uint8_t *encode_indexed(int bits, uint32_t *size)
+{
+    uint32_t colors = 1u << bits;
+    uint32_t stride = (IMG_W * bits + 7) / 8;
+    *size           = colors * 4 + stride * IMG_H;
+    uint8_t *data   = calloc(1, *size);
+    for (uint32_t i = 0; i < colors; ++i) {
+        lv_color32_t c = { .ch = { .red   = (uint8_t)(i * 255 / (colors - 1)),
+                                   .green = (uint8_t)(i * 97),
+                                   .blue  = (uint8_t)(255 - i * 255 / (colors - 1)),
+                                   .alpha = 0xFF } };
+        memcpy(data + i * 4, &c, 4);
+    }
+    uint8_t *rows = data + colors * 4;
+    for (uint32_t y = 0; y < IMG_H; ++y) {
+        for (uint32_t x = 0; x < IMG_W; ++x) {
+            uint32_t index = (s_px[y * IMG_W + x].full >> (16 - bits)) & (colors - 1);
+            uint32_t bit   = x * bits;
+            rows[y * stride + bit / 8] |= (uint8_t)(index << (8 - bits - bit % 8));
+        }
+    }
+    return data;
+}
+
+static uint32_t median(uint32_t *us, int runs)
+{
+    for (int i = 1; i < runs; ++i) {
+        for (int j = i; j > 0 && us[j - 1] > us[j]; --j) {
+            uint32_t t = us[j];
+            us[j]      = us[j - 1];
+            us[j - 1]  = t;
+        }
+    }
+    return us[runs / 2];
+}
+
+static int bench(lv_obj_t *img, const char *name, lv_img_cf_t cf, const uint8_t *data, uint32_t size, int runs)
+{
+    lv_img_dsc_t dsc = { .header = { .cf = cf, .w = IMG_W, .h = IMG_H }, .data_size = size, .data = data };
+    lv_img_set_src(img, &dsc);
+    lv_refr_now(NULL);
+
+    lvgl_port_blit_stats_t blit;
+    lvgl_port_blit_get_stats(&blit, true);
+    lv_refr_get_occluded_px(true);
+    uint32_t *us = calloc(runs, sizeof(*us));
+    for (int i = 0; i < runs; ++i) {
+        lv_obj_invalidate(img);
+        int64_t t0 = esp_timer_get_time();
+        lv_refr_now(NULL);
+        us[i] = (uint32_t)(esp_timer_get_time() - t0);
+    }
+    uint32_t occluded = lv_refr_get_occluded_px(true) / runs;
+    lvgl_port_blit_get_stats(&blit, true);
+    uint32_t blit_bytes = (blit.dma_bytes + blit.cpu_bytes) / runs;
+
+    printf("{\"bench\":\"img_format\",\"cf\":\"%s\",\"bytes\":%u,\"draw_us\":%u,\"occluded_px\":%u,"
+           "\"blit_bytes\":%u}\n",
+           name, (unsigned)size, (unsigned)median(us, runs), (unsigned)occluded, (unsigned)blit_bytes);
+    free(us);
+
+    bool covers = cf == LV_IMG_CF_TRUE_COLOR;
+    CHECK(covers ? occluded >= IMG_W * IMG_H / 2 : occluded == 0);
+    CHECK(covers ? blit_bytes >= IMG_W * IMG_H : blit_bytes == 0);
+    lv_img_set_src(img, NULL);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    int runs = 21;
+    if (argc > 2 && strcmp(argv[1], "-n") == 0) runs = atoi(argv[2]) > 0 ? atoi(argv[2]) : 1;
+
+    CHECK(load_photo());
+    lv_init();
+    lv_disp_draw_buf_init(&s_draw_buf, s_buf[0], s_buf[1], W * ROWS);
+    lv_disp_drv_init(&s_drv);
+    s_drv.hor_res         = W;
+    s_drv.ver_res         = H;
+    s_drv.draw_buf        = &s_draw_buf;
+    s_drv.flush_cb        = flush_cb;
+    s_drv.draw_ctx_init   = blit_ctx_init;
+    s_drv.draw_ctx_deinit = lv_draw_sw_deinit_ctx;
+    lv_disp_drv_register(&s_drv);
+
+    /* ui_Img of ui_Screen1.c */
+    lv_obj_t *scr = lv_scr_act();
+    lv_obj_set_style_bg_color(scr, lv_color_black(), 0);
+    lv_obj_t *img = lv_img_create(scr);
+    lv_obj_align(img, LV_ALIGN_CENTER, 43, -49);
+    lv_obj_set_style_radius(img, 10, 0);
+    lv_obj_set_style_border_color(img, lv_color_hex(0x282828), 0);
+    lv_obj_set_style_border_width(img, 8, 0);
+
+    uint32_t size8, size4;
+    uint8_t *i8 = encode_indexed(8, &size8);
+    uint8_t *i4 = encode_indexed(4, &size4);
+    CHECK(bench(img, "TRUE_COLOR", LV_IMG_CF_TRUE_COLOR, (const uint8_t *)s_px, sizeof(s_px), runs) == 0);
+    CHECK(bench(img, "INDEXED_8BIT", LV_IMG_CF_INDEXED_8BIT, i8, size8, runs) == 0);
+    CHECK(bench(img, "INDEXED_4BIT", LV_IMG_CF_INDEXED_4BIT, i4, size4, runs) == 0);
+    free(i8);
+    free(i4);
+    printf("{\"test\":\"img_format\",\"ok\":1}\n");
+    return 0;
+}
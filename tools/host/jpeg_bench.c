@@ -0,0 +1,193 @@
+/*
+ * ui_jpeg_decode() on one and two workers.
+ *
+ * For every split JPEG given on the command line, and for the same file with
+ * its strips stacked three times (three times the rows and strips), the
+ * two-worker output must equal the one-worker output, and the stacked image
+ * three copies of the single one. Prints the decode time of both per image,
+ * next to the time ui_asset_read_file() takes to read the file and to read
+ * the decoded frame written out as RAW RGB565, the format it would otherwise
+ * be stored in.
+ *
+ *   jpeg_bench [-n runs] file.sjpg...
+ */
+#include "ui_jpeg.h"
+#include "ui_asset_reader.h"
+#include "esp_timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define SJPG_HEADER_SIZE 22
+
+typedef struct {
+    uint8_t *data;
+    uint32_t size;
+    uint16_t w;
+    uint16_t h;
+    uint16_t strips;
+} sjpg_t;
+
+static uint16_t rd16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | p[1] << 8);
+}
+
+static void wr16(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static bool sjpg_load(const char *path, sjpg_t *out)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) return false;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    rewind(f);
+    out->data = malloc(size);
+    bool ok   = out->data && size > SJPG_HEADER_SIZE && fread(out->data, 1, size, f) == (size_t)size &&
+                memcmp(out->data, "_SJPG__", 8) == 0;
+    fclose(f);
+    if (!ok) return false;
+    out->size   = (uint32_t)size;
+    out->w      = rd16(out->data + 14);
+    out->h      = rd16(out->data + 16);
+    out->strips = rd16(out->data + 18);
+    return true;
+}
+
+/* The strips of `in` repeated `times` times, in a new container */
+static sjpg_t sjpg_stack(const sjpg_t *in, int times)
+{
+    uint32_t table   = (uint32_t)in->strips * 2;
+    uint32_t payload = in->size - SJPG_HEADER_SIZE - table;
+    sjpg_t out       = { .w = in->w, .h = (uint16_t)(in->h * times), .strips = (uint16_t)(in->strips * times) };
+    out.size         = SJPG_HEADER_SIZE + table * times + payload * times;
+    out.data         = malloc(out.size);
+    memcpy(out.data, in->data, SJPG_HEADER_SIZE);
+    wr16(out.data + 16, out.h);
+    wr16(out.data + 18, out.strips);
+    uint8_t *p = out.data + SJPG_HEADER_SIZE;
+    for (int i = 0; i < times; ++i, p += table) memcpy(p, in->data + SJPG_HEADER_SIZE, table);
+    for (int i = 0; i < times; ++i, p += payload) memcpy(p, in->data + SJPG_HEADER_SIZE + table, payload);
+    return out;
+}
+
+static uint32_t median(uint32_t *us, int runs)
+{
+    for (int i = 1; i < runs; ++i) {
+        for (int j = i; j > 0 && us[j - 1] > us[j]; --j) {
+            uint32_t t = us[j];
+            us[j]      = us[j - 1];
+            us[j - 1]  = t;
+        }
+    }
+    return us[runs / 2];
+}
+
+/* Median decode time over `runs` */
+static uint32_t time_decode(const sjpg_t *img, lv_color_t *dst, int workers, int runs, bool *ok)
+{
+    uint32_t *us = calloc(runs, sizeof(*us));
+    for (int i = 0; i < runs; ++i) {
+        int64_t t0 = esp_timer_get_time();
+        *ok &= ui_jpeg_decode(img->data, img->size, img->w, img->h, dst, workers);
+        us[i] = (uint32_t)(esp_timer_get_time() - t0);
+    }
+    uint32_t med = median(us, runs);
+    free(us);
+    return med;
+}
+
+/* Median time over `runs` to read `size` bytes written to a temporary file */
+static uint32_t time_read(const void *data, uint32_t size, int runs, bool *ok)
+{
+    char path[] = "/tmp/jpeg_bench_XXXXXX";
+    int fd      = mkstemp(path);
+    if (fd < 0 || write(fd, data, size) != (ssize_t)size) *ok = false;
+    if (fd >= 0) close(fd);
+
+    uint8_t *buf = malloc(size);
+    uint32_t *us = calloc(runs, sizeof(*us));
+    for (int i = 0; *ok && i < runs; ++i) {
+        int64_t t0 = esp_timer_get_time();
+        *ok &= ui_asset_read_file(path, buf, size);
+        us[i] = (uint32_t)(esp_timer_get_time() - t0);
+        *ok &= memcmp(buf, data, size) == 0;
+    }
+    uint32_t med = median(us, runs);
+    free(us);
+    free(buf);
+    unlink(path);
+    return med;
+}
+
+static bool bench(const char *name, const sjpg_t *img, int runs, const lv_color_t *tile, size_t tile_px)
+{
+    size_t px       = (size_t)img->w * img->h;
+    lv_color_t *one = calloc(px, sizeof(lv_color_t));
+    lv_color_t *two = calloc(px, sizeof(lv_color_t));
+    bool ok         = true;
+
+    uint32_t us1 = time_decode(img, one, 1, runs, &ok);
+    uint32_t us2 = time_decode(img, two, 2, runs, &ok);
+    bool same    = ok && memcmp(one, two, px * sizeof(lv_color_t)) == 0;
+    for (size_t off = 0; same && tile && off < px; off += tile_px) {
+        same = memcmp(one + off, tile, tile_px * sizeof(lv_color_t)) == 0;
+    }
+    uint32_t raw_bytes = (uint32_t)(px * sizeof(lv_color_t));
+    uint32_t read_us   = time_read(img->data, img->size, runs, &ok);
+    uint32_t raw_us    = time_read(one, raw_bytes, runs, &ok);
+
+    printf("{\"bench\":\"jpeg\",\"image\":\"%s\",\"w\":%u,\"h\":%u,\"strips\":%u,\"in_bytes\":%u,"
+           "\"decode_1_us\":%u,\"decode_2_us\":%u,\"speedup\":%.2f,\"read_us\":%u,\"raw_bytes\":%u,"
+           "\"raw_read_us\":%u,\"equal\":%d}\n",
+           name, img->w, img->h, img->strips, (unsigned)img->size, (unsigned)us1, (unsigned)us2,
+           us2 ? (double)us1 / us2 : 0.0, (unsigned)read_us, (unsigned)raw_bytes, (unsigned)raw_us, same);
+    free(one);
+    free(two);
+    return same && ok;
+}
+
+int main(int argc, char **argv)
+{
+    int runs  = 21;
+    int first = 1;
+    if (argc > 2 && strcmp(argv[1], "-n") == 0) {
+        runs  = atoi(argv[2]) > 0 ? atoi(argv[2]) : 1;
+        first = 3;
+    }
+    if (first >= argc) {
+        fprintf(stderr, "usage: %s [-n runs] file.sjpg...\n", argv[0]);
+        return 2;
+    }
+
+    if (!ui_asset_reader_init()) return 1;
+    bool ok = true;
+    for (int i = first; i < argc; ++i) {
+        sjpg_t img;
+        if (!sjpg_load(argv[i], &img)) {
+            fprintf(stderr, "%s: not a split JPEG\n", argv[i]);
+            return 2;
+        }
+        const char *name = strrchr(argv[i], '/') ? strrchr(argv[i], '/') + 1 : argv[i];
+
+        size_t px        = (size_t)img.w * img.h;
+        lv_color_t *ref  = calloc(px, sizeof(lv_color_t));
+        ok &= ui_jpeg_decode(img.data, img.size, img.w, img.h, ref, 1);
+        ok &= bench(name, &img, runs, NULL, 0);
+
+        char stacked[256];
+        snprintf(stacked, sizeof(stacked), "%s x3", name);
+        sjpg_t tall = sjpg_stack(&img, 3);
+        ok &= bench(stacked, &tall, runs, ref, px);
+
+        free(tall.data);
+        free(ref);
+        free(img.data);
+    }
+    return ok ? 0 : 1;
+}
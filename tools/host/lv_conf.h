@@ -0,0 +1,53 @@
+/*
+ * LVGL configuration of the host build: the LVGL settings of sdkconfig.defaults
+ * and the Kconfig defaults of the options added to the vendored LVGL. The
+ * options a test or benchmark compares can be overridden with -D.
+ */
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+#define LV_COLOR_DEPTH     16
+#define LV_COLOR_16_SWAP   0
+/* The Kconfig default for 16 bpp; LV_DRAW_SW_SWAR needs it non-zero */
+#define LV_COLOR_MIX_ROUND_OFS 128
+
+#define LV_MEM_CUSTOM         1
+#define LV_MEM_CUSTOM_INCLUDE "lv_mem_psram.h"
+#define LV_MEMCPY_MEMSET_STD  1
+
+#define LV_DISP_DEF_REFR_PERIOD 100
+#define LV_TICK_CUSTOM          1
+#define LV_TICK_CUSTOM_INCLUDE  "lv_host_tick.h"
+#define LV_TICK_CUSTOM_SYS_TIME_EXPR (lv_host_tick_ms())
+
+#define LV_FONT_MONTSERRAT_12 1
+#define LV_FONT_MONTSERRAT_14 1
+#define LV_FONT_MONTSERRAT_16 1
+#define LV_FONT_MONTSERRAT_18 1
+#define LV_FONT_MONTSERRAT_20 1
+#define LV_FONT_MONTSERRAT_22 1
+#define LV_FONT_MONTSERRAT_24 1
+#define LV_FONT_MONTSERRAT_26 1
+#define LV_FONT_MONTSERRAT_28 1
+#define LV_FONT_MONTSERRAT_30 1
+#define LV_FONT_MONTSERRAT_32 1
+#define LV_FONT_MONTSERRAT_34 1
+#define LV_FONT_FMT_TXT_LARGE 1
+
+#define LV_USE_SJPG 1
+#define LV_USE_DEMO_BENCHMARK 1
+
+#ifndef LV_DRAW_SW_SWAR
+#define LV_DRAW_SW_SWAR 1
+#endif
+#ifndef LV_REFR_OCCLUSION
+#define LV_REFR_OCCLUSION 1
+#endif
+#ifndef LV_FONT_FMT_TXT_A8_CACHE_SIZE
+#define LV_FONT_FMT_TXT_A8_CACHE_SIZE 131072
+#endif
+#ifndef LV_TXT_LAYOUT_CACHE_NUM
+#define LV_TXT_LAYOUT_CACHE_NUM 16
+#endif
+
+#endif /*LV_CONF_H*/
@@ -0,0 +1,11 @@
+#pragma once
+#include <stdint.h>
+#include <time.h>
+
+/* LVGL's tick on the host: CLOCK_MONOTONIC in milliseconds */
+static inline uint32_t lv_host_tick_ms(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint32_t)(t.tv_sec * 1000 + t.tv_nsec / 1000000);
+}
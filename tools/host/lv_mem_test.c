@@ -0,0 +1,176 @@
+/*
+ * components/lv_mem_psram in hybrid mode.
+ *
+ * With LVGL, 20 rounds of building a screen of 150 buttons with labels,
+ * drawing it and deleting it: the objects come from the pools, and after the
+ * first round, which leaves LVGL's caches allocated, each round gives the
+ * pools back what it took.
+ *
+ * Then two million random allocations, frees and reallocations over 4000
+ * slots, mostly small blocks with some large ones: every block keeps its fill
+ * pattern until freed, a reallocation keeps the old bytes, every block served
+ * by the SRAM pools is 16-byte aligned, and once everything is freed the pools
+ * are back to their use before. lv_mem_test_8k runs only this part, without
+ * LVGL, on an 8 KB arena, where small blocks spill to the heap.
+ */
+#include "lv_mem_psram.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if LV_MEM_TEST_LVGL
+#include "lvgl.h"
+#endif
+
+#define SLOTS 4000
+#define OPS   2000000
+
+#define CHECK(c)                                                    \
+    do {                                                            \
+        if (!(c)) {                                                 \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #c); \
+            return 1;                                               \
+        }                                                           \
+    } while (0)
+
+static uint8_t *s_ptr[SLOTS];
+static size_t s_size[SLOTS];
+static uint8_t s_tag[SLOTS];
+
+static bool filled(const uint8_t *p, size_t size, uint8_t tag)
+{
+    for (size_t i = 0; i < size; ++i) {
+        if (p[i] != tag) return false;
+    }
+    return true;
+}
+
+static uint32_t pool_allocs(void)
+{
+    lv_mem_psram_stats_t s;
+    lv_mem_psram_get_stats(&s, false);
+    return s.pool_allocs;
+}
+
+/* Mostly object-sized blocks, one in `large_one_in` up to `large_max` bytes */
+static size_t random_size(int large_one_in, size_t large_max)
+{
+    return rand() % large_one_in == 0 ? 1 + rand() % large_max : 1 + rand() % LV_MEM_PSRAM_SMALL_MAX;
+}
+
+static int stress(void)
+{
+    lv_mem_psram_stats_t s;
+    lv_mem_psram_get_stats(&s, true);
+    size_t start_used = s.pool_used;
+    srand(3);
+    for (long op = 0; op < OPS; ++op) {
+        int i = rand() % SLOTS;
+        if (s_ptr[i] == NULL) {
+            size_t size   = random_size(10, 3000);
+            uint32_t pool = pool_allocs();
+            s_ptr[i]      = lv_mem_custom_alloc(size);
+            CHECK(s_ptr[i] != NULL);
+            CHECK(pool_allocs() == pool || (uintptr_t)s_ptr[i] % 16 == 0);
+            s_size[i] = size;
+            s_tag[i]  = (uint8_t)rand();
+            memset(s_ptr[i], s_tag[i], size);
+            continue;
+        }
+        CHECK(filled(s_ptr[i], s_size[i], s_tag[i]));
+        if (rand() % 3 == 0) {
+            size_t size   = random_size(4, 2000);
+            uint32_t pool = pool_allocs();
+            uint8_t *p    = lv_mem_custom_realloc(s_ptr[i], size);
+            CHECK(p != NULL);
+            CHECK(pool_allocs() == pool || (uintptr_t)p % 16 == 0);
+            CHECK(filled(p, size < s_size[i] ? size : s_size[i], s_tag[i]));
+            s_ptr[i]  = p;
+            s_size[i] = size;
+            memset(p, s_tag[i], size);
+        } else {
+            lv_mem_custom_free(s_ptr[i]);
+            s_ptr[i] = NULL;
+        }
+    }
+    for (int i = 0; i < SLOTS; ++i) {
+        if (s_ptr[i] == NULL) continue;
+        CHECK(filled(s_ptr[i], s_size[i], s_tag[i]));
+        lv_mem_custom_free(s_ptr[i]);
+        s_ptr[i] = NULL;
+    }
+
+    lv_mem_psram_get_stats(&s, true);
+    CHECK(s.pool_size > 0 && s.pool_allocs > 0 && s.pool_used == start_used);
+    printf("{\"test\":\"lv_mem_stress\",\"pool_kb\":%u,\"ops\":%d,\"pool_allocs\":%u,\"heap_allocs\":%u,"
+           "\"spills\":%u,\"pool_peak\":%u,\"ok\":1}\n",
+           (unsigned)(s.pool_size / 1024), OPS, (unsigned)s.pool_allocs, (unsigned)s.psram_allocs, (unsigned)s.spills,
+           (unsigned)s.pool_peak);
+    return 0;
+}
+
+#if LV_MEM_TEST_LVGL
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *px)
+{
+    (void)area;
+    (void)px;
+    lv_disp_flush_ready(drv);
+}
+
+static int buttons(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_color_t buf[800 * 40];
+    static lv_disp_drv_t drv;
+
+    lv_init();
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, 800 * 40);
+    lv_disp_drv_init(&drv);
+    drv.hor_res  = 800;
+    drv.ver_res  = 480;
+    drv.flush_cb = flush_cb;
+    drv.draw_buf = &draw_buf;
+    lv_disp_drv_register(&drv);
+    lv_refr_now(NULL);
+
+    lv_mem_psram_stats_t start, first, s;
+    lv_mem_psram_get_stats(&start, true);
+    for (int round = 0; round < 20; ++round) {
+        lv_obj_t *home = lv_scr_act();
+        lv_obj_t *scr  = lv_obj_create(NULL);
+        for (int i = 0; i < 150; ++i) {
+            lv_obj_t *btn = lv_btn_create(scr);
+            lv_obj_set_style_bg_color(btn, lv_color_hex(i * 1000), 0);
+            lv_obj_set_style_radius(btn, i % 10, 0);
+            lv_obj_set_pos(btn, (i % 10) * 80, (i / 10) * 30);
+            lv_obj_t *label = lv_label_create(btn);
+            lv_label_set_text_fmt(label, "Button %d with some text", i);
+        }
+        lv_scr_load(scr);
+        lv_refr_now(NULL);
+        lv_mem_psram_get_stats(&s, false);
+        CHECK(s.pool_used > start.pool_used + 150 * 2 * 16);
+
+        lv_scr_load(home);
+        lv_obj_del(scr);
+        lv_refr_now(NULL);
+        lv_mem_psram_get_stats(&s, false);
+        /* The first round leaves LVGL's caches allocated */
+        if (round == 0) first = s;
+        CHECK(s.pool_used == first.pool_used);
+    }
+    printf("{\"test\":\"lv_mem_buttons\",\"rounds\":20,\"pool_allocs\":%u,\"heap_allocs\":%u,\"spills\":%u,"
+           "\"pool_peak\":%u,\"ok\":1}\n",
+           (unsigned)s.pool_allocs, (unsigned)s.psram_allocs, (unsigned)s.spills, (unsigned)s.pool_peak);
+    return 0;
+}
+#endif
+
+int main(void)
+{
+    CHECK(strcmp(lv_mem_psram_mode(), "hybrid") == 0);
+#if LV_MEM_TEST_LVGL
+    CHECK(buttons() == 0);
+#endif
+    CHECK(stress() == 0);
+    return 0;
+}
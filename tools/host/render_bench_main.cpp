@@ -0,0 +1,31 @@
+/*
+ * main/render_bench.cpp on the host, set up as app_main() does it: the LVGL
+ * port of main/lvgl_v8_port.cpp on an 800x480 RGB LCD whose frame buffers are
+ * in memory (idf/esp_display_panel.hpp), results on stdout.
+ */
+#include "lvgl_v8_port.h"
+#include "render_bench.h"
+#include "esp_log.h"
+
+extern "C" void uart_host_wait_done(void);
+
+using namespace esp_panel::drivers;
+
+int main(void)
+{
+    // Never deleted, the LVGL task runs until the process exits
+    LCD* lcd     = new LCD(800, 480);
+    Touch* touch = new Touch();
+#if LVGL_PORT_AVOID_TEARING_MODE
+    // The tearing modes render into the LCD frame buffers
+    lcd->configFrameBufferNumber(LVGL_PORT_DISP_BUFFER_NUM);
+#endif
+    if (!lcd->begin() || !lvgl_port_init(lcd, touch) || !lvgl_port_start()) {
+        ESP_LOGE("BENCH", "LVGL init failed");
+        return 1;
+    }
+    render_bench_mem_t port_mem = {};
+    render_bench_start(&port_mem);
+    uart_host_wait_done();
+    return 0;
+}
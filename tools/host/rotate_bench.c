@@ -0,0 +1,159 @@
+/*
+ * main/lvgl_port_rotate.c against the rotation it replaced (rotate_ref.c).
+ *
+ * On full 800x480 frames, lvgl_port_rotate_rgb565() must write exactly what
+ * the ROTATE_90/180/270_ALL_BPP macros and the ROTATE_90/270_OPTIMIZED_16BPP
+ * macros write, at 90, 180 and 270 degrees. On random areas of even and odd
+ * frame sizes, narrow and odd-sized ones included, it must write what the
+ * ALL_BPP macros write and leave every pixel outside the rotated area as it
+ * was. Then the old path and the blocked one are timed on a full frame, a
+ * 200x100 area and a 40x20 area, the median per rotation is printed.
+ *
+ *   rotate_bench [-n runs]
+ */
+#include "lvgl_port_rotate.h"
+#include "esp_timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void ref_rotate_all_bpp(const uint16_t *from, uint16_t *to, int w, int h, int x1, int y1, int x2, int y2, int rotate);
+void ref_rotate_optimized(const uint16_t *from, uint16_t *to, int w, int h, int x1, int y1, int x2, int y2,
+                          int rotate);
+
+typedef void (*rotate_fn_t)(const uint16_t *from, uint16_t *to, int w, int h, int x1, int y1, int x2, int y2,
+                            int rotate);
+
+#define CHECK(c)                                                    \
+    do {                                                            \
+        if (!(c)) {                                                 \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #c); \
+            return 1;                                               \
+        }                                                           \
+    } while (0)
+
+#define W     800
+#define H     480
+#define AREAS 3000
+
+static const int s_rotations[] = { 90, 180, 270 };
+
+static uint16_t s_from[W * H], s_ref[W * H], s_out[W * H];
+
+/* Rotate with `ref` and with lvgl_port_rotate_rgb565() into frames of the same prefill, 0 if they are equal */
+static int compare(rotate_fn_t ref, int w, int h, int x1, int y1, int x2, int y2, int rotate)
+{
+    memset(s_ref, 0x55, sizeof(s_ref));
+    memset(s_out, 0x55, sizeof(s_out));
+    ref(s_from, s_ref, w, h, x1, y1, x2, y2, rotate);
+    lvgl_port_rotate_rgb565(s_from, s_out, w, h, x1, y1, x2, y2, rotate);
+    return memcmp(s_ref, s_out, sizeof(s_ref)) != 0;
+}
+
+static uint32_t check_frames(void)
+{
+    uint32_t bad = 0;
+    for (size_t r = 0; r < 3; ++r) {
+        bad += compare(ref_rotate_all_bpp, W, H, 0, 0, W - 1, H - 1, s_rotations[r]);
+        bad += compare(ref_rotate_optimized, W, H, 0, 0, W - 1, H - 1, s_rotations[r]);
+    }
+    return bad;
+}
+
+static uint32_t check_areas(void)
+{
+    uint32_t bad = 0;
+    srand(1);
+    for (int i = 0; i < AREAS; ++i) {
+        /* Odd frame widths and heights make every other row or column unaligned */
+        int w  = i % 5 == 0 ? W - 1 : W;
+        int h  = i % 7 == 0 ? H - 1 : H;
+        int x1 = rand() % w, x2 = rand() % w;
+        int y1 = rand() % h, y2 = rand() % h;
+        if (x1 > x2) {
+            int t = x1;
+            x1    = x2;
+            x2    = t;
+        }
+        if (y1 > y2) {
+            int t = y1;
+            y1    = y2;
+            y2    = t;
+        }
+        /* One to three columns wide: no whole 2x2 block on some rows */
+        if (i % 3 == 0) {
+            x2 = x1 + rand() % 3;
+            if (x2 >= w) x2 = w - 1;
+        }
+        int rotate = s_rotations[i % 3];
+        if (compare(ref_rotate_all_bpp, w, h, x1, y1, x2, y2, rotate)) {
+            fprintf(stderr, "mismatch: %dx%d frame, (%d, %d)-(%d, %d), %d degrees\n", w, h, x1, y1, x2, y2, rotate);
+            bad++;
+        }
+    }
+    return bad;
+}
+
+/* Median time of one rotation over `runs` */
+static double time_rotate_us(rotate_fn_t fn, int x1, int y1, int x2, int y2, int rotate, int runs)
+{
+    int reps     = (x2 - x1 + 1) * (y2 - y1 + 1) >= W * H / 4 ? 5 : 50;
+    uint32_t *us = calloc(runs, sizeof(*us));
+    for (int i = 0; i < runs; ++i) {
+        int64_t t0 = esp_timer_get_time();
+        for (int k = 0; k < reps; ++k) fn(s_from, s_out, W, H, x1, y1, x2, y2, rotate);
+        us[i] = (uint32_t)(esp_timer_get_time() - t0);
+    }
+    for (int i = 1; i < runs; ++i) {
+        for (int j = i; j > 0 && us[j - 1] > us[j]; --j) {
+            uint32_t t = us[j];
+            us[j]      = us[j - 1];
+            us[j - 1]  = t;
+        }
+    }
+    double med = (double)us[runs / 2] / reps;
+    free(us);
+    return med;
+}
+
+static void bench(int runs)
+{
+    static const struct {
+        const char *name;
+        int x1, y1, x2, y2;
+    } areas[] = {
+        { "full", 0, 0, W - 1, H - 1 },
+        { "200x100", 100, 50, 299, 149 },
+        { "40x20", 300, 200, 339, 219 },
+    };
+    for (size_t a = 0; a < sizeof(areas) / sizeof(areas[0]); ++a) {
+        for (size_t r = 0; r < 3; ++r) {
+            int x1 = areas[a].x1, y1 = areas[a].y1, x2 = areas[a].x2, y2 = areas[a].y2, rotate = s_rotations[r];
+            double all_bpp_us   = time_rotate_us(ref_rotate_all_bpp, x1, y1, x2, y2, rotate, runs);
+            double optimized_us = time_rotate_us(ref_rotate_optimized, x1, y1, x2, y2, rotate, runs);
+            double blocked_us   = time_rotate_us(lvgl_port_rotate_rgb565, x1, y1, x2, y2, rotate, runs);
+            printf("{\"bench\":\"rotate\",\"area\":\"%s\",\"rotate\":%d,\"all_bpp_us\":%.1f,\"optimized_us\":%.1f,"
+                   "\"blocked_us\":%.1f}\n",
+                   areas[a].name, rotate, all_bpp_us, optimized_us, blocked_us);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int runs = 21;
+    if (argc > 2 && strcmp(argv[1], "-n") == 0) {
+        runs = atoi(argv[2]) > 0 ? atoi(argv[2]) : 1;
+    }
+    srand(7);
+    for (int i = 0; i < W * H; ++i) s_from[i] = (uint16_t)rand();
+
+    uint32_t frame_bad = check_frames();
+    CHECK(frame_bad == 0);
+    uint32_t area_bad = check_areas();
+    CHECK(area_bad == 0);
+
+    bench(runs);
+    printf("{\"test\":\"rotate\",\"frames\":6,\"areas\":%d,\"ok\":1}\n", AREAS);
+    return 0;
+}
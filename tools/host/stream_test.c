@@ -0,0 +1,140 @@
+/*
+ * components/ui/ui_img_stream.c as registered by the UI.
+ *
+ * A catalog photo (TRUE_COLOR) and the arrow icon (ALPHA_2BIT) whose
+ * descriptors hold a stream tag and the UI_IMG_STREAM_RESERVED mark must draw
+ * the same frame as the files read into memory. A 2x2 image, smaller than a
+ * tag but starting with its magic, whose pixels end right before an unmapped
+ * page must draw without the decoder reading past them, and a tag in a
+ * descriptor without the mark must not be streamed.
+ */
+#include "ui_img_stream.h"
+#include "ui_img_manager.h"
+#include "ui_asset_reader.h"
+#include "lvgl.h"
+#include "esp_heap_caps.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define W    800
+#define H    480
+#define ROWS 20
+
+#define CHECK(c)                                                    \
+    do {                                                            \
+        if (!(c)) {                                                 \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #c); \
+            return 1;                                               \
+        }                                                           \
+    } while (0)
+
+static lv_color_t s_fb[W * H];
+static lv_color_t s_ref[W * H];
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *px)
+{
+    int32_t w = lv_area_get_width(area);
+    for (int32_t y = area->y1; y <= area->y2; ++y, px += w) {
+        memcpy(&s_fb[y * W + area->x1], px, w * sizeof(lv_color_t));
+    }
+    lv_disp_flush_ready(drv);
+}
+
+/* Draw the screen with `dsc` in the image and return the number of stream opens it took */
+static uint32_t draw(lv_obj_t *img, const lv_img_dsc_t *dsc)
+{
+    ui_img_stream_stats_t s;
+    ui_img_stream_reset_stats();
+    lv_img_cache_invalidate_src(NULL);
+    lv_img_set_src(img, dsc);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    ui_img_stream_get_stats(&s);
+    return s.opens;
+}
+
+static int check_file(lv_obj_t *img, const char *path_S, uint32_t size, uint16_t w, uint16_t h, lv_img_cf_t cf)
+{
+    lv_img_dsc_t dsc = { .header = { .cf = cf, .w = w, .h = h }, .data_size = size };
+
+    dsc.data = _ui_load_binary_direct(path_S, size);
+    CHECK(dsc.data != NULL);
+    CHECK(draw(img, &dsc) == 0);
+    memcpy(s_ref, s_fb, sizeof(s_fb));
+    heap_caps_free((void *)dsc.data);
+
+    dsc.header.reserved = UI_IMG_STREAM_RESERVED;
+    dsc.data            = _ui_load_binary_stream(path_S, size);
+    CHECK(dsc.data != NULL);
+    CHECK(draw(img, &dsc) > 0);
+    CHECK(memcmp(s_fb, s_ref, sizeof(s_fb)) == 0);
+
+    /* The same tag without the mark is left to LVGL: only asked for its info, never opened by the stream */
+    dsc.header.reserved = 0;
+    lv_img_decoder_dsc_t dec;
+    ui_img_stream_stats_t s;
+    ui_img_stream_reset_stats();
+    lv_img_cache_invalidate_src(NULL);
+    if (lv_img_decoder_open(&dec, &dsc, lv_color_black(), 0) == LV_RES_OK) lv_img_decoder_close(&dec);
+    ui_img_stream_get_stats(&s);
+    CHECK(s.opens == 0);
+    lv_img_set_src(img, NULL);
+    heap_caps_free((void *)dsc.data);
+    return 0;
+}
+
+/*
+ * A 2x2 image at the very end of a mapping, smaller than a tag, whose pixels
+ * start like one: any read past its 8 bytes faults
+ */
+static int check_tiny(lv_obj_t *img)
+{
+    long page    = sysconf(_SC_PAGESIZE);
+    uint8_t *map = mmap(NULL, 2 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    CHECK(map != MAP_FAILED);
+    CHECK(mprotect(map + page, page, PROT_NONE) == 0);
+    lv_color_t *px = (lv_color_t *)(map + page - 4 * sizeof(lv_color_t));
+    const uint32_t magic = UI_IMG_STREAM_MAGIC;
+    memcpy(px, &magic, sizeof(magic));
+    px[2].full = px[3].full = 0xF800;
+
+    lv_img_dsc_t dsc = { .header = { .cf = LV_IMG_CF_TRUE_COLOR, .w = 2, .h = 2 },
+                         .data_size = 4 * sizeof(lv_color_t), .data = (const uint8_t *)px };
+    CHECK(draw(img, &dsc) == 0);
+    lv_area_t a;
+    lv_obj_get_content_coords(img, &a);
+    CHECK(s_fb[a.y1 * W + a.x1].full == px[0].full && s_fb[a.y2 * W + a.x2].full == 0xF800);
+    lv_img_set_src(img, NULL);
+    munmap(map, 2 * page);
+    return 0;
+}
+
+int main(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_color_t buf[W * ROWS];
+    static lv_disp_drv_t drv;
+
+    lv_init();
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, W * ROWS);
+    lv_disp_drv_init(&drv);
+    drv.hor_res  = W;
+    drv.ver_res  = H;
+    drv.flush_cb = flush_cb;
+    drv.draw_buf = &draw_buf;
+    lv_disp_drv_register(&drv);
+    CHECK(ui_asset_reader_init());
+    ui_img_stream_init();
+
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_hex(0x3060A0), 0);
+    lv_obj_t *img = lv_img_create(lv_scr_act());
+    lv_obj_align(img, LV_ALIGN_CENTER, 43, -49);
+
+    CHECK(check_tiny(img) == 0);
+    CHECK(check_file(img, "S:assets/ui_img_02_png.bin", 578 * 339 * 2, 578, 339, LV_IMG_CF_TRUE_COLOR) == 0);
+    CHECK(check_file(img, "S:assets/ui_img_1049104300.bin", 770, 55, 55, LV_IMG_CF_ALPHA_2BIT) == 0);
+    printf("{\"test\":\"img_stream\",\"ok\":1}\n");
+    return 0;
+}
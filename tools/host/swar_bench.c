@@ -0,0 +1,269 @@
+/*
+ * The LV_DRAW_SW_SWAR kernels of lv_draw_sw_blend.c against stock LVGL.
+ *
+ * swar_mix(), swar_mix2(), swar_mix2_premult() and blend_mix() must equal
+ * lv_color_mix() and lv_color_mix_premult() for every pair of channel values
+ * at every opacity. The whole blend, SWAR against the same file built without
+ * it (blend_ref.c), must leave the same pixels for fills and images, with and
+ * without opacity, without a mask, with a fully covering one and with random
+ * ones, in the three blend modes and at odd sizes and offsets. Then both are
+ * timed on an 800x20 draw buffer band, the median per blend is printed.
+ *
+ *   swar_bench [-n runs]
+ */
+#define lv_draw_sw_blend       swar_draw_sw_blend
+#define lv_draw_sw_blend_basic swar_draw_sw_blend_basic
+#include "src/draw/sw/lv_draw_sw_blend.c"
+#undef lv_draw_sw_blend
+#undef lv_draw_sw_blend_basic
+
+#include "lvgl.h"
+#include "esp_timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !BLEND_SWAR
+#error "swar_bench needs LV_DRAW_SW_SWAR with 16-bit, unswapped colors"
+#endif
+
+void ref_draw_sw_blend_basic(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc);
+
+typedef void (*blend_fn_t)(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc);
+
+#define CHECK(c)                                                    \
+    do {                                                            \
+        if (!(c)) {                                                 \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #c); \
+            return 1;                                               \
+        }                                                           \
+    } while (0)
+
+#define BW 173
+#define BH 37
+#define BAND_W 800
+#define BAND_H 20
+
+static lv_color_t s_bg[BW * BH], s_src[BW * BH], s_ref[BW * BH], s_out[BW * BH];
+static lv_opa_t s_mask[BW * BH + 3], s_mask_copy[BW * BH + 3];
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *px)
+{
+    (void)area;
+    (void)px;
+    lv_disp_flush_ready(drv);
+}
+
+/* The blend reads the refreshing display's driver (set_px_cb, screen_transp) */
+static void disp_init(void)
+{
+    static lv_color_t buf[BAND_W * 10];
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t drv;
+    lv_init();
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, BAND_W * 10);
+    lv_disp_drv_init(&drv);
+    drv.hor_res  = BAND_W;
+    drv.ver_res  = 480;
+    drv.draw_buf = &draw_buf;
+    drv.flush_cb = flush_cb;
+    _lv_refr_set_disp_refreshing(lv_disp_drv_register(&drv));
+}
+
+/* 64 distinct values in every channel: red and green a, blue reversed */
+static uint16_t chan(uint32_t a)
+{
+    return (uint16_t)(((a & 31) << 11) | (a << 5) | (31 - (a & 31)));
+}
+
+static uint16_t mix_ref(uint16_t fg, uint16_t bg, uint8_t mix)
+{
+    lv_color_t c1 = { .full = fg }, c2 = { .full = bg };
+    return lv_color_mix(c1, c2, mix).full;
+}
+
+/* Every fg/bg channel pair at every opacity. Returns the number of wrong pixels. */
+static uint32_t check_kernels(void)
+{
+    uint32_t bad = 0;
+    for (uint32_t mix = 0; mix < 256; ++mix) {
+        uint32_t inv = 255 - mix;
+        for (uint32_t a = 0; a < 64; ++a) {
+            uint16_t fg = chan(a), fg1 = chan(63 - a);
+            lv_color_t c = { .full = fg };
+            uint16_t premult[3];
+            lv_color_premult(c, (uint8_t)mix, premult);
+            uint32_t premult_rb = swar_rb(fg) * mix + SWAR_ROUND_OFS;
+            uint32_t premult_g2 = ((fg >> 5) & 0x3F) * mix * 0x00010001U + SWAR_ROUND_OFS;
+            for (uint32_t b = 0; b < 64; ++b) {
+                uint16_t bg = chan(b), bg1 = chan(b ^ 21);
+                uint16_t want = mix_ref(fg, bg, (uint8_t)mix), want1 = mix_ref(fg1, bg1, (uint8_t)mix);
+                lv_color_t bgc = { .full = bg }, bgc1 = { .full = bg1 };
+                lv_color_t fgc = { .full = fg };
+
+                bad += (uint16_t)swar_mix(fg, bg, mix, inv) != want;
+                bad += blend_mix(fgc, bgc, (lv_opa_t)mix).full != want;
+
+                uint32_t two = swar_mix2(fg | (uint32_t)fg1 << 16, bg | (uint32_t)bg1 << 16, mix, inv);
+                bad += (uint16_t)two != want;
+                bad += (uint16_t)(two >> 16) != want1;
+
+                two = swar_mix2_premult(premult_rb, premult_g2, bg | (uint32_t)bg1 << 16, inv);
+                bad += (uint16_t)two != lv_color_mix_premult(premult, bgc, (uint8_t)inv).full;
+                bad += (uint16_t)(two >> 16) != lv_color_mix_premult(premult, bgc1, (uint8_t)inv).full;
+            }
+        }
+    }
+    return bad;
+}
+
+static void blend(blend_fn_t fn, lv_color_t *dest, const lv_area_t *buf_area, const lv_draw_sw_blend_dsc_t *dsc)
+{
+    lv_draw_sw_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.base_draw.buf       = dest;
+    ctx.base_draw.buf_area  = (lv_area_t *)buf_area;
+    ctx.base_draw.clip_area = buf_area;
+    fn((lv_draw_ctx_t *)&ctx, dsc);
+}
+
+/*
+ * Every branch of fill_normal() and map_normal(), and the blend modes on top
+ * of blend_mix(), on random areas of a BWxBH buffer. Returns the number of
+ * blends that left other pixels than the reference.
+ */
+static uint32_t check_blends(uint32_t *cases)
+{
+    static const lv_opa_t opas[] = { 255, 254, 253, 200, 128, 127, 64, 3, 1 };
+    static const lv_blend_mode_t modes[] = { LV_BLEND_MODE_NORMAL, LV_BLEND_MODE_ADDITIVE,
+                                             LV_BLEND_MODE_SUBTRACTIVE };
+    const lv_area_t buf_area = { 0, 0, BW - 1, BH - 1 };
+    uint32_t bad = 0;
+
+    srand(7);
+    for (int bg_kind = 0; bg_kind < 3; ++bg_kind)           /* Uniform, random, stripes */
+    for (int use_src = 0; use_src < 2; ++use_src)           /* Fill, image */
+    for (int mask_kind = 0; mask_kind < 4; ++mask_kind)     /* None, cover, random, runs of 0 and 255 */
+    for (size_t o = 0; o < sizeof(opas) / sizeof(opas[0]); ++o)
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); ++m)
+    for (int rep = 0; rep < 6; ++rep) {
+        for (int i = 0; i < BW * BH; ++i) {
+            s_bg[i].full  = bg_kind == 0 ? 0x7bcf : bg_kind == 1 ? (uint16_t)rand() : ((i / 3) & 1 ? 0xffff : 0x1234);
+            s_src[i].full = (uint16_t)rand();
+            int r         = rand() & 255;
+            s_mask[i + rep % 4] = mask_kind == 1 ? 255 : mask_kind == 2 ? r : (r < 80 ? 0 : r < 160 ? 255 : r);
+        }
+        memcpy(s_ref, s_bg, sizeof(s_bg));
+        memcpy(s_out, s_bg, sizeof(s_bg));
+
+        /* Odd widths and heights, and masks starting off a word boundary */
+        lv_area_t area = { rand() % 20, rand() % 10, 0, 0 };
+        area.x2        = area.x1 + rand() % (BW - area.x1);
+        area.y2        = area.y1 + rand() % (BH - area.y1);
+
+        lv_draw_sw_blend_dsc_t dsc;
+        memset(&dsc, 0, sizeof(dsc));
+        dsc.blend_area = &area;
+        dsc.mask_area  = &area;
+        dsc.opa        = opas[o];
+        dsc.color.full = (uint16_t)rand();
+        dsc.blend_mode = modes[m];
+        dsc.src_buf    = use_src ? s_src : NULL;
+        dsc.mask_res   = mask_kind ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
+
+        /* The blend may change the mask, each side gets its own copy */
+        memcpy(s_mask_copy, s_mask, sizeof(s_mask));
+        dsc.mask_buf = mask_kind ? s_mask + rep % 4 : NULL;
+        blend(ref_draw_sw_blend_basic, s_ref, &buf_area, &dsc);
+        dsc.mask_buf = mask_kind ? s_mask_copy + rep % 4 : NULL;
+        blend(swar_draw_sw_blend_basic, s_out, &buf_area, &dsc);
+
+        ++*cases;
+        bad += memcmp(s_ref, s_out, sizeof(s_ref)) != 0;
+    }
+    return bad;
+}
+
+/* Median time of one blend over `runs` */
+static uint32_t time_blend(blend_fn_t fn, lv_color_t *band, const lv_draw_sw_blend_dsc_t *dsc, int runs)
+{
+    const lv_area_t band_area = { 0, 0, BAND_W - 1, BAND_H - 1 };
+    uint32_t *us              = calloc(runs, sizeof(*us));
+    for (int i = 0; i < runs; ++i) {
+        /* Change the background so the fill's last-result cache doesn't skip the work */
+        for (int p = 0; p < BAND_W * BAND_H; p += 97) band[p].full ^= 0x0841;
+        int64_t t0 = esp_timer_get_time();
+        for (int k = 0; k < 10; ++k) blend(fn, band, &band_area, dsc);
+        us[i] = (uint32_t)(esp_timer_get_time() - t0);
+    }
+    for (int i = 1; i < runs; ++i) {
+        for (int j = i; j > 0 && us[j - 1] > us[j]; --j) {
+            uint32_t t = us[j];
+            us[j]      = us[j - 1];
+            us[j - 1]  = t;
+        }
+    }
+    uint32_t med = us[runs / 2];
+    free(us);
+    return med;
+}
+
+static void bench(int runs)
+{
+    static const struct {
+        const char *name;
+        bool src;
+        bool mask;
+        lv_opa_t opa;
+    } cases[] = {
+        { "fill_opa", false, false, 128 }, { "fill_mask", false, true, 255 }, { "fill_mask_opa", false, true, 128 },
+        { "map_opa", true, false, 128 },   { "map_mask", true, true, 255 },   { "map_mask_opa", true, true, 128 },
+    };
+    static lv_color_t band[BAND_W * BAND_H], src[BAND_W * BAND_H];
+    static lv_opa_t mask[BAND_W * BAND_H];
+    const lv_area_t band_area = { 0, 0, BAND_W - 1, BAND_H - 1 };
+
+    srand(1);
+    for (int i = 0; i < BAND_W * BAND_H; ++i) {
+        band[i].full = (uint16_t)rand();
+        src[i].full  = (uint16_t)rand();
+        mask[i]      = (lv_opa_t)(rand() | 1);
+    }
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+        lv_draw_sw_blend_dsc_t dsc;
+        memset(&dsc, 0, sizeof(dsc));
+        dsc.blend_area = &band_area;
+        dsc.mask_area  = &band_area;
+        dsc.color.full = 0x1234;
+        dsc.opa        = cases[c].opa;
+        dsc.src_buf    = cases[c].src ? src : NULL;
+        dsc.mask_buf   = cases[c].mask ? mask : NULL;
+        dsc.mask_res   = cases[c].mask ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
+
+        uint32_t ref_us  = time_blend(ref_draw_sw_blend_basic, band, &dsc, runs);
+        uint32_t swar_us = time_blend(swar_draw_sw_blend_basic, band, &dsc, runs);
+        printf("{\"bench\":\"swar\",\"case\":\"%s\",\"w\":%d,\"h\":%d,\"ref_us\":%.1f,\"swar_us\":%.1f,"
+               "\"speedup\":%.2f}\n",
+               cases[c].name, BAND_W, BAND_H, ref_us / 10.0, swar_us / 10.0,
+               swar_us ? (double)ref_us / swar_us : 0.0);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int runs = 21;
+    if (argc > 2 && strcmp(argv[1], "-n") == 0) {
+        runs = atoi(argv[2]) > 0 ? atoi(argv[2]) : 1;
+    }
+    disp_init();
+
+    uint32_t kernel_bad = check_kernels();
+    CHECK(kernel_bad == 0);
+    uint32_t cases     = 0;
+    uint32_t blend_bad = check_blends(&cases);
+    CHECK(blend_bad == 0);
+
+    bench(runs);
+    printf("{\"test\":\"swar\",\"kernel_mixes\":%u,\"blends\":%u,\"ok\":1}\n", 256u * 64 * 64, (unsigned)cases);
+    return 0;
+}
@@ -0,0 +1,151 @@
+/*
+ * main/lvgl_port_touch.c on the FreeRTOS emulation, against a fake
+ * controller whose point the test sets before raising INT with
+ * lvgl_port_touch_irq(). A press reported before the task started is queued,
+ * unchanged reads and bus errors queue nothing, a release is queued where the
+ * finger left, samples carry the time of their INT edge, a full ring drops
+ * the oldest samples and keeps the newest, and without INT the task polls.
+ */
+#include "lvgl_port_touch.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include <pthread.h>
+#include <stdio.h>
+
+#define CHECK(c)                                                    \
+    do {                                                            \
+        if (!(c)) {                                                 \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #c); \
+            return 1;                                               \
+        }                                                           \
+    } while (0)
+
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static int s_ret; /* What the next read returns: > 0 pressed, 0 released, < 0 bus error */
+static int16_t s_x, s_y;
+static uint32_t s_ready;
+
+static int fake_read(void *ctx, int16_t *x, int16_t *y)
+{
+    (void)ctx;
+    pthread_mutex_lock(&s_lock);
+    int ret = s_ret;
+    /* A released controller reports no coordinates */
+    *x = ret > 0 ? s_x : 0;
+    *y = ret > 0 ? s_y : 0;
+    pthread_mutex_unlock(&s_lock);
+    return ret;
+}
+
+static void fake_ready(void)
+{
+    __atomic_fetch_add(&s_ready, 1, __ATOMIC_RELAXED);
+}
+
+static void fake_set(int ret, int16_t x, int16_t y)
+{
+    pthread_mutex_lock(&s_lock);
+    s_ret = ret;
+    s_x   = x;
+    s_y   = y;
+    pthread_mutex_unlock(&s_lock);
+}
+
+static lvgl_port_touch_stats_t stats(void)
+{
+    lvgl_port_touch_stats_t s;
+    lvgl_port_touch_get_stats(&s, false);
+    return s;
+}
+
+/* Wait up to a second for the task to have queued `samples` samples in all */
+static bool wait_samples(uint32_t samples)
+{
+    for (int i = 0; i < 1000 && stats().samples < samples; ++i) vTaskDelay(1);
+    return stats().samples >= samples;
+}
+
+/* Wait up to a second for the task to have read the controller `reads` times in all */
+static bool wait_reads(uint32_t reads)
+{
+    for (int i = 0; i < 1000 && stats().reads < reads; ++i) vTaskDelay(1);
+    return stats().reads >= reads;
+}
+
+static lvgl_port_touch_config_t config(bool irq, uint32_t poll_ms)
+{
+    return (lvgl_port_touch_config_t){
+        .read          = fake_read,
+        .ready         = fake_ready,
+        .irq           = irq,
+        .poll_ms       = poll_ms,
+        .task_stack    = 4096,
+        .task_priority = 5,
+        .task_core     = -1,
+    };
+}
+
+int main(void)
+{
+    lvgl_port_touch_sample_t s;
+
+    /* Pressed, and INT raised, before the task exists */
+    fake_set(1, 10, 20);
+    lvgl_port_touch_irq();
+    lvgl_port_touch_config_t cfg = config(true, 1000);
+    CHECK(lvgl_port_touch_init(&cfg));
+    CHECK(wait_samples(1));
+    CHECK(lvgl_port_touch_pop(&s) && s.pressed && s.x == 10 && s.y == 20);
+
+    /* The same point again, and a bus error: read, nothing queued */
+    uint32_t reads = stats().reads;
+    lvgl_port_touch_irq();
+    CHECK(wait_reads(reads + 1));
+    fake_set(-1, 0, 0);
+    lvgl_port_touch_irq();
+    CHECK(wait_reads(reads + 2));
+    CHECK(lvgl_port_touch_pending() == 0 && stats().samples == 1 && stats().errors == 1);
+
+    /* A move, stamped with its INT edge, then the release where the finger left */
+    fake_set(1, 11, 21);
+    int64_t before = esp_timer_get_time();
+    lvgl_port_touch_irq();
+    int64_t after = esp_timer_get_time();
+    CHECK(wait_samples(2));
+    CHECK(lvgl_port_touch_pop(&s) && s.pressed && s.x == 11 && s.y == 21);
+    CHECK(s.time_us >= before && s.time_us <= after);
+    fake_set(0, 0, 0);
+    lvgl_port_touch_irq();
+    CHECK(wait_samples(3));
+    CHECK(lvgl_port_touch_pop(&s) && !s.pressed && s.x == 11 && s.y == 21);
+
+    /* LVGL stalls for 20 moves: the ring keeps the newest 16 */
+    for (int i = 0; i < 20; ++i) {
+        fake_set(1, (int16_t)(100 + i), (int16_t)(200 + i));
+        lvgl_port_touch_irq();
+        CHECK(wait_samples(4 + i));
+    }
+    CHECK(lvgl_port_touch_pending() == LVGL_PORT_TOUCH_RING_SIZE);
+    CHECK(stats().dropped == 20 - LVGL_PORT_TOUCH_RING_SIZE);
+    for (int i = 20 - LVGL_PORT_TOUCH_RING_SIZE; i < 20; ++i) {
+        CHECK(lvgl_port_touch_pop(&s) && s.pressed && s.x == 100 + i && s.y == 200 + i);
+    }
+    CHECK(!lvgl_port_touch_pop(&s));
+    CHECK(s_ready == stats().samples);
+    lvgl_port_touch_deinit();
+
+    /* Without INT the task finds the release by itself */
+    cfg = config(false, 5);
+    CHECK(lvgl_port_touch_init(&cfg));
+    CHECK(wait_samples(1));
+    CHECK(lvgl_port_touch_pop(&s) && s.pressed && s.x == 119 && s.y == 219);
+    fake_set(0, 0, 0);
+    CHECK(wait_samples(2));
+    CHECK(lvgl_port_touch_pop(&s) && !s.pressed && s.x == 119 && s.y == 219);
+    CHECK(stats().irqs == 0);
+    lvgl_port_touch_deinit();
+
+    printf("{\"test\":\"touch\",\"ok\":1}\n");
+    return 0;
+}
@@ -0,0 +1,209 @@
+/*
+ * main/lvgl_port_trace.c replaying hand-written stamp sequences.
+ *
+ * Interactions with a flush on the LVGL task, with a flush task whose last
+ * flush comes after the refresh timer returns or before it, and with a late
+ * flush of the previous frame, before or after the next frame is rendered,
+ * which must not be taken for the next frame's. A VSYNC gives the photon
+ * stamp. Inputs that draw nothing are counted by lvgl_port_trace_idle(),
+ * interactions pushed out by newer ones or stuck for over a second are
+ * abandoned. Every value from 0 to 4096 us and a geometric
+ * sweep up to 2^20 us must land in a bucket whose top is above it and at most
+ * a quarter (or 16 us) higher, and the report line must be well formed and
+ * truncated safely.
+ */
+#include "lvgl_port_trace.h"
+#include <stdio.h>
+#include <string.h>
+
+#define CHECK(c)                                                    \
+    do {                                                            \
+        if (!(c)) {                                                 \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #c); \
+            return 1;                                               \
+        }                                                           \
+    } while (0)
+
+#define HUGE_US (1 << 21)
+
+static lvgl_port_trace_stats_t s_stats;
+
+static const lvgl_port_trace_stats_t *stats(void)
+{
+    lvgl_port_trace_get_stats(&s_stats, true);
+    return &s_stats;
+}
+
+/* Touch at `t`, dispatched and invalid at the same time */
+static void press(int64_t t)
+{
+    lvgl_port_trace_input(t);
+    lvgl_port_trace_dispatch(t);
+    lvgl_port_trace_invalid(t);
+}
+
+static int check_sync_flush(void)
+{
+    lvgl_port_trace_init(false, false);
+    press(1000);
+    lvgl_port_trace_rendered(5000, 1);
+    const lvgl_port_trace_stats_t *s = stats();
+    CHECK(s->completed == 1 && s->hist[LVGL_PORT_TRACE_H_TOTAL].max_us == 4000);
+    CHECK(s->worst.stamp_us[LVGL_PORT_TRACE_FLUSHED] == 5000 && s->worst.stamp_us[LVGL_PORT_TRACE_PHOTON] == 5000);
+    return 0;
+}
+
+static int check_flush_task(void)
+{
+    lvgl_port_trace_init(true, true);
+
+    /* In order: rendered, flushed, VSYNC */
+    press(1000);
+    lvgl_port_trace_rendered(5000, 1);
+    lvgl_port_trace_flushed(6000, 1);
+    CHECK(stats()->completed == 0);
+    lvgl_port_trace_vsync(7000);
+    const lvgl_port_trace_stats_t *s = stats();
+    CHECK(s->completed == 1 && s->hist[LVGL_PORT_TRACE_H_FLUSH].max_us == 1000);
+    CHECK(s->hist[LVGL_PORT_TRACE_H_SCANOUT].max_us == 1000 && s->hist[LVGL_PORT_TRACE_H_TOTAL].max_us == 6000);
+
+    /* The flush task is done with the last area before the refresh timer returns */
+    press(10000);
+    lvgl_port_trace_flushed(13000, 2);
+    lvgl_port_trace_rendered(14000, 2);
+    lvgl_port_trace_vsync(15000);
+    s = stats();
+    CHECK(s->completed == 1 && s->abandoned == 0);
+    CHECK(s->worst.stamp_us[LVGL_PORT_TRACE_RENDERED] == 13000 && s->worst.stamp_us[LVGL_PORT_TRACE_FLUSHED] == 13000);
+    CHECK(s->hist[LVGL_PORT_TRACE_H_RENDER].max_us == 3000 && s->hist[LVGL_PORT_TRACE_H_SCANOUT].max_us == 2000);
+
+    /* Frame 3's last flush lands after an input was invalidated for frame 4 */
+    press(20000);
+    lvgl_port_trace_rendered(21000, 3);
+    press(21500);
+    lvgl_port_trace_flushed(22000, 3);
+    lvgl_port_trace_rendered(25000, 4);
+    lvgl_port_trace_vsync(26000);
+    s = stats();
+    CHECK(s->completed == 1 && s->worst.stamp_us[LVGL_PORT_TRACE_TOUCH] == 20000);
+    lvgl_port_trace_flushed(27000, 4);
+    lvgl_port_trace_vsync(28000);
+    s = stats();
+    CHECK(s->completed == 1 && s->worst.stamp_us[LVGL_PORT_TRACE_TOUCH] == 21500);
+    CHECK(s->worst.stamp_us[LVGL_PORT_TRACE_RENDERED] == 25000 && s->worst.stamp_us[LVGL_PORT_TRACE_FLUSHED] == 27000);
+
+    /* Frame 5's last flush lands after frame 6 was rendered */
+    press(30000);
+    lvgl_port_trace_rendered(31000, 5);
+    press(31500);
+    lvgl_port_trace_rendered(33000, 6);
+    lvgl_port_trace_flushed(34000, 5);
+    lvgl_port_trace_vsync(35000);
+    s = stats();
+    CHECK(s->completed == 1 && s->worst.stamp_us[LVGL_PORT_TRACE_TOUCH] == 30000);
+    lvgl_port_trace_flushed(36000, 6);
+    lvgl_port_trace_vsync(37000);
+    s = stats();
+    CHECK(s->completed == 1 && s->worst.stamp_us[LVGL_PORT_TRACE_FLUSHED] == 36000);
+    return 0;
+}
+
+static int check_idle_and_abandoned(void)
+{
+    lvgl_port_trace_init(false, false);
+
+    /* Dispatched, nothing invalidated */
+    lvgl_port_trace_input(1000);
+    lvgl_port_trace_dispatch(1100);
+    lvgl_port_trace_idle();
+    lvgl_port_trace_rendered(2000, 1);
+    const lvgl_port_trace_stats_t *s = stats();
+    CHECK(s->no_redraw == 1 && s->completed == 0);
+
+    /* One more in flight than there are slots: the oldest is pushed out */
+    for (int i = 0; i <= LVGL_PORT_TRACE_SLOTS; ++i) lvgl_port_trace_input(3000 + i);
+    lvgl_port_trace_dispatch(4000);
+    lvgl_port_trace_invalid(4000);
+    lvgl_port_trace_rendered(5000, 2);
+    s = stats();
+    CHECK(s->abandoned == 1 && s->completed == LVGL_PORT_TRACE_SLOTS);
+    CHECK(s->hist[LVGL_PORT_TRACE_H_TOTAL].max_us == 5000 - 3001);
+
+    /* Stuck without a refresh for over a second */
+    press(10000);
+    lvgl_port_trace_input(10000 + 1000001);
+    s = stats();
+    CHECK(s->abandoned == 1 && s->completed == 0);
+    return 0;
+}
+
+/* Bucket top of `us`: the p50 of `us` and a much larger value */
+static uint32_t bucket_top_of(uint32_t us)
+{
+    lvgl_port_trace_init(false, false);
+    press(0);
+    lvgl_port_trace_rendered(us, 1);
+    press(0);
+    lvgl_port_trace_rendered(HUGE_US, 2);
+    return lvgl_port_trace_percentile(&stats()->hist[LVGL_PORT_TRACE_H_TOTAL], 500);
+}
+
+static int check_buckets(void)
+{
+    for (uint32_t us = 0; us < (1 << 20); us = (us < 4096) ? us + 1 : us + us / 7) {
+        uint32_t top   = bucket_top_of(us);
+        uint32_t slack = (us / 4 > 16) ? us / 4 : 16;
+        if ((top <= us) || (top > us + slack)) {
+            fprintf(stderr, "%u us: bucket top %u\n", (unsigned)us, (unsigned)top);
+            return 1;
+        }
+    }
+
+    /* Past ~1 s everything shares the last bucket, reported as the max */
+    CHECK(bucket_top_of(HUGE_US - 1) == HUGE_US);
+
+    lvgl_port_trace_histogram_t h;
+    memset(&h, 0, sizeof(h));
+    CHECK(lvgl_port_trace_percentile(&h, 500) == 0);
+    h.count      = 100;
+    h.max_us     = 40;
+    h.buckets[0] = 90;
+    h.buckets[2] = 10;
+    CHECK(lvgl_port_trace_percentile(&h, 900) == 16);
+    CHECK(lvgl_port_trace_percentile(&h, 901) == 40);
+    CHECK(lvgl_port_trace_percentile(&h, 1000) == 40);
+    return 0;
+}
+
+static int check_format(void)
+{
+    lvgl_port_trace_init(true, false);
+    press(1000);
+    lvgl_port_trace_rendered(5000, 1);
+    lvgl_port_trace_flushed(7000, 1);
+    const lvgl_port_trace_stats_t *s = stats();
+
+    char line[512];
+    size_t len = lvgl_port_trace_format(s, line, sizeof(line));
+    CHECK(len == strlen(line) && len > 2 && line[len - 1] == '\n' && line[len - 2] == '}');
+    CHECK(strstr(line, "\"n\":1,") != NULL && strstr(line, "\"total_ms\":[6.0,6.0,6.0,6.0]") != NULL);
+    CHECK(strstr(line, "\"worst\":{\"id\":1,\"dispatch_ms\":0.0,\"handle_ms\":0.0,\"render_ms\":4.0,"
+                       "\"flush_ms\":2.0,\"scanout_ms\":0.0,\"total_ms\":6.0}") != NULL);
+
+    char small[40];
+    memset(small, 'x', sizeof(small));
+    len = lvgl_port_trace_format(s, small, sizeof(small));
+    CHECK(len == sizeof(small) - 1 && small[len] == '\0');
+    return 0;
+}
+
+int main(void)
+{
+    CHECK(check_sync_flush() == 0);
+    CHECK(check_flush_task() == 0);
+    CHECK(check_idle_and_abandoned() == 0);
+    CHECK(check_buckets() == 0);
+    CHECK(check_format() == 0);
+    printf("{\"test\":\"trace\",\"ok\":1}\n");
+    return 0;
+}
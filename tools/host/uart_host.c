@@ -0,0 +1,54 @@
+/*
+ * UART1 of the render benchmark on the host: results go to stdout, and
+ * uart_host_wait_done() returns once the benchmark has written its last line.
+ */
+#include "uart.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <stdio.h>
+#include <string.h>
+
+#define DONE_LINE "{\"bench\":\"done\"}"
+
+static SemaphoreHandle_t s_done;
+
+int uart_init()
+{
+    if (!s_done) s_done = xSemaphoreCreateBinary();
+    return 0;
+}
+
+int uart_release()
+{
+    return 0;
+}
+
+int uart_flush_buffers()
+{
+    return fflush(stdout);
+}
+
+int uart_write(void *data, uint32_t bytes, uint32_t timeout)
+{
+    (void)timeout;
+    fwrite(data, 1, bytes, stdout);
+    fflush(stdout);
+    if (bytes >= sizeof(DONE_LINE) - 1 && memcmp(data, DONE_LINE, sizeof(DONE_LINE) - 1) == 0) {
+        xSemaphoreGive(s_done);
+    }
+    return (int)bytes;
+}
+
+int uart_read(void *buffer, uint32_t bytes, uint32_t timeout)
+{
+    (void)buffer;
+    (void)bytes;
+    (void)timeout;
+    return 0;
+}
+
+void uart_host_wait_done(void)
+{
+    uart_init();
+    xSemaphoreTake(s_done, portMAX_DELAY);
+}
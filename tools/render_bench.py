@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+"""
+Render benchmark driver (CONFIG_RENDER_BENCH, main/render_bench.cpp).
+
+The firmware writes one JSON object per line to UART1 (921600 baud) for
+each phase: lv_demo_benchmark, then the Screen2 -> Screen1 and
+Screen1 -> Screen2 transitions of the quiz. Avoid-tearing mode, rotation
+and draw buffers are compile-time options, so every configuration is a
+separate build.
+
+Collect the results of the firmware already flashed:
+
+    python tools/render_bench.py collect --port /dev/ttyUSB1
+
+Build, flash and collect every configuration of the matrix below and
+write one CSV:
+
+    python tools/render_bench.py matrix --flash-port /dev/ttyACM0 --port /dev/ttyUSB1 -o bench.csv
+
+Needs pyserial, and ESP-IDF (idf.py) for "matrix".
+"""
+import argparse
+import csv
+import json
+import os
+import subprocess
+import sys
+import time
+
+REPO_ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+BAUD = 921600
+
+# name -> sdkconfig lines added on top of sdkconfig.defaults
+MATRIX = {
+    "mode0_rows20x2_sram": ["CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT=20", "CONFIG_LVGL_PORT_BUFFER_NUM=2"],
+    "mode0_rows20x2_sram_noflushtask": ["CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT=20", "CONFIG_LVGL_PORT_BUFFER_NUM=2",
+                                        "CONFIG_LVGL_PORT_FLUSH_TASK=n"],
+    "mode0_rows20x2_sram_parblend": ["CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT=20", "CONFIG_LVGL_PORT_BUFFER_NUM=2",
+                                     "CONFIG_LVGL_PORT_PARALLEL_BLEND=y"],
+    "mode0_rows40x2_sram_parblend": ["CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT=40", "CONFIG_LVGL_PORT_BUFFER_NUM=2",
+                                     "CONFIG_LVGL_PORT_PARALLEL_BLEND=y"],
+    "mode0_rows20x2_sram_blit": ["CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT=20", "CONFIG_LVGL_PORT_BUFFER_NUM=2",
+                                 "CONFIG_LVGL_PORT_ASYNC_BLIT=y"],
+    "mode0_rows40x2_sram_blit": ["CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT=40", "CONFIG_LVGL_PORT_BUFFER_NUM=2",
+                                 "CONFIG_LVGL_PORT_ASYNC_BLIT=y"],
+    "mode0_rows20x2_sram_notxtcache": ["CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT=20", "CONFIG_LVGL_PORT_BUFFER_NUM=2",
+                                       "CONFIG_LV_TXT_LAYOUT_CACHE_NUM=0"],
+    "mode0_rows20x2_sram_fullfonts": ["CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT=20", "CONFIG_LVGL_PORT_BUFFER_NUM=2",
+                                      "CONFIG_UI_FONT_SUBSET=n"],
+    "mode0_rows20x2_sram_scrcache": ["CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT=20", "CONFIG_LVGL_PORT_BUFFER_NUM=2",
+                                     "CONFIG_UI_SCREEN_CACHE=y"],
+    "mode0_rows20x2_sram_slide": ["CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT=20", "CONFIG_LVGL_PORT_BUFFER_NUM=2",
+                                  "CONFIG_UI_SCREEN_TRANSITION_SLIDE=y"],
+    "mode0_rows20x2_sram_slide_scrcache": ["CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT=20", "CONFIG_LVGL_PORT_BUFFER_NUM=2",
+                                           "CONFIG_UI_SCREEN_TRANSITION_SLIDE=y", "CONFIG_UI_SCREEN_CACHE=y"],
+    "mode0_rows20x2_sram_fade": ["CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT=20", "CONFIG_LVGL_PORT_BUFFER_NUM=2",
+                                 "CONFIG_UI_SCREEN_TRANSITION_FADE=y"],
+    "mode0_rows20x2_sram_fade_scrcache": ["CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT=20", "CONFIG_LVGL_PORT_BUFFER_NUM=2",
+                                          "CONFIG_UI_SCREEN_TRANSITION_FADE=y", "CONFIG_UI_SCREEN_CACHE=y"],
+    "mode0_rows20x2_sram_mempsram": ["CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT=20", "CONFIG_LVGL_PORT_BUFFER_NUM=2",
+                                     "CONFIG_LV_MEM_PSRAM_ONLY=y"],
+    "mode0_rows20x2_sram_memmalloc": ["CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT=20", "CONFIG_LVGL_PORT_BUFFER_NUM=2",
+                                      "CONFIG_LV_MEM_PSRAM_MALLOC=y"],
+    "mode0_rows20x2_sram_polling": ["CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT=20", "CONFIG_LVGL_PORT_BUFFER_NUM=2",
+                                    "CONFIG_LVGL_PORT_EVENT_WAKE=n"],
+    "mode0_rows20x2_sram_touchpoll": ["CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT=20", "CONFIG_LVGL_PORT_BUFFER_NUM=2",
+                                      "CONFIG_LVGL_PORT_TOUCH_TASK=n"],
+    "mode0_rows20x1_sram": ["CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT=20", "CONFIG_LVGL_PORT_BUFFER_NUM=1"],
+    "mode0_rows40x2_sram": ["CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT=40", "CONFIG_LVGL_PORT_BUFFER_NUM=2"],
+    "mode0_rows80x2_psram": ["CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT=80", "CONFIG_LVGL_PORT_BUFFER_NUM=2",
+                             "CONFIG_LVGL_PORT_BUFFER_PSRAM=y"],
+    "mode0_full_psram": ["CONFIG_LVGL_PORT_BUFFER_SIZE_HEIGHT=480", "CONFIG_LVGL_PORT_BUFFER_NUM=2",
+                         "CONFIG_LVGL_PORT_BUFFER_PSRAM=y"],
+    "mode1": ["CONFIG_LVGL_PORT_AVOID_TEARING_MODE_1=y"],
+    "mode2": ["CONFIG_LVGL_PORT_AVOID_TEARING_MODE_2=y"],
+    "mode3": ["CONFIG_LVGL_PORT_AVOID_TEARING_MODE_3=y"],
+    "mode3_rot90": ["CONFIG_LVGL_PORT_AVOID_TEARING_MODE_3=y", "CONFIG_LVGL_PORT_ROTATION_DEGREE_90=y"],
+    "mode3_rot180": ["CONFIG_LVGL_PORT_AVOID_TEARING_MODE_3=y", "CONFIG_LVGL_PORT_ROTATION_DEGREE_180=y"],
+    "mode3_rot90_noage": ["CONFIG_LVGL_PORT_AVOID_TEARING_MODE_3=y", "CONFIG_LVGL_PORT_ROTATION_DEGREE_90=y",
+                          "CONFIG_LVGL_PORT_BUFFER_AGE=n"],
+}
+
+
+def collect(port, timeout):
+    """JSON records read from `port` until the firmware reports "done"."""
+    import serial
+
+    records = []
+    deadline = time.time() + timeout
+    with serial.Serial(port, BAUD, timeout=1) as ser:
+        while time.time() < deadline:
+            line = ser.readline().decode("utf-8", "replace").strip()
+            if not line.startswith("{"):
+                continue
+            try:
+                rec = json.loads(line)
+            except ValueError:
+                continue
+            if rec.get("bench") == "done":
+                return records
+            if rec.get("bench") == "render":
+                print("  %-24s %6.1f fps  render %6d us  flush %6d us  rot %7d B  split %6d px  occl %7d B  blit %6d kcyc/img  txt %4d/%4d hit/miss  glyph %5d/%4d hit/miss  switch %5.1f ms  anim %4.1f fps  scr %d/%d hit/miss  wake %5.1f/s  i2c %5.1f/s  cpu %s" % (
+                    rec["phase"], rec["fps"], rec["render_us"], rec["flush_us"], rec.get("rotate_bytes", 0),
+                    rec.get("split_px", 0),
+                    rec.get("occl_fill_bytes", 0), rec.get("blit_saved_kcyc_per_img", 0),
+                    rec.get("txt_hits", 0), rec.get("txt_misses", 0),
+                    rec.get("glyph_hits", 0), rec.get("glyph_misses", 0),
+                    rec.get("first_frame_ms", 0), rec.get("anim_fps", 0),
+                    rec.get("scr_hits", 0), rec.get("scr_misses", 0), rec.get("wakeups_per_s", 0),
+                    rec.get("touch_reads_per_s", 0),
+                    "/".join("%.0f%%" % rec[k] for k in sorted(rec) if k.startswith("cpu"))))
+                records.append(rec)
+            elif rec.get("bench") == "style":
+                print("  %-24s %6.1f ns/lookup  %d objs  pool %.1f/%d KB  spills %d" % (
+                    "style_" + rec["lv_mem"], rec["ns_per_lookup"], rec["objs"], rec["pool_peak_kb"], rec["pool_kb"],
+                    rec["spills"]))
+                records.append(rec)
+    raise SystemExit("timeout waiting for the benchmark on %s" % port)
+
+
+def build_and_flash(name, lines, flash_port):
+    build_dir = os.path.join(REPO_ROOT, "build_bench", name)
+    os.makedirs(build_dir, exist_ok=True)
+    frag = os.path.join(build_dir, "sdkconfig.bench")
+    with open(frag, "w") as f:
+        f.write("\n".join(["CONFIG_RENDER_BENCH=y"] + lines) + "\n")
+
+    defaults = ";".join([os.path.join(REPO_ROOT, "sdkconfig.defaults"), frag])
+    subprocess.run(["idf.py", "-C", REPO_ROOT, "-B", build_dir,
+                    "-D", "SDKCONFIG=" + os.path.join(build_dir, "sdkconfig"),
+                    "-D", "SDKCONFIG_DEFAULTS=" + defaults,
+                    "-p", flash_port, "build", "flash"], check=True)
+
+
+def write_csv(path, records):
+    keys = []
+    for rec in records:
+        keys += [k for k in rec if k not in keys]
+    out = open(path, "w", newline="") if path != "-" else sys.stdout
+    w = csv.DictWriter(out, fieldnames=keys)
+    w.writeheader()
+    w.writerows(records)
+    if out is not sys.stdout:
+        out.close()
+        print("%s: %d rows" % (path, len(records)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="cmd", required=True)
+
+    p = sub.add_parser("collect", help="read the results of the flashed firmware")
+    p.add_argument("--port", required=True, help="serial port wired to UART1 (GPIO19 RX / GPIO20 TX)")
+    p.add_argument("--timeout", type=float, default=600)
+    p.add_argument("-o", "--output", default="-", help="CSV file, default stdout")
+
+    p = sub.add_parser("matrix", help="build, flash and collect every configuration")
+    p.add_argument("--flash-port", required=True)
+    p.add_argument("--port", required=True, help="serial port wired to UART1")
+    p.add_argument("--only", nargs="*", choices=sorted(MATRIX), help="subset of configurations")
+    p.add_argument("--timeout", type=float, default=600)
+    p.add_argument("-o", "--output", default="-")
+
+    args = parser.parse_args()
+    if args.cmd == "collect":
+        write_csv(args.output, collect(args.port, args.timeout))
+        return
+
+    records = []
+    for name in args.only or MATRIX:
+        print("== %s" % name)
+        build_and_flash(name, MATRIX[name], args.flash_port)
+        for rec in collect(args.port, args.timeout):
+            records.append(dict(config=name, **rec))
+    write_csv(args.output, records)
+
+
+if __name__ == "__main__":
+    main()